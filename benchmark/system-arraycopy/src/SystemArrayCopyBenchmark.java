@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import com.google.caliper.SimpleBenchmark;
+
+public class SystemArrayCopyBenchmark extends SimpleBenchmark {
+  // Each benchmark moves `length` elements by one position within the same array. The
+  // intrinsics copy forward, so moving the elements down is done inline, while moving them
+  // up falls back to the native System.arraycopy.
+  static final int smallLength = 16;
+  static final int largeLength = 1024;
+  static char[] chars = new char[largeLength + 1];
+  static Object[] objects = new Object[largeLength + 1];
+
+  static {
+    for (int i = 0; i < objects.length; i++) {
+      objects[i] = new Object();
+    }
+  }
+
+  public void timeSmallCharArrayIntrinsic(int reps) {
+    for (int i = 0; i < reps; i++) {
+      System.arraycopy(chars, 1, chars, 0, smallLength);
+    }
+  }
+
+  public void timeSmallCharArrayRuntime(int reps) {
+    for (int i = 0; i < reps; i++) {
+      System.arraycopy(chars, 0, chars, 1, smallLength);
+    }
+  }
+
+  public void timeLargeCharArrayIntrinsic(int reps) {
+    for (int i = 0; i < reps; i++) {
+      System.arraycopy(chars, 1, chars, 0, largeLength);
+    }
+  }
+
+  public void timeLargeCharArrayRuntime(int reps) {
+    for (int i = 0; i < reps; i++) {
+      System.arraycopy(chars, 0, chars, 1, largeLength);
+    }
+  }
+
+  public void timeSmallObjectArrayIntrinsic(int reps) {
+    for (int i = 0; i < reps; i++) {
+      System.arraycopy(objects, 1, objects, 0, smallLength);
+    }
+  }
+
+  public void timeSmallObjectArrayRuntime(int reps) {
+    for (int i = 0; i < reps; i++) {
+      System.arraycopy(objects, 0, objects, 1, smallLength);
+    }
+  }
+
+  public void timeLargeObjectArrayIntrinsic(int reps) {
+    for (int i = 0; i < reps; i++) {
+      System.arraycopy(objects, 1, objects, 0, largeLength);
+    }
+  }
+
+  public void timeLargeObjectArrayRuntime(int reps) {
+    for (int i = 0; i < reps; i++) {
+      System.arraycopy(objects, 0, objects, 1, largeLength);
+    }
+  }
+}
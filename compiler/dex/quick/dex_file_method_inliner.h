@@ -128,6 +128,7 @@ class DexFileMethodInliner {
       kClassCacheJavaLangObject,
       kClassCacheJavaLangRefReference,
       kClassCacheJavaLangString,
+      kClassCacheJavaLangCharSequence,
       kClassCacheJavaLangStringBuffer,
       kClassCacheJavaLangStringBuilder,
       kClassCacheJavaLangStringFactory,
@@ -211,6 +212,21 @@ class DexFileMethodInliner {
       kNameCacheNumberOfTrailingZeros,
       kNameCacheRotateRight,
       kNameCacheRotateLeft,
+      kNameCacheBitCount,
+      kNameCacheCompare,
+      kNameCacheHighestOneBit,
+      kNameCacheLowestOneBit,
+      kNameCacheSignum,
+      kNameCacheHashCode,
+      kNameCacheContentEquals,
+      kNameCacheCos,
+      kNameCacheSin,
+      kNameCacheTan,
+      kNameCacheAtan2,
+      kNameCacheExp,
+      kNameCacheLog,
+      kNameCachePow,
+      kNameCacheHypot,
       kNameCacheLast
     };
 
@@ -244,10 +260,12 @@ class DexFileMethodInliner {
       kProtoCacheJ_S,
       kProtoCacheJB_V,
       kProtoCacheJI_V,
+      kProtoCacheJJ_I,
       kProtoCacheJJ_J,
       kProtoCacheJJ_V,
       kProtoCacheJS_V,
       kProtoCacheObject_Z,
+      kProtoCacheCharSequence_Z,
       kProtoCacheJI_J,
       kProtoCacheObjectJII_Z,
       kProtoCacheObjectJJJ_Z,
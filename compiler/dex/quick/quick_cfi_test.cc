@@ -69,7 +69,8 @@ class QuickCFITest : public CFITest {
       nullptr,
       new PassManagerOptions(),
       nullptr,
-      false);
+      false,
+      kRegisterAllocatorDefault);
     VerificationResults verification_results(&compiler_options);
     DexFileToMethodInlinerMap method_inliner_map;
     std::unique_ptr<const InstructionSetFeatures> isa_features;
@@ -41,6 +41,9 @@ class QuickAssembleX86TestBase : public testing::Test {
         CompilerOptions::kDefaultNumDexMethodsThreshold,
         CompilerOptions::kDefaultInlineDepthLimit,
         CompilerOptions::kDefaultInlineMaxCodeUnits,
+        CompilerOptions::kDefaultLoopUnrollFactor,
+        CompilerOptions::kDefaultLoopUnrollMaxSize,
+        CompilerOptions::kDefaultLoopPeelMaxSize,
         false,
         CompilerOptions::kDefaultTopKProfileThreshold,
         false,
@@ -52,7 +55,8 @@ class QuickAssembleX86TestBase : public testing::Test {
         nullptr,
         new PassManagerOptions(),
         nullptr,
-        false));
+        false,
+        kRegisterAllocatorDefault));
     verification_results_.reset(new VerificationResults(compiler_options_.get()));
     method_inliner_map_.reset(new DexFileToMethodInlinerMap());
     compiler_driver_.reset(new CompilerDriver(
@@ -0,0 +1,377 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compiled_method_cache.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <memory>
+#include <sstream>
+
+#include "arch/instruction_set_features.h"
+#include "base/casts.h"
+#include "base/logging.h"
+#include "base/stringprintf.h"
+#include "base/unix_file/fd_file.h"
+#include "compiled_method.h"
+#include "compiler_options.h"
+#include "dex_instruction-inl.h"
+#include "globals.h"
+#include "modifiers.h"
+#include "oat.h"
+#include "os.h"
+#include "utils.h"
+#include "utils/array_ref.h"
+
+namespace art {
+
+// An entry starts with the magic and the version of the entry format, followed by the key and
+// the compiled method. Numbers are stored as native 32-bit words, arrays as their size in bytes
+// followed by their contents.
+static constexpr uint8_t kEntryMagic[] = { 'c', 'm', 'c', '\n' };
+static constexpr uint8_t kEntryVersion[] = { '0', '0', '1', '\0' };
+
+static void AppendUint32(std::vector<uint8_t>* data, uint32_t value) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+  data->insert(data->end(), bytes, bytes + sizeof(value));
+}
+
+static void AppendArray(std::vector<uint8_t>* data, const uint8_t* begin, size_t size) {
+  AppendUint32(data, dchecked_integral_cast<uint32_t>(size));
+  data->insert(data->end(), begin, begin + size);
+}
+
+template <typename Vector>
+static void AppendVector(std::vector<uint8_t>* data, const Vector* vector) {
+  if (vector == nullptr) {
+    AppendArray(data, nullptr, 0u);
+  } else {
+    AppendArray(data, vector->data(), vector->size());
+  }
+}
+
+static void AppendKeyUint32(std::string* key, uint32_t value) {
+  key->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Reads an entry, failing instead of reading past its end.
+class EntryReader {
+ public:
+  explicit EntryReader(const std::vector<uint8_t>& data) : data_(data), pos_(0u) {}
+
+  bool ReadUint32(uint32_t* value) {
+    if (data_.size() - pos_ < sizeof(*value)) {
+      return false;
+    }
+    memcpy(value, data_.data() + pos_, sizeof(*value));
+    pos_ += sizeof(*value);
+    return true;
+  }
+
+  bool ReadArray(ArrayRef<const uint8_t>* array) {
+    uint32_t size;
+    if (!ReadUint32(&size) || data_.size() - pos_ < size) {
+      return false;
+    }
+    *array = ArrayRef<const uint8_t>(data_.data() + pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  bool ReadBytes(ArrayRef<const uint8_t>* array, size_t size) {
+    if (data_.size() - pos_ < size) {
+      return false;
+    }
+    *array = ArrayRef<const uint8_t>(data_.data() + pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  bool IsAtEnd() const {
+    return pos_ == data_.size();
+  }
+
+ private:
+  const std::vector<uint8_t>& data_;
+  size_t pos_;
+};
+
+static bool Matches(const ArrayRef<const uint8_t>& array, const uint8_t* expected, size_t size) {
+  return array.size() == size && memcmp(array.data(), expected, size) == 0;
+}
+
+// Returns whether the code item only holds instructions whose compiled code does not depend on
+// other classes.
+static bool HasOnlySelfContainedInstructions(const DexFile::CodeItem& code_item) {
+  const Instruction* inst = Instruction::At(code_item.insns_);
+  const Instruction* end = Instruction::At(code_item.insns_ + code_item.insns_size_in_code_units_);
+  for (; inst < end; inst = inst->Next()) {
+    // Types, strings, fields and methods are resolved against other classes, and so are the
+    // quickened field offsets and vtable indices.
+    if (Instruction::IndexTypeOf(inst->Opcode()) != Instruction::kIndexNone) {
+      return false;
+    }
+    // The compiler drops the type check of an array store when it knows that the stored value is
+    // assignable to the component type, which depends on the class hierarchy.
+    if (inst->Opcode() == Instruction::APUT_OBJECT) {
+      return false;
+    }
+  }
+  return true;
+}
+
+CompiledMethodCache::CompiledMethodCache(const std::string& directory,
+                                         const CompilerOptions& compiler_options,
+                                         Compiler::Kind compiler_kind,
+                                         InstructionSet instruction_set,
+                                         const InstructionSetFeatures* instruction_set_features,
+                                         bool image)
+    : directory_(directory),
+      compiler_kind_(compiler_kind),
+      instruction_set_(instruction_set),
+      hits_(0u),
+      misses_(0u) {
+  std::ostringstream oss;
+  oss << "oat-version=" << reinterpret_cast<const char*>(OatHeader::kOatVersion)
+      << " isa=" << GetInstructionSetString(instruction_set)
+      << " features=" << instruction_set_features->GetFeatureString()
+      << " compiler=" << static_cast<int>(compiler_kind)
+      << " image=" << image
+      << " read-barrier=" << kUseReadBarrier
+      << " heap-poisoning=" << kPoisonHeapReferences
+      << " tlab=" << kUseTlab
+      << " filter=" << compiler_options.GetCompilerFilter()
+      << " huge=" << compiler_options.GetHugeMethodThreshold()
+      << " large=" << compiler_options.GetLargeMethodThreshold()
+      << " small=" << compiler_options.GetSmallMethodThreshold()
+      << " tiny=" << compiler_options.GetTinyMethodThreshold()
+      << " inline-depth=" << compiler_options.GetInlineDepthLimit()
+      << " inline-units=" << compiler_options.GetInlineMaxCodeUnits()
+      << " unroll-factor=" << compiler_options.GetLoopUnrollFactor()
+      << " unroll-size=" << compiler_options.GetLoopUnrollMaxSize()
+      << " peel-size=" << compiler_options.GetLoopPeelMaxSize()
+      << " debuggable=" << compiler_options.GetDebuggable()
+      << " debug-info=" << compiler_options.GetGenerateDebugInfo()
+      << " implicit-null=" << compiler_options.GetImplicitNullChecks()
+      << " implicit-so=" << compiler_options.GetImplicitStackOverflowChecks()
+      << " implicit-suspend=" << compiler_options.GetImplicitSuspendChecks()
+      << " pic=" << compiler_options.GetCompilePic()
+      << " patch-info=" << compiler_options.GetIncludePatchInformation()
+      << " regalloc=" << static_cast<int>(compiler_options.GetRegisterAllocationStrategy())
+      << '\n';
+  key_prefix_ = oss.str();
+}
+
+std::string CompiledMethodCache::GetKey(const DexFile::CodeItem* code_item,
+                                        uint32_t access_flags,
+                                        uint32_t method_idx,
+                                        const DexFile& dex_file) const {
+  if ((access_flags & kAccNative) == 0) {
+    // Only the optimizing compiler is known not to look at other classes for such methods.
+    // Constructors may need a barrier depending on the fields of their class.
+    if (compiler_kind_ != Compiler::kOptimizing ||
+        code_item == nullptr ||
+        (access_flags & kAccConstructor) != 0 ||
+        code_item->tries_size_ != 0u ||
+        !HasOnlySelfContainedInstructions(*code_item)) {
+      return std::string();
+    }
+  }
+  std::string key(key_prefix_);
+  AppendKeyUint32(&key, access_flags & (kAccStatic | kAccSynchronized | kAccNative));
+  uint32_t shorty_length;
+  const char* shorty = dex_file.GetMethodShorty(dex_file.GetMethodId(method_idx), &shorty_length);
+  AppendKeyUint32(&key, shorty_length);
+  key.append(shorty, shorty_length);
+  if (code_item != nullptr) {
+    AppendKeyUint32(&key, code_item->registers_size_);
+    AppendKeyUint32(&key, code_item->ins_size_);
+    AppendKeyUint32(&key, code_item->outs_size_);
+    AppendKeyUint32(&key, code_item->insns_size_in_code_units_);
+    key.append(reinterpret_cast<const char*>(code_item->insns_),
+               code_item->insns_size_in_code_units_ * sizeof(code_item->insns_[0]));
+  }
+  return key;
+}
+
+std::string CompiledMethodCache::GetEntryPath(const std::string& key) const {
+  // 64-bit FNV-1a. The key is compared on load, so a collision only costs a recompilation.
+  uint64_t hash = UINT64_C(0xcbf29ce484222325);
+  for (char c : key) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * UINT64_C(0x100000001b3);
+  }
+  return StringPrintf("%s/%016" PRIx64, directory_.c_str(), hash);
+}
+
+static CompiledMethod* DecodeEntry(const std::vector<uint8_t>& data,
+                                   const std::string& key,
+                                   InstructionSet instruction_set,
+                                   CompilerDriver* driver) {
+  EntryReader reader(data);
+  ArrayRef<const uint8_t> magic;
+  ArrayRef<const uint8_t> version;
+  ArrayRef<const uint8_t> entry_key;
+  if (!reader.ReadBytes(&magic, sizeof(kEntryMagic)) ||
+      !Matches(magic, kEntryMagic, sizeof(kEntryMagic)) ||
+      !reader.ReadBytes(&version, sizeof(kEntryVersion)) ||
+      !Matches(version, kEntryVersion, sizeof(kEntryVersion)) ||
+      !reader.ReadArray(&entry_key) ||
+      !Matches(entry_key, reinterpret_cast<const uint8_t*>(key.data()), key.size())) {
+    return nullptr;
+  }
+  uint32_t entry_instruction_set;
+  uint32_t frame_size_in_bytes;
+  uint32_t core_spill_mask;
+  uint32_t fp_spill_mask;
+  ArrayRef<const uint8_t> quick_code;
+  ArrayRef<const uint8_t> mapping_table;
+  ArrayRef<const uint8_t> vmap_table;
+  ArrayRef<const uint8_t> gc_map;
+  ArrayRef<const uint8_t> cfi_info;
+  uint32_t src_map_size;
+  if (!reader.ReadUint32(&entry_instruction_set) ||
+      entry_instruction_set != static_cast<uint32_t>(instruction_set) ||
+      !reader.ReadUint32(&frame_size_in_bytes) ||
+      !reader.ReadUint32(&core_spill_mask) ||
+      !reader.ReadUint32(&fp_spill_mask) ||
+      !reader.ReadArray(&quick_code) ||
+      quick_code.empty() ||
+      !reader.ReadArray(&mapping_table) ||
+      !reader.ReadArray(&vmap_table) ||
+      !reader.ReadArray(&gc_map) ||
+      !reader.ReadArray(&cfi_info) ||
+      !reader.ReadUint32(&src_map_size)) {
+    return nullptr;
+  }
+  DefaultSrcMap src_mapping_table;
+  for (uint32_t i = 0; i != src_map_size; ++i) {
+    SrcMapElem elem;
+    uint32_t to;
+    if (!reader.ReadUint32(&elem.from_) ||
+        !reader.ReadUint32(&to) ||
+        (!src_mapping_table.empty() && elem.from_ < src_mapping_table.back().from_)) {
+      return nullptr;
+    }
+    elem.to_ = static_cast<int32_t>(to);
+    src_mapping_table.push_back(elem);
+  }
+  if (!reader.IsAtEnd()) {
+    return nullptr;
+  }
+  return CompiledMethod::SwapAllocCompiledMethod(driver,
+                                                 instruction_set,
+                                                 quick_code,
+                                                 frame_size_in_bytes,
+                                                 core_spill_mask,
+                                                 fp_spill_mask,
+                                                 &src_mapping_table,
+                                                 mapping_table,
+                                                 vmap_table,
+                                                 gc_map,
+                                                 cfi_info,
+                                                 ArrayRef<const LinkerPatch>());
+}
+
+CompiledMethod* CompiledMethodCache::Lookup(const std::string& key, CompilerDriver* driver) {
+  DCHECK(!key.empty());
+  std::string path = GetEntryPath(key);
+  std::vector<uint8_t> data;
+  {
+    std::unique_ptr<File> file(OS::OpenFileForReading(path.c_str()));
+    if (file == nullptr) {
+      misses_.FetchAndAddSequentiallyConsistent(1u);
+      return nullptr;
+    }
+    int64_t length = file->GetLength();
+    if (length >= 0) {
+      data.resize(static_cast<size_t>(length));
+      if (!file->ReadFully(data.data(), data.size())) {
+        data.clear();
+      }
+    }
+  }
+  CompiledMethod* compiled_method = data.empty()
+      ? nullptr
+      : DecodeEntry(data, key, instruction_set_, driver);
+  if (compiled_method == nullptr) {
+    LOG(WARNING) << "Deleting compiled method cache entry " << path
+                 << " which does not match its key";
+    unlink(path.c_str());
+    misses_.FetchAndAddSequentiallyConsistent(1u);
+    return nullptr;
+  }
+  // Bump the modification time, so that entries which are no longer used can be told apart
+  // when trimming the cache directory.
+  utimes(path.c_str(), nullptr);
+  hits_.FetchAndAddSequentiallyConsistent(1u);
+  return compiled_method;
+}
+
+void CompiledMethodCache::Store(const std::string& key, const CompiledMethod& compiled_method) {
+  DCHECK(!key.empty());
+  if (!compiled_method.GetPatches().empty()) {
+    // Linker patches refer to other methods, types or strings, which the key does not cover.
+    return;
+  }
+  std::vector<uint8_t> data;
+  data.insert(data.end(), kEntryMagic, kEntryMagic + sizeof(kEntryMagic));
+  data.insert(data.end(), kEntryVersion, kEntryVersion + sizeof(kEntryVersion));
+  AppendArray(&data, reinterpret_cast<const uint8_t*>(key.data()), key.size());
+  AppendUint32(&data, static_cast<uint32_t>(compiled_method.GetInstructionSet()));
+  AppendUint32(&data, dchecked_integral_cast<uint32_t>(compiled_method.GetFrameSizeInBytes()));
+  AppendUint32(&data, compiled_method.GetCoreSpillMask());
+  AppendUint32(&data, compiled_method.GetFpSpillMask());
+  AppendVector(&data, compiled_method.GetQuickCode());
+  AppendVector(&data, compiled_method.GetMappingTable());
+  AppendVector(&data, compiled_method.GetVmapTable());
+  AppendVector(&data, compiled_method.GetGcMap());
+  AppendVector(&data, compiled_method.GetCFIInfo());
+  const SwapSrcMap& src_mapping_table = compiled_method.GetSrcMappingTable();
+  AppendUint32(&data, dchecked_integral_cast<uint32_t>(src_mapping_table.size()));
+  for (const SrcMapElem& elem : src_mapping_table) {
+    AppendUint32(&data, elem.from_);
+    AppendUint32(&data, static_cast<uint32_t>(elem.to_));
+  }
+
+  // Write a temporary file and rename it, so that no compilation ever reads a partial entry.
+  std::string path = GetEntryPath(key);
+  std::string temp_path = StringPrintf("%s.%d.%d.tmp", path.c_str(), getpid(), GetTid());
+  std::unique_ptr<File> file(OS::CreateEmptyFile(temp_path.c_str()));
+  if (file == nullptr) {
+    PLOG(WARNING) << "Failed to create compiled method cache entry " << temp_path;
+    return;
+  }
+  if (!file->WriteFully(data.data(), data.size())) {
+    PLOG(WARNING) << "Failed to write compiled method cache entry " << temp_path;
+    file->Erase();
+    unlink(temp_path.c_str());
+    return;
+  }
+  if (file->FlushCloseOrErase() != 0) {
+    PLOG(WARNING) << "Failed to flush compiled method cache entry " << temp_path;
+    unlink(temp_path.c_str());
+    return;
+  }
+  if (rename(temp_path.c_str(), path.c_str()) != 0) {
+    PLOG(WARNING) << "Failed to rename " << temp_path << " to " << path;
+    unlink(temp_path.c_str());
+  }
+}
+
+}  // namespace art
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_DRIVER_COMPILED_METHOD_CACHE_H_
+#define ART_COMPILER_DRIVER_COMPILED_METHOD_CACHE_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "arch/instruction_set.h"
+#include "atomic.h"
+#include "base/macros.h"
+#include "compiler.h"
+#include "dex_file.h"
+
+namespace art {
+
+class CompiledMethod;
+class CompilerDriver;
+class CompilerOptions;
+class InstructionSetFeatures;
+
+// A cache of compiled methods kept on disk, so that a later dex2oat run does not compile the
+// same methods again. Each entry is a file in the cache directory named after a hash of its key.
+// The key holds everything the compiled code depends on: the oat version, the instruction set and
+// its features, the compiler and its options, and the method's access flags, shorty and code
+// item. The whole key is stored in the entry and compared on load; an entry that does not match
+// or cannot be parsed is deleted and the method is compiled again.
+//
+// Only methods whose compiled code depends on nothing but the key are cached: JNI stubs, and
+// methods without try blocks whose instructions do not refer to types, strings, fields or other
+// methods. The code compiled for any other method bakes in what the compiler knew about other
+// classes, e.g. through inlining or field offsets, and the key cannot capture that.
+class CompiledMethodCache {
+ public:
+  CompiledMethodCache(const std::string& directory,
+                      const CompilerOptions& compiler_options,
+                      Compiler::Kind compiler_kind,
+                      InstructionSet instruction_set,
+                      const InstructionSetFeatures* instruction_set_features,
+                      bool image);
+
+  // Returns the key of the method, or an empty string if its compiled code cannot be cached.
+  // `code_item` is null for native methods.
+  std::string GetKey(const DexFile::CodeItem* code_item,
+                     uint32_t access_flags,
+                     uint32_t method_idx,
+                     const DexFile& dex_file) const;
+
+  // Returns a new CompiledMethod made from the entry for `key`, or null if there is no valid one.
+  CompiledMethod* Lookup(const std::string& key, CompilerDriver* driver);
+
+  // Writes the entry for `key`. Failures are logged, the compilation does not depend on them.
+  void Store(const std::string& key, const CompiledMethod& compiled_method);
+
+  size_t GetHits() const {
+    return hits_.LoadRelaxed();
+  }
+
+  size_t GetMisses() const {
+    return misses_.LoadRelaxed();
+  }
+
+ private:
+  std::string GetEntryPath(const std::string& key) const;
+
+  const std::string directory_;
+  const Compiler::Kind compiler_kind_;
+  const InstructionSet instruction_set_;
+
+  // The part of every key that does not depend on the method.
+  std::string key_prefix_;
+
+  Atomic<size_t> hits_;
+  Atomic<size_t> misses_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompiledMethodCache);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_DRIVER_COMPILED_METHOD_CACHE_H_
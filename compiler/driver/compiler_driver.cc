@@ -36,6 +36,7 @@
 #include "compiled_class.h"
 #include "compiled_method.h"
 #include "compiler.h"
+#include "compiler_callbacks.h"
 #include "compiler_driver-inl.h"
 #include "dex_compilation_unit.h"
 #include "dex_file-inl.h"
@@ -44,6 +45,7 @@
 #include "dex/verified_method.h"
 #include "dex/quick/dex_file_method_inliner.h"
 #include "dex/quick/dex_file_to_method_inliner_map.h"
+#include "driver/compiled_method_cache.h"
 #include "driver/compiler_options.h"
 #ifndef MOE
 #include "elf_writer_quick.h"
@@ -76,6 +78,7 @@
 #include "utils/swap_space.h"
 #include "verifier/method_verifier.h"
 #include "verifier/method_verifier-inl.h"
+#include "verifier/verifier_deps.h"
 
 namespace art {
 
@@ -451,6 +454,15 @@ CompilerDriver::~CompilerDriver() {
   compiler_->UnInit();
 }
 
+void CompilerDriver::SetCompiledMethodCacheDirectory(const std::string& directory) {
+  compiled_method_cache_.reset(new CompiledMethodCache(directory,
+                                                       *compiler_options_,
+                                                       compiler_kind_,
+                                                       instruction_set_,
+                                                       instruction_set_features_,
+                                                       image_));
+}
+
 #define CREATE_TRAMPOLINE(type, abi, offset) \
     if (Is64BitInstructionSet(instruction_set_)) { \
       return CreateTrampoline64(instruction_set_, abi, \
@@ -569,6 +581,21 @@ static bool InstructionSetHasGenericJniStub(InstructionSet isa) {
   }
 }
 
+// Returns the key of the method in the driver's compiled method cache, or an empty string if
+// there is no such cache or the method's compiled code cannot be cached.
+static std::string GetCompiledMethodCacheKey(CompilerDriver* driver,
+                                             bool cacheable,
+                                             const DexFile::CodeItem* code_item,
+                                             uint32_t access_flags,
+                                             uint32_t method_idx,
+                                             const DexFile& dex_file) {
+  CompiledMethodCache* cache = driver->GetCompiledMethodCache();
+  if (cache == nullptr || !cacheable) {
+    return std::string();
+  }
+  return cache->GetKey(code_item, access_flags, method_idx, dex_file);
+}
+
 static void CompileMethod(Thread* self,
                           CompilerDriver* driver,
                           const DexFile::CodeItem* code_item,
@@ -593,8 +620,22 @@ static void CompileMethod(Thread* self,
         InstructionSetHasGenericJniStub(driver->GetInstructionSet())) {
       // Leaving this empty will trigger the generic JNI version
     } else {
-      compiled_method = driver->GetCompiler()->JniCompile(access_flags, method_idx, dex_file);
-      CHECK(compiled_method != nullptr);
+      std::string cache_key = GetCompiledMethodCacheKey(driver,
+                                                        /* cacheable */ true,
+                                                        code_item,
+                                                        access_flags,
+                                                        method_idx,
+                                                        dex_file);
+      if (!cache_key.empty()) {
+        compiled_method = driver->GetCompiledMethodCache()->Lookup(cache_key, driver);
+      }
+      if (compiled_method == nullptr) {
+        compiled_method = driver->GetCompiler()->JniCompile(access_flags, method_idx, dex_file);
+        CHECK(compiled_method != nullptr);
+        if (!cache_key.empty()) {
+          driver->GetCompiledMethodCache()->Store(cache_key, *compiled_method);
+        }
+      }
     }
   } else if ((access_flags & kAccAbstract) != 0) {
     // Abstract methods don't have code.
@@ -614,10 +655,27 @@ static void CompileMethod(Thread* self,
         // Is eligable for compilation by methods-to-compile filter.
         driver->IsMethodToCompile(method_ref);
     if (compile) {
-      // NOTE: if compiler declines to compile this method, it will return null.
-      compiled_method = driver->GetCompiler()->Compile(code_item, access_flags, invoke_type,
-                                                       class_def_idx, method_idx, class_loader,
-                                                       dex_file, dex_cache);
+      // A verification failure depends on the classes involved, do not reuse code compiled
+      // despite one.
+      std::string cache_key = GetCompiledMethodCacheKey(
+          driver,
+          /* cacheable */ verified_method->GetEncounteredVerificationFailures() == 0,
+          code_item,
+          access_flags,
+          method_idx,
+          dex_file);
+      if (!cache_key.empty()) {
+        compiled_method = driver->GetCompiledMethodCache()->Lookup(cache_key, driver);
+      }
+      if (compiled_method == nullptr) {
+        // NOTE: if compiler declines to compile this method, it will return null.
+        compiled_method = driver->GetCompiler()->Compile(code_item, access_flags, invoke_type,
+                                                         class_def_idx, method_idx, class_loader,
+                                                         dex_file, dex_cache);
+        if (compiled_method != nullptr && !cache_key.empty()) {
+          driver->GetCompiledMethodCache()->Store(cache_key, *compiled_method);
+        }
+      }
     }
     if (compiled_method == nullptr &&
         dex_to_dex_compilation_level != optimizer::DexToDexCompilationLevel::kDontDexToDexCompile) {
@@ -1389,14 +1447,14 @@ bool CompilerDriver::CanEmbedReferenceTypeInCode(ClassReference* ref,
   return true;
 }
 
-uint32_t CompilerDriver::GetReferenceSlowFlagOffset() const {
+uint32_t CompilerDriver::GetReferenceSlowFlagOffset() {
   ScopedObjectAccess soa(Thread::Current());
   mirror::Class* klass = mirror::Reference::GetJavaLangRefReference();
   DCHECK(klass->IsInitialized());
   return klass->GetSlowPathFlagOffset().Uint32Value();
 }
 
-uint32_t CompilerDriver::GetReferenceDisableFlagOffset() const {
+uint32_t CompilerDriver::GetReferenceDisableFlagOffset() {
   ScopedObjectAccess soa(Thread::Current());
   mirror::Class* klass = mirror::Reference::GetJavaLangRefReference();
   DCHECK(klass->IsInitialized());
@@ -2084,6 +2142,21 @@ void CompilerDriver::Verify(jobject class_loader, const std::vector<const DexFil
   }
 }
 
+// Set the status of a resolved class to verified without running the verifier.
+static void MarkClassVerified(Thread* self, Handle<mirror::Class> klass, CompilerDriver* driver)
+    SHARED_REQUIRES(Locks::mutator_lock_) {
+  if (klass->GetStatus() < mirror::Class::kStatusVerified) {
+    ObjectLock<mirror::Class> lock(self, klass);
+    // Set class status to verified.
+    mirror::Class::SetStatus(klass, mirror::Class::kStatusVerified, self);
+    // Mark methods as pre-verified. If we don't do this, the interpreter will run with
+    // access checks.
+    klass->SetPreverifiedFlagOnAllMethods(
+        GetInstructionSetPointerSize(driver->GetInstructionSet()));
+    klass->SetPreverified();
+  }
+}
+
 class VerifyClassVisitor : public CompilationVisitor {
  public:
   explicit VerifyClassVisitor(const ParallelCompilationManager* manager) : manager_(manager) {}
@@ -2122,13 +2195,26 @@ class VerifyClassVisitor : public CompilationVisitor {
       }
     } else if (!SkipClass(jclass_loader, dex_file, klass.Get())) {
       CHECK(klass->IsResolved()) << PrettyClass(klass.Get());
-      class_linker->VerifyClass(soa.Self(), klass);
+      CompilerCallbacks* callbacks = Runtime::Current()->GetCompilerCallbacks();
+      verifier::VerifierDeps* verifier_deps =
+          (callbacks != nullptr) ? callbacks->GetVerifierDeps() : nullptr;
+      if (verifier_deps != nullptr && verifier_deps->IsClassVerified(dex_file, class_def_index)) {
+        // Verified by an earlier compilation whose verifier dependencies still hold.
+        MarkClassVerified(soa.Self(), klass, manager_->GetCompiler());
+        ClassReference ref(manager_->GetDexFile(), class_def_index);
+        manager_->GetCompiler()->RecordClassStatus(ref, klass->GetStatus());
+      } else {
+        class_linker->VerifyClass(soa.Self(), klass);
 
-      if (klass->IsErroneous()) {
-        // ClassLinker::VerifyClass throws, which isn't useful in the compiler.
-        CHECK(soa.Self()->IsExceptionPending());
-        soa.Self()->ClearException();
-        manager_->GetCompiler()->SetHadHardVerifierFailure();
+        if (klass->IsErroneous()) {
+          // ClassLinker::VerifyClass throws, which isn't useful in the compiler.
+          CHECK(soa.Self()->IsExceptionPending());
+          soa.Self()->ClearException();
+          manager_->GetCompiler()->SetHadHardVerifierFailure();
+        }
+        if (verifier_deps != nullptr) {
+          verifier_deps->RecordClassVerified(dex_file, class_def_index, klass->IsVerified());
+        }
       }
 
       CHECK(klass->IsCompileTimeVerified() || klass->IsErroneous())
@@ -2180,16 +2266,7 @@ class SetVerifiedClassVisitor : public CompilationVisitor {
       // Only do this if the class is resolved. If even resolution fails, quickening will go very,
       // very wrong.
       if (klass->IsResolved()) {
-        if (klass->GetStatus() < mirror::Class::kStatusVerified) {
-          ObjectLock<mirror::Class> lock(soa.Self(), klass);
-          // Set class status to verified.
-          mirror::Class::SetStatus(klass, mirror::Class::kStatusVerified, soa.Self());
-          // Mark methods as pre-verified. If we don't do this, the interpreter will run with
-          // access checks.
-          klass->SetPreverifiedFlagOnAllMethods(
-              GetInstructionSetPointerSize(manager_->GetCompiler()->GetInstructionSet()));
-          klass->SetPreverified();
-        }
+        MarkClassVerified(soa.Self(), klass, manager_->GetCompiler());
         // Record the final class status if necessary.
         ClassReference ref(manager_->GetDexFile(), class_def_index);
         manager_->GetCompiler()->RecordClassStatus(ref, klass->GetStatus());
@@ -2631,6 +2708,21 @@ bool CompilerDriver::SkipCompilation(const std::string& method_name) {
   return !compile;
 }
 
+MethodHotness CompilerDriver::GetMethodHotness(const std::string& method_name) const {
+  if (!profile_present_) {
+    return kMethodCold;
+  }
+  ProfileFile::ProfileData data;
+  if (!profile_file_.GetProfileData(&data, method_name)) {
+    return kMethodCold;
+  }
+  // Use the same bucket comparison as SkipCompilation() so that hot methods are exactly
+  // the ones the profile asked us to compile.
+  bool hot = data.GetTopKUsedPercentage() - data.GetUsedPercent()
+             <= compiler_options_->GetTopKProfileThreshold();
+  return hot ? kMethodHot : kMethodWarm;
+}
+
 std::string CompilerDriver::GetMemoryUsageString(bool extended) const {
   std::ostringstream oss;
   Runtime* const runtime = Runtime::Current();
@@ -55,6 +55,7 @@ class MethodVerifier;
 
 class CompiledClass;
 class CompiledMethod;
+class CompiledMethodCache;
 class CompilerOptions;
 class DexCompilationUnit;
 class DexFileToMethodInlinerMap;
@@ -80,6 +81,17 @@ enum EntryPointCallingConvention {
   kQuickAbi
 };
 
+// How often a method was sampled in the profile, used to group the code of hot methods.
+enum MethodHotness : uint8_t {
+  // Part of the leading top_k_threshold % of the samples.
+  kMethodHot,
+  // Sampled, but not often enough to be hot.
+  kMethodWarm,
+  // Not in the profile, or there is no profile.
+  kMethodCold,
+  kMethodHotnessCount
+};
+
 static constexpr bool kUseMurmur3Hash = true;
 
 class CompilerDriver {
@@ -215,8 +227,8 @@ class CompilerDriver {
   // Query methods for the java.lang.ref.Reference class.
   bool CanEmbedReferenceTypeInCode(ClassReference* ref,
                                    bool* use_direct_type_ptr, uintptr_t* direct_type_ptr);
-  uint32_t GetReferenceSlowFlagOffset() const;
-  uint32_t GetReferenceDisableFlagOffset() const;
+  static uint32_t GetReferenceSlowFlagOffset();
+  static uint32_t GetReferenceDisableFlagOffset();
 
   // Get the DexCache for the
   mirror::DexCache* GetDexCache(const DexCompilationUnit* mUnit)
@@ -437,6 +449,12 @@ class CompilerDriver {
     return dedupe_enabled_;
   }
 
+  // Take compiled methods from, and add them to, the persistent cache in the given directory.
+  void SetCompiledMethodCacheDirectory(const std::string& directory);
+  CompiledMethodCache* GetCompiledMethodCache() const {
+    return compiled_method_cache_.get();
+  }
+
   // Checks if class specified by type_idx is one of the image_classes_
   bool IsImageClass(const char* descriptor) const;
 
@@ -465,6 +483,9 @@ class CompilerDriver {
   // Should the compiler run on this method given profile information?
   bool SkipCompilation(const std::string& method_name);
 
+  // Classify a method by its profile samples. Returns kMethodCold if there is no profile.
+  MethodHotness GetMethodHotness(const std::string& method_name) const;
+
   // Get memory usage during compilation.
   std::string GetMemoryUsageString(bool extended) const;
 
@@ -664,6 +685,7 @@ class CompilerDriver {
   std::unique_ptr<AOTCompilationStats> stats_;
 
   bool dedupe_enabled_;
+  std::unique_ptr<CompiledMethodCache> compiled_method_cache_;
   bool dump_stats_;
   const bool dump_passes_;
   const std::string dump_cfg_file_name_;
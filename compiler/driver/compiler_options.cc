@@ -29,6 +29,9 @@ CompilerOptions::CompilerOptions()
       num_dex_methods_threshold_(kDefaultNumDexMethodsThreshold),
       inline_depth_limit_(kDefaultInlineDepthLimit),
       inline_max_code_units_(kDefaultInlineMaxCodeUnits),
+      loop_unroll_factor_(kDefaultLoopUnrollFactor),
+      loop_unroll_max_size_(kDefaultLoopUnrollMaxSize),
+      loop_peel_max_size_(kDefaultLoopPeelMaxSize),
       include_patch_information_(kDefaultIncludePatchInformation),
       top_k_profile_threshold_(kDefaultTopKProfileThreshold),
       debuggable_(false),
@@ -40,7 +43,8 @@ CompilerOptions::CompilerOptions()
       verbose_methods_(nullptr),
       pass_manager_options_(new PassManagerOptions),
       abort_on_hard_verifier_failure_(false),
-      init_failure_output_(nullptr) {
+      init_failure_output_(nullptr),
+      register_allocation_strategy_(kRegisterAllocatorDefault) {
 }
 
 CompilerOptions::~CompilerOptions() {
@@ -56,6 +60,9 @@ CompilerOptions::CompilerOptions(CompilerFilter compiler_filter,
                                  size_t num_dex_methods_threshold,
                                  size_t inline_depth_limit,
                                  size_t inline_max_code_units,
+                                 size_t loop_unroll_factor,
+                                 size_t loop_unroll_max_size,
+                                 size_t loop_peel_max_size,
                                  bool include_patch_information,
                                  double top_k_profile_threshold,
                                  bool debuggable,
@@ -67,7 +74,8 @@ CompilerOptions::CompilerOptions(CompilerFilter compiler_filter,
                                  const std::vector<std::string>* verbose_methods,
                                  PassManagerOptions* pass_manager_options,
                                  std::ostream* init_failure_output,
-                                 bool abort_on_hard_verifier_failure
+                                 bool abort_on_hard_verifier_failure,
+                                 RegisterAllocationStrategy register_allocation_strategy
                                  ) :  // NOLINT(whitespace/parens)
     compiler_filter_(compiler_filter),
     huge_method_threshold_(huge_method_threshold),
@@ -77,6 +85,9 @@ CompilerOptions::CompilerOptions(CompilerFilter compiler_filter,
     num_dex_methods_threshold_(num_dex_methods_threshold),
     inline_depth_limit_(inline_depth_limit),
     inline_max_code_units_(inline_max_code_units),
+    loop_unroll_factor_(loop_unroll_factor),
+    loop_unroll_max_size_(loop_unroll_max_size),
+    loop_peel_max_size_(loop_peel_max_size),
     include_patch_information_(include_patch_information),
     top_k_profile_threshold_(top_k_profile_threshold),
     debuggable_(debuggable),
@@ -88,7 +99,8 @@ CompilerOptions::CompilerOptions(CompilerFilter compiler_filter,
     verbose_methods_(verbose_methods),
     pass_manager_options_(pass_manager_options),
     abort_on_hard_verifier_failure_(abort_on_hard_verifier_failure),
-    init_failure_output_(init_failure_output) {
+    init_failure_output_(init_failure_output),
+    register_allocation_strategy_(register_allocation_strategy) {
 }
 
 }  // namespace art
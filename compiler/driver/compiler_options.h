@@ -23,6 +23,7 @@
 
 #include "base/macros.h"
 #include "globals.h"
+#include "optimizing/register_allocation_strategy.h"
 
 namespace art {
 
@@ -53,6 +54,9 @@ class CompilerOptions FINAL {
   static const bool kDefaultIncludePatchInformation = false;
   static const size_t kDefaultInlineDepthLimit = 3;
   static const size_t kDefaultInlineMaxCodeUnits = 20;
+  static const size_t kDefaultLoopUnrollFactor = 4;
+  static const size_t kDefaultLoopUnrollMaxSize = 48;
+  static const size_t kDefaultLoopPeelMaxSize = 24;
 
   // Default inlining settings when the space filter is used.
   static constexpr size_t kSpaceFilterInlineDepthLimit = 3;
@@ -69,6 +73,9 @@ class CompilerOptions FINAL {
                   size_t num_dex_methods_threshold,
                   size_t inline_depth_limit,
                   size_t inline_max_code_units,
+                  size_t loop_unroll_factor,
+                  size_t loop_unroll_max_size,
+                  size_t loop_peel_max_size,
                   bool include_patch_information,
                   double top_k_profile_threshold,
                   bool debuggable,
@@ -80,7 +87,8 @@ class CompilerOptions FINAL {
                   const std::vector<std::string>* verbose_methods,
                   PassManagerOptions* pass_manager_options,
                   std::ostream* init_failure_output,
-                  bool abort_on_hard_verifier_failure);
+                  bool abort_on_hard_verifier_failure,
+                  RegisterAllocationStrategy register_allocation_strategy);
 
   CompilerFilter GetCompilerFilter() const {
     return compiler_filter_;
@@ -153,6 +161,18 @@ class CompilerOptions FINAL {
     return inline_max_code_units_;
   }
 
+  size_t GetLoopUnrollFactor() const {
+    return loop_unroll_factor_;
+  }
+
+  size_t GetLoopUnrollMaxSize() const {
+    return loop_unroll_max_size_;
+  }
+
+  size_t GetLoopPeelMaxSize() const {
+    return loop_peel_max_size_;
+  }
+
   double GetTopKProfileThreshold() const {
     return top_k_profile_threshold_;
   }
@@ -211,6 +231,10 @@ class CompilerOptions FINAL {
     return abort_on_hard_verifier_failure_;
   }
 
+  RegisterAllocationStrategy GetRegisterAllocationStrategy() const {
+    return register_allocation_strategy_;
+  }
+
  private:
   CompilerFilter compiler_filter_;
   const size_t huge_method_threshold_;
@@ -220,6 +244,12 @@ class CompilerOptions FINAL {
   const size_t num_dex_methods_threshold_;
   const size_t inline_depth_limit_;
   const size_t inline_max_code_units_;
+  // Maximum number of copies of the body of an unrolled loop.
+  const size_t loop_unroll_factor_;
+  // Maximum number of instructions in an unrolled loop, all copies included.
+  const size_t loop_unroll_max_size_;
+  // Maximum number of instructions in a loop whose first iteration is peeled.
+  const size_t loop_peel_max_size_;
   const bool include_patch_information_;
   // When using a profile file only the top K% of the profiled samples will be compiled.
   const double top_k_profile_threshold_;
@@ -242,6 +272,9 @@ class CompilerOptions FINAL {
   // Log initialization of initialization failures to this stream if not null.
   std::ostream* const init_failure_output_;
 
+  // Register allocator used by the optimizing compiler.
+  const RegisterAllocationStrategy register_allocation_strategy_;
+
   DISALLOW_COPY_AND_ASSIGN(CompilerOptions);
 };
 std::ostream& operator<<(std::ostream& os, const CompilerOptions::CompilerFilter& rhs);
@@ -42,9 +42,10 @@ class ImageTest : public CommonCompilerTest {
     ReserveImageSpace();
     CommonCompilerTest::SetUp();
   }
+  void TestWriteRead(ImageHeader::StorageMode storage_mode);
 };
 
-TEST_F(ImageTest, WriteRead) {
+void ImageTest::TestWriteRead(ImageHeader::StorageMode storage_mode) {
   TEST_DISABLED_FOR_NON_PIC_COMPILING_WITH_OPTIMIZING();
   // Create a generic location tmp file, to be the base of the .art and .oat temporary files.
   ScratchFile location;
@@ -64,8 +65,10 @@ TEST_F(ImageTest, WriteRead) {
   ScratchFile oat_file(OS::CreateEmptyFile(oat_filename.c_str()));
 
   const uintptr_t requested_image_base = ART_BASE_ADDRESS;
-  std::unique_ptr<ImageWriter> writer(new ImageWriter(*compiler_driver_, requested_image_base,
-                                                      /*compile_pic*/false));
+  std::unique_ptr<ImageWriter> writer(new ImageWriter(*compiler_driver_,
+                                                      requested_image_base,
+                                                      /*compile_pic*/false,
+                                                      storage_mode));
   // TODO: compile_pic should be a test argument.
   {
     {
@@ -113,9 +116,15 @@ TEST_F(ImageTest, WriteRead) {
     ImageHeader image_header;
     ASSERT_EQ(file->ReadFully(&image_header, sizeof(image_header)), true);
     ASSERT_TRUE(image_header.IsValid());
+    ASSERT_EQ(storage_mode, image_header.GetStorageMode());
     const auto& bitmap_section = image_header.GetImageSection(ImageHeader::kSectionImageBitmap);
     ASSERT_GE(bitmap_section.Offset(), sizeof(image_header));
     ASSERT_NE(0U, bitmap_section.Size());
+    ASSERT_EQ(image_header.GetBitmapFileOffset() + bitmap_section.Size(),
+              static_cast<uint64_t>(file->GetLength()));
+    if (storage_mode != ImageHeader::kStorageModeUncompressed) {
+      ASSERT_LT(image_header.GetDataSize(), image_header.GetImageSize() - sizeof(image_header));
+    }
 
     gc::Heap* heap = Runtime::Current()->GetHeap();
     ASSERT_TRUE(!heap->GetContinuousSpaces().empty());
@@ -171,8 +180,10 @@ TEST_F(ImageTest, WriteRead) {
 
   gc::space::ImageSpace* image_space = heap->GetImageSpace();
   ASSERT_TRUE(image_space != nullptr);
-  ASSERT_LE(image_space->Size(), image_file_size);
 
+  if (storage_mode == ImageHeader::kStorageModeUncompressed) {
+    ASSERT_LE(image_space->Size(), image_file_size);
+  }
   image_space->VerifyImageAllocations();
   uint8_t* image_begin = image_space->Begin();
   uint8_t* image_end = image_space->End();
@@ -199,6 +210,14 @@ TEST_F(ImageTest, WriteRead) {
   CHECK_EQ(0, rmdir_result);
 }
 
+TEST_F(ImageTest, WriteReadUncompressed) {
+  TestWriteRead(ImageHeader::kStorageModeUncompressed);
+}
+
+TEST_F(ImageTest, WriteReadZlib) {
+  TestWriteRead(ImageHeader::kStorageModeZlib);
+}
+
 TEST_F(ImageTest, ImageHeaderIsValid) {
     uint32_t image_begin = ART_BASE_ADDRESS;
     uint32_t image_size_ = 16 * KB;
@@ -19,6 +19,7 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
 #include <vector>
@@ -66,6 +67,7 @@
 #include "runtime.h"
 #include "scoped_thread_state_change.h"
 #include "handle_scope-inl.h"
+#include "thread_pool.h"
 #include "utils/dex_cache_arrays_layout-inl.h"
 
 using ::art::mirror::Class;
@@ -175,12 +177,18 @@ bool ImageWriter::Write(const std::string& image_filename,
 #endif
 
   {
+    // Create the workers before taking the mutator lock, attaching them must not wait on us.
+    std::unique_ptr<ThreadPool> thread_pool;
+    if (compiler_driver_.GetThreadCount() > 1u) {
+      thread_pool.reset(new ThreadPool("Image writer thread pool",
+                                       compiler_driver_.GetThreadCount() - 1u));
+    }
     ScopedObjectAccess soa(Thread::Current());
     CreateHeader(oat_loaded_size, oat_data_offset);
     CopyAndFixupNativeData();
     // TODO: heap validation can't handle these fix up passes.
     Runtime::Current()->GetHeap()->DisableObjectValidation();
-    CopyAndFixupObjects();
+    CopyAndFixupObjects(thread_pool.get());
   }
 
   SetOatChecksumFromElfFile(oat_file.get());
@@ -203,25 +211,49 @@ bool ImageWriter::Write(const std::string& image_filename,
   }
 
   // Write out the image + fields + methods.
-  const auto write_count = image_header->GetImageSize();
-  if (!image_file->WriteFully(image_->Begin(), write_count)) {
-    PLOG(ERROR) << "Failed to write image file " << image_filename;
-    image_file->Erase();
-    return false;
+  if (image_storage_mode_ == ImageHeader::kStorageModeUncompressed) {
+    const auto write_count = image_header->GetImageSize();
+    if (!image_file->WriteFully(image_->Begin(), write_count)) {
+      PLOG(ERROR) << "Failed to write image file " << image_filename;
+      image_file->Erase();
+      return false;
+    }
+  } else {
+    const uint64_t compress_start_time = NanoTime();
+    const uint8_t* data = image_->Begin() + sizeof(ImageHeader);
+    const size_t data_size = image_header->GetImageSize() - sizeof(ImageHeader);
+    std::vector<uint8_t> compressed_data;
+    size_t compressed_size = ImageHeader::CompressData(
+        image_storage_mode_, data, data_size, &compressed_data, &error_msg);
+    if (compressed_size == 0u) {
+      LOG(ERROR) << "Failed to compress image file " << image_filename << ": " << error_msg;
+      image_file->Erase();
+      return false;
+    }
+    VLOG(compiler) << "Compressed image data from " << data_size << " to " << compressed_size
+                   << " bytes in " << PrettyDuration(NanoTime() - compress_start_time);
+    image_header->SetStorageMode(image_storage_mode_, compressed_size);
+    if (!image_file->WriteFully(image_header, sizeof(ImageHeader)) ||
+        !image_file->WriteFully(compressed_data.data(), compressed_size)) {
+      PLOG(ERROR) << "Failed to write image file " << image_filename;
+      image_file->Erase();
+      return false;
+    }
   }
 
   // Write out the image bitmap at the page aligned start of the image end.
   const ImageSection& bitmap_section = image_header->GetImageSection(ImageHeader::kSectionImageBitmap);
+  const size_t bitmap_file_offset = image_header->GetBitmapFileOffset();
 #ifndef MOE
-  CHECK_ALIGNED(bitmap_section.Offset(), kPageSize);
+  CHECK_ALIGNED(bitmap_file_offset, kPageSize);
 #else
-  CHECK_ALIGNED_PARAM(bitmap_section.Offset(), instruction_set_ == kArm64 ? (4*4096) : 4096);
+  CHECK_ALIGNED_PARAM(bitmap_file_offset, instruction_set_ == kArm64 ? (4*4096) : 4096);
 #endif
   if (!image_file->Write(reinterpret_cast<char*>(image_bitmap_->Begin()),
 #ifndef MOE
-                         bitmap_section.Size(), bitmap_section.Offset())) {
+                         bitmap_section.Size(), bitmap_file_offset)) {
 #else
-                         image_bitmap_->Size(), bitmap_section.Offset())) {
+                         image_bitmap_->Size(), bitmap_file_offset)) {
 #endif
     PLOG(ERROR) << "Failed to write image file " << image_filename;
     image_file->Erase();
@@ -234,7 +266,8 @@ bool ImageWriter::Write(const std::string& image_filename,
   }
 #endif
       
-  CHECK_EQ(bitmap_section.End(), static_cast<size_t>(image_file->GetLength()));
+  CHECK_EQ(bitmap_file_offset + bitmap_section.Size(),
+           static_cast<size_t>(image_file->GetLength()));
   if (image_file->FlushCloseOrErase() != 0) {
     PLOG(ERROR) << "Failed to flush and close image file " << image_filename;
     return false;
@@ -1193,9 +1226,60 @@ void ImageWriter::CopyAndFixupNativeData() {
   CHECK_EQ(intern_table_bytes, intern_table_bytes_);
 }
 
-void ImageWriter::CopyAndFixupObjects() {
+// Copies and fixes up a range of the image objects. Each object is copied to its own image
+// offset and the fixups only write to the copy, so the tasks are independent and the image
+// contents do not depend on how the objects are split between the workers.
+class ImageWriter::CopyAndFixupObjectsTask : public Task {
+ public:
+  CopyAndFixupObjectsTask(ImageWriter* image_writer,
+                          mirror::Object* const* begin,
+                          mirror::Object* const* end)
+      : image_writer_(image_writer), begin_(begin), end_(end) {}
+
+  // The thread which created the task holds the mutator lock and heap bitmap lock for us.
+  void Run(Thread* self ATTRIBUTE_UNUSED) OVERRIDE NO_THREAD_SAFETY_ANALYSIS {
+    for (mirror::Object* const* it = begin_; it != end_; ++it) {
+      image_writer_->CopyAndFixupObject(*it);
+    }
+  }
+
+  void Finalize() OVERRIDE {
+    delete this;
+  }
+
+ private:
+  ImageWriter* const image_writer_;
+  mirror::Object* const* const begin_;
+  mirror::Object* const* const end_;
+};
+
+void ImageWriter::CopyAndFixupObjects(ThreadPool* thread_pool) {
   gc::Heap* heap = Runtime::Current()->GetHeap();
-  heap->VisitObjects(CopyAndFixupObjectsCallback, this);
+  if (thread_pool == nullptr) {
+    heap->VisitObjects(CopyAndFixupObjectsCallback, this);
+  } else {
+    Thread* self = Thread::Current();
+    std::vector<mirror::Object*> objects;
+    heap->VisitObjects(CollectObjectsCallback, &objects);
+    // Use a few tasks per thread so that threads which get the big objects do not hold up
+    // the others.
+    static constexpr size_t kTasksPerThread = 4u;
+    static constexpr size_t kMinObjectsPerTask = 1024u;
+    const size_t num_threads = thread_pool->GetThreadCount() + 1u;
+    const size_t objects_per_task =
+        std::max(objects.size() / (num_threads * kTasksPerThread), kMinObjectsPerTask);
+    ReaderMutexLock mu(self, *Locks::heap_bitmap_lock_);
+    for (size_t begin = 0u; begin < objects.size(); begin += objects_per_task) {
+      size_t end = std::min(begin + objects_per_task, objects.size());
+      thread_pool->AddTask(self, new CopyAndFixupObjectsTask(this,
+                                                             objects.data() + begin,
+                                                             objects.data() + end));
+    }
+    thread_pool->StartWorkers(self);
+    thread_pool->Wait(self, /* do_work */ true, /* may_hold_locks */ true);
+    thread_pool->StopWorkers(self);
+  }
+  pointer_arrays_.clear();
   // Fix up the object previously had hash codes.
   for (const auto& hash_pair : saved_hashcode_map_) {
     Object* obj = hash_pair.first;
@@ -1211,6 +1295,12 @@ void ImageWriter::CopyAndFixupObjectsCallback(Object* obj, void* arg) {
   reinterpret_cast<ImageWriter*>(arg)->CopyAndFixupObject(obj);
 }
 
+void ImageWriter::CollectObjectsCallback(Object* obj, void* arg) {
+  DCHECK(obj != nullptr);
+  DCHECK(arg != nullptr);
+  reinterpret_cast<std::vector<Object*>*>(arg)->push_back(obj);
+}
+
 void ImageWriter::FixupPointerArray(mirror::Object* dst, mirror::PointerArray* arr,
                                     mirror::Class* klass, Bin array_type) {
   CHECK(klass->IsArrayClass());
@@ -1251,7 +1341,8 @@ void ImageWriter::CopyAndFixupObject(Object* obj) {
   DCHECK_LT(offset, image_end_);
   const auto* src = reinterpret_cast<const uint8_t*>(obj);
 
-  image_bitmap_->Set(dst);  // Mark the obj as live.
+  // Neighbouring objects may be copied by other threads and share a bitmap word.
+  image_bitmap_->AtomicTestAndSet(dst);  // Mark the obj as live.
 
   const size_t n = obj->SizeOf();
   DCHECK_LE(offset + n, image_->Size());
@@ -1377,9 +1468,9 @@ void ImageWriter::FixupObject(Object* orig, Object* copy) {
     // Is this a native pointer array?
     auto it = pointer_arrays_.find(down_cast<mirror::PointerArray*>(orig));
     if (it != pointer_arrays_.end()) {
-      // Should only need to fixup every pointer array exactly once.
+      // Every object is visited exactly once, so every pointer array is fixed up once. The
+      // map is only cleared after all objects were copied, it is shared between the workers.
       FixupPointerArray(copy, down_cast<mirror::PointerArray*>(orig), klass, it->second);
-      pointer_arrays_.erase(it);
       return;
     }
   }
@@ -49,7 +49,8 @@ class ImageWriter FINAL {
 #ifdef MOE
               InstructionSet instruction_set,
 #endif
-              bool compile_pic)
+              bool compile_pic,
+              ImageHeader::StorageMode image_storage_mode)
       : compiler_driver_(compiler_driver), image_begin_(reinterpret_cast<uint8_t*>(image_begin)),
 #ifdef MOE
         instruction_set_(instruction_set),
@@ -60,6 +61,7 @@ class ImageWriter FINAL {
         quick_generic_jni_trampoline_offset_(0),
         quick_imt_conflict_trampoline_offset_(0), quick_resolution_trampoline_offset_(0),
         quick_to_interpreter_bridge_offset_(0), compile_pic_(compile_pic),
+        image_storage_mode_(image_storage_mode),
         target_ptr_size_(InstructionSetPointerSize(compiler_driver_.GetInstructionSet())),
         bin_slot_sizes_(), bin_slot_offsets_(), bin_slot_count_(),
         intern_table_bytes_(0u), image_method_array_(ImageHeader::kImageMethodsCount),
@@ -265,9 +267,12 @@ class ImageWriter FINAL {
 
   // Creates the contiguous image in memory and adjusts pointers.
   void CopyAndFixupNativeData() SHARED_REQUIRES(Locks::mutator_lock_);
-  void CopyAndFixupObjects() SHARED_REQUIRES(Locks::mutator_lock_);
+  // If thread_pool is not null, the objects are copied in parallel using its workers.
+  void CopyAndFixupObjects(ThreadPool* thread_pool) SHARED_REQUIRES(Locks::mutator_lock_);
   static void CopyAndFixupObjectsCallback(mirror::Object* obj, void* arg)
       SHARED_REQUIRES(Locks::mutator_lock_);
+  static void CollectObjectsCallback(mirror::Object* obj, void* arg)
+      SHARED_REQUIRES(Locks::mutator_lock_);
   void CopyAndFixupObject(mirror::Object* obj) SHARED_REQUIRES(Locks::mutator_lock_);
   void CopyAndFixupMethod(ArtMethod* orig, ArtMethod* copy)
       SHARED_REQUIRES(Locks::mutator_lock_);
@@ -334,7 +339,8 @@ class ImageWriter FINAL {
   std::unique_ptr<MemMap> image_;
 
   // Pointer arrays that need to be updated. Since these are only some int and long arrays, we need
-  // to keep track. These include vtable arrays, iftable arrays, and dex caches.
+  // to keep track. These include vtable arrays, iftable arrays, and dex caches. Read-only while
+  // the objects are being copied.
   std::unordered_map<mirror::PointerArray*, Bin> pointer_arrays_;
 
   // The start offsets of the dex cache arrays.
@@ -360,6 +366,9 @@ class ImageWriter FINAL {
   uint32_t quick_to_interpreter_bridge_offset_;
   const bool compile_pic_;
 
+  // How the image data is stored in the image file.
+  const ImageHeader::StorageMode image_storage_mode_;
+
   // Size of pointers on the target architecture.
   size_t target_ptr_size_;
 
@@ -395,6 +404,8 @@ class ImageWriter FINAL {
   uint64_t dirty_methods_;
   uint64_t clean_methods_;
 
+  class CopyAndFixupObjectsTask;
+
   friend class FixupClassVisitor;
   friend class FixupRootVisitor;
   friend class FixupVisitor;
@@ -75,6 +75,9 @@ JitCompiler::JitCompiler() : total_time_(0) {
       CompilerOptions::kDefaultNumDexMethodsThreshold,
       CompilerOptions::kDefaultInlineDepthLimit,
       CompilerOptions::kDefaultInlineMaxCodeUnits,
+      CompilerOptions::kDefaultLoopUnrollFactor,
+      CompilerOptions::kDefaultLoopUnrollMaxSize,
+      CompilerOptions::kDefaultLoopPeelMaxSize,
       /* include_patch_information */ false,
       CompilerOptions::kDefaultTopKProfileThreshold,
       Runtime::Current()->IsDebuggable(),
@@ -86,7 +89,9 @@ JitCompiler::JitCompiler() : total_time_(0) {
       /* verbose_methods */ nullptr,
       pass_manager_options,
       /* init_failure_output */ nullptr,
-      /* abort_on_hard_verifier_failure */ false));
+      /* abort_on_hard_verifier_failure */ false,
+      // Linear scan is faster to run, which matters more when compiling at runtime.
+      kRegisterAllocatorLinearScan));
   const InstructionSet instruction_set = kRuntimeISA;
   for (const StringPiece option : Runtime::Current()->GetCompilerOptions()) {
     VLOG(compiler) << "JIT compiler option " << option;
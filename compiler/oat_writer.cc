@@ -28,6 +28,7 @@
 #include "class_linker.h"
 #include "compiled_class.h"
 #include "compiled_method.h"
+#include "compiler_callbacks.h"
 #include "dex_file-inl.h"
 #include "dex/verification_results.h"
 #include "driver/compiler_driver.h"
@@ -48,6 +49,7 @@
 #include "handle_scope-inl.h"
 #include "utils/dex_cache_arrays_layout-inl.h"
 #include "verifier/method_verifier.h"
+#include "verifier/verifier_deps.h"
 
 namespace art {
 
@@ -73,6 +75,7 @@ OatWriter::OatWriter(const std::vector<const DexFile*>& dex_files,
     size_(0u),
     bss_size_(0u),
     oat_data_offset_(0u),
+    num_code_regions_(1u),
     image_file_location_oat_checksum_(image_file_location_oat_checksum),
     image_file_location_oat_begin_(image_file_location_oat_begin),
     image_patch_delta_(image_patch_delta),
@@ -83,6 +86,7 @@ OatWriter::OatWriter(const std::vector<const DexFile*>& dex_files,
     size_oat_header_(0),
     size_oat_header_key_value_store_(0),
     size_dex_file_(0),
+    size_verifier_deps_(0),
     size_interpreter_to_interpreter_bridge_(0),
     size_interpreter_to_compiled_code_bridge_(0),
     size_jni_dlsym_lookup_(0),
@@ -129,6 +133,10 @@ OatWriter::OatWriter(const std::vector<const DexFile*>& dex_files,
     TimingLogger::ScopedTiming split("InitDexFiles", timings);
     offset = InitDexFiles(offset);
   }
+  {
+    TimingLogger::ScopedTiming split("InitVerifierDeps", timings);
+    offset = InitVerifierDeps(offset);
+  }
   {
     TimingLogger::ScopedTiming split("InitOatClasses", timings);
     offset = InitOatClasses(offset);
@@ -290,7 +298,16 @@ class OatWriter::OatDexMethodVisitor : public DexMethodVisitor {
   OatDexMethodVisitor(OatWriter* writer, size_t offset)
     : DexMethodVisitor(writer, offset),
       oat_class_index_(0u),
-      method_offsets_index_(0u) {
+      method_offsets_index_(0u),
+      code_region_(0u) {
+  }
+
+  // The code visitors make one pass over the dex methods for each code region
+  // and deal only with the methods in that region, see InitOatCodeDexFiles().
+  void StartCodeRegion(size_t code_region) {
+    DCHECK_LT(code_region, writer_->num_code_regions_);
+    oat_class_index_ = 0u;
+    code_region_ = code_region;
   }
 
   bool StartClass(const DexFile* dex_file, size_t class_def_index) {
@@ -306,8 +323,23 @@ class OatWriter::OatDexMethodVisitor : public DexMethodVisitor {
   }
 
  protected:
+  bool IsLastCodeRegion() const {
+    return code_region_ + 1u == writer_->num_code_regions_;
+  }
+
+  // Whether the compiled method at method_offsets_index_ belongs to the current code region.
+  bool IsInCodeRegion(const OatClass* oat_class) const {
+    if (oat_class->method_hotness_.empty()) {
+      DCHECK_EQ(writer_->num_code_regions_, 1u);
+      return true;
+    }
+    DCHECK_LT(method_offsets_index_, oat_class->method_hotness_.size());
+    return oat_class->method_hotness_[method_offsets_index_] == code_region_;
+  }
+
   size_t oat_class_index_;
   size_t method_offsets_index_;
+  size_t code_region_;
 };
 
 class OatWriter::InitOatClassesMethodVisitor : public DexMethodVisitor {
@@ -366,6 +398,38 @@ class OatWriter::InitOatClassesMethodVisitor : public DexMethodVisitor {
   size_t num_non_null_compiled_methods_;
 };
 
+class OatWriter::InitCodeLayoutMethodVisitor : public OatDexMethodVisitor {
+ public:
+  InitCodeLayoutMethodVisitor(OatWriter* writer, size_t offset)
+    : OatDexMethodVisitor(writer, offset),
+      num_methods_() {
+  }
+
+  bool VisitMethod(size_t class_def_method_index, const ClassDataItemIterator& it) {
+    OatClass* oat_class = writer_->oat_classes_[oat_class_index_];
+    CompiledMethod* compiled_method = oat_class->GetCompiledMethod(class_def_method_index);
+
+    if (compiled_method != nullptr) {
+      // The profile is keyed by the pretty method name, same as for SkipCompilation().
+      MethodHotness hotness = writer_->compiler_driver_->GetMethodHotness(
+          PrettyMethod(it.GetMemberIndex(), *dex_file_));
+      DCHECK_EQ(method_offsets_index_, oat_class->method_hotness_.size());
+      oat_class->method_hotness_.push_back(hotness);
+      ++num_methods_[hotness];
+      ++method_offsets_index_;
+    }
+
+    return true;
+  }
+
+  size_t GetNumMethods(MethodHotness hotness) const {
+    return num_methods_[hotness];
+  }
+
+ private:
+  size_t num_methods_[kMethodHotnessCount];
+};
+
 class OatWriter::InitCodeMethodVisitor : public OatDexMethodVisitor {
  public:
   InitCodeMethodVisitor(OatWriter* writer, size_t offset)
@@ -377,7 +441,7 @@ class OatWriter::InitCodeMethodVisitor : public OatDexMethodVisitor {
 
   bool EndClass() {
     OatDexMethodVisitor::EndClass();
-    if (oat_class_index_ == writer_->oat_classes_.size()) {
+    if (oat_class_index_ == writer_->oat_classes_.size() && IsLastCodeRegion()) {
       offset_ = writer_->relative_patcher_->ReserveSpaceEnd(offset_);
     }
     return true;
@@ -388,6 +452,12 @@ class OatWriter::InitCodeMethodVisitor : public OatDexMethodVisitor {
     OatClass* oat_class = writer_->oat_classes_[oat_class_index_];
     CompiledMethod* compiled_method = oat_class->GetCompiledMethod(class_def_method_index);
 
+    if (compiled_method != nullptr && !IsInCodeRegion(oat_class)) {
+      // Laid out in another code region pass.
+      ++method_offsets_index_;
+      return true;
+    }
+
     if (compiled_method != nullptr) {
       // Derived from CompiledMethod.
       uint32_t quick_code_offset = 0;
@@ -700,7 +770,7 @@ class OatWriter::WriteCodeMethodVisitor : public OatDexMethodVisitor {
 
   bool EndClass() SHARED_REQUIRES(Locks::mutator_lock_) {
     bool result = OatDexMethodVisitor::EndClass();
-    if (oat_class_index_ == writer_->oat_classes_.size()) {
+    if (oat_class_index_ == writer_->oat_classes_.size() && IsLastCodeRegion()) {
       DCHECK(result);  // OatDexMethodVisitor::EndClass() never fails.
       offset_ = writer_->relative_patcher_->WriteThunks(out_, offset_);
       if (UNLIKELY(offset_ == 0u)) {
@@ -716,6 +786,12 @@ class OatWriter::WriteCodeMethodVisitor : public OatDexMethodVisitor {
     OatClass* oat_class = writer_->oat_classes_[oat_class_index_];
     const CompiledMethod* compiled_method = oat_class->GetCompiledMethod(class_def_method_index);
 
+    if (compiled_method != nullptr && !IsInCodeRegion(oat_class)) {
+      // Written in another code region pass.
+      ++method_offsets_index_;
+      return true;
+    }
+
     // No thread suspension since dex_cache_ that may get invalidated if that occurs.
     ScopedAssertNoThreadSuspension tsc(Thread::Current(), __FUNCTION__);
     if (compiled_method != nullptr) {  // ie. not an abstract method
@@ -1067,6 +1143,23 @@ size_t OatWriter::InitDexFiles(size_t offset) {
   return offset;
 }
 
+size_t OatWriter::InitVerifierDeps(size_t offset) {
+  CompilerCallbacks* callbacks = Runtime::Current()->GetCompilerCallbacks();
+  verifier::VerifierDeps* verifier_deps =
+      (callbacks != nullptr) ? callbacks->GetVerifierDeps() : nullptr;
+  if (verifier_deps == nullptr) {
+    return offset;
+  }
+  size_t original_offset = offset;
+  offset = RoundUp(offset, 4);
+  size_dex_file_alignment_ += offset - original_offset;
+
+  verifier_deps->Encode(&verifier_deps_data_);
+  oat_header_->SetVerifierDeps(offset, verifier_deps_data_.size());
+  oat_header_->UpdateChecksum(verifier_deps_data_.data(), verifier_deps_data_.size());
+  return offset + verifier_deps_data_.size();
+}
+
 size_t OatWriter::InitOatClasses(size_t offset) {
   // calculate the offsets within OatDexFiles to OatClasses
   InitOatClassesMethodVisitor visitor(this, offset);
@@ -1159,7 +1252,27 @@ size_t OatWriter::InitOatCodeDexFiles(size_t offset) {
       offset = visitor.GetOffset();                   \
     } while (false)
 
-  VISIT(InitCodeMethodVisitor);
+  if (compiler_driver_->ProfilePresent()) {
+    InitCodeLayoutMethodVisitor visitor(this, offset);
+    bool success = VisitDexMethods(&visitor);
+    DCHECK(success);
+    num_code_regions_ = kMethodHotnessCount;
+    VLOG(compiler) << "Code layout: " << visitor.GetNumMethods(kMethodHot) << " hot, "
+        << visitor.GetNumMethods(kMethodWarm) << " warm, "
+        << visitor.GetNumMethods(kMethodCold) << " cold methods";
+  }
+
+  {
+    // Keep the same visitor for all code regions so that deduplication and the
+    // relative patcher see a single monotonic layout.
+    InitCodeMethodVisitor visitor(this, offset);
+    for (size_t code_region = 0u; code_region != num_code_regions_; ++code_region) {
+      visitor.StartCodeRegion(code_region);
+      bool success = VisitDexMethods(&visitor);
+      DCHECK(success);
+    }
+    offset = visitor.GetOffset();
+  }
   if (compiler_driver_->IsImage()) {
     VISIT(InitImageMethodVisitor);
   }
@@ -1254,6 +1367,7 @@ bool OatWriter::WriteCode(OutputStream* out) {
     DO_STAT(size_oat_header_);
     DO_STAT(size_oat_header_key_value_store_);
     DO_STAT(size_dex_file_);
+    DO_STAT(size_verifier_deps_);
     DO_STAT(size_interpreter_to_interpreter_bridge_);
     DO_STAT(size_interpreter_to_compiled_code_bridge_);
     DO_STAT(size_jni_dlsym_lookup_);
@@ -1332,6 +1446,20 @@ bool OatWriter::WriteTables(OutputStream* out, const size_t file_offset) {
     }
     size_dex_file_ += dex_file->GetHeader().file_size_;
   }
+  if (!verifier_deps_data_.empty()) {
+    uint32_t expected_offset = file_offset + oat_header_->GetVerifierDepsOffset();
+    off_t actual_offset = out->Seek(expected_offset, kSeekSet);
+    if (static_cast<uint32_t>(actual_offset) != expected_offset) {
+      PLOG(ERROR) << "Failed to seek to verifier deps section. Actual: " << actual_offset
+                  << " Expected: " << expected_offset;
+      return false;
+    }
+    if (!out->WriteFully(verifier_deps_data_.data(), verifier_deps_data_.size())) {
+      PLOG(ERROR) << "Failed to write verifier deps to " << out->GetLocation();
+      return false;
+    }
+    size_verifier_deps_ = verifier_deps_data_.size();
+  }
   for (size_t i = 0; i != oat_classes_.size(); ++i) {
     if (!oat_classes_[i]->Write(this, out, file_offset)) {
       PLOG(ERROR) << "Failed to write oat methods information to " << out->GetLocation();
@@ -1399,18 +1527,17 @@ size_t OatWriter::WriteCode(OutputStream* out, const size_t file_offset, size_t
 size_t OatWriter::WriteCodeDexFiles(OutputStream* out,
                                     const size_t file_offset,
                                     size_t relative_offset) {
-  #define VISIT(VisitorType)                                              \
-    do {                                                                  \
-      VisitorType visitor(this, out, file_offset, relative_offset);       \
-      if (UNLIKELY(!VisitDexMethods(&visitor))) {                         \
-        return 0;                                                         \
-      }                                                                   \
-      relative_offset = visitor.GetOffset();                              \
-    } while (false)
-
-  VISIT(WriteCodeMethodVisitor);
-
-  #undef VISIT
+  {
+    // Write the code regions in the order they were laid out by InitOatCodeDexFiles().
+    WriteCodeMethodVisitor visitor(this, out, file_offset, relative_offset);
+    for (size_t code_region = 0u; code_region != num_code_regions_; ++code_region) {
+      visitor.StartCodeRegion(code_region);
+      if (UNLIKELY(!VisitDexMethods(&visitor))) {
+        return 0;
+      }
+    }
+    relative_offset = visitor.GetOffset();
+  }
 
   size_code_alignment_ += relative_patcher_->CodeAlignmentSize();
   size_relative_call_thunks_ += relative_patcher_->RelativeCallThunksSize();
@@ -155,6 +155,7 @@ class OatWriter {
   class DexMethodVisitor;
   class OatDexMethodVisitor;
   class InitOatClassesMethodVisitor;
+  class InitCodeLayoutMethodVisitor;
   class InitCodeMethodVisitor;
   template <typename DataAccess>
   class InitMapMethodVisitor;
@@ -170,6 +171,7 @@ class OatWriter {
   size_t InitOatHeader();
   size_t InitOatDexFiles(size_t offset);
   size_t InitDexFiles(size_t offset);
+  size_t InitVerifierDeps(size_t offset);
   size_t InitOatClasses(size_t offset);
   size_t InitOatMaps(size_t offset);
   size_t InitOatCode(size_t offset)
@@ -262,6 +264,10 @@ class OatWriter {
     std::vector<OatMethodOffsets> method_offsets_;
     std::vector<OatQuickMethodHeader> method_headers_;
 
+    // MethodHotness of each CompiledMethod present in the OatClass, in the same
+    // order as method_offsets_. Empty if the code is not laid out by hotness.
+    std::vector<uint8_t> method_hotness_;
+
    private:
     DISALLOW_COPY_AND_ASSIGN(OatClass);
   };
@@ -287,6 +293,11 @@ class OatWriter {
   // Offset of the oat data from the start of the mmapped region of the elf file.
   size_t oat_data_offset_;
 
+  // Number of regions the code is grouped into. With a profile, the code of hot methods
+  // is placed first, then warm and then cold methods, each in dex definition order.
+  // Without a profile, there is a single region in dex definition order.
+  size_t num_code_regions_;
+
   // dependencies on the image.
   uint32_t image_file_location_oat_checksum_;
   uintptr_t image_file_location_oat_begin_;
@@ -296,6 +307,7 @@ class OatWriter {
   SafeMap<std::string, std::string>* key_value_store_;
   OatHeader* oat_header_;
   std::vector<OatDexFile*> oat_dex_files_;
+  std::vector<uint8_t> verifier_deps_data_;
   std::vector<OatClass*> oat_classes_;
   std::unique_ptr<const std::vector<uint8_t>> jni_dlsym_lookup_;
   std::unique_ptr<const std::vector<uint8_t>> quick_generic_jni_trampoline_;
@@ -309,6 +321,7 @@ class OatWriter {
   uint32_t size_oat_header_;
   uint32_t size_oat_header_key_value_store_;
   uint32_t size_dex_file_;
+  uint32_t size_verifier_deps_;
   uint32_t size_interpreter_to_interpreter_bridge_;
   uint32_t size_interpreter_to_compiled_code_bridge_;
   uint32_t size_jni_dlsym_lookup_;
@@ -1301,6 +1301,51 @@ void CodeGenerator::EmitParallelMoves(Location from1,
   GetMoveResolver()->EmitNativeCode(&parallel_move);
 }
 
+// Compiled code only knows how to allocate from the bump pointer TLAB, and does
+// not emit the read barriers needed to load the class from the dex cache.
+#ifndef MOE
+static constexpr bool kAllocateInline = kUseTlab && !kUseReadBarrier;
+#else
+static constexpr bool kAllocateInline = false;
+#endif
+
+// Arrays larger than this are left to the runtime, which puts large primitive arrays
+// in the large object space.
+static constexpr size_t kMaxInlineArrayAllocationSize = 2 * KB;
+
+bool CodeGenerator::CanAllocateInline(HInstruction* instruction) {
+  if (!kAllocateInline) {
+    return false;
+  }
+  if (instruction->IsNewInstance()) {
+    // Classes needing an access check are resolved and checked by the entrypoint.
+    return instruction->AsNewInstance()->GetEntrypoint() == kQuickAllocObject;
+  }
+  HNewArray* new_array = instruction->AsNewArray();
+  if (new_array->GetEntrypoint() != kQuickAllocArray) {
+    return false;
+  }
+  HInstruction* length = new_array->InputAt(0);
+  if (length->IsIntConstant()) {
+    // Negative and large constant lengths always take the runtime path.
+    int32_t value = length->AsIntConstant()->GetValue();
+    return value >= 0 && value <= GetMaxInlineArrayLength(new_array);
+  }
+  return true;
+}
+
+size_t CodeGenerator::GetArrayComponentSizeShift(HNewArray* new_array) {
+  const char* descriptor = new_array->GetDexFile().StringByTypeIdx(new_array->GetTypeIndex());
+  DCHECK_EQ(descriptor[0], '[') << descriptor;
+  return Primitive::ComponentSizeShift(Primitive::GetType(descriptor[1]));
+}
+
+int32_t CodeGenerator::GetMaxInlineArrayLength(HNewArray* new_array) {
+  size_t shift = GetArrayComponentSizeShift(new_array);
+  size_t data_offset = mirror::Array::DataOffset(1u << shift).Uint32Value();
+  return (kMaxInlineArrayAllocationSize - data_offset) >> shift;
+}
+
 void CodeGenerator::ValidateInvokeRuntime(HInstruction* instruction, SlowPathCode* slow_path) {
   // Ensure that the call kind indication given to the register allocator is
   // coherent with the runtime call generated, and that the GC side effect is
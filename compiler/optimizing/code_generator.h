@@ -342,6 +342,17 @@ class CodeGenerator {
     return type == Primitive::kPrimNot && !value->IsNullConstant();
   }
 
+  // Returns whether `instruction`, an HNewInstance or an HNewArray, can be allocated
+  // inline by bumping the thread-local allocation buffer pointer, with the allocation
+  // entrypoint as slow path.
+  static bool CanAllocateInline(HInstruction* instruction);
+
+  // Returns the log2 of the component size of the arrays allocated by `new_array`.
+  static size_t GetArrayComponentSizeShift(HNewArray* new_array);
+
+  // Returns the largest length of the arrays allocated inline by `new_array`.
+  static int32_t GetMaxInlineArrayLength(HNewArray* new_array);
+
   void ValidateInvokeRuntime(HInstruction* instruction, SlowPathCode* slow_path);
 
   void AddAllocatedRegister(Location location) {
@@ -269,6 +269,53 @@ class LoadStringSlowPathARM : public SlowPathCode {
   DISALLOW_COPY_AND_ASSIGN(LoadStringSlowPathARM);
 };
 
+class AllocationSlowPathARM : public SlowPathCode {
+ public:
+  explicit AllocationSlowPathARM(HInstruction* instruction) : instruction_(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    LocationSummary* locations = instruction_->GetLocations();
+    DCHECK(!locations->GetLiveRegisters()->ContainsCoreRegister(locations->Out().reg()));
+
+    CodeGeneratorARM* arm_codegen = down_cast<CodeGeneratorARM*>(codegen);
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    QuickEntrypointEnum entrypoint;
+    uint16_t type_index;
+    if (instruction_->IsNewInstance()) {
+      entrypoint = instruction_->AsNewInstance()->GetEntrypoint();
+      type_index = instruction_->AsNewInstance()->GetTypeIndex();
+      arm_codegen->Move32(Location::RegisterLocation(calling_convention.GetRegisterAt(1)),
+                          locations->InAt(0));
+    } else {
+      entrypoint = instruction_->AsNewArray()->GetEntrypoint();
+      type_index = instruction_->AsNewArray()->GetTypeIndex();
+      codegen->EmitParallelMoves(
+          locations->InAt(0),
+          Location::RegisterLocation(calling_convention.GetRegisterAt(1)),
+          Primitive::kPrimInt,
+          locations->InAt(1),
+          Location::RegisterLocation(calling_convention.GetRegisterAt(2)),
+          instruction_->InputAt(1)->GetType());
+    }
+    __ LoadImmediate(calling_convention.GetRegisterAt(0), type_index);
+    arm_codegen->InvokeRuntime(entrypoint, instruction_, instruction_->GetDexPc(), this);
+    arm_codegen->Move32(locations->Out(), Location::RegisterLocation(R0));
+
+    RestoreLiveRegisters(codegen, locations);
+    __ b(GetExitLabel());
+  }
+
+  const char* GetDescription() const OVERRIDE { return "AllocationSlowPathARM"; }
+
+ private:
+  HInstruction* const instruction_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationSlowPathARM);
+};
+
 class TypeCheckSlowPathARM : public SlowPathCode {
  public:
   TypeCheckSlowPathARM(HInstruction* instruction, bool is_fatal)
@@ -3127,6 +3174,15 @@ void InstructionCodeGeneratorARM::VisitUShr(HUShr* ushr) {
 }
 
 void LocationsBuilderARM::VisitNewInstance(HNewInstance* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+        instruction, LocationSummary::kCallOnSlowPath);
+    locations->SetInAt(0, Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->SetOut(Location::RequiresRegister());
+    return;
+  }
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
   InvokeRuntimeCallingConvention calling_convention;
@@ -3136,6 +3192,36 @@ void LocationsBuilderARM::VisitNewInstance(HNewInstance* instruction) {
 }
 
 void InstructionCodeGeneratorARM::VisitNewInstance(HNewInstance* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = instruction->GetLocations();
+    Register current_method = locations->InAt(0).AsRegister<Register>();
+    Register out = locations->Out().AsRegister<Register>();
+    Register klass = locations->GetTemp(0).AsRegister<Register>();
+    Register size = locations->GetTemp(1).AsRegister<Register>();
+    SlowPathCode* slow_path = new (GetGraph()->GetArena()) AllocationSlowPathARM(instruction);
+    codegen_->AddSlowPath(slow_path);
+
+    // Only initialized classes without finalizer are allocated inline, like the
+    // TLAB fast path of the runtime.
+    GenerateResolvedTypeLoad(klass, current_method, instruction->GetTypeIndex(), slow_path);
+    __ LoadFromOffset(kLoadWord, IP, klass, mirror::Class::StatusOffset().Int32Value());
+    __ cmp(IP, ShifterOperand(mirror::Class::kStatusInitialized));
+    __ b(slow_path->GetEntryLabel(), LT);
+    __ LoadFromOffset(kLoadWord, IP, klass, mirror::Class::AccessFlagsOffset().Int32Value());
+    __ tst(IP, ShifterOperand(kAccClassIsFinalizable));
+    __ b(slow_path->GetEntryLabel(), NE);
+    __ LoadFromOffset(kLoadWord, size, klass, mirror::Class::ObjectSizeOffset().Int32Value());
+    __ AddConstant(size, size, kObjectAlignment - 1);
+    __ bic(size, size, ShifterOperand(kObjectAlignment - 1));
+    GenerateTlabAllocation(out, klass, size, slow_path);
+    // The header must be visible to other threads before the reference to the object, and the
+    // loads of class data which follow must not be reordered before the status check. A full
+    // barrier orders both, like the TLAB fast path of the runtime.
+    GenerateMemoryBarrier(MemBarrierKind::kAnyAny);
+    __ Bind(slow_path->GetExitLabel());
+    return;
+  }
+
   InvokeRuntimeCallingConvention calling_convention;
   __ LoadImmediate(calling_convention.GetRegisterAt(0), instruction->GetTypeIndex());
   // Note: if heap poisoning is enabled, the entry point takes cares
@@ -3147,6 +3233,16 @@ void InstructionCodeGeneratorARM::VisitNewInstance(HNewInstance* instruction) {
 }
 
 void LocationsBuilderARM::VisitNewArray(HNewArray* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+        instruction, LocationSummary::kCallOnSlowPath);
+    locations->SetInAt(0, Location::RegisterOrConstant(instruction->InputAt(0)));
+    locations->SetInAt(1, Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->SetOut(Location::RequiresRegister());
+    return;
+  }
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
   InvokeRuntimeCallingConvention calling_convention;
@@ -3157,6 +3253,46 @@ void LocationsBuilderARM::VisitNewArray(HNewArray* instruction) {
 }
 
 void InstructionCodeGeneratorARM::VisitNewArray(HNewArray* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = instruction->GetLocations();
+    Location length = locations->InAt(0);
+    Register current_method = locations->InAt(1).AsRegister<Register>();
+    Register out = locations->Out().AsRegister<Register>();
+    Register klass = locations->GetTemp(0).AsRegister<Register>();
+    Register size = locations->GetTemp(1).AsRegister<Register>();
+    size_t shift = CodeGenerator::GetArrayComponentSizeShift(instruction);
+    uint32_t data_offset = mirror::Array::DataOffset(1u << shift).Uint32Value();
+    uint32_t length_offset = mirror::Array::LengthOffset().Uint32Value();
+    SlowPathCode* slow_path = new (GetGraph()->GetArena()) AllocationSlowPathARM(instruction);
+    codegen_->AddSlowPath(slow_path);
+
+    GenerateResolvedTypeLoad(klass, current_method, instruction->GetTypeIndex(), slow_path);
+    if (length.IsConstant()) {
+      int32_t value = length.GetConstant()->AsIntConstant()->GetValue();
+      __ LoadImmediate(size, RoundUp(data_offset + (value << shift), kObjectAlignment));
+    } else {
+      // Negative lengths are caught by the unsigned comparison, and thrown by the runtime.
+      Register length_reg = length.AsRegister<Register>();
+      __ LoadImmediate(IP, CodeGenerator::GetMaxInlineArrayLength(instruction));
+      __ cmp(length_reg, ShifterOperand(IP));
+      __ b(slow_path->GetEntryLabel(), HI);
+      __ Lsl(size, length_reg, shift);
+      __ AddConstant(size, size, data_offset + kObjectAlignment - 1);
+      __ bic(size, size, ShifterOperand(kObjectAlignment - 1));
+    }
+    GenerateTlabAllocation(out, klass, size, slow_path);
+    if (length.IsConstant()) {
+      __ LoadImmediate(IP, length.GetConstant()->AsIntConstant()->GetValue());
+      __ StoreToOffset(kStoreWord, IP, out, length_offset);
+    } else {
+      __ StoreToOffset(kStoreWord, length.AsRegister<Register>(), out, length_offset);
+    }
+    // The header must be visible to other threads before the reference to the array.
+    GenerateMemoryBarrier(MemBarrierKind::kStoreStore);
+    __ Bind(slow_path->GetExitLabel());
+    return;
+  }
+
   InvokeRuntimeCallingConvention calling_convention;
   __ LoadImmediate(calling_convention.GetRegisterAt(0), instruction->GetTypeIndex());
   // Note: if heap poisoning is enabled, the entry point takes cares
@@ -3167,6 +3303,41 @@ void InstructionCodeGeneratorARM::VisitNewArray(HNewArray* instruction) {
                           nullptr);
 }
 
+void InstructionCodeGeneratorARM::GenerateResolvedTypeLoad(Register klass,
+                                                           Register current_method,
+                                                           uint16_t type_index,
+                                                           SlowPathCode* slow_path) {
+  __ LoadFromOffset(kLoadWord,
+                    klass,
+                    current_method,
+                    ArtMethod::DexCacheResolvedTypesOffset(kArmPointerSize).Int32Value());
+  __ LoadFromOffset(kLoadWord, klass, klass, CodeGenerator::GetCacheOffset(type_index));
+  __ CompareAndBranchIfZero(klass, slow_path->GetEntryLabel());
+}
+
+void InstructionCodeGeneratorARM::GenerateTlabAllocation(Register out,
+                                                         Register klass,
+                                                         Register size,
+                                                         SlowPathCode* slow_path) {
+  // The new position of the TLAB is computed in `size`. TLAB memory is zeroed, so only
+  // the class needs to be stored in the header.
+  __ LoadFromOffset(kLoadWord, out, TR, Thread::ThreadLocalPosOffset<kArmWordSize>().Int32Value());
+  __ add(size, size, ShifterOperand(out));
+  __ LoadFromOffset(kLoadWord, IP, TR, Thread::ThreadLocalEndOffset<kArmWordSize>().Int32Value());
+  __ cmp(size, ShifterOperand(IP));
+  __ b(slow_path->GetEntryLabel(), HI);
+  __ StoreToOffset(kStoreWord, size, TR, Thread::ThreadLocalPosOffset<kArmWordSize>().Int32Value());
+  __ LoadFromOffset(
+      kLoadWord, IP, TR, Thread::ThreadLocalObjectsOffset<kArmWordSize>().Int32Value());
+  __ AddConstant(IP, IP, 1);
+  __ StoreToOffset(
+      kStoreWord, IP, TR, Thread::ThreadLocalObjectsOffset<kArmWordSize>().Int32Value());
+  if (kPoisonHeapReferences) {
+    __ PoisonHeapReference(klass);
+  }
+  __ StoreToOffset(kStoreWord, klass, out, mirror::Object::ClassOffset().Int32Value());
+}
+
 void LocationsBuilderARM::VisitParameterValue(HParameterValue* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
@@ -209,6 +209,20 @@ class InstructionCodeGeneratorARM : public HGraphVisitor {
   // the suspend call.
   void GenerateSuspendCheck(HSuspendCheck* check, HBasicBlock* successor);
   void GenerateClassInitializationCheck(SlowPathCode* slow_path, Register class_reg);
+  // Loads the class of `type_index` from the dex cache of `current_method` into `klass`,
+  // branching to `slow_path` if it is not resolved.
+  void GenerateResolvedTypeLoad(Register klass,
+                                Register current_method,
+                                uint16_t type_index,
+                                SlowPathCode* slow_path);
+  // Allocates an object of class `klass` and of `size` bytes, a multiple of the object
+  // alignment, from the thread-local allocation buffer into `out`. Branches to `slow_path`
+  // if the buffer is too small. Clobbers `klass`, `size` and IP. The caller emits the
+  // memory barrier once the header is initialized.
+  void GenerateTlabAllocation(Register out,
+                              Register klass,
+                              Register size,
+                              SlowPathCode* slow_path);
   void GenerateAndConst(Register out, Register first, uint32_t value);
   void GenerateOrrConst(Register out, Register first, uint32_t value);
   void GenerateEorConst(Register out, Register first, uint32_t value);
@@ -410,6 +410,55 @@ class SuspendCheckSlowPathARM64 : public SlowPathCodeARM64 {
   DISALLOW_COPY_AND_ASSIGN(SuspendCheckSlowPathARM64);
 };
 
+class AllocationSlowPathARM64 : public SlowPathCodeARM64 {
+ public:
+  explicit AllocationSlowPathARM64(HInstruction* instruction) : instruction_(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    LocationSummary* locations = instruction_->GetLocations();
+    DCHECK(!locations->GetLiveRegisters()->ContainsCoreRegister(locations->Out().reg()));
+    CodeGeneratorARM64* arm64_codegen = down_cast<CodeGeneratorARM64*>(codegen);
+
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    QuickEntrypointEnum entrypoint;
+    uint16_t type_index;
+    if (instruction_->IsNewInstance()) {
+      entrypoint = instruction_->AsNewInstance()->GetEntrypoint();
+      type_index = instruction_->AsNewInstance()->GetTypeIndex();
+      arm64_codegen->MoveLocation(LocationFrom(calling_convention.GetRegisterAt(1)),
+                                  locations->InAt(0),
+                                  instruction_->InputAt(0)->GetType());
+    } else {
+      entrypoint = instruction_->AsNewArray()->GetEntrypoint();
+      type_index = instruction_->AsNewArray()->GetTypeIndex();
+      codegen->EmitParallelMoves(locations->InAt(0),
+                                 LocationFrom(calling_convention.GetRegisterAt(1)),
+                                 Primitive::kPrimInt,
+                                 locations->InAt(1),
+                                 LocationFrom(calling_convention.GetRegisterAt(2)),
+                                 instruction_->InputAt(1)->GetType());
+    }
+    __ Mov(calling_convention.GetRegisterAt(0).W(), type_index);
+    arm64_codegen->InvokeRuntime(entrypoint, instruction_, instruction_->GetDexPc(), this);
+    arm64_codegen->MoveLocation(locations->Out(),
+                                calling_convention.GetReturnLocation(Primitive::kPrimNot),
+                                Primitive::kPrimNot);
+
+    RestoreLiveRegisters(codegen, locations);
+    __ B(GetExitLabel());
+  }
+
+  const char* GetDescription() const OVERRIDE { return "AllocationSlowPathARM64"; }
+
+ private:
+  HInstruction* const instruction_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationSlowPathARM64);
+};
+
 class TypeCheckSlowPathARM64 : public SlowPathCodeARM64 {
  public:
   TypeCheckSlowPathARM64(HInstruction* instruction, bool is_fatal)
@@ -2837,25 +2886,8 @@ static bool TryGenerateIntrinsicCode(HInvoke* invoke, CodeGeneratorARM64* codege
   return false;
 }
 
-void CodeGeneratorARM64::GenerateStaticOrDirectCall(HInvokeStaticOrDirect* invoke, Location temp) {
-  // For better instruction scheduling we load the direct code pointer before the method pointer.
-  bool direct_code_loaded = false;
-  switch (invoke->GetCodePtrLocation()) {
-    case HInvokeStaticOrDirect::CodePtrLocation::kCallDirectWithFixup:
-      // LR = code address from literal pool with link-time patch.
-      __ Ldr(lr, DeduplicateMethodCodeLiteral(invoke->GetTargetMethod()));
-      direct_code_loaded = true;
-      break;
-    case HInvokeStaticOrDirect::CodePtrLocation::kCallDirect:
-      // LR = invoke->GetDirectCodePtr();
-      __ Ldr(lr, DeduplicateUint64Literal(invoke->GetDirectCodePtr()));
-      direct_code_loaded = true;
-      break;
-    default:
-      break;
-  }
-
-  // Make sure that ArtMethod* is passed in kArtMethodRegister as per the calling convention.
+Location CodeGeneratorARM64::GenerateCalleeMethodStaticOrDirectCall(HInvokeStaticOrDirect* invoke,
+                                                                    Location temp) {
   Location callee_method = temp;  // For all kinds except kRecursive, callee will be in temp.
   switch (invoke->GetMethodLoadKind()) {
     case HInvokeStaticOrDirect::MethodLoadKind::kStringInit:
@@ -2916,6 +2948,29 @@ void CodeGeneratorARM64::GenerateStaticOrDirectCall(HInvokeStaticOrDirect* invok
       break;
     }
   }
+  return callee_method;
+}
+
+void CodeGeneratorARM64::GenerateStaticOrDirectCall(HInvokeStaticOrDirect* invoke, Location temp) {
+  // For better instruction scheduling we load the direct code pointer before the method pointer.
+  bool direct_code_loaded = false;
+  switch (invoke->GetCodePtrLocation()) {
+    case HInvokeStaticOrDirect::CodePtrLocation::kCallDirectWithFixup:
+      // LR = code address from literal pool with link-time patch.
+      __ Ldr(lr, DeduplicateMethodCodeLiteral(invoke->GetTargetMethod()));
+      direct_code_loaded = true;
+      break;
+    case HInvokeStaticOrDirect::CodePtrLocation::kCallDirect:
+      // LR = invoke->GetDirectCodePtr();
+      __ Ldr(lr, DeduplicateUint64Literal(invoke->GetDirectCodePtr()));
+      direct_code_loaded = true;
+      break;
+    default:
+      break;
+  }
+
+  // Make sure that ArtMethod* is passed in kArtMethodRegister as per the calling convention.
+  Location callee_method = GenerateCalleeMethodStaticOrDirectCall(invoke, temp);
 
   switch (invoke->GetCodePtrLocation()) {
     case HInvokeStaticOrDirect::CodePtrLocation::kCallSelf:
@@ -3295,6 +3350,16 @@ void InstructionCodeGeneratorARM64::VisitNeg(HNeg* neg) {
 }
 
 void LocationsBuilderARM64::VisitNewArray(HNewArray* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+        instruction, LocationSummary::kCallOnSlowPath);
+    locations->SetInAt(0, Location::RegisterOrConstant(instruction->InputAt(0)));
+    locations->SetInAt(1, Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->SetOut(Location::RequiresRegister());
+    return;
+  }
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
   InvokeRuntimeCallingConvention calling_convention;
@@ -3308,6 +3373,47 @@ void LocationsBuilderARM64::VisitNewArray(HNewArray* instruction) {
 
 void InstructionCodeGeneratorARM64::VisitNewArray(HNewArray* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    Location length = locations->InAt(0);
+    Register current_method = InputRegisterAt(instruction, 1);
+    Register out = OutputRegister(instruction);
+    Register klass = WRegisterFrom(locations->GetTemp(0));
+    Register size = XRegisterFrom(locations->GetTemp(1));
+    size_t shift = CodeGenerator::GetArrayComponentSizeShift(instruction);
+    uint32_t data_offset = mirror::Array::DataOffset(1u << shift).Uint32Value();
+    uint32_t length_offset = mirror::Array::LengthOffset().Uint32Value();
+    SlowPathCodeARM64* slow_path =
+        new (GetGraph()->GetArena()) AllocationSlowPathARM64(instruction);
+    codegen_->AddSlowPath(slow_path);
+
+    GenerateResolvedTypeLoad(klass, current_method, instruction->GetTypeIndex(), slow_path);
+    if (length.IsConstant()) {
+      int32_t value = length.GetConstant()->AsIntConstant()->GetValue();
+      __ Mov(size, RoundUp(data_offset + (value << shift), kObjectAlignment));
+    } else {
+      // Negative lengths are caught by the unsigned comparison, and thrown by the runtime.
+      Register length_reg = WRegisterFrom(length);
+      __ Cmp(length_reg, CodeGenerator::GetMaxInlineArrayLength(instruction));
+      __ B(hi, slow_path->GetEntryLabel());
+      __ Lsl(size.W(), length_reg, shift);
+      __ Add(size.W(), size.W(), data_offset + kObjectAlignment - 1);
+      __ And(size.W(), size.W(), ~static_cast<uint32_t>(kObjectAlignment - 1));
+    }
+    GenerateTlabAllocation(out, klass, size, slow_path);
+    if (length.IsConstant()) {
+      UseScratchRegisterScope temps(GetVIXLAssembler());
+      Register temp = temps.AcquireW();
+      __ Mov(temp, length.GetConstant()->AsIntConstant()->GetValue());
+      __ Str(temp, HeapOperand(out, length_offset));
+    } else {
+      __ Str(WRegisterFrom(length), HeapOperand(out, length_offset));
+    }
+    // The header must be visible to other threads before the reference to the array.
+    GenerateMemoryBarrier(MemBarrierKind::kStoreStore);
+    __ Bind(slow_path->GetExitLabel());
+    return;
+  }
+
   InvokeRuntimeCallingConvention calling_convention;
   Register type_index = RegisterFrom(locations->GetTemp(0), Primitive::kPrimInt);
   DCHECK(type_index.Is(w0));
@@ -3322,6 +3428,15 @@ void InstructionCodeGeneratorARM64::VisitNewArray(HNewArray* instruction) {
 }
 
 void LocationsBuilderARM64::VisitNewInstance(HNewInstance* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+        instruction, LocationSummary::kCallOnSlowPath);
+    locations->SetInAt(0, Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->SetOut(Location::RequiresRegister());
+    return;
+  }
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
   InvokeRuntimeCallingConvention calling_convention;
@@ -3333,6 +3448,40 @@ void LocationsBuilderARM64::VisitNewInstance(HNewInstance* instruction) {
 
 void InstructionCodeGeneratorARM64::VisitNewInstance(HNewInstance* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    Register current_method = InputRegisterAt(instruction, 0);
+    Register out = OutputRegister(instruction);
+    Register klass = WRegisterFrom(locations->GetTemp(0));
+    Register size = XRegisterFrom(locations->GetTemp(1));
+    SlowPathCodeARM64* slow_path =
+        new (GetGraph()->GetArena()) AllocationSlowPathARM64(instruction);
+    codegen_->AddSlowPath(slow_path);
+
+    // Only initialized classes without finalizer are allocated inline, like the
+    // TLAB fast path of the runtime.
+    GenerateResolvedTypeLoad(klass, current_method, instruction->GetTypeIndex(), slow_path);
+    {
+      UseScratchRegisterScope temps(GetVIXLAssembler());
+      Register temp = temps.AcquireW();
+      __ Ldr(temp, HeapOperand(klass, mirror::Class::StatusOffset()));
+      __ Cmp(temp, mirror::Class::kStatusInitialized);
+      __ B(lt, slow_path->GetEntryLabel());
+      __ Ldr(temp, HeapOperand(klass, mirror::Class::AccessFlagsOffset()));
+      __ Tst(temp, kAccClassIsFinalizable);
+      __ B(ne, slow_path->GetEntryLabel());
+    }
+    __ Ldr(size.W(), HeapOperand(klass, mirror::Class::ObjectSizeOffset()));
+    __ Add(size.W(), size.W(), kObjectAlignment - 1);
+    __ And(size.W(), size.W(), ~static_cast<uint32_t>(kObjectAlignment - 1));
+    GenerateTlabAllocation(out, klass, size, slow_path);
+    // The header must be visible to other threads before the reference to the object, and the
+    // loads of class data which follow must not be reordered before the status check. A full
+    // barrier orders both, like the TLAB fast path of the runtime.
+    GenerateMemoryBarrier(MemBarrierKind::kAnyAny);
+    __ Bind(slow_path->GetExitLabel());
+    return;
+  }
+
   Register type_index = RegisterFrom(locations->GetTemp(0), Primitive::kPrimInt);
   DCHECK(type_index.Is(w0));
   __ Mov(type_index, instruction->GetTypeIndex());
@@ -3345,6 +3494,39 @@ void InstructionCodeGeneratorARM64::VisitNewInstance(HNewInstance* instruction)
   CheckEntrypointTypes<kQuickAllocObjectWithAccessCheck, void*, uint32_t, ArtMethod*>();
 }
 
+void InstructionCodeGeneratorARM64::GenerateResolvedTypeLoad(Register klass,
+                                                             Register current_method,
+                                                             uint16_t type_index,
+                                                             SlowPathCodeARM64* slow_path) {
+  MemberOffset resolved_types_offset = ArtMethod::DexCacheResolvedTypesOffset(kArm64PointerSize);
+  __ Ldr(klass.X(), MemOperand(current_method, resolved_types_offset.Int32Value()));
+  __ Ldr(klass, MemOperand(klass.X(), CodeGenerator::GetCacheOffset(type_index)));
+  __ Cbz(klass, slow_path->GetEntryLabel());
+}
+
+void InstructionCodeGeneratorARM64::GenerateTlabAllocation(Register out,
+                                                           Register klass,
+                                                           Register size,
+                                                           SlowPathCodeARM64* slow_path) {
+  UseScratchRegisterScope temps(GetVIXLAssembler());
+  Register temp = temps.AcquireX();
+  // The new position of the TLAB is computed in `size`. TLAB memory is zeroed, so only
+  // the class needs to be stored in the header.
+  __ Ldr(out.X(), MemOperand(tr, Thread::ThreadLocalPosOffset<kArm64WordSize>().Int32Value()));
+  __ Add(size, size, out.X());
+  __ Ldr(temp, MemOperand(tr, Thread::ThreadLocalEndOffset<kArm64WordSize>().Int32Value()));
+  __ Cmp(size, temp);
+  __ B(hi, slow_path->GetEntryLabel());
+  __ Str(size, MemOperand(tr, Thread::ThreadLocalPosOffset<kArm64WordSize>().Int32Value()));
+  __ Ldr(temp, MemOperand(tr, Thread::ThreadLocalObjectsOffset<kArm64WordSize>().Int32Value()));
+  __ Add(temp, temp, 1);
+  __ Str(temp, MemOperand(tr, Thread::ThreadLocalObjectsOffset<kArm64WordSize>().Int32Value()));
+  if (kPoisonHeapReferences) {
+    GetAssembler()->PoisonHeapReference(klass);
+  }
+  __ Str(klass, HeapOperand(out, mirror::Object::ClassOffset()));
+}
+
 void LocationsBuilderARM64::VisitNot(HNot* instruction) {
   LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instruction);
   locations->SetInAt(0, Location::RequiresRegister());
@@ -193,6 +193,20 @@ class InstructionCodeGeneratorARM64 : public HGraphVisitor {
 
  private:
   void GenerateClassInitializationCheck(SlowPathCodeARM64* slow_path, vixl::Register class_reg);
+  // Loads the class of `type_index` from the dex cache of `current_method` into `klass`,
+  // branching to `slow_path` if it is not resolved.
+  void GenerateResolvedTypeLoad(vixl::Register klass,
+                                vixl::Register current_method,
+                                uint16_t type_index,
+                                SlowPathCodeARM64* slow_path);
+  // Allocates an object of class `klass` and of `size` bytes, a multiple of the object
+  // alignment, from the thread-local allocation buffer into `out`. Branches to `slow_path`
+  // if the buffer is too small. Clobbers `klass` and `size`. The caller emits the
+  // memory barrier once the header is initialized.
+  void GenerateTlabAllocation(vixl::Register out,
+                              vixl::Register klass,
+                              vixl::Register size,
+                              SlowPathCodeARM64* slow_path);
   void GenerateMemoryBarrier(MemBarrierKind kind);
   void GenerateSuspendCheck(HSuspendCheck* instruction, HBasicBlock* successor);
   void HandleBinaryOp(HBinaryOperation* instr);
@@ -389,6 +403,9 @@ class CodeGeneratorARM64 : public CodeGenerator {
     return false;
   }
 
+  // Loads the ArtMethod* of the callee of `invoke` and returns its location, which is
+  // `temp` unless the call is recursive.
+  Location GenerateCalleeMethodStaticOrDirectCall(HInvokeStaticOrDirect* invoke, Location temp);
   void GenerateStaticOrDirectCall(HInvokeStaticOrDirect* invoke, Location temp) OVERRIDE;
   void GenerateVirtualCall(HInvokeVirtual* invoke, Location temp) OVERRIDE;
 
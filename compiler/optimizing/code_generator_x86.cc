@@ -290,6 +290,53 @@ class LoadClassSlowPathX86 : public SlowPathCode {
   DISALLOW_COPY_AND_ASSIGN(LoadClassSlowPathX86);
 };
 
+class AllocationSlowPathX86 : public SlowPathCode {
+ public:
+  explicit AllocationSlowPathX86(HInstruction* instruction) : instruction_(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    LocationSummary* locations = instruction_->GetLocations();
+    DCHECK(!locations->GetLiveRegisters()->ContainsCoreRegister(locations->Out().reg()));
+
+    CodeGeneratorX86* x86_codegen = down_cast<CodeGeneratorX86*>(codegen);
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    QuickEntrypointEnum entrypoint;
+    uint16_t type_index;
+    if (instruction_->IsNewInstance()) {
+      entrypoint = instruction_->AsNewInstance()->GetEntrypoint();
+      type_index = instruction_->AsNewInstance()->GetTypeIndex();
+      x86_codegen->Move32(Location::RegisterLocation(calling_convention.GetRegisterAt(1)),
+                          locations->InAt(0));
+    } else {
+      entrypoint = instruction_->AsNewArray()->GetEntrypoint();
+      type_index = instruction_->AsNewArray()->GetTypeIndex();
+      x86_codegen->EmitParallelMoves(
+          locations->InAt(0),
+          Location::RegisterLocation(calling_convention.GetRegisterAt(1)),
+          Primitive::kPrimInt,
+          locations->InAt(1),
+          Location::RegisterLocation(calling_convention.GetRegisterAt(2)),
+          instruction_->InputAt(1)->GetType());
+    }
+    __ movl(calling_convention.GetRegisterAt(0), Immediate(type_index));
+    x86_codegen->InvokeRuntime(entrypoint, instruction_, instruction_->GetDexPc(), this);
+    x86_codegen->Move32(locations->Out(), Location::RegisterLocation(EAX));
+    RestoreLiveRegisters(codegen, locations);
+
+    __ jmp(GetExitLabel());
+  }
+
+  const char* GetDescription() const OVERRIDE { return "AllocationSlowPathX86"; }
+
+ private:
+  HInstruction* const instruction_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationSlowPathX86);
+};
+
 class TypeCheckSlowPathX86 : public SlowPathCode {
  public:
   TypeCheckSlowPathX86(HInstruction* instruction, bool is_fatal)
@@ -3526,6 +3573,15 @@ void InstructionCodeGeneratorX86::VisitUShr(HUShr* ushr) {
 }
 
 void LocationsBuilderX86::VisitNewInstance(HNewInstance* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+        instruction, LocationSummary::kCallOnSlowPath);
+    locations->SetInAt(0, Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->SetOut(Location::RequiresRegister());
+    return;
+  }
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
   locations->SetOut(Location::RegisterLocation(EAX));
@@ -3535,6 +3591,32 @@ void LocationsBuilderX86::VisitNewInstance(HNewInstance* instruction) {
 }
 
 void InstructionCodeGeneratorX86::VisitNewInstance(HNewInstance* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = instruction->GetLocations();
+    Register current_method = locations->InAt(0).AsRegister<Register>();
+    Register out = locations->Out().AsRegister<Register>();
+    Register klass = locations->GetTemp(0).AsRegister<Register>();
+    Register size = locations->GetTemp(1).AsRegister<Register>();
+    SlowPathCode* slow_path = new (GetGraph()->GetArena()) AllocationSlowPathX86(instruction);
+    codegen_->AddSlowPath(slow_path);
+
+    // Only initialized classes without finalizer are allocated inline, like the
+    // TLAB fast path of the runtime.
+    GenerateResolvedTypeLoad(klass, current_method, instruction->GetTypeIndex(), slow_path);
+    __ cmpl(Address(klass, mirror::Class::StatusOffset().Int32Value()),
+            Immediate(mirror::Class::kStatusInitialized));
+    __ j(kLess, slow_path->GetEntryLabel());
+    __ movl(size, Address(klass, mirror::Class::AccessFlagsOffset().Int32Value()));
+    __ testl(size, Immediate(static_cast<int32_t>(kAccClassIsFinalizable)));
+    __ j(kNotZero, slow_path->GetEntryLabel());
+    __ movl(size, Address(klass, mirror::Class::ObjectSizeOffset().Int32Value()));
+    __ addl(size, Immediate(kObjectAlignment - 1));
+    __ andl(size, Immediate(-static_cast<int32_t>(kObjectAlignment)));
+    GenerateTlabAllocation(out, klass, size, slow_path);
+    __ Bind(slow_path->GetExitLabel());
+    return;
+  }
+
   InvokeRuntimeCallingConvention calling_convention;
   __ movl(calling_convention.GetRegisterAt(0), Immediate(instruction->GetTypeIndex()));
   // Note: if heap poisoning is enabled, the entry point takes cares
@@ -3547,6 +3629,16 @@ void InstructionCodeGeneratorX86::VisitNewInstance(HNewInstance* instruction) {
 }
 
 void LocationsBuilderX86::VisitNewArray(HNewArray* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+        instruction, LocationSummary::kCallOnSlowPath);
+    locations->SetInAt(0, Location::RegisterOrConstant(instruction->InputAt(0)));
+    locations->SetInAt(1, Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->SetOut(Location::RequiresRegister());
+    return;
+  }
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
   locations->SetOut(Location::RegisterLocation(EAX));
@@ -3557,6 +3649,44 @@ void LocationsBuilderX86::VisitNewArray(HNewArray* instruction) {
 }
 
 void InstructionCodeGeneratorX86::VisitNewArray(HNewArray* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = instruction->GetLocations();
+    Location length = locations->InAt(0);
+    Register current_method = locations->InAt(1).AsRegister<Register>();
+    Register out = locations->Out().AsRegister<Register>();
+    Register klass = locations->GetTemp(0).AsRegister<Register>();
+    Register size = locations->GetTemp(1).AsRegister<Register>();
+    size_t shift = CodeGenerator::GetArrayComponentSizeShift(instruction);
+    uint32_t data_offset = mirror::Array::DataOffset(1u << shift).Uint32Value();
+    uint32_t length_offset = mirror::Array::LengthOffset().Uint32Value();
+    SlowPathCode* slow_path = new (GetGraph()->GetArena()) AllocationSlowPathX86(instruction);
+    codegen_->AddSlowPath(slow_path);
+
+    GenerateResolvedTypeLoad(klass, current_method, instruction->GetTypeIndex(), slow_path);
+    if (length.IsConstant()) {
+      int32_t value = length.GetConstant()->AsIntConstant()->GetValue();
+      __ movl(size, Immediate(RoundUp(data_offset + (value << shift), kObjectAlignment)));
+    } else {
+      // Negative lengths are caught by the unsigned comparison, and thrown by the runtime.
+      Register length_reg = length.AsRegister<Register>();
+      __ cmpl(length_reg, Immediate(CodeGenerator::GetMaxInlineArrayLength(instruction)));
+      __ j(kAbove, slow_path->GetEntryLabel());
+      __ movl(size, length_reg);
+      __ shll(size, Immediate(shift));
+      __ addl(size, Immediate(data_offset + kObjectAlignment - 1));
+      __ andl(size, Immediate(-static_cast<int32_t>(kObjectAlignment)));
+    }
+    GenerateTlabAllocation(out, klass, size, slow_path);
+    if (length.IsConstant()) {
+      __ movl(Address(out, length_offset),
+              Immediate(length.GetConstant()->AsIntConstant()->GetValue()));
+    } else {
+      __ movl(Address(out, length_offset), length.AsRegister<Register>());
+    }
+    __ Bind(slow_path->GetExitLabel());
+    return;
+  }
+
   InvokeRuntimeCallingConvention calling_convention;
   __ movl(calling_convention.GetRegisterAt(0), Immediate(instruction->GetTypeIndex()));
 
@@ -3569,6 +3699,37 @@ void InstructionCodeGeneratorX86::VisitNewArray(HNewArray* instruction) {
   DCHECK(!codegen_->IsLeafMethod());
 }
 
+void InstructionCodeGeneratorX86::GenerateResolvedTypeLoad(Register klass,
+                                                           Register current_method,
+                                                           uint16_t type_index,
+                                                           SlowPathCode* slow_path) {
+  __ movl(klass, Address(
+      current_method, ArtMethod::DexCacheResolvedTypesOffset(kX86PointerSize).Int32Value()));
+  __ movl(klass, Address(klass, CodeGenerator::GetCacheOffset(type_index)));
+  __ testl(klass, klass);
+  __ j(kEqual, slow_path->GetEntryLabel());
+}
+
+void InstructionCodeGeneratorX86::GenerateTlabAllocation(Register out,
+                                                         Register klass,
+                                                         Register size,
+                                                         SlowPathCode* slow_path) {
+  // The new position of the TLAB is computed in `size`. TLAB memory is zeroed, so only
+  // the class needs to be stored in the header.
+  __ fs()->movl(out, Address::Absolute(Thread::ThreadLocalPosOffset<kX86WordSize>()));
+  __ addl(size, out);
+  __ fs()->cmpl(size, Address::Absolute(Thread::ThreadLocalEndOffset<kX86WordSize>()));
+  __ j(kAbove, slow_path->GetEntryLabel());
+  __ fs()->movl(Address::Absolute(Thread::ThreadLocalPosOffset<kX86WordSize>()), size);
+  __ fs()->addl(Address::Absolute(Thread::ThreadLocalObjectsOffset<kX86WordSize>()),
+                Immediate(1));
+  if (kPoisonHeapReferences) {
+    __ PoisonHeapReference(klass);
+  }
+  __ movl(Address(out, mirror::Object::ClassOffset().Int32Value()), klass);
+  // No need for memory fence, thanks to the x86 memory model.
+}
+
 void LocationsBuilderX86::VisitParameterValue(HParameterValue* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
@@ -201,6 +201,19 @@ class InstructionCodeGeneratorX86 : public HGraphVisitor {
   // the suspend call.
   void GenerateSuspendCheck(HSuspendCheck* check, HBasicBlock* successor);
   void GenerateClassInitializationCheck(SlowPathCode* slow_path, Register class_reg);
+  // Loads the class of `type_index` from the dex cache of `current_method` into `klass`,
+  // branching to `slow_path` if it is not resolved.
+  void GenerateResolvedTypeLoad(Register klass,
+                                Register current_method,
+                                uint16_t type_index,
+                                SlowPathCode* slow_path);
+  // Allocates an object of class `klass` and of `size` bytes, a multiple of the object
+  // alignment, from the thread-local allocation buffer into `out`. Branches to `slow_path`
+  // if the buffer is too small. Clobbers `klass` and `size`.
+  void GenerateTlabAllocation(Register out,
+                              Register klass,
+                              Register size,
+                              SlowPathCode* slow_path);
   void HandleBitwiseOperation(HBinaryOperation* instruction);
   void GenerateDivRemIntegral(HBinaryOperation* instruction);
   void DivRemOneOrMinusOne(HBinaryOperation* instruction);
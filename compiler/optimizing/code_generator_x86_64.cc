@@ -299,6 +299,52 @@ class LoadStringSlowPathX86_64 : public SlowPathCode {
   DISALLOW_COPY_AND_ASSIGN(LoadStringSlowPathX86_64);
 };
 
+class AllocationSlowPathX86_64 : public SlowPathCode {
+ public:
+  explicit AllocationSlowPathX86_64(HInstruction* instruction) : instruction_(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) OVERRIDE {
+    LocationSummary* locations = instruction_->GetLocations();
+    DCHECK(!locations->GetLiveRegisters()->ContainsCoreRegister(locations->Out().reg()));
+
+    CodeGeneratorX86_64* x64_codegen = down_cast<CodeGeneratorX86_64*>(codegen);
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    QuickEntrypointEnum entrypoint;
+    uint16_t type_index;
+    if (instruction_->IsNewInstance()) {
+      entrypoint = instruction_->AsNewInstance()->GetEntrypoint();
+      type_index = instruction_->AsNewInstance()->GetTypeIndex();
+      x64_codegen->Move(Location::RegisterLocation(calling_convention.GetRegisterAt(1)),
+                        locations->InAt(0));
+    } else {
+      entrypoint = instruction_->AsNewArray()->GetEntrypoint();
+      type_index = instruction_->AsNewArray()->GetTypeIndex();
+      x64_codegen->EmitParallelMoves(
+          locations->InAt(0),
+          Location::RegisterLocation(calling_convention.GetRegisterAt(1)),
+          Primitive::kPrimInt,
+          locations->InAt(1),
+          Location::RegisterLocation(calling_convention.GetRegisterAt(2)),
+          instruction_->InputAt(1)->GetType());
+    }
+    __ movl(CpuRegister(calling_convention.GetRegisterAt(0)), Immediate(type_index));
+    x64_codegen->InvokeRuntime(entrypoint, instruction_, instruction_->GetDexPc(), this);
+    x64_codegen->Move(locations->Out(), Location::RegisterLocation(RAX));
+    RestoreLiveRegisters(codegen, locations);
+    __ jmp(GetExitLabel());
+  }
+
+  const char* GetDescription() const OVERRIDE { return "AllocationSlowPathX86_64"; }
+
+ private:
+  HInstruction* const instruction_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationSlowPathX86_64);
+};
+
 class TypeCheckSlowPathX86_64 : public SlowPathCode {
  public:
   TypeCheckSlowPathX86_64(HInstruction* instruction, bool is_fatal)
@@ -3515,6 +3561,15 @@ void InstructionCodeGeneratorX86_64::VisitUShr(HUShr* ushr) {
 }
 
 void LocationsBuilderX86_64::VisitNewInstance(HNewInstance* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+        instruction, LocationSummary::kCallOnSlowPath);
+    locations->SetInAt(0, Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->SetOut(Location::RequiresRegister());
+    return;
+  }
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
   InvokeRuntimeCallingConvention calling_convention;
@@ -3524,6 +3579,32 @@ void LocationsBuilderX86_64::VisitNewInstance(HNewInstance* instruction) {
 }
 
 void InstructionCodeGeneratorX86_64::VisitNewInstance(HNewInstance* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = instruction->GetLocations();
+    CpuRegister current_method = locations->InAt(0).AsRegister<CpuRegister>();
+    CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+    CpuRegister klass = locations->GetTemp(0).AsRegister<CpuRegister>();
+    CpuRegister size = locations->GetTemp(1).AsRegister<CpuRegister>();
+    SlowPathCode* slow_path = new (GetGraph()->GetArena()) AllocationSlowPathX86_64(instruction);
+    codegen_->AddSlowPath(slow_path);
+
+    // Only initialized classes without finalizer are allocated inline, like the
+    // TLAB fast path of the runtime.
+    GenerateResolvedTypeLoad(klass, current_method, instruction->GetTypeIndex(), slow_path);
+    __ cmpl(Address(klass, mirror::Class::StatusOffset().Int32Value()),
+            Immediate(mirror::Class::kStatusInitialized));
+    __ j(kLess, slow_path->GetEntryLabel());
+    __ movl(size, Address(klass, mirror::Class::AccessFlagsOffset().Int32Value()));
+    __ testl(size, Immediate(static_cast<int32_t>(kAccClassIsFinalizable)));
+    __ j(kNotZero, slow_path->GetEntryLabel());
+    __ movl(size, Address(klass, mirror::Class::ObjectSizeOffset().Int32Value()));
+    __ addl(size, Immediate(kObjectAlignment - 1));
+    __ andl(size, Immediate(-static_cast<int32_t>(kObjectAlignment)));
+    GenerateTlabAllocation(out, klass, size, slow_path);
+    __ Bind(slow_path->GetExitLabel());
+    return;
+  }
+
   InvokeRuntimeCallingConvention calling_convention;
   codegen_->Load64BitValue(CpuRegister(calling_convention.GetRegisterAt(0)),
                            instruction->GetTypeIndex());
@@ -3539,6 +3620,16 @@ void InstructionCodeGeneratorX86_64::VisitNewInstance(HNewInstance* instruction)
 }
 
 void LocationsBuilderX86_64::VisitNewArray(HNewArray* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(
+        instruction, LocationSummary::kCallOnSlowPath);
+    locations->SetInAt(0, Location::RegisterOrConstant(instruction->InputAt(0)));
+    locations->SetInAt(1, Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+    locations->SetOut(Location::RequiresRegister());
+    return;
+  }
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCall);
   InvokeRuntimeCallingConvention calling_convention;
@@ -3549,6 +3640,44 @@ void LocationsBuilderX86_64::VisitNewArray(HNewArray* instruction) {
 }
 
 void InstructionCodeGeneratorX86_64::VisitNewArray(HNewArray* instruction) {
+  if (CodeGenerator::CanAllocateInline(instruction)) {
+    LocationSummary* locations = instruction->GetLocations();
+    Location length = locations->InAt(0);
+    CpuRegister current_method = locations->InAt(1).AsRegister<CpuRegister>();
+    CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+    CpuRegister klass = locations->GetTemp(0).AsRegister<CpuRegister>();
+    CpuRegister size = locations->GetTemp(1).AsRegister<CpuRegister>();
+    size_t shift = CodeGenerator::GetArrayComponentSizeShift(instruction);
+    uint32_t data_offset = mirror::Array::DataOffset(1u << shift).Uint32Value();
+    uint32_t length_offset = mirror::Array::LengthOffset().Uint32Value();
+    SlowPathCode* slow_path = new (GetGraph()->GetArena()) AllocationSlowPathX86_64(instruction);
+    codegen_->AddSlowPath(slow_path);
+
+    GenerateResolvedTypeLoad(klass, current_method, instruction->GetTypeIndex(), slow_path);
+    if (length.IsConstant()) {
+      int32_t value = length.GetConstant()->AsIntConstant()->GetValue();
+      __ movl(size, Immediate(RoundUp(data_offset + (value << shift), kObjectAlignment)));
+    } else {
+      // Negative lengths are caught by the unsigned comparison, and thrown by the runtime.
+      CpuRegister length_reg = length.AsRegister<CpuRegister>();
+      __ cmpl(length_reg, Immediate(CodeGenerator::GetMaxInlineArrayLength(instruction)));
+      __ j(kAbove, slow_path->GetEntryLabel());
+      __ movl(size, length_reg);
+      __ shll(size, Immediate(shift));
+      __ addl(size, Immediate(data_offset + kObjectAlignment - 1));
+      __ andl(size, Immediate(-static_cast<int32_t>(kObjectAlignment)));
+    }
+    GenerateTlabAllocation(out, klass, size, slow_path);
+    if (length.IsConstant()) {
+      __ movl(Address(out, length_offset),
+              Immediate(length.GetConstant()->AsIntConstant()->GetValue()));
+    } else {
+      __ movl(Address(out, length_offset), length.AsRegister<CpuRegister>());
+    }
+    __ Bind(slow_path->GetExitLabel());
+    return;
+  }
+
   InvokeRuntimeCallingConvention calling_convention;
   codegen_->Load64BitValue(CpuRegister(calling_convention.GetRegisterAt(0)),
                            instruction->GetTypeIndex());
@@ -3563,6 +3692,40 @@ void InstructionCodeGeneratorX86_64::VisitNewArray(HNewArray* instruction) {
   DCHECK(!codegen_->IsLeafMethod());
 }
 
+void InstructionCodeGeneratorX86_64::GenerateResolvedTypeLoad(CpuRegister klass,
+                                                              CpuRegister current_method,
+                                                              uint16_t type_index,
+                                                              SlowPathCode* slow_path) {
+  __ movq(klass, Address(
+      current_method, ArtMethod::DexCacheResolvedTypesOffset(kX86_64PointerSize).Int32Value()));
+  __ movl(klass, Address(klass, CodeGenerator::GetCacheOffset(type_index)));
+  __ testl(klass, klass);
+  __ j(kEqual, slow_path->GetEntryLabel());
+}
+
+void InstructionCodeGeneratorX86_64::GenerateTlabAllocation(CpuRegister out,
+                                                            CpuRegister klass,
+                                                            CpuRegister size,
+                                                            SlowPathCode* slow_path) {
+  // The new position of the TLAB is computed in `size`. TLAB memory is zeroed, so only
+  // the class needs to be stored in the header.
+  __ gs()->movq(out, Address::Absolute(Thread::ThreadLocalPosOffset<kX86_64WordSize>(), true));
+  __ addq(size, out);
+  __ gs()->cmpq(size, Address::Absolute(Thread::ThreadLocalEndOffset<kX86_64WordSize>(), true));
+  __ j(kAbove, slow_path->GetEntryLabel());
+  __ gs()->movq(Address::Absolute(Thread::ThreadLocalPosOffset<kX86_64WordSize>(), true), size);
+  __ gs()->movq(size,
+                Address::Absolute(Thread::ThreadLocalObjectsOffset<kX86_64WordSize>(), true));
+  __ addq(size, Immediate(1));
+  __ gs()->movq(Address::Absolute(Thread::ThreadLocalObjectsOffset<kX86_64WordSize>(), true),
+                size);
+  if (kPoisonHeapReferences) {
+    __ PoisonHeapReference(klass);
+  }
+  __ movl(Address(out, mirror::Object::ClassOffset().Int32Value()), klass);
+  // No need for memory fence, thanks to the X86_64 memory model.
+}
+
 void LocationsBuilderX86_64::VisitParameterValue(HParameterValue* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
@@ -200,6 +200,19 @@ class InstructionCodeGeneratorX86_64 : public HGraphVisitor {
   // the suspend call.
   void GenerateSuspendCheck(HSuspendCheck* instruction, HBasicBlock* successor);
   void GenerateClassInitializationCheck(SlowPathCode* slow_path, CpuRegister class_reg);
+  // Loads the class of `type_index` from the dex cache of `current_method` into `klass`,
+  // branching to `slow_path` if it is not resolved.
+  void GenerateResolvedTypeLoad(CpuRegister klass,
+                                CpuRegister current_method,
+                                uint16_t type_index,
+                                SlowPathCode* slow_path);
+  // Allocates an object of class `klass` and of `size` bytes, a multiple of the object
+  // alignment, from the thread-local allocation buffer into `out`. Branches to `slow_path`
+  // if the buffer is too small. Clobbers `klass` and `size`.
+  void GenerateTlabAllocation(CpuRegister out,
+                              CpuRegister klass,
+                              CpuRegister size,
+                              SlowPathCode* slow_path);
   void HandleBitwiseOperation(HBinaryOperation* operation);
   void GenerateRemFP(HRem* rem);
   void DivRemOneOrMinusOne(HBinaryOperation* instruction);
@@ -101,6 +101,21 @@ InductionVarRange::Value InductionVarRange::GetMaxInduction(HInstruction* contex
   return SimplifyMax(GetInduction(context, instruction, /* is_min */ false));
 }
 
+bool InductionVarRange::GetConstantTripCount(HLoopInformation* loop,
+                                             /*out*/int64_t* trip_count) {
+  HInductionVarAnalysis::InductionInfo* trip =
+      induction_analysis_->LookupInfo(loop, loop->GetHeader()->GetLastInstruction());
+  int32_t value;
+  if (trip != nullptr &&
+      trip->operation == HInductionVarAnalysis::kTripCountInLoop &&
+      GetConstant(trip->op_b, &value) &&
+      value >= 0) {
+    *trip_count = value;
+    return true;
+  }
+  return false;
+}
+
 bool InductionVarRange::CanGenerateCode(HInstruction* context,
                                         HInstruction* instruction,
                                         /*out*/bool* top_test) {
@@ -68,6 +68,13 @@ class InductionVarRange {
    */
   Value GetMaxInduction(HInstruction* context, HInstruction* instruction);
 
+  /**
+   * Returns true if the trip count of the given loop is a known constant, which is then
+   * returned in trip_count. Only trip counts of loops that are known to be taken and finite
+   * are returned. For loops with early exits, the value forms an upper bound.
+   */
+  bool GetConstantTripCount(HLoopInformation* loop, /*out*/int64_t* trip_count);
+
   /**
    * Returns true if range analysis is able to generate code for the lower and upper bound
    * expressions on the instruction in the given context. Output parameter top_test denotes
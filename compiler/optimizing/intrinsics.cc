@@ -168,6 +168,57 @@ static Intrinsics GetIntrinsic(InlineMethod method, InstructionSet instruction_s
           UNREACHABLE();
       }
 
+    case kIntrinsicBitCount:
+      switch (GetType(method.d.data, true)) {
+        case Primitive::kPrimInt:
+          return Intrinsics::kIntegerBitCount;
+        case Primitive::kPrimLong:
+          return Intrinsics::kLongBitCount;
+        default:
+          LOG(FATAL) << "Unknown/unsupported op size " << method.d.data;
+          UNREACHABLE();
+      }
+    case kIntrinsicCompare:
+      switch (GetType(method.d.data, true)) {
+        case Primitive::kPrimInt:
+          return Intrinsics::kIntegerCompare;
+        case Primitive::kPrimLong:
+          return Intrinsics::kLongCompare;
+        default:
+          LOG(FATAL) << "Unknown/unsupported op size " << method.d.data;
+          UNREACHABLE();
+      }
+    case kIntrinsicHighestOneBit:
+      switch (GetType(method.d.data, true)) {
+        case Primitive::kPrimInt:
+          return Intrinsics::kIntegerHighestOneBit;
+        case Primitive::kPrimLong:
+          return Intrinsics::kLongHighestOneBit;
+        default:
+          LOG(FATAL) << "Unknown/unsupported op size " << method.d.data;
+          UNREACHABLE();
+      }
+    case kIntrinsicLowestOneBit:
+      switch (GetType(method.d.data, true)) {
+        case Primitive::kPrimInt:
+          return Intrinsics::kIntegerLowestOneBit;
+        case Primitive::kPrimLong:
+          return Intrinsics::kLongLowestOneBit;
+        default:
+          LOG(FATAL) << "Unknown/unsupported op size " << method.d.data;
+          UNREACHABLE();
+      }
+    case kIntrinsicSignum:
+      switch (GetType(method.d.data, true)) {
+        case Primitive::kPrimInt:
+          return Intrinsics::kIntegerSignum;
+        case Primitive::kPrimLong:
+          return Intrinsics::kLongSignum;
+        default:
+          LOG(FATAL) << "Unknown/unsupported op size " << method.d.data;
+          UNREACHABLE();
+      }
+
     // Abs.
     case kIntrinsicAbsDouble:
       return Intrinsics::kMathAbsDouble;
@@ -193,6 +244,22 @@ static Intrinsics GetIntrinsic(InlineMethod method, InstructionSet instruction_s
           Intrinsics::kMathMaxLongLong : Intrinsics::kMathMinLongLong;
 
     // Misc math.
+    case kIntrinsicCos:
+      return Intrinsics::kMathCos;
+    case kIntrinsicSin:
+      return Intrinsics::kMathSin;
+    case kIntrinsicTan:
+      return Intrinsics::kMathTan;
+    case kIntrinsicAtan2:
+      return Intrinsics::kMathAtan2;
+    case kIntrinsicExp:
+      return Intrinsics::kMathExp;
+    case kIntrinsicLog:
+      return Intrinsics::kMathLog;
+    case kIntrinsicPow:
+      return Intrinsics::kMathPow;
+    case kIntrinsicHypot:
+      return Intrinsics::kMathHypot;
     case kIntrinsicSqrt:
       return Intrinsics::kMathSqrt;
     case kIntrinsicCeil:
@@ -258,6 +325,10 @@ static Intrinsics GetIntrinsic(InlineMethod method, InstructionSet instruction_s
       return Intrinsics::kStringEquals;
     case kIntrinsicGetCharsNoCheck:
       return Intrinsics::kStringGetCharsNoCheck;
+    case kIntrinsicHashCode:
+      return Intrinsics::kStringHashCode;
+    case kIntrinsicContentEquals:
+      return Intrinsics::kStringContentEquals;
     case kIntrinsicIsEmptyOrLength:
       // The inliner can handle these two cases - and this is the preferred approach
       // since after inlining the call is no longer visible (as opposed to waiting
@@ -266,6 +337,8 @@ static Intrinsics GetIntrinsic(InlineMethod method, InstructionSet instruction_s
     case kIntrinsicIndexOf:
       return ((method.d.data & kIntrinsicFlagBase0) == 0) ?
           Intrinsics::kStringIndexOfAfter : Intrinsics::kStringIndexOf;
+    case kIntrinsicIndexOfString:
+      return Intrinsics::kStringIndexOfString;
     case kIntrinsicNewStringFromBytes:
       return Intrinsics::kStringNewStringFromBytes;
     case kIntrinsicNewStringFromChars:
@@ -417,6 +490,15 @@ static bool CheckInvokeType(Intrinsics intrinsic, HInvoke* invoke, const DexFile
   }
 }
 
+// Reference.getReferent() reads the static flags of java.lang.ref.Reference, so, like the quick
+// compiler, only intrinsify it when the class is initialized and its type can be used in code.
+static bool CanIntrinsifyReferenceGetReferent(CompilerDriver* driver) {
+  ClassReference ref;
+  bool use_direct_type_ptr;
+  uintptr_t direct_type_ptr;
+  return driver->CanEmbedReferenceTypeInCode(&ref, &use_direct_type_ptr, &direct_type_ptr);
+}
+
 // TODO: Refactor DexFileMethodInliner and have something nicer than InlineMethod.
 void IntrinsicsRecognizer::Run() {
   for (HReversePostOrderIterator it(*graph_); !it.Done(); it.Advance()) {
@@ -439,7 +521,8 @@ void IntrinsicsRecognizer::Run() {
                   << intrinsic << " for "
                   << PrettyMethod(invoke->GetDexMethodIndex(), invoke->GetDexFile())
                   << invoke->DebugName();
-            } else {
+            } else if (intrinsic != Intrinsics::kReferenceGetReferent ||
+                       CanIntrinsifyReferenceGetReferent(driver_)) {
               invoke->SetIntrinsic(intrinsic, NeedsEnvironmentOrCache(intrinsic));
             }
           }
@@ -20,9 +20,12 @@
 #include "art_method.h"
 #include "code_generator_arm64.h"
 #include "common_arm64.h"
+#include "driver/compiler_driver.h"
 #include "entrypoints/quick/quick_entrypoints.h"
 #include "intrinsics.h"
 #include "mirror/array-inl.h"
+#include "mirror/class-inl.h"
+#include "mirror/reference.h"
 #include "mirror/string.h"
 #include "thread.h"
 #include "utils/arm64/assembler_arm64.h"
@@ -709,6 +712,55 @@ void IntrinsicCodeGeneratorARM64::VisitMathRoundFloat(HInvoke* invoke) {
   GenMathRound(invoke->GetLocations(), false, GetVIXLAssembler());
 }
 
+static void CreateFPToFPCallLocations(ArenaAllocator* arena, HInvoke* invoke) {
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kCall,
+                                                           kIntrinsified);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, LocationFrom(calling_convention.GetFpuRegisterAt(0)));
+  locations->SetOut(calling_convention.GetReturnLocation(invoke->GetType()));
+}
+
+static void CreateFPFPToFPCallLocations(ArenaAllocator* arena, HInvoke* invoke) {
+  CreateFPToFPCallLocations(arena, invoke);
+  InvokeRuntimeCallingConvention calling_convention;
+  invoke->GetLocations()->SetInAt(1, LocationFrom(calling_convention.GetFpuRegisterAt(1)));
+}
+
+// Calls the libm function stored in the quick entrypoint at `entry_point_offset`. The
+// function is a leaf that does not touch the Java heap, and it preserves the registers
+// that are callee-save for ART, so no transition or extra spilling is needed.
+static void GenFPToFPCall(HInvoke* invoke,
+                          CodeGeneratorARM64* codegen,
+                          int32_t entry_point_offset) {
+  vixl::MacroAssembler* masm = codegen->GetVIXLAssembler();
+  DCHECK(invoke->GetLocations()->WillCall());
+  __ Ldr(lr, MemOperand(tr, entry_point_offset));
+  __ Blr(lr);
+  codegen->RecordPcInfo(invoke, invoke->GetDexPc());
+}
+
+#define MATH_LIBM_INTRINSIC(Name, Arity, Entrypoint)                                     \
+void IntrinsicLocationsBuilderARM64::VisitMath ## Name(HInvoke* invoke) {                \
+  Create ## Arity ## ToFPCallLocations(arena_, invoke);                                  \
+}                                                                                        \
+void IntrinsicCodeGeneratorARM64::VisitMath ## Name(HInvoke* invoke) {                   \
+  GenFPToFPCall(invoke,                                                                  \
+                codegen_,                                                                \
+                QUICK_ENTRYPOINT_OFFSET(kArm64WordSize, Entrypoint).Int32Value());       \
+}
+
+MATH_LIBM_INTRINSIC(Cos, FP, pCos)
+MATH_LIBM_INTRINSIC(Sin, FP, pSin)
+MATH_LIBM_INTRINSIC(Tan, FP, pTan)
+MATH_LIBM_INTRINSIC(Atan2, FPFP, pAtan2)
+MATH_LIBM_INTRINSIC(Exp, FP, pExp)
+MATH_LIBM_INTRINSIC(Log, FP, pLog)
+MATH_LIBM_INTRINSIC(Pow, FPFP, pPow)
+MATH_LIBM_INTRINSIC(Hypot, FPFP, pHypot)
+
+#undef MATH_LIBM_INTRINSIC
+
 void IntrinsicLocationsBuilderARM64::VisitMemoryPeekByte(HInvoke* invoke) {
   CreateIntToIntLocations(arena_, invoke);
 }
@@ -821,7 +873,7 @@ static void GenUnsafeGet(HInvoke* invoke,
   DCHECK((type == Primitive::kPrimInt) ||
          (type == Primitive::kPrimLong) ||
          (type == Primitive::kPrimNot));
-  vixl::MacroAssembler* masm = codegen->GetAssembler()->vixl_masm_;
+  vixl::MacroAssembler* masm = codegen->GetVIXLAssembler();
   Register base = WRegisterFrom(locations->InAt(1));    // Object pointer.
   Register offset = XRegisterFrom(locations->InAt(2));  // Long offset.
   Register trg = RegisterFrom(locations->Out(), type);
@@ -936,7 +988,7 @@ static void GenUnsafePut(LocationSummary* locations,
                          bool is_volatile,
                          bool is_ordered,
                          CodeGeneratorARM64* codegen) {
-  vixl::MacroAssembler* masm = codegen->GetAssembler()->vixl_masm_;
+  vixl::MacroAssembler* masm = codegen->GetVIXLAssembler();
 
   Register base = WRegisterFrom(locations->InAt(1));    // Object pointer.
   Register offset = XRegisterFrom(locations->InAt(2));  // Long offset.
@@ -1023,7 +1075,7 @@ static void CreateIntIntIntIntIntToInt(ArenaAllocator* arena, HInvoke* invoke) {
 
 static void GenCas(LocationSummary* locations, Primitive::Type type, CodeGeneratorARM64* codegen) {
   bool use_acquire_release = codegen->GetInstructionSetFeatures().PreferAcquireRelease();
-  vixl::MacroAssembler* masm = codegen->GetAssembler()->vixl_masm_;
+  vixl::MacroAssembler* masm = codegen->GetVIXLAssembler();
 
   Register out = WRegisterFrom(locations->Out());                  // Boolean result.
 
@@ -1191,10 +1243,14 @@ void IntrinsicCodeGeneratorARM64::VisitStringCompareTo(HInvoke* invoke) {
   __ Bind(slow_path->GetExitLabel());
 }
 
-void IntrinsicLocationsBuilderARM64::VisitStringEquals(HInvoke* invoke) {
-  LocationSummary* locations = new (arena_) LocationSummary(invoke,
-                                                            LocationSummary::kNoCall,
-                                                            kIntrinsified);
+static void CreateStringEqualsLocations(HInvoke* invoke,
+                                        ArenaAllocator* allocator,
+                                        bool content_equals) {
+  // contentEquals() calls the Java method for arguments that are not strings.
+  LocationSummary* locations = new (allocator) LocationSummary(
+      invoke,
+      content_equals ? LocationSummary::kCallOnSlowPath : LocationSummary::kNoCall,
+      kIntrinsified);
   locations->SetInAt(0, Location::RequiresRegister());
   locations->SetInAt(1, Location::RequiresRegister());
   // Temporary registers to store lengths of strings and for calculations.
@@ -1204,8 +1260,11 @@ void IntrinsicLocationsBuilderARM64::VisitStringEquals(HInvoke* invoke) {
   locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
 }
 
-void IntrinsicCodeGeneratorARM64::VisitStringEquals(HInvoke* invoke) {
-  vixl::MacroAssembler* masm = GetVIXLAssembler();
+static void GenerateStringEquals(HInvoke* invoke,
+                                 vixl::MacroAssembler* masm,
+                                 CodeGeneratorARM64* codegen,
+                                 ArenaAllocator* allocator,
+                                 bool content_equals) {
   LocationSummary* locations = invoke->GetLocations();
 
   Register str = WRegisterFrom(locations->InAt(0));
@@ -1230,8 +1289,18 @@ void IntrinsicCodeGeneratorARM64::VisitStringEquals(HInvoke* invoke) {
   // Note that the null check must have been done earlier.
   DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
 
-  // Check if input is null, return false if it is.
-  __ Cbz(arg, &return_false);
+  // equals() returns false for a null argument and for any other type. contentEquals() throws
+  // for null and compares the chars of other CharSequences, leave both to the Java method.
+  SlowPathCodeARM64* slow_path = nullptr;
+  vixl::Label* not_a_string = &return_false;
+  if (content_equals) {
+    slow_path = new (allocator) IntrinsicSlowPathARM64(invoke);
+    codegen->AddSlowPath(slow_path);
+    not_a_string = slow_path->GetEntryLabel();
+  }
+
+  // Check if input is null.
+  __ Cbz(arg, not_a_string);
 
   // Reference equality check, return true if same reference.
   __ Cmp(str, arg);
@@ -1244,7 +1313,7 @@ void IntrinsicCodeGeneratorARM64::VisitStringEquals(HInvoke* invoke) {
   __ Ldr(temp, MemOperand(str.X(), class_offset));
   __ Ldr(temp1, MemOperand(arg.X(), class_offset));
   __ Cmp(temp, temp1);
-  __ B(&return_false, ne);
+  __ B(not_a_string, ne);
 
   // Load lengths of this and argument strings.
   __ Ldr(temp, MemOperand(str.X(), count_offset));
@@ -1285,6 +1354,121 @@ void IntrinsicCodeGeneratorARM64::VisitStringEquals(HInvoke* invoke) {
   __ Bind(&return_false);
   __ Mov(out, 0);
   __ Bind(&end);
+  if (slow_path != nullptr) {
+    __ Bind(slow_path->GetExitLabel());
+  }
+}
+
+void IntrinsicLocationsBuilderARM64::VisitStringEquals(HInvoke* invoke) {
+  CreateStringEqualsLocations(invoke, arena_, false);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitStringEquals(HInvoke* invoke) {
+  GenerateStringEquals(invoke, GetVIXLAssembler(), codegen_, GetAllocator(), false);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitStringContentEquals(HInvoke* invoke) {
+  CreateStringEqualsLocations(invoke, arena_, true);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitStringContentEquals(HInvoke* invoke) {
+  GenerateStringEquals(invoke, GetVIXLAssembler(), codegen_, GetAllocator(), true);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitStringHashCode(HInvoke* invoke) {
+  LocationSummary* locations = new (arena_) LocationSummary(invoke,
+                                                            LocationSummary::kNoCall,
+                                                            kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  // Remaining length, address of the next char and the char itself.
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  // Hashes of the four interleaved sequences of chars, their multiplier, and the next chars.
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitStringHashCode(HInvoke* invoke) {
+  vixl::MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  const int32_t hash_code_offset = mirror::String::HashCodeOffset().Int32Value();
+  const int32_t count_offset = mirror::String::CountOffset().Int32Value();
+  const int32_t value_offset = mirror::String::ValueOffset().Int32Value();
+
+  Register str = XRegisterFrom(locations->InAt(0));
+  Register out = WRegisterFrom(locations->Out());
+  Register count = WRegisterFrom(locations->GetTemp(0));
+  Register ptr = XRegisterFrom(locations->GetTemp(1));
+  Register temp = WRegisterFrom(locations->GetTemp(2));
+  FPRegister acc = DRegisterFrom(locations->GetTemp(3));
+  FPRegister multiplier = DRegisterFrom(locations->GetTemp(4));
+  FPRegister chars = DRegisterFrom(locations->GetTemp(5));
+
+  UseScratchRegisterScope scratch_scope(masm);
+  Register thirty_one = scratch_scope.AcquireW();
+
+  vixl::Label vector_loop;
+  vixl::Label scalar_loop;
+  vixl::Label scalar_loop_check;
+  vixl::Label store;
+  vixl::Label done;
+
+  // Note that the null check must have been done earlier.
+  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+
+  // A non-zero hash code has already been computed and cached.
+  __ Ldr(out, MemOperand(str, hash_code_offset));
+  __ Cbnz(out, &done);
+
+  // Here out == 0, which is the hash code of the empty prefix.
+  __ Ldr(count, MemOperand(str, count_offset));
+  __ Add(ptr, str, value_offset);
+  __ Mov(thirty_one, 31);
+  __ Cmp(count, 4);
+  __ B(&scalar_loop_check, lt);
+
+  // Lane i of `acc` holds the hash code of chars i, i + 4, i + 8, ..., that is
+  // the sum of c[i + 4 * k] * 31^(4 * (n - 1 - k)) over the n groups of four chars.
+  __ Movi(acc.V4S(), 0);
+  __ Mov(temp, 31 * 31 * 31 * 31);
+  __ Dup(multiplier.V4S(), temp);
+
+  __ Bind(&vector_loop);
+  __ Ld1(chars.V4H(), MemOperand(ptr, 4 * sizeof(uint16_t), PostIndex));
+  __ Uxtl(chars.V4S(), chars.V4H());
+  __ Mul(acc.V4S(), acc.V4S(), multiplier.V4S());
+  __ Add(acc.V4S(), acc.V4S(), chars.V4S());
+  __ Sub(count, count, 4);
+  __ Cmp(count, 4);
+  __ B(&vector_loop, ge);
+
+  // Combine the lanes: out = ((acc[0] * 31 + acc[1]) * 31 + acc[2]) * 31 + acc[3].
+  __ Umov(out, acc.V4S(), 0);
+  for (int lane = 1; lane < 4; ++lane) {
+    __ Umov(temp, acc.V4S(), lane);
+    __ Madd(out, out, thirty_one, temp);
+  }
+
+  // Hash the remaining chars one at a time: out = out * 31 + c.
+  __ Bind(&scalar_loop_check);
+  __ Cbz(count, &store);
+
+  __ Bind(&scalar_loop);
+  __ Ldrh(temp, MemOperand(ptr, sizeof(uint16_t), PostIndex));
+  __ Madd(out, out, thirty_one, temp);
+  __ Sub(count, count, 1);
+  __ Cbnz(count, &scalar_loop);
+
+  // Cache the hash code in the string, like String.hashCode() does.
+  __ Bind(&store);
+  __ Str(out, MemOperand(str, hash_code_offset));
+
+  __ Bind(&done);
 }
 
 static void GenerateVisitStringIndexOf(HInvoke* invoke,
@@ -1372,6 +1556,127 @@ void IntrinsicCodeGeneratorARM64::VisitStringIndexOfAfter(HInvoke* invoke) {
   GenerateVisitStringIndexOf(invoke, GetVIXLAssembler(), codegen_, GetAllocator(), false);
 }
 
+void IntrinsicLocationsBuilderARM64::VisitStringIndexOfString(HInvoke* invoke) {
+  LocationSummary* locations = new (arena_) LocationSummary(invoke,
+                                                            LocationSummary::kCallOnSlowPath,
+                                                            kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  // Pattern length, last start index, first char of the pattern, address of the current start,
+  // addresses of the compared chars and the number of chars left to compare.
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitStringIndexOfString(HInvoke* invoke) {
+  vixl::MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  const int32_t count_offset = mirror::String::CountOffset().Int32Value();
+  const int32_t value_offset = mirror::String::ValueOffset().Int32Value();
+  const int32_t char_size = sizeof(uint16_t);
+
+  Register str = XRegisterFrom(locations->InAt(0));
+  Register pattern = XRegisterFrom(locations->InAt(1));
+  Register out = WRegisterFrom(locations->Out());
+  Register pattern_length = WRegisterFrom(locations->GetTemp(0));
+  Register last = WRegisterFrom(locations->GetTemp(1));
+  Register first = WRegisterFrom(locations->GetTemp(2));
+  Register start = XRegisterFrom(locations->GetTemp(3));
+  Register str_ptr = XRegisterFrom(locations->GetTemp(4));
+  Register pattern_ptr = XRegisterFrom(locations->GetTemp(5));
+  Register remaining = WRegisterFrom(locations->GetTemp(6));
+
+  UseScratchRegisterScope scratch_scope(masm);
+  Register temp1 = scratch_scope.AcquireX();
+  Register temp2 = scratch_scope.AcquireX();
+
+  vixl::Label scan;
+  vixl::Label wide_loop;
+  vixl::Label tail_loop_check;
+  vixl::Label tail_loop;
+  vixl::Label next;
+  vixl::Label not_found;
+  vixl::Label done;
+
+  // Note that the null check must have been done earlier.
+  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+
+  // Leave the NullPointerException for a null pattern to the Java method.
+  SlowPathCodeARM64* slow_path = new (GetAllocator()) IntrinsicSlowPathARM64(invoke);
+  codegen_->AddSlowPath(slow_path);
+  __ Cbz(pattern, slow_path->GetEntryLabel());
+
+  // The empty pattern is found at index 0, `out` holds the index of the current start from here.
+  __ Ldr(pattern_length, MemOperand(pattern, count_offset));
+  __ Mov(out, 0);
+  __ Cbz(pattern_length, &done);
+
+  // The pattern can start at indexes 0 to str.length - pattern.length, there are none if the
+  // pattern is longer than the string.
+  __ Ldr(last, MemOperand(str, count_offset));
+  __ Subs(last, last, pattern_length);
+  __ B(&not_found, lt);
+  __ Ldrh(first, MemOperand(pattern, value_offset));
+  __ Add(start, str, value_offset);
+
+  // Look for the first char of the pattern.
+  __ Bind(&scan);
+  __ Ldrh(temp1.W(), MemOperand(start));
+  __ Cmp(temp1.W(), first);
+  __ B(&next, ne);
+
+  // Compare the rest of the pattern, four chars at a time while at least four are left, then
+  // one at a time. Only the chars of the pattern and the chars of the string it is compared
+  // with are read, the wide loads may be unaligned.
+  __ Sub(remaining, pattern_length, 1);
+  __ Add(str_ptr, start, char_size);
+  __ Add(pattern_ptr, pattern, value_offset + char_size);
+  __ Cmp(remaining, 4);
+  __ B(&tail_loop_check, lt);
+
+  __ Bind(&wide_loop);
+  __ Ldr(temp1, MemOperand(str_ptr, 4 * char_size, PostIndex));
+  __ Ldr(temp2, MemOperand(pattern_ptr, 4 * char_size, PostIndex));
+  __ Cmp(temp1, temp2);
+  __ B(&next, ne);
+  __ Sub(remaining, remaining, 4);
+  __ Cmp(remaining, 4);
+  __ B(&wide_loop, ge);
+
+  __ Bind(&tail_loop_check);
+  __ Cbz(remaining, &done);
+
+  __ Bind(&tail_loop);
+  __ Ldrh(temp1.W(), MemOperand(str_ptr, char_size, PostIndex));
+  __ Ldrh(temp2.W(), MemOperand(pattern_ptr, char_size, PostIndex));
+  __ Cmp(temp1.W(), temp2.W());
+  __ B(&next, ne);
+  __ Sub(remaining, remaining, 1);
+  __ Cbnz(remaining, &tail_loop);
+  __ B(&done);
+
+  // Try the next start, if any.
+  __ Bind(&next);
+  __ Add(start, start, char_size);
+  __ Add(out, out, 1);
+  __ Cmp(out, last);
+  __ B(&scan, le);
+
+  __ Bind(&not_found);
+  __ Mov(out, -1);
+
+  __ Bind(&done);
+  __ Bind(slow_path->GetExitLabel());
+}
+
 void IntrinsicLocationsBuilderARM64::VisitStringNewStringFromBytes(HInvoke* invoke) {
   LocationSummary* locations = new (arena_) LocationSummary(invoke,
                                                             LocationSummary::kCall,
@@ -1450,6 +1755,740 @@ void IntrinsicCodeGeneratorARM64::VisitStringNewStringFromString(HInvoke* invoke
   __ Bind(slow_path->GetExitLabel());
 }
 
+// Returns the location of a position or length input of System.arraycopy, which is kept as
+// a constant only if it can be encoded in an add or compare instruction.
+static Location LocationForSystemArrayCopyInput(HInstruction* input) {
+  HIntConstant* constant = input->AsIntConstant();
+  if (constant != nullptr && vixl::Assembler::IsImmAddSub(constant->GetValue())) {
+    return Location::ConstantLocation(constant);
+  }
+  return Location::RequiresRegister();
+}
+
+void IntrinsicLocationsBuilderARM64::VisitSystemArrayCopyChar(HInvoke* invoke) {
+  // Check to see if we have known failures that will cause us to have to bail out
+  // to the runtime, and just generate the runtime call directly.
+  HIntConstant* src_pos = invoke->InputAt(1)->AsIntConstant();
+  HIntConstant* dest_pos = invoke->InputAt(3)->AsIntConstant();
+
+  // The positions must be non-negative.
+  if ((src_pos != nullptr && src_pos->GetValue() < 0) ||
+      (dest_pos != nullptr && dest_pos->GetValue() < 0)) {
+    // We will have to fail anyways.
+    return;
+  }
+
+  // The length must be >= 0.
+  HIntConstant* length = invoke->InputAt(4)->AsIntConstant();
+  if (length != nullptr && length->GetValue() < 0) {
+    // Just call as normal.
+    return;
+  }
+
+  LocationSummary* locations = new (arena_) LocationSummary(invoke,
+                                                            LocationSummary::kCallOnSlowPath,
+                                                            kIntrinsified);
+  // arraycopy(char[] src, int src_pos, char[] dest, int dest_pos, int length).
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, LocationForSystemArrayCopyInput(invoke->InputAt(1)));
+  locations->SetInAt(2, Location::RequiresRegister());
+  locations->SetInAt(3, LocationForSystemArrayCopyInput(invoke->InputAt(3)));
+  locations->SetInAt(4, LocationForSystemArrayCopyInput(invoke->InputAt(4)));
+
+  // Current source address, current destination address and end source address.
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+}
+
+static void CheckSystemArrayCopyPosition(vixl::MacroAssembler* masm,
+                                         const Location& pos,
+                                         const Register& input,
+                                         const Location& length,
+                                         SlowPathCodeARM64* slow_path,
+                                         const Register& input_len,
+                                         const Register& temp,
+                                         bool length_is_input_length = false) {
+  // Where is the length in the Array?
+  const int32_t length_offset = mirror::Array::LengthOffset().Int32Value();
+
+  if (pos.IsConstant()) {
+    int32_t pos_const = pos.GetConstant()->AsIntConstant()->GetValue();
+    if (pos_const == 0) {
+      if (!length_is_input_length) {
+        // Check that length(input) >= length.
+        __ Ldr(temp, MemOperand(input.X(), length_offset));
+        __ Cmp(temp, OperandFrom(length, Primitive::kPrimInt));
+        __ B(slow_path->GetEntryLabel(), lt);
+      }
+    } else {
+      // Check that length(input) >= pos.
+      __ Ldr(input_len, MemOperand(input.X(), length_offset));
+      __ Subs(temp, input_len, pos_const);
+      __ B(slow_path->GetEntryLabel(), lt);
+
+      // Check that (length(input) - pos) >= length.
+      __ Cmp(temp, OperandFrom(length, Primitive::kPrimInt));
+      __ B(slow_path->GetEntryLabel(), lt);
+    }
+  } else if (length_is_input_length) {
+    // The only way the copy can succeed is if pos is zero.
+    __ Cbnz(WRegisterFrom(pos), slow_path->GetEntryLabel());
+  } else {
+    // Check that pos >= 0.
+    Register pos_reg = WRegisterFrom(pos);
+    __ Tbnz(pos_reg, pos_reg.size() - 1, slow_path->GetEntryLabel());
+
+    // Check that pos <= length(input).
+    __ Ldr(temp, MemOperand(input.X(), length_offset));
+    __ Subs(temp, temp, pos_reg);
+    __ B(slow_path->GetEntryLabel(), lt);
+
+    // Check that (length(input) - pos) >= length.
+    __ Cmp(temp, OperandFrom(length, Primitive::kPrimInt));
+    __ B(slow_path->GetEntryLabel(), lt);
+  }
+}
+
+// Computes the address of the first source element, the address of the first destination
+// element, and the address past the last source element of a copy of `type` elements.
+static void GenSystemArrayCopyAddresses(vixl::MacroAssembler* masm,
+                                        Primitive::Type type,
+                                        const Register& src,
+                                        const Location& src_pos,
+                                        const Register& dest,
+                                        const Location& dest_pos,
+                                        const Location& length,
+                                        const Register& src_base,
+                                        const Register& dest_base,
+                                        const Register& src_end) {
+  const int32_t element_size = Primitive::ComponentSize(type);
+  const size_t element_size_shift = Primitive::ComponentSizeShift(type);
+  const int32_t data_offset = mirror::Array::DataOffset(element_size).Int32Value();
+
+  if (src_pos.IsConstant()) {
+    int32_t constant = src_pos.GetConstant()->AsIntConstant()->GetValue();
+    __ Add(src_base, src.X(), element_size * constant + data_offset);
+  } else {
+    __ Add(src_base, src.X(), data_offset);
+    __ Add(src_base, src_base, Operand(WRegisterFrom(src_pos), UXTW, element_size_shift));
+  }
+
+  if (dest_pos.IsConstant()) {
+    int32_t constant = dest_pos.GetConstant()->AsIntConstant()->GetValue();
+    __ Add(dest_base, dest.X(), element_size * constant + data_offset);
+  } else {
+    __ Add(dest_base, dest.X(), data_offset);
+    __ Add(dest_base, dest_base, Operand(WRegisterFrom(dest_pos), UXTW, element_size_shift));
+  }
+
+  if (length.IsConstant()) {
+    int32_t constant = length.GetConstant()->AsIntConstant()->GetValue();
+    __ Add(src_end, src_base, element_size * constant);
+  } else {
+    __ Add(src_end, src_base, Operand(WRegisterFrom(length), UXTW, element_size_shift));
+  }
+}
+
+// Copies the elements between `src_curr_addr` and `src_stop_addr` to `dest_curr_addr`, eight
+// bytes at a time and then one element at a time. The copy goes forward, so it is only correct
+// for overlapping ranges if the destination does not start after the source. References are
+// moved as pairs of 32-bit words, so that each of them is still accessed atomically. All three
+// address registers are clobbered.
+static void GenSystemArrayCopyLoop(vixl::MacroAssembler* masm,
+                                   Primitive::Type type,
+                                   const Register& src_curr_addr,
+                                   const Register& dest_curr_addr,
+                                   const Register& src_stop_addr) {
+  const int32_t element_size = Primitive::ComponentSize(type);
+  const int32_t chunk_size = 2 * sizeof(int32_t);
+  DCHECK(type == Primitive::kPrimChar || type == Primitive::kPrimNot);
+
+  UseScratchRegisterScope temps(masm);
+  Register tmp1 = temps.AcquireX();
+  Register tmp2 = temps.AcquireX();
+
+  vixl::Label chunk_loop;
+  vixl::Label element_loop;
+  vixl::Label element_loop_check;
+  vixl::Label done;
+
+  // Copy whole chunks while at least `chunk_size` bytes remain.
+  __ Sub(src_stop_addr, src_stop_addr, chunk_size);
+  __ Cmp(src_curr_addr, src_stop_addr);
+  __ B(&element_loop_check, hi);
+  __ Bind(&chunk_loop);
+  if (type == Primitive::kPrimNot) {
+    __ Ldp(tmp1.W(), tmp2.W(), MemOperand(src_curr_addr, chunk_size, PostIndex));
+    __ Stp(tmp1.W(), tmp2.W(), MemOperand(dest_curr_addr, chunk_size, PostIndex));
+  } else {
+    __ Ldr(tmp1, MemOperand(src_curr_addr, chunk_size, PostIndex));
+    __ Str(tmp1, MemOperand(dest_curr_addr, chunk_size, PostIndex));
+  }
+  __ Cmp(src_curr_addr, src_stop_addr);
+  __ B(&chunk_loop, ls);
+
+  // Copy the remaining elements one at a time.
+  __ Bind(&element_loop_check);
+  __ Add(src_stop_addr, src_stop_addr, chunk_size);
+  __ Cmp(src_curr_addr, src_stop_addr);
+  __ B(&done, eq);
+  __ Bind(&element_loop);
+  if (type == Primitive::kPrimNot) {
+    __ Ldr(tmp1.W(), MemOperand(src_curr_addr, element_size, PostIndex));
+    __ Str(tmp1.W(), MemOperand(dest_curr_addr, element_size, PostIndex));
+  } else {
+    __ Ldrh(tmp1.W(), MemOperand(src_curr_addr, element_size, PostIndex));
+    __ Strh(tmp1.W(), MemOperand(dest_curr_addr, element_size, PostIndex));
+  }
+  __ Cmp(src_curr_addr, src_stop_addr);
+  __ B(&element_loop, ne);
+  __ Bind(&done);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopyChar(HInvoke* invoke) {
+  vixl::MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Register src = WRegisterFrom(locations->InAt(0));
+  Location src_pos = locations->InAt(1);
+  Register dest = WRegisterFrom(locations->InAt(2));
+  Location dest_pos = locations->InAt(3);
+  Location length = locations->InAt(4);
+  Register src_curr_addr = XRegisterFrom(locations->GetTemp(0));
+  Register dest_curr_addr = XRegisterFrom(locations->GetTemp(1));
+  Register src_stop_addr = XRegisterFrom(locations->GetTemp(2));
+
+  SlowPathCodeARM64* slow_path = new (GetAllocator()) IntrinsicSlowPathARM64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  // If source and destination are the same, we go to slow path if we need to do
+  // forward copying.
+  vixl::Label ok;
+  __ Cmp(src, dest);
+  __ B(&ok, ne);
+  if (src_pos.IsConstant()) {
+    int32_t src_pos_constant = src_pos.GetConstant()->AsIntConstant()->GetValue();
+    if (dest_pos.IsConstant()) {
+      if (src_pos_constant < dest_pos.GetConstant()->AsIntConstant()->GetValue()) {
+        __ B(slow_path->GetEntryLabel());
+      }
+    } else {
+      __ Cmp(WRegisterFrom(dest_pos), src_pos_constant);
+      __ B(slow_path->GetEntryLabel(), gt);
+    }
+  } else {
+    __ Cmp(WRegisterFrom(src_pos), OperandFrom(dest_pos, Primitive::kPrimInt));
+    __ B(slow_path->GetEntryLabel(), lt);
+  }
+  __ Bind(&ok);
+
+  // Bail out if the source is null.
+  __ Cbz(src, slow_path->GetEntryLabel());
+
+  // Bail out if the destination is null.
+  __ Cbz(dest, slow_path->GetEntryLabel());
+
+  // If the length is negative, bail out.
+  // We have already checked in the LocationsBuilder for the constant case.
+  if (!length.IsConstant()) {
+    Register length_reg = WRegisterFrom(length);
+    __ Tbnz(length_reg, length_reg.size() - 1, slow_path->GetEntryLabel());
+  }
+
+  // Validity checks: source.
+  CheckSystemArrayCopyPosition(masm,
+                               src_pos,
+                               src,
+                               length,
+                               slow_path,
+                               src_curr_addr.W(),
+                               dest_curr_addr.W());
+
+  // Validity checks: dest.
+  CheckSystemArrayCopyPosition(masm,
+                               dest_pos,
+                               dest,
+                               length,
+                               slow_path,
+                               src_curr_addr.W(),
+                               dest_curr_addr.W());
+
+  GenSystemArrayCopyAddresses(masm,
+                              Primitive::kPrimChar,
+                              src,
+                              src_pos,
+                              dest,
+                              dest_pos,
+                              length,
+                              src_curr_addr,
+                              dest_curr_addr,
+                              src_stop_addr);
+
+  GenSystemArrayCopyLoop(masm, Primitive::kPrimChar, src_curr_addr, dest_curr_addr, src_stop_addr);
+
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitSystemArrayCopy(HInvoke* invoke) {
+  CodeGenerator::CreateSystemArrayCopyLocationSummary(invoke);
+  LocationSummary* locations = invoke->GetLocations();
+  if (locations == nullptr) {
+    return;
+  }
+
+  locations->SetInAt(1, LocationForSystemArrayCopyInput(invoke->InputAt(1)));
+  locations->SetInAt(3, LocationForSystemArrayCopyInput(invoke->InputAt(3)));
+  locations->SetInAt(4, LocationForSystemArrayCopyInput(invoke->InputAt(4)));
+}
+
+void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopy(HInvoke* invoke) {
+  vixl::MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  const int32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+  const int32_t super_offset = mirror::Class::SuperClassOffset().Int32Value();
+  const int32_t component_offset = mirror::Class::ComponentTypeOffset().Int32Value();
+  const int32_t primitive_offset = mirror::Class::PrimitiveTypeOffset().Int32Value();
+
+  Register src = WRegisterFrom(locations->InAt(0));
+  Location src_pos = locations->InAt(1);
+  Register dest = WRegisterFrom(locations->InAt(2));
+  Location dest_pos = locations->InAt(3);
+  Location length = locations->InAt(4);
+  Register temp1 = WRegisterFrom(locations->GetTemp(0));
+  Register temp2 = WRegisterFrom(locations->GetTemp(1));
+  Register temp3 = WRegisterFrom(locations->GetTemp(2));
+  Arm64Assembler* assembler = codegen_->GetAssembler();
+
+  SlowPathCodeARM64* slow_path = new (GetAllocator()) IntrinsicSlowPathARM64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  vixl::Label ok;
+  SystemArrayCopyOptimizations optimizations(invoke);
+
+  if (!optimizations.GetDestinationIsSource()) {
+    if (!src_pos.IsConstant() || !dest_pos.IsConstant()) {
+      __ Cmp(src, dest);
+    }
+  }
+
+  // If source and destination are the same, we go to slow path if we need to do
+  // forward copying.
+  if (src_pos.IsConstant()) {
+    int32_t src_pos_constant = src_pos.GetConstant()->AsIntConstant()->GetValue();
+    if (dest_pos.IsConstant()) {
+      int32_t dest_pos_constant = dest_pos.GetConstant()->AsIntConstant()->GetValue();
+      if (optimizations.GetDestinationIsSource()) {
+        // Checked when building locations.
+        DCHECK_GE(src_pos_constant, dest_pos_constant);
+      } else if (src_pos_constant < dest_pos_constant) {
+        // The arrays may still be the same at runtime.
+        __ Cmp(src, dest);
+        __ B(slow_path->GetEntryLabel(), eq);
+      }
+    } else {
+      if (!optimizations.GetDestinationIsSource()) {
+        __ B(&ok, ne);
+      }
+      __ Cmp(WRegisterFrom(dest_pos), src_pos_constant);
+      __ B(slow_path->GetEntryLabel(), gt);
+    }
+  } else {
+    if (!optimizations.GetDestinationIsSource()) {
+      __ B(&ok, ne);
+    }
+    __ Cmp(WRegisterFrom(src_pos), OperandFrom(dest_pos, Primitive::kPrimInt));
+    __ B(slow_path->GetEntryLabel(), lt);
+  }
+
+  __ Bind(&ok);
+
+  if (!optimizations.GetSourceIsNotNull()) {
+    // Bail out if the source is null.
+    __ Cbz(src, slow_path->GetEntryLabel());
+  }
+
+  if (!optimizations.GetDestinationIsNotNull() && !optimizations.GetDestinationIsSource()) {
+    // Bail out if the destination is null.
+    __ Cbz(dest, slow_path->GetEntryLabel());
+  }
+
+  // If the length is negative, bail out.
+  // We have already checked in the LocationsBuilder for the constant case.
+  if (!length.IsConstant() &&
+      !optimizations.GetCountIsSourceLength() &&
+      !optimizations.GetCountIsDestinationLength()) {
+    Register length_reg = WRegisterFrom(length);
+    __ Tbnz(length_reg, length_reg.size() - 1, slow_path->GetEntryLabel());
+  }
+
+  // Validity checks: source.
+  CheckSystemArrayCopyPosition(masm,
+                               src_pos,
+                               src,
+                               length,
+                               slow_path,
+                               temp1,
+                               temp2,
+                               optimizations.GetCountIsSourceLength());
+
+  // Validity checks: dest.
+  CheckSystemArrayCopyPosition(masm,
+                               dest_pos,
+                               dest,
+                               length,
+                               slow_path,
+                               temp1,
+                               temp2,
+                               optimizations.GetCountIsDestinationLength());
+
+  if (!optimizations.GetDoesNotNeedTypeCheck()) {
+    // Check whether all elements of the source array are assignable to the component
+    // type of the destination array. We do two checks: the classes are the same,
+    // or the destination is Object[]. If none of these checks succeed, we go to the
+    // slow path. In both cases the elements are copied without checking them.
+    __ Ldr(temp1, MemOperand(dest.X(), class_offset));
+    __ Ldr(temp2, MemOperand(src.X(), class_offset));
+    bool did_unpoison = false;
+    if (!optimizations.GetDestinationIsNonPrimitiveArray() ||
+        !optimizations.GetSourceIsNonPrimitiveArray()) {
+      // One or two of the references need to be unpoisoned. Unpoison them
+      // both to make the identity check valid.
+      assembler->MaybeUnpoisonHeapReference(temp1);
+      assembler->MaybeUnpoisonHeapReference(temp2);
+      did_unpoison = true;
+    }
+
+    if (!optimizations.GetDestinationIsNonPrimitiveArray()) {
+      // Bail out if the destination is not a non primitive array.
+      __ Ldr(temp3, HeapOperand(temp1, component_offset));
+      __ Cbz(temp3, slow_path->GetEntryLabel());
+      assembler->MaybeUnpoisonHeapReference(temp3);
+      __ Ldrh(temp3, HeapOperand(temp3, primitive_offset));
+      static_assert(Primitive::kPrimNot == 0, "Expected 0 for kPrimNot");
+      __ Cbnz(temp3, slow_path->GetEntryLabel());
+    }
+
+    if (!optimizations.GetSourceIsNonPrimitiveArray()) {
+      // Bail out if the source is not a non primitive array.
+      __ Ldr(temp3, HeapOperand(temp2, component_offset));
+      __ Cbz(temp3, slow_path->GetEntryLabel());
+      assembler->MaybeUnpoisonHeapReference(temp3);
+      __ Ldrh(temp3, HeapOperand(temp3, primitive_offset));
+      static_assert(Primitive::kPrimNot == 0, "Expected 0 for kPrimNot");
+      __ Cbnz(temp3, slow_path->GetEntryLabel());
+    }
+
+    __ Cmp(temp1, temp2);
+
+    if (optimizations.GetDestinationIsTypedObjectArray()) {
+      vixl::Label do_copy;
+      __ B(&do_copy, eq);
+      if (!did_unpoison) {
+        assembler->MaybeUnpoisonHeapReference(temp1);
+      }
+      __ Ldr(temp1, HeapOperand(temp1, component_offset));
+      assembler->MaybeUnpoisonHeapReference(temp1);
+      __ Ldr(temp1, HeapOperand(temp1, super_offset));
+      // No need to unpoison the result, we're comparing against null.
+      __ Cbnz(temp1, slow_path->GetEntryLabel());
+      __ Bind(&do_copy);
+    } else {
+      __ B(slow_path->GetEntryLabel(), ne);
+    }
+  } else if (!optimizations.GetSourceIsNonPrimitiveArray()) {
+    DCHECK(optimizations.GetDestinationIsNonPrimitiveArray());
+    // Bail out if the source is not a non primitive array.
+    __ Ldr(temp1, MemOperand(src.X(), class_offset));
+    assembler->MaybeUnpoisonHeapReference(temp1);
+    __ Ldr(temp3, HeapOperand(temp1, component_offset));
+    __ Cbz(temp3, slow_path->GetEntryLabel());
+    assembler->MaybeUnpoisonHeapReference(temp3);
+    __ Ldrh(temp3, HeapOperand(temp3, primitive_offset));
+    static_assert(Primitive::kPrimNot == 0, "Expected 0 for kPrimNot");
+    __ Cbnz(temp3, slow_path->GetEntryLabel());
+  }
+
+  GenSystemArrayCopyAddresses(masm,
+                              Primitive::kPrimNot,
+                              src,
+                              src_pos,
+                              dest,
+                              dest_pos,
+                              length,
+                              temp1.X(),
+                              temp2.X(),
+                              temp3.X());
+
+  // Iterate over the arrays and do a raw copy of the objects. We don't need to
+  // poison/unpoison, nor do any read barrier as the next uses of the destination
+  // array will do it.
+  GenSystemArrayCopyLoop(masm, Primitive::kPrimNot, temp1.X(), temp2.X(), temp3.X());
+
+  // We only need one card marking on the destination array: the card of the array
+  // object covers all of its elements for the GC.
+  codegen_->MarkGCCard(dest, NoReg, /* value_can_be_null */ false);
+
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitStringGetCharsNoCheck(HInvoke* invoke) {
+  // public void getChars(int srcBegin, int srcEnd, char[] dst, int dstBegin);
+  LocationSummary* locations = new (arena_) LocationSummary(invoke,
+                                                            LocationSummary::kNoCall,
+                                                            kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, LocationForSystemArrayCopyInput(invoke->InputAt(1)));
+  locations->SetInAt(2, Location::RequiresRegister());
+  locations->SetInAt(3, Location::RequiresRegister());
+  locations->SetInAt(4, Location::RequiresRegister());
+
+  // Current source address, current destination address and end source address.
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+}
+
+void IntrinsicCodeGeneratorARM64::VisitStringGetCharsNoCheck(HInvoke* invoke) {
+  vixl::MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  const size_t char_size = Primitive::ComponentSize(Primitive::kPrimChar);
+  DCHECK_EQ(char_size, 2u);
+  // Location of data in char array buffer.
+  const int32_t data_offset = mirror::Array::DataOffset(char_size).Int32Value();
+  // Location of char array data in string.
+  const int32_t value_offset = mirror::String::ValueOffset().Int32Value();
+
+  // public void getChars(int srcBegin, int srcEnd, char[] dst, int dstBegin);
+  Register obj = WRegisterFrom(locations->InAt(0));
+  Location srcBegin = locations->InAt(1);
+  Register srcEnd = WRegisterFrom(locations->InAt(2));
+  Register dst = WRegisterFrom(locations->InAt(3));
+  Register dstBegin = WRegisterFrom(locations->InAt(4));
+  Register src_curr_addr = XRegisterFrom(locations->GetTemp(0));
+  Register dst_curr_addr = XRegisterFrom(locations->GetTemp(1));
+  Register src_stop_addr = XRegisterFrom(locations->GetTemp(2));
+
+  // Compute the address of the source string and the number of chars to move.
+  if (srcBegin.IsConstant()) {
+    int32_t srcBegin_value = srcBegin.GetConstant()->AsIntConstant()->GetValue();
+    __ Add(src_curr_addr, obj.X(), value_offset + srcBegin_value * char_size);
+    __ Sub(src_stop_addr.W(), srcEnd, srcBegin_value);
+  } else {
+    __ Add(src_curr_addr, obj.X(), value_offset);
+    __ Add(src_curr_addr, src_curr_addr, Operand(WRegisterFrom(srcBegin), UXTW, 1));
+    __ Sub(src_stop_addr.W(), srcEnd, WRegisterFrom(srcBegin));
+  }
+
+  // Compute the end of the source chars.
+  __ Add(src_stop_addr, src_curr_addr, Operand(src_stop_addr.W(), UXTW, 1));
+
+  // Compute the address of the destination buffer.
+  __ Add(dst_curr_addr, dst.X(), data_offset);
+  __ Add(dst_curr_addr, dst_curr_addr, Operand(dstBegin, UXTW, 1));
+
+  GenSystemArrayCopyLoop(masm, Primitive::kPrimChar, src_curr_addr, dst_curr_addr, src_stop_addr);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitReferenceGetReferent(HInvoke* invoke) {
+  // IntrinsicsRecognizer only recognizes the intrinsic when java.lang.ref.Reference is
+  // initialized, so the offsets of its static flags are known.
+  LocationSummary* locations = new (arena_) LocationSummary(invoke,
+                                                            LocationSummary::kCallOnSlowPath,
+                                                            kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister());
+  // The ArtMethod* of Reference.get(), then its declaring class.
+  locations->AddTemp(Location::RequiresRegister());
+}
+
+void IntrinsicCodeGeneratorARM64::VisitReferenceGetReferent(HInvoke* invoke) {
+  vixl::MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Register obj = WRegisterFrom(locations->InAt(0));
+  Register out = WRegisterFrom(locations->Out());
+
+  const uint32_t disable_flag_offset = CompilerDriver::GetReferenceDisableFlagOffset();
+  const uint32_t slow_path_flag_offset = CompilerDriver::GetReferenceSlowFlagOffset();
+
+  SlowPathCodeARM64* slow_path = new (GetAllocator()) IntrinsicSlowPathARM64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  // Note that the null check must have been done earlier.
+  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+
+  // Load the callee, then its declaring class, which is java.lang.ref.Reference.
+  HInvokeStaticOrDirect* invoke_direct = invoke->AsInvokeStaticOrDirect();
+  DCHECK(invoke_direct != nullptr);
+  Register temp = XRegisterFrom(
+      codegen_->GenerateCalleeMethodStaticOrDirectCall(invoke_direct, locations->GetTemp(0)));
+  __ Ldr(temp.W(), MemOperand(temp, ArtMethod::DeclaringClassOffset().Int32Value()));
+
+  // Take the slow path if the intrinsic is disabled, or if the GC needs the referent to be
+  // read through the runtime, e.g. while it is processing references.
+  UseScratchRegisterScope temps(masm);
+  Register flag = temps.AcquireW();
+  __ Ldrb(flag, MemOperand(temp, disable_flag_offset));
+  __ Ldrb(temp.W(), MemOperand(temp, slow_path_flag_offset));
+  __ Orr(flag, flag, temp.W());
+  __ Cbnz(flag, slow_path->GetEntryLabel());
+
+  // Fast path.
+  __ Ldr(out, HeapOperand(obj, mirror::Reference::ReferentOffset().Int32Value()));
+  codegen_->GetAssembler()->MaybeUnpoisonHeapReference(out);
+  __ Bind(slow_path->GetExitLabel());
+}
+
+static void GenBitCount(HInvoke* invoke, Primitive::Type type, vixl::MacroAssembler* masm) {
+  DCHECK(type == Primitive::kPrimInt || type == Primitive::kPrimLong);
+  LocationSummary* locations = invoke->GetLocations();
+
+  UseScratchRegisterScope temps(masm);
+  Register src = RegisterFrom(locations->InAt(0), type);
+  Register dst = RegisterFrom(locations->Out(), type);
+  FPRegister fpr = (type == Primitive::kPrimLong) ? temps.AcquireD() : temps.AcquireS();
+
+  // Count the bits of each byte with CNT, and sum the byte counts with ADDV.
+  __ Fmov(fpr, src);
+  __ Cnt(fpr.V8B(), fpr.V8B());
+  __ Addv(fpr.B(), fpr.V8B());
+  __ Fmov(dst, fpr);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitIntegerBitCount(HInvoke* invoke) {
+  CreateIntToIntLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitIntegerBitCount(HInvoke* invoke) {
+  GenBitCount(invoke, Primitive::kPrimInt, GetVIXLAssembler());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitLongBitCount(HInvoke* invoke) {
+  CreateIntToIntLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitLongBitCount(HInvoke* invoke) {
+  GenBitCount(invoke, Primitive::kPrimLong, GetVIXLAssembler());
+}
+
+static void GenHighestOneBit(LocationSummary* locations,
+                             Primitive::Type type,
+                             vixl::MacroAssembler* masm) {
+  DCHECK(type == Primitive::kPrimInt || type == Primitive::kPrimLong);
+
+  UseScratchRegisterScope temps(masm);
+  Register src = RegisterFrom(locations->InAt(0), type);
+  Register dst = RegisterFrom(locations->Out(), type);
+  Register temp = temps.AcquireSameSizeAs(src);
+  size_t high_bit = (type == Primitive::kPrimLong) ? 63u : 31u;
+  size_t clz_high_bit = (type == Primitive::kPrimLong) ? 6u : 5u;
+
+  __ Clz(temp, src);
+  __ Mov(dst, UINT64_C(1) << high_bit);
+  // CLZ only returns the register size, with its high bit set, for a zero input.
+  // Moving that bit to the top clears the result.
+  __ Bic(dst, dst, Operand(temp, LSL, high_bit - clz_high_bit));
+  __ Lsr(dst, dst, temp);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitIntegerHighestOneBit(HInvoke* invoke) {
+  CreateIntToIntLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitIntegerHighestOneBit(HInvoke* invoke) {
+  GenHighestOneBit(invoke->GetLocations(), Primitive::kPrimInt, GetVIXLAssembler());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitLongHighestOneBit(HInvoke* invoke) {
+  CreateIntToIntLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitLongHighestOneBit(HInvoke* invoke) {
+  GenHighestOneBit(invoke->GetLocations(), Primitive::kPrimLong, GetVIXLAssembler());
+}
+
+static void GenLowestOneBit(LocationSummary* locations,
+                            Primitive::Type type,
+                            vixl::MacroAssembler* masm) {
+  DCHECK(type == Primitive::kPrimInt || type == Primitive::kPrimLong);
+
+  UseScratchRegisterScope temps(masm);
+  Register src = RegisterFrom(locations->InAt(0), type);
+  Register dst = RegisterFrom(locations->Out(), type);
+  Register temp = temps.AcquireSameSizeAs(src);
+
+  __ Neg(temp, src);
+  __ And(dst, temp, src);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitIntegerLowestOneBit(HInvoke* invoke) {
+  CreateIntToIntLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitIntegerLowestOneBit(HInvoke* invoke) {
+  GenLowestOneBit(invoke->GetLocations(), Primitive::kPrimInt, GetVIXLAssembler());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitLongLowestOneBit(HInvoke* invoke) {
+  CreateIntToIntLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitLongLowestOneBit(HInvoke* invoke) {
+  GenLowestOneBit(invoke->GetLocations(), Primitive::kPrimLong, GetVIXLAssembler());
+}
+
+// Computes Integer/Long.compare(x, y), or Integer/Long.signum(x) when the invoke
+// has a single argument.
+static void GenCompare(HInvoke* invoke, Primitive::Type type, vixl::MacroAssembler* masm) {
+  DCHECK(type == Primitive::kPrimInt || type == Primitive::kPrimLong);
+  LocationSummary* locations = invoke->GetLocations();
+  Register first = RegisterFrom(locations->InAt(0), type);
+  Register out = WRegisterFrom(locations->Out());
+
+  if (invoke->GetNumberOfArguments() == 1) {
+    __ Cmp(first, 0);
+  } else {
+    __ Cmp(first, RegisterFrom(locations->InAt(1), type));
+  }
+  __ Cset(out, ne);        // out = (first != second) ? 1 : 0
+  __ Cneg(out, out, lt);   // out = (first < second) ? -out : out
+}
+
+void IntrinsicLocationsBuilderARM64::VisitIntegerCompare(HInvoke* invoke) {
+  CreateIntIntToIntLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitIntegerCompare(HInvoke* invoke) {
+  GenCompare(invoke, Primitive::kPrimInt, GetVIXLAssembler());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitLongCompare(HInvoke* invoke) {
+  CreateIntIntToIntLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitLongCompare(HInvoke* invoke) {
+  GenCompare(invoke, Primitive::kPrimLong, GetVIXLAssembler());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitIntegerSignum(HInvoke* invoke) {
+  CreateIntToIntLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitIntegerSignum(HInvoke* invoke) {
+  GenCompare(invoke, Primitive::kPrimInt, GetVIXLAssembler());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitLongSignum(HInvoke* invoke) {
+  CreateIntToIntLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitLongSignum(HInvoke* invoke) {
+  GenCompare(invoke, Primitive::kPrimLong, GetVIXLAssembler());
+}
+
 // Unimplemented intrinsics.
 
 #define UNIMPLEMENTED_INTRINSIC(Name)                                                  \
@@ -1458,11 +2497,6 @@ void IntrinsicLocationsBuilderARM64::Visit ## Name(HInvoke* invoke ATTRIBUTE_UNU
 void IntrinsicCodeGeneratorARM64::Visit ## Name(HInvoke* invoke ATTRIBUTE_UNUSED) {    \
 }
 
-UNIMPLEMENTED_INTRINSIC(SystemArrayCopyChar)
-UNIMPLEMENTED_INTRINSIC(SystemArrayCopy)
-UNIMPLEMENTED_INTRINSIC(ReferenceGetReferent)
-UNIMPLEMENTED_INTRINSIC(StringGetCharsNoCheck)
-
 #undef UNIMPLEMENTED_INTRINSIC
 
 #undef __
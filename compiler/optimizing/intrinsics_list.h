@@ -26,18 +26,28 @@
   V(DoubleLongBitsToDouble, kStatic, kNeedsEnvironmentOrCache) \
   V(FloatFloatToRawIntBits, kStatic, kNeedsEnvironmentOrCache) \
   V(FloatIntBitsToFloat, kStatic, kNeedsEnvironmentOrCache) \
+  V(IntegerBitCount, kStatic, kNeedsEnvironmentOrCache) \
+  V(IntegerCompare, kStatic, kNeedsEnvironmentOrCache) \
+  V(IntegerHighestOneBit, kStatic, kNeedsEnvironmentOrCache) \
+  V(IntegerLowestOneBit, kStatic, kNeedsEnvironmentOrCache) \
   V(IntegerReverse, kStatic, kNeedsEnvironmentOrCache) \
   V(IntegerReverseBytes, kStatic, kNeedsEnvironmentOrCache) \
   V(IntegerNumberOfLeadingZeros, kStatic, kNeedsEnvironmentOrCache) \
   V(IntegerNumberOfTrailingZeros, kStatic, kNeedsEnvironmentOrCache) \
   V(IntegerRotateRight, kStatic, kNeedsEnvironmentOrCache) \
   V(IntegerRotateLeft, kStatic, kNeedsEnvironmentOrCache) \
+  V(IntegerSignum, kStatic, kNeedsEnvironmentOrCache) \
+  V(LongBitCount, kStatic, kNeedsEnvironmentOrCache) \
+  V(LongCompare, kStatic, kNeedsEnvironmentOrCache) \
+  V(LongHighestOneBit, kStatic, kNeedsEnvironmentOrCache) \
+  V(LongLowestOneBit, kStatic, kNeedsEnvironmentOrCache) \
   V(LongReverse, kStatic, kNeedsEnvironmentOrCache) \
   V(LongReverseBytes, kStatic, kNeedsEnvironmentOrCache) \
   V(LongNumberOfLeadingZeros, kStatic, kNeedsEnvironmentOrCache) \
   V(LongNumberOfTrailingZeros, kStatic, kNeedsEnvironmentOrCache) \
   V(LongRotateRight, kStatic, kNeedsEnvironmentOrCache) \
   V(LongRotateLeft, kStatic, kNeedsEnvironmentOrCache) \
+  V(LongSignum, kStatic, kNeedsEnvironmentOrCache) \
   V(ShortReverseBytes, kStatic, kNeedsEnvironmentOrCache) \
   V(MathAbsDouble, kStatic, kNeedsEnvironmentOrCache) \
   V(MathAbsFloat, kStatic, kNeedsEnvironmentOrCache) \
@@ -51,6 +61,14 @@
   V(MathMaxFloatFloat, kStatic, kNeedsEnvironmentOrCache) \
   V(MathMaxLongLong, kStatic, kNeedsEnvironmentOrCache) \
   V(MathMaxIntInt, kStatic, kNeedsEnvironmentOrCache) \
+  V(MathCos, kStatic, kNeedsEnvironmentOrCache) \
+  V(MathSin, kStatic, kNeedsEnvironmentOrCache) \
+  V(MathTan, kStatic, kNeedsEnvironmentOrCache) \
+  V(MathAtan2, kStatic, kNeedsEnvironmentOrCache) \
+  V(MathExp, kStatic, kNeedsEnvironmentOrCache) \
+  V(MathLog, kStatic, kNeedsEnvironmentOrCache) \
+  V(MathPow, kStatic, kNeedsEnvironmentOrCache) \
+  V(MathHypot, kStatic, kNeedsEnvironmentOrCache) \
   V(MathSqrt, kStatic, kNeedsEnvironmentOrCache) \
   V(MathCeil, kStatic, kNeedsEnvironmentOrCache) \
   V(MathFloor, kStatic, kNeedsEnvironmentOrCache) \
@@ -70,10 +88,13 @@
   V(MemoryPokeShortNative, kStatic, kNeedsEnvironmentOrCache) \
   V(StringCharAt, kDirect, kNeedsEnvironmentOrCache) \
   V(StringCompareTo, kDirect, kNeedsEnvironmentOrCache) \
+  V(StringContentEquals, kDirect, kNeedsEnvironmentOrCache) \
   V(StringEquals, kDirect, kNeedsEnvironmentOrCache) \
   V(StringGetCharsNoCheck, kDirect, kNeedsEnvironmentOrCache) \
+  V(StringHashCode, kDirect, kNeedsEnvironmentOrCache) \
   V(StringIndexOf, kDirect, kNeedsEnvironmentOrCache) \
   V(StringIndexOfAfter, kDirect, kNeedsEnvironmentOrCache) \
+  V(StringIndexOfString, kDirect, kNeedsEnvironmentOrCache) \
   V(StringNewStringFromBytes, kStatic, kNeedsEnvironmentOrCache) \
   V(StringNewStringFromChars, kStatic, kNeedsEnvironmentOrCache) \
   V(StringNewStringFromString, kStatic, kNeedsEnvironmentOrCache) \
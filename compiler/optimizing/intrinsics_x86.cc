@@ -2296,6 +2296,228 @@ void IntrinsicCodeGeneratorX86::VisitIntegerRotateRight(HInvoke* invoke) {
   GenRotate(assembler, invoke, /* is_left */ false);
 }
 
+static void CreateBitCountLocations(
+    ArenaAllocator* arena, CodeGeneratorX86* codegen, HInvoke* invoke, bool is_long) {
+  if (!codegen->GetInstructionSetFeatures().HasPopCnt()) {
+    // Do nothing if there is no popcnt support. This results in generating
+    // a call for the intrinsic rather than direct code.
+    return;
+  }
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kNoCall,
+                                                           kIntrinsified);
+  if (is_long) {
+    locations->SetInAt(0, Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+  } else {
+    locations->SetInAt(0, Location::Any());
+  }
+  locations->SetOut(Location::RequiresRegister());
+}
+
+static void GenBitCount(X86Assembler* assembler, HInvoke* invoke, bool is_long) {
+  LocationSummary* locations = invoke->GetLocations();
+  Location src = locations->InAt(0);
+  Register out = locations->Out().AsRegister<Register>();
+
+  if (invoke->InputAt(0)->IsConstant()) {
+    // Evaluate this at compile time.
+    int64_t value = Int64FromConstant(invoke->InputAt(0)->AsConstant());
+    value = is_long
+        ? POPCOUNT(static_cast<uint64_t>(value))
+        : POPCOUNT(static_cast<uint32_t>(value));
+    if (value == 0) {
+      __ xorl(out, out);
+    } else {
+      __ movl(out, Immediate(value));
+    }
+    return;
+  }
+
+  // Handle the non-constant cases.
+  if (!is_long) {
+    if (src.IsRegister()) {
+      __ popcntl(out, src.AsRegister<Register>());
+    } else {
+      DCHECK(src.IsStackSlot());
+      __ popcntl(out, Address(ESP, src.GetStackIndex()));
+    }
+    return;
+  }
+
+  // The 64-bit case needs to add the counts of both halves.
+  DCHECK(src.IsRegisterPair());
+  Register temp = locations->GetTemp(0).AsRegister<Register>();
+  __ popcntl(temp, src.AsRegisterPairLow<Register>());
+  __ popcntl(out, src.AsRegisterPairHigh<Register>());
+  __ addl(out, temp);
+}
+
+void IntrinsicLocationsBuilderX86::VisitIntegerBitCount(HInvoke* invoke) {
+  CreateBitCountLocations(arena_, codegen_, invoke, /* is_long */ false);
+}
+
+void IntrinsicCodeGeneratorX86::VisitIntegerBitCount(HInvoke* invoke) {
+  GenBitCount(GetAssembler(), invoke, /* is_long */ false);
+}
+
+void IntrinsicLocationsBuilderX86::VisitLongBitCount(HInvoke* invoke) {
+  CreateBitCountLocations(arena_, codegen_, invoke, /* is_long */ true);
+}
+
+void IntrinsicCodeGeneratorX86::VisitLongBitCount(HInvoke* invoke) {
+  GenBitCount(GetAssembler(), invoke, /* is_long */ true);
+}
+
+static void CreateOneBitLocations(ArenaAllocator* arena, HInvoke* invoke, bool is_high) {
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kNoCall,
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister());
+  // A variable shift count needs to be in CL.
+  locations->AddTemp(is_high ? Location::RegisterLocation(ECX) : Location::RequiresRegister());
+}
+
+static void GenOneBit(X86Assembler* assembler, HInvoke* invoke, bool is_high) {
+  LocationSummary* locations = invoke->GetLocations();
+  Register src = locations->InAt(0).AsRegister<Register>();
+  Register out = locations->Out().AsRegister<Register>();
+  Register temp = locations->GetTemp(0).AsRegister<Register>();
+
+  if (is_high) {
+    // The highest one bit is 1 << BSR(src), or zero if there is no bit set.
+    __ bsrl(temp, src);
+
+    // BSR sets ZF if the input was zero, and the output is undefined.
+    NearLabel is_zero, done;
+    __ j(kEqual, &is_zero);
+    __ movl(out, Immediate(1));
+    __ shll(out, temp);
+    __ jmp(&done);
+
+    __ Bind(&is_zero);
+    __ xorl(out, out);
+
+    __ Bind(&done);
+  } else {
+    // The lowest one bit is src & -src.
+    __ movl(temp, src);
+    __ negl(temp);
+    __ movl(out, src);
+    __ andl(out, temp);
+  }
+}
+
+void IntrinsicLocationsBuilderX86::VisitIntegerHighestOneBit(HInvoke* invoke) {
+  CreateOneBitLocations(arena_, invoke, /* is_high */ true);
+}
+
+void IntrinsicCodeGeneratorX86::VisitIntegerHighestOneBit(HInvoke* invoke) {
+  GenOneBit(GetAssembler(), invoke, /* is_high */ true);
+}
+
+void IntrinsicLocationsBuilderX86::VisitIntegerLowestOneBit(HInvoke* invoke) {
+  CreateOneBitLocations(arena_, invoke, /* is_high */ false);
+}
+
+void IntrinsicCodeGeneratorX86::VisitIntegerLowestOneBit(HInvoke* invoke) {
+  GenOneBit(GetAssembler(), invoke, /* is_high */ false);
+}
+
+static void CreateCompareLocations(ArenaAllocator* arena, HInvoke* invoke) {
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kNoCall,
+                                                           kIntrinsified);
+  for (size_t i = 0, e = invoke->GetNumberOfArguments(); i < e; ++i) {
+    locations->SetInAt(i, Location::RequiresRegister());
+  }
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+// Computes Integer/Long.compare(x, y), or Integer/Long.signum(x) when the invoke
+// has a single argument.
+static void GenCompare(X86Assembler* assembler, HInvoke* invoke, bool is_long) {
+  LocationSummary* locations = invoke->GetLocations();
+  Location first = locations->InAt(0);
+  Register out = locations->Out().AsRegister<Register>();
+  bool is_signum = invoke->GetNumberOfArguments() == 1;
+
+  NearLabel less, greater, done;
+  if (is_long) {
+    Register first_low = first.AsRegisterPairLow<Register>();
+    Register first_high = first.AsRegisterPairHigh<Register>();
+    if (is_signum) {
+      __ testl(first_high, first_high);
+      __ j(kLess, &less);
+      __ j(kGreater, &greater);
+      __ testl(first_low, first_low);
+      __ j(kNotEqual, &greater);
+    } else {
+      Location second = locations->InAt(1);
+      __ cmpl(first_high, second.AsRegisterPairHigh<Register>());
+      __ j(kLess, &less);
+      __ j(kGreater, &greater);
+      // The high words are equal, compare the low words as unsigned values.
+      __ cmpl(first_low, second.AsRegisterPairLow<Register>());
+      __ j(kBelow, &less);
+      __ j(kAbove, &greater);
+    }
+  } else {
+    Register first_reg = first.AsRegister<Register>();
+    if (is_signum) {
+      __ testl(first_reg, first_reg);
+    } else {
+      __ cmpl(first_reg, locations->InAt(1).AsRegister<Register>());
+    }
+    __ j(kLess, &less);
+    __ j(kGreater, &greater);
+  }
+  __ xorl(out, out);
+  __ jmp(&done);
+
+  __ Bind(&greater);
+  __ movl(out, Immediate(1));
+  __ jmp(&done);
+
+  __ Bind(&less);
+  __ movl(out, Immediate(-1));
+
+  __ Bind(&done);
+}
+
+void IntrinsicLocationsBuilderX86::VisitIntegerCompare(HInvoke* invoke) {
+  CreateCompareLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86::VisitIntegerCompare(HInvoke* invoke) {
+  GenCompare(GetAssembler(), invoke, /* is_long */ false);
+}
+
+void IntrinsicLocationsBuilderX86::VisitLongCompare(HInvoke* invoke) {
+  CreateCompareLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86::VisitLongCompare(HInvoke* invoke) {
+  GenCompare(GetAssembler(), invoke, /* is_long */ true);
+}
+
+void IntrinsicLocationsBuilderX86::VisitIntegerSignum(HInvoke* invoke) {
+  CreateCompareLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86::VisitIntegerSignum(HInvoke* invoke) {
+  GenCompare(GetAssembler(), invoke, /* is_long */ false);
+}
+
+void IntrinsicLocationsBuilderX86::VisitLongSignum(HInvoke* invoke) {
+  CreateCompareLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86::VisitLongSignum(HInvoke* invoke) {
+  GenCompare(GetAssembler(), invoke, /* is_long */ true);
+}
+
 // Unimplemented intrinsics.
 
 #define UNIMPLEMENTED_INTRINSIC(Name)                                                   \
@@ -2308,7 +2530,20 @@ UNIMPLEMENTED_INTRINSIC(MathRoundDouble)
 UNIMPLEMENTED_INTRINSIC(ReferenceGetReferent)
 UNIMPLEMENTED_INTRINSIC(LongRotateRight)
 UNIMPLEMENTED_INTRINSIC(LongRotateLeft)
+UNIMPLEMENTED_INTRINSIC(LongHighestOneBit)
+UNIMPLEMENTED_INTRINSIC(LongLowestOneBit)
 UNIMPLEMENTED_INTRINSIC(SystemArrayCopy)
+UNIMPLEMENTED_INTRINSIC(StringHashCode)
+UNIMPLEMENTED_INTRINSIC(StringIndexOfString)
+UNIMPLEMENTED_INTRINSIC(StringContentEquals)
+UNIMPLEMENTED_INTRINSIC(MathCos)
+UNIMPLEMENTED_INTRINSIC(MathSin)
+UNIMPLEMENTED_INTRINSIC(MathTan)
+UNIMPLEMENTED_INTRINSIC(MathAtan2)
+UNIMPLEMENTED_INTRINSIC(MathExp)
+UNIMPLEMENTED_INTRINSIC(MathLog)
+UNIMPLEMENTED_INTRINSIC(MathPow)
+UNIMPLEMENTED_INTRINSIC(MathHypot)
 
 #undef UNIMPLEMENTED_INTRINSIC
 
@@ -687,6 +687,71 @@ void IntrinsicCodeGeneratorX86_64::VisitMathRoundDouble(HInvoke* invoke) {
   __ Bind(&done);
 }
 
+static void CreateFPToFPCallLocations(ArenaAllocator* arena, HInvoke* invoke) {
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kCall,
+                                                           kIntrinsified);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, Location::FpuRegisterLocation(calling_convention.GetFpuRegisterAt(0)));
+  locations->SetOut(Location::FpuRegisterLocation(XMM0));
+
+  // The entrypoint is a native function, which may clobber XMM12-15 even though
+  // they are callee-save registers for ART. Mark them as temps so that their
+  // values are saved in the frame of the method.
+  locations->AddTemp(Location::FpuRegisterLocation(XMM12));
+  locations->AddTemp(Location::FpuRegisterLocation(XMM13));
+  locations->AddTemp(Location::FpuRegisterLocation(XMM14));
+  locations->AddTemp(Location::FpuRegisterLocation(XMM15));
+}
+
+static void CreateFPFPToFPCallLocations(ArenaAllocator* arena, HInvoke* invoke) {
+  CreateFPToFPCallLocations(arena, invoke);
+  InvokeRuntimeCallingConvention calling_convention;
+  invoke->GetLocations()->SetInAt(
+      1, Location::FpuRegisterLocation(calling_convention.GetFpuRegisterAt(1)));
+}
+
+// Calls the libm function stored in the quick entrypoint at `entry_point_offset`. The
+// function does not need a transition to native code, as it is a leaf that does not
+// touch the Java heap.
+static void GenFPToFPCall(HInvoke* invoke,
+                          CodeGeneratorX86_64* codegen,
+                          ThreadOffset<kX86_64WordSize> entry_point_offset) {
+  X86_64Assembler* assembler = codegen->GetAssembler();
+  DCHECK(invoke->GetLocations()->WillCall());
+
+#ifndef MOE
+  __ gs()->call(Address::Absolute(entry_point_offset, true));
+#else
+  __ pushq(CpuRegister(RAX));
+  __ gs()->movq(CpuRegister(RAX), Address::Absolute(MOE_TLS_THREAD_OFFSET_64, true));
+  __ movq(CpuRegister(RAX), Address(CpuRegister(RAX), entry_point_offset.Int32Value()));
+  __ gs()->movq(Address::Absolute(MOE_TLS_SCRATCH_OFFSET_64, true), CpuRegister(RAX));
+  __ popq(CpuRegister(RAX));
+  __ gs()->call(Address::Absolute(MOE_TLS_SCRATCH_OFFSET_64, true));
+#endif
+  codegen->RecordPcInfo(invoke, invoke->GetDexPc());
+}
+
+#define MATH_LIBM_INTRINSIC(Name, Arity, Entrypoint)                                    \
+void IntrinsicLocationsBuilderX86_64::VisitMath ## Name(HInvoke* invoke) {              \
+  Create ## Arity ## ToFPCallLocations(arena_, invoke);                                 \
+}                                                                                       \
+void IntrinsicCodeGeneratorX86_64::VisitMath ## Name(HInvoke* invoke) {                 \
+  GenFPToFPCall(invoke, codegen_, QUICK_ENTRYPOINT_OFFSET(kX86_64WordSize, Entrypoint)); \
+}
+
+MATH_LIBM_INTRINSIC(Cos, FP, pCos)
+MATH_LIBM_INTRINSIC(Sin, FP, pSin)
+MATH_LIBM_INTRINSIC(Tan, FP, pTan)
+MATH_LIBM_INTRINSIC(Atan2, FPFP, pAtan2)
+MATH_LIBM_INTRINSIC(Exp, FP, pExp)
+MATH_LIBM_INTRINSIC(Log, FP, pLog)
+MATH_LIBM_INTRINSIC(Pow, FPFP, pPow)
+MATH_LIBM_INTRINSIC(Hypot, FPFP, pHypot)
+
+#undef MATH_LIBM_INTRINSIC
+
 void IntrinsicLocationsBuilderX86_64::VisitStringCharAt(HInvoke* invoke) {
   // The inputs plus one temp.
   LocationSummary* locations = new (arena_) LocationSummary(invoke,
@@ -1179,10 +1244,14 @@ void IntrinsicCodeGeneratorX86_64::VisitStringCompareTo(HInvoke* invoke) {
   __ Bind(slow_path->GetExitLabel());
 }
 
-void IntrinsicLocationsBuilderX86_64::VisitStringEquals(HInvoke* invoke) {
-  LocationSummary* locations = new (arena_) LocationSummary(invoke,
-                                                            LocationSummary::kNoCall,
-                                                            kIntrinsified);
+static void CreateStringEqualsLocations(HInvoke* invoke,
+                                        ArenaAllocator* allocator,
+                                        bool content_equals) {
+  // contentEquals() calls the Java method for arguments that are not strings.
+  LocationSummary* locations = new (allocator) LocationSummary(
+      invoke,
+      content_equals ? LocationSummary::kCallOnSlowPath : LocationSummary::kNoCall,
+      kIntrinsified);
   locations->SetInAt(0, Location::RequiresRegister());
   locations->SetInAt(1, Location::RequiresRegister());
 
@@ -1194,8 +1263,11 @@ void IntrinsicLocationsBuilderX86_64::VisitStringEquals(HInvoke* invoke) {
   locations->SetOut(Location::RegisterLocation(RSI), Location::kOutputOverlap);
 }
 
-void IntrinsicCodeGeneratorX86_64::VisitStringEquals(HInvoke* invoke) {
-  X86_64Assembler* assembler = GetAssembler();
+static void GenerateStringEquals(HInvoke* invoke,
+                                 X86_64Assembler* assembler,
+                                 CodeGeneratorX86_64* codegen,
+                                 ArenaAllocator* allocator,
+                                 bool content_equals) {
   LocationSummary* locations = invoke->GetLocations();
 
   CpuRegister str = locations->InAt(0).AsRegister<CpuRegister>();
@@ -1214,9 +1286,21 @@ void IntrinsicCodeGeneratorX86_64::VisitStringEquals(HInvoke* invoke) {
   // Note that the null check must have been done earlier.
   DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
 
-  // Check if input is null, return false if it is.
+  // equals() returns false for a null argument and for any other type. contentEquals() throws
+  // for null and compares the chars of other CharSequences, leave both to the Java method.
+  SlowPathCode* slow_path = nullptr;
+  if (content_equals) {
+    slow_path = new (allocator) IntrinsicSlowPathX86_64(invoke);
+    codegen->AddSlowPath(slow_path);
+  }
+
+  // Check if input is null.
   __ testl(arg, arg);
-  __ j(kEqual, &return_false);
+  if (content_equals) {
+    __ j(kEqual, slow_path->GetEntryLabel());
+  } else {
+    __ j(kEqual, &return_false);
+  }
 
   // Instanceof check for the argument by comparing class fields.
   // All string objects must have the same type since String cannot be subclassed.
@@ -1224,7 +1308,11 @@ void IntrinsicCodeGeneratorX86_64::VisitStringEquals(HInvoke* invoke) {
   // If the argument is a string object, its class field must be equal to receiver's class field.
   __ movl(rcx, Address(str, class_offset));
   __ cmpl(rcx, Address(arg, class_offset));
-  __ j(kNotEqual, &return_false);
+  if (content_equals) {
+    __ j(kNotEqual, slow_path->GetEntryLabel());
+  } else {
+    __ j(kNotEqual, &return_false);
+  }
 
   // Reference equality check, return true if same reference.
   __ cmpl(str, arg);
@@ -1265,6 +1353,25 @@ void IntrinsicCodeGeneratorX86_64::VisitStringEquals(HInvoke* invoke) {
   __ Bind(&return_false);
   __ xorl(rsi, rsi);
   __ Bind(&end);
+  if (slow_path != nullptr) {
+    __ Bind(slow_path->GetExitLabel());
+  }
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitStringEquals(HInvoke* invoke) {
+  CreateStringEqualsLocations(invoke, arena_, false);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitStringEquals(HInvoke* invoke) {
+  GenerateStringEquals(invoke, GetAssembler(), codegen_, GetAllocator(), false);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitStringContentEquals(HInvoke* invoke) {
+  CreateStringEqualsLocations(invoke, arena_, true);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitStringContentEquals(HInvoke* invoke) {
+  GenerateStringEquals(invoke, GetAssembler(), codegen_, GetAllocator(), true);
 }
 
 static void CreateStringIndexOfLocations(HInvoke* invoke,
@@ -1418,6 +1525,108 @@ void IntrinsicCodeGeneratorX86_64::VisitStringIndexOfAfter(HInvoke* invoke) {
   GenerateStringIndexOf(invoke, GetAssembler(), codegen_, GetAllocator(), false);
 }
 
+void IntrinsicLocationsBuilderX86_64::VisitStringIndexOfString(HInvoke* invoke) {
+  LocationSummary* locations = new (arena_) LocationSummary(invoke,
+                                                            LocationSummary::kCallOnSlowPath,
+                                                            kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+
+  // repne scasw looks for the first char of the pattern in AX, at RDI, counting down RCX.
+  // repe cmpsw then compares the rest of the pattern at RSI with the chars at RDI.
+  locations->AddTemp(Location::RegisterLocation(RAX));
+  locations->AddTemp(Location::RegisterLocation(RCX));
+  locations->AddTemp(Location::RegisterLocation(RDI));
+  locations->AddTemp(Location::RegisterLocation(RSI));
+  // RDI and RCX of the scan, saved across the compare.
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitStringIndexOfString(HInvoke* invoke) {
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister str = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister pattern = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister rax = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister rcx = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister rdi = locations->GetTemp(2).AsRegister<CpuRegister>();
+  CpuRegister rsi = locations->GetTemp(3).AsRegister<CpuRegister>();
+  CpuRegister next_char = locations->GetTemp(4).AsRegister<CpuRegister>();
+  CpuRegister remaining = locations->GetTemp(5).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+
+  const int32_t count_offset = mirror::String::CountOffset().Int32Value();
+  const int32_t value_offset = mirror::String::ValueOffset().Int32Value();
+  const int32_t char_size = sizeof(uint16_t);
+
+  // Note that the null check must have been done earlier.
+  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+
+  // Leave the NullPointerException for a null pattern to the Java method.
+  SlowPathCode* slow_path = new (GetAllocator()) IntrinsicSlowPathX86_64(invoke);
+  codegen_->AddSlowPath(slow_path);
+  __ testl(pattern, pattern);
+  __ j(kEqual, slow_path->GetEntryLabel());
+
+  NearLabel scan, found, not_found, done;
+
+  // The empty pattern is found at index 0.
+  __ movl(out, Address(pattern, count_offset));
+  __ testl(out, out);
+  __ j(kEqual, &done);
+
+  // The pattern can start at indexes 0 to str.length - pattern.length, there are none if the
+  // pattern is longer than the string. Only the chars of the string are read: the scan stops
+  // at the last possible start and the compare stops at the end of the pattern.
+  __ movl(rcx, Address(str, count_offset));
+  __ subl(rcx, out);
+  __ j(kLess, &not_found);
+  __ addl(rcx, Immediate(1));
+
+  __ movzxw(rax, Address(pattern, value_offset));
+  __ leaq(rdi, Address(str, value_offset));
+
+  // Look for the first char of the pattern. If found, RDI points to the char after it.
+  __ Bind(&scan);
+  __ repne_scasw();
+  __ j(kNotEqual, &not_found);
+
+  __ movq(next_char, rdi);
+  __ movq(remaining, rcx);
+  // Compare the rest of the pattern. repe cmpsw does not set the flags for a count of zero,
+  // so a pattern of one char is handled separately.
+  __ movl(rcx, Address(pattern, count_offset));
+  __ subl(rcx, Immediate(1));
+  __ j(kEqual, &found);
+  __ leaq(rsi, Address(pattern, value_offset + char_size));
+  __ repe_cmpsw();
+  // Moves do not change the flags of the compare.
+  __ movq(rdi, next_char);
+  __ movq(rcx, remaining);
+  __ j(kEqual, &found);
+  // Scan on from the char after the mismatched start, if there are more starts to try.
+  __ testl(rcx, rcx);
+  __ j(kNotEqual, &scan);
+
+  __ Bind(&not_found);
+  __ movl(out, Immediate(-1));
+  __ jmp(&done);
+
+  // The index of the match is (next_char - (str + value_offset)) / 2 - 1.
+  __ Bind(&found);
+  __ movl(out, next_char);
+  __ subl(out, str);
+  __ subl(out, Immediate(value_offset + char_size));
+  __ shrl(out, Immediate(1));
+
+  __ Bind(&done);
+  __ Bind(slow_path->GetExitLabel());
+}
+
 void IntrinsicLocationsBuilderX86_64::VisitStringNewStringFromBytes(HInvoke* invoke) {
   LocationSummary* locations = new (arena_) LocationSummary(invoke,
                                                             LocationSummary::kCall,
@@ -1591,6 +1800,108 @@ void IntrinsicCodeGeneratorX86_64::VisitStringGetCharsNoCheck(HInvoke* invoke) {
   __ rep_movsw();
 }
 
+void IntrinsicLocationsBuilderX86_64::VisitStringHashCode(HInvoke* invoke) {
+  LocationSummary* locations = new (arena_) LocationSummary(invoke,
+                                                            LocationSummary::kNoCall,
+                                                            kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+  // Remaining length, address of the next char and the char itself.
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  if (codegen_->GetInstructionSetFeatures().HasSSE4_1()) {
+    // Hashes of the four interleaved sequences of chars, their multiplier, and the next chars.
+    locations->AddTemp(Location::RequiresFpuRegister());
+    locations->AddTemp(Location::RequiresFpuRegister());
+    locations->AddTemp(Location::RequiresFpuRegister());
+  }
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitStringHashCode(HInvoke* invoke) {
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  const int32_t hash_code_offset = mirror::String::HashCodeOffset().Int32Value();
+  const int32_t count_offset = mirror::String::CountOffset().Int32Value();
+  const int32_t value_offset = mirror::String::ValueOffset().Int32Value();
+
+  CpuRegister str = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister count = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister ptr = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(2).AsRegister<CpuRegister>();
+
+  Label scalar_loop_check, store, done;
+  NearLabel scalar_loop;
+
+  // Note that the null check must have been done earlier.
+  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+
+  // A non-zero hash code has already been computed and cached.
+  __ movl(out, Address(str, hash_code_offset));
+  __ testl(out, out);
+  __ j(kNotEqual, &done);
+
+  // Here out == 0, which is the hash code of the empty prefix.
+  __ movl(count, Address(str, count_offset));
+  __ leaq(ptr, Address(str, value_offset));
+
+  if (locations->GetTempCount() > 3) {
+    XmmRegister acc = locations->GetTemp(3).AsFpuRegister<XmmRegister>();
+    XmmRegister multiplier = locations->GetTemp(4).AsFpuRegister<XmmRegister>();
+    XmmRegister chars = locations->GetTemp(5).AsFpuRegister<XmmRegister>();
+    NearLabel vector_loop;
+
+    __ cmpl(count, Immediate(4));
+    __ j(kLess, &scalar_loop_check);
+
+    // Lane i of `acc` holds the hash code of chars i, i + 4, i + 8, ..., that is
+    // the sum of c[i + 4 * k] * 31^(4 * (n - 1 - k)) over the n groups of four chars.
+    __ pxor(acc, acc);
+    __ movl(temp, Immediate(31 * 31 * 31 * 31));
+    __ movd(multiplier, temp, /* is64bit */ false);
+    __ pshufd(multiplier, multiplier, Immediate(0));
+
+    __ Bind(&vector_loop);
+    __ pmovzxwd(chars, Address(ptr, 0));
+    __ pmulld(acc, multiplier);
+    __ paddd(acc, chars);
+    __ addq(ptr, Immediate(4 * sizeof(uint16_t)));
+    __ subl(count, Immediate(4));
+    __ cmpl(count, Immediate(4));
+    __ j(kGreaterEqual, &vector_loop);
+
+    // Combine the lanes: out = ((acc[0] * 31 + acc[1]) * 31 + acc[2]) * 31 + acc[3].
+    __ movd(out, acc, /* is64bit */ false);
+    for (int lane = 1; lane < 4; ++lane) {
+      __ pshufd(chars, acc, Immediate(lane));
+      __ movd(temp, chars, /* is64bit */ false);
+      __ imull(out, out, Immediate(31));
+      __ addl(out, temp);
+    }
+  }
+
+  // Hash the remaining chars one at a time: out = out * 31 + c.
+  __ Bind(&scalar_loop_check);
+  __ testl(count, count);
+  __ j(kEqual, &store);
+
+  __ Bind(&scalar_loop);
+  __ movzxw(temp, Address(ptr, 0));
+  __ imull(out, out, Immediate(31));
+  __ addl(out, temp);
+  __ addq(ptr, Immediate(sizeof(uint16_t)));
+  __ subl(count, Immediate(1));
+  __ j(kNotEqual, &scalar_loop);
+
+  // Cache the hash code in the string, like String.hashCode() does.
+  __ Bind(&store);
+  __ movl(Address(str, hash_code_offset), out);
+
+  __ Bind(&done);
+}
+
 static void GenPeek(LocationSummary* locations, Primitive::Type size, X86_64Assembler* assembler) {
   CpuRegister address = locations->InAt(0).AsRegister<CpuRegister>();
   CpuRegister out = locations->Out().AsRegister<CpuRegister>();  // == address, here for clarity.
@@ -2358,6 +2669,232 @@ void IntrinsicCodeGeneratorX86_64::VisitLongRotateRight(HInvoke* invoke) {
   GenRotate(assembler, invoke, /* is_long */ true, /* is_left */ false);
 }
 
+static void CreateBitCountLocations(
+    ArenaAllocator* arena, CodeGeneratorX86_64* codegen, HInvoke* invoke) {
+  if (!codegen->GetInstructionSetFeatures().HasPopCnt()) {
+    // Do nothing if there is no popcnt support. This results in generating
+    // a call for the intrinsic rather than direct code.
+    return;
+  }
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kNoCall,
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::Any());
+  locations->SetOut(Location::RequiresRegister());
+}
+
+static void GenBitCount(X86_64Assembler* assembler, HInvoke* invoke, bool is_long) {
+  LocationSummary* locations = invoke->GetLocations();
+  Location src = locations->InAt(0);
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+
+  if (invoke->InputAt(0)->IsConstant()) {
+    // Evaluate this at compile time.
+    int64_t value = Int64FromConstant(invoke->InputAt(0)->AsConstant());
+    value = is_long
+        ? POPCOUNT(static_cast<uint64_t>(value))
+        : POPCOUNT(static_cast<uint32_t>(value));
+    if (value == 0) {
+      __ xorl(out, out);
+    } else {
+      __ movl(out, Immediate(value));
+    }
+    return;
+  }
+
+  if (src.IsRegister()) {
+    if (is_long) {
+      __ popcntq(out, src.AsRegister<CpuRegister>());
+    } else {
+      __ popcntl(out, src.AsRegister<CpuRegister>());
+    }
+  } else if (is_long) {
+    DCHECK(src.IsDoubleStackSlot());
+    __ popcntq(out, Address(CpuRegister(RSP), src.GetStackIndex()));
+  } else {
+    DCHECK(src.IsStackSlot());
+    __ popcntl(out, Address(CpuRegister(RSP), src.GetStackIndex()));
+  }
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitIntegerBitCount(HInvoke* invoke) {
+  CreateBitCountLocations(arena_, codegen_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitIntegerBitCount(HInvoke* invoke) {
+  GenBitCount(GetAssembler(), invoke, /* is_long */ false);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitLongBitCount(HInvoke* invoke) {
+  CreateBitCountLocations(arena_, codegen_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitLongBitCount(HInvoke* invoke) {
+  GenBitCount(GetAssembler(), invoke, /* is_long */ true);
+}
+
+static void CreateOneBitLocations(ArenaAllocator* arena, HInvoke* invoke, bool is_high) {
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kNoCall,
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister());
+  // A variable shift count needs to be in CL.
+  locations->AddTemp(is_high ? Location::RegisterLocation(RCX) : Location::RequiresRegister());
+}
+
+static void GenOneBit(X86_64Assembler* assembler, HInvoke* invoke, bool is_high, bool is_long) {
+  LocationSummary* locations = invoke->GetLocations();
+  CpuRegister src = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister tmp = locations->GetTemp(0).AsRegister<CpuRegister>();
+
+  if (is_high) {
+    // The highest one bit is 1 << BSR(src), or zero if there is no bit set.
+    if (is_long) {
+      __ bsrq(tmp, src);
+    } else {
+      __ bsrl(tmp, src);
+    }
+
+    // BSR sets ZF if the input was zero, and the output is undefined.
+    NearLabel is_zero, done;
+    __ j(kEqual, &is_zero);
+    __ movl(out, Immediate(1));  // Clears the upper bits too.
+    if (is_long) {
+      __ shlq(out, tmp);
+    } else {
+      __ shll(out, tmp);
+    }
+    __ jmp(&done);
+
+    __ Bind(&is_zero);
+    __ xorl(out, out);
+
+    __ Bind(&done);
+  } else {
+    // The lowest one bit is src & -src.
+    if (is_long) {
+      __ movq(tmp, src);
+      __ negq(tmp);
+      __ movq(out, src);
+      __ andq(out, tmp);
+    } else {
+      __ movl(tmp, src);
+      __ negl(tmp);
+      __ movl(out, src);
+      __ andl(out, tmp);
+    }
+  }
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitIntegerHighestOneBit(HInvoke* invoke) {
+  CreateOneBitLocations(arena_, invoke, /* is_high */ true);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitIntegerHighestOneBit(HInvoke* invoke) {
+  GenOneBit(GetAssembler(), invoke, /* is_high */ true, /* is_long */ false);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitLongHighestOneBit(HInvoke* invoke) {
+  CreateOneBitLocations(arena_, invoke, /* is_high */ true);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitLongHighestOneBit(HInvoke* invoke) {
+  GenOneBit(GetAssembler(), invoke, /* is_high */ true, /* is_long */ true);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitIntegerLowestOneBit(HInvoke* invoke) {
+  CreateOneBitLocations(arena_, invoke, /* is_high */ false);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitIntegerLowestOneBit(HInvoke* invoke) {
+  GenOneBit(GetAssembler(), invoke, /* is_high */ false, /* is_long */ false);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitLongLowestOneBit(HInvoke* invoke) {
+  CreateOneBitLocations(arena_, invoke, /* is_high */ false);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitLongLowestOneBit(HInvoke* invoke) {
+  GenOneBit(GetAssembler(), invoke, /* is_high */ false, /* is_long */ true);
+}
+
+static void CreateCompareLocations(ArenaAllocator* arena, HInvoke* invoke) {
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kNoCall,
+                                                           kIntrinsified);
+  for (size_t i = 0, e = invoke->GetNumberOfArguments(); i < e; ++i) {
+    locations->SetInAt(i, Location::RequiresRegister());
+  }
+  // The output and the temporary are cleared before the inputs are compared.
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+  locations->AddTemp(Location::RequiresRegister());
+}
+
+// Computes Integer/Long.compare(x, y), or Integer/Long.signum(x) when the invoke
+// has a single argument, as (x > y) - (x < y).
+static void GenCompare(X86_64Assembler* assembler, HInvoke* invoke, bool is_long) {
+  LocationSummary* locations = invoke->GetLocations();
+  CpuRegister first = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister tmp = locations->GetTemp(0).AsRegister<CpuRegister>();
+  bool is_signum = invoke->GetNumberOfArguments() == 1;
+
+  // SETcc only writes the low byte of its register.
+  __ xorl(out, out);
+  __ xorl(tmp, tmp);
+  if (is_signum) {
+    if (is_long) {
+      __ testq(first, first);
+    } else {
+      __ testl(first, first);
+    }
+  } else {
+    CpuRegister second = locations->InAt(1).AsRegister<CpuRegister>();
+    if (is_long) {
+      __ cmpq(first, second);
+    } else {
+      __ cmpl(first, second);
+    }
+  }
+  __ setcc(kGreater, out);
+  __ setcc(kLess, tmp);
+  __ subl(out, tmp);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitIntegerCompare(HInvoke* invoke) {
+  CreateCompareLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitIntegerCompare(HInvoke* invoke) {
+  GenCompare(GetAssembler(), invoke, /* is_long */ false);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitLongCompare(HInvoke* invoke) {
+  CreateCompareLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitLongCompare(HInvoke* invoke) {
+  GenCompare(GetAssembler(), invoke, /* is_long */ true);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitIntegerSignum(HInvoke* invoke) {
+  CreateCompareLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitIntegerSignum(HInvoke* invoke) {
+  GenCompare(GetAssembler(), invoke, /* is_long */ false);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitLongSignum(HInvoke* invoke) {
+  CreateCompareLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitLongSignum(HInvoke* invoke) {
+  GenCompare(GetAssembler(), invoke, /* is_long */ true);
+}
+
 // Unimplemented intrinsics.
 
 #define UNIMPLEMENTED_INTRINSIC(Name)                                                   \
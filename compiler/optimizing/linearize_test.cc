@@ -251,4 +251,38 @@ TEST(LinearizeTest, CFG7) {
   TestCode(data, blocks);
 }
 
+TEST(LinearizeTest, ThrowingBlockLast) {
+  // The throwing block is placed after the return, just before the exit block.
+  const uint16_t data[] = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::IF_NE, 3,
+    Instruction::THROW | 0 << 8,
+    Instruction::RETURN_VOID);
+
+  ArenaPool pool;
+  ArenaAllocator allocator(&pool);
+  HGraph* graph = CreateGraph(&allocator);
+  HGraphBuilder builder(graph);
+  const DexFile::CodeItem* item = reinterpret_cast<const DexFile::CodeItem*>(data);
+  bool graph_built = builder.BuildGraph(*item);
+  ASSERT_TRUE(graph_built);
+
+  graph->TryBuildingSsa();
+
+  std::unique_ptr<const X86InstructionSetFeatures> features_x86(
+      X86InstructionSetFeatures::FromCppDefines());
+  x86::CodeGeneratorX86 codegen(graph, *features_x86.get(), CompilerOptions());
+  SsaLivenessAnalysis liveness(graph, &codegen);
+  liveness.Analyze();
+
+  const ArenaVector<HBasicBlock*>& linear_order = graph->GetLinearOrder();
+  ASSERT_GE(linear_order.size(), 3u);
+  ASSERT_TRUE(linear_order.back()->IsExitBlock());
+  HBasicBlock* throwing_block = linear_order[linear_order.size() - 2];
+  ASSERT_TRUE(throwing_block->GetLastInstruction()->IsThrow());
+  for (size_t i = 0; i < linear_order.size() - 2; ++i) {
+    ASSERT_FALSE(linear_order[i]->GetLastInstruction()->IsThrow());
+  }
+}
+
 }  // namespace art
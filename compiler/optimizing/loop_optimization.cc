@@ -0,0 +1,651 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "loop_optimization.h"
+
+namespace art {
+
+#define FOR_EACH_COPYABLE_BINARY_OPERATION(M)                           \
+  M(Add)                                                                \
+  M(Sub)                                                                \
+  M(Mul)                                                                \
+  M(Div)                                                                \
+  M(Rem)                                                                \
+  M(And)                                                                \
+  M(Or)                                                                 \
+  M(Xor)                                                                \
+  M(Shl)                                                                \
+  M(Shr)                                                                \
+  M(UShr)
+
+#define FOR_EACH_COPYABLE_CONDITION(M)                                  \
+  M(Equal)                                                              \
+  M(NotEqual)                                                           \
+  M(LessThan)                                                           \
+  M(LessThanOrEqual)                                                    \
+  M(GreaterThan)                                                        \
+  M(GreaterThanOrEqual)                                                 \
+  M(Below)                                                              \
+  M(BelowOrEqual)                                                       \
+  M(Above)                                                              \
+  M(AboveOrEqual)
+
+#define FOR_EACH_COPYABLE_INSTRUCTION(M)                                \
+  FOR_EACH_COPYABLE_BINARY_OPERATION(M)                                 \
+  FOR_EACH_COPYABLE_CONDITION(M)                                        \
+  M(Neg)                                                                \
+  M(Not)                                                                \
+  M(BooleanNot)                                                         \
+  M(TypeConversion)                                                     \
+  M(Compare)                                                            \
+  M(NullCheck)                                                          \
+  M(BoundsCheck)                                                        \
+  M(DivZeroCheck)                                                       \
+  M(ArrayLength)                                                        \
+  M(ArrayGet)                                                           \
+  M(ArraySet)                                                           \
+  M(InstanceFieldGet)                                                   \
+  M(InstanceFieldSet)                                                   \
+  M(InstanceOf)                                                         \
+  M(CheckCast)                                                          \
+  M(BoundType)                                                          \
+  M(If)
+
+static bool IsCopyable(HInstruction* instruction) {
+  switch (instruction->GetKind()) {
+#define COPYABLE_CASE(type) case HInstruction::k##type:
+    FOR_EACH_COPYABLE_INSTRUCTION(COPYABLE_CASE)
+#undef COPYABLE_CASE
+      return true;
+    default:
+      return false;
+  }
+}
+
+static HInstruction* Lookup(const ArenaSafeMap<HInstruction*, HInstruction*>& map,
+                            HInstruction* instruction) {
+  auto it = map.find(instruction);
+  return (it != map.end()) ? it->second : instruction;
+}
+
+static bool IsDefinedOutOfTheLoop(HInstruction* instruction, HLoopInformation* loop) {
+  return !loop->Contains(*instruction->GetBlock());
+}
+
+static bool IsUsedOutOfTheLoop(HInstruction* instruction, HLoopInformation* loop) {
+  for (HUseIterator<HInstruction*> it(instruction->GetUses()); !it.Done(); it.Advance()) {
+    if (!loop->Contains(*it.Current()->GetUser()->GetBlock())) {
+      return true;
+    }
+  }
+  for (HUseIterator<HEnvironment*> it(instruction->GetEnvUses()); !it.Done(); it.Advance()) {
+    if (!loop->Contains(*it.Current()->GetUser()->GetHolder()->GetBlock())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the number of instructions of `loop`, not counting phis, the suspend check
+// and gotos. Only valid for loops accepted by IsSimpleLoop().
+static size_t GetLoopSize(HLoopInformation* loop) {
+  size_t size = 0;
+  for (HBasicBlock* block : { loop->GetHeader(), loop->GetBackEdges()[0] }) {
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      if (!it.Current()->IsSuspendCheck() && !it.Current()->IsGoto()) {
+        ++size;
+      }
+    }
+  }
+  return size;
+}
+
+// Creates a copy of `instruction` with the given inputs.
+static HInstruction* CreateCopy(ArenaAllocator* arena,
+                                HInstruction* instruction,
+                                HInstruction** inputs) {
+  Primitive::Type type = instruction->GetType();
+  uint32_t dex_pc = instruction->GetDexPc();
+  switch (instruction->GetKind()) {
+#define BINARY_OPERATION_CASE(name)                                     \
+    case HInstruction::k##name:                                         \
+      return new (arena) H##name(type, inputs[0], inputs[1], dex_pc);
+    FOR_EACH_COPYABLE_BINARY_OPERATION(BINARY_OPERATION_CASE)
+#undef BINARY_OPERATION_CASE
+
+#define CONDITION_CASE(name)                                            \
+    case HInstruction::k##name: {                                       \
+      HCondition* condition = new (arena) H##name(inputs[0], inputs[1], dex_pc); \
+      condition->SetBias(instruction->AsCondition()->GetBias());        \
+      return condition;                                                 \
+    }
+    FOR_EACH_COPYABLE_CONDITION(CONDITION_CASE)
+#undef CONDITION_CASE
+
+    case HInstruction::kNeg:
+      return new (arena) HNeg(type, inputs[0], dex_pc);
+    case HInstruction::kNot:
+      return new (arena) HNot(type, inputs[0], dex_pc);
+    case HInstruction::kBooleanNot:
+      return new (arena) HBooleanNot(inputs[0], dex_pc);
+    case HInstruction::kTypeConversion:
+      return new (arena) HTypeConversion(type, inputs[0], dex_pc);
+    case HInstruction::kCompare:
+      return new (arena) HCompare(inputs[0]->GetType(),
+                                  inputs[0],
+                                  inputs[1],
+                                  instruction->AsCompare()->GetBias(),
+                                  dex_pc);
+    case HInstruction::kNullCheck:
+      return new (arena) HNullCheck(inputs[0], dex_pc);
+    case HInstruction::kBoundsCheck:
+      return new (arena) HBoundsCheck(inputs[0], inputs[1], dex_pc);
+    case HInstruction::kDivZeroCheck:
+      return new (arena) HDivZeroCheck(inputs[0], dex_pc);
+    case HInstruction::kArrayLength:
+      return new (arena) HArrayLength(inputs[0], dex_pc);
+    case HInstruction::kArrayGet:
+      return new (arena) HArrayGet(inputs[0], inputs[1], type, dex_pc);
+    case HInstruction::kArraySet: {
+      HArraySet* array_set = instruction->AsArraySet();
+      HArraySet* copy = new (arena) HArraySet(
+          inputs[0], inputs[1], inputs[2], array_set->GetComponentType(), dex_pc);
+      if (!array_set->NeedsTypeCheck()) {
+        copy->ClearNeedsTypeCheck();
+      }
+      if (!array_set->GetValueCanBeNull()) {
+        copy->ClearValueCanBeNull();
+      }
+      if (array_set->StaticTypeOfArrayIsObjectArray()) {
+        copy->SetStaticTypeOfArrayIsObjectArray();
+      }
+      return copy;
+    }
+    case HInstruction::kInstanceFieldGet: {
+      const FieldInfo& info = instruction->AsInstanceFieldGet()->GetFieldInfo();
+      return new (arena) HInstanceFieldGet(inputs[0],
+                                           info.GetFieldType(),
+                                           info.GetFieldOffset(),
+                                           info.IsVolatile(),
+                                           info.GetFieldIndex(),
+                                           info.GetDexFile(),
+                                           info.GetDexCache(),
+                                           dex_pc);
+    }
+    case HInstruction::kInstanceFieldSet: {
+      HInstanceFieldSet* field_set = instruction->AsInstanceFieldSet();
+      const FieldInfo& info = field_set->GetFieldInfo();
+      HInstanceFieldSet* copy = new (arena) HInstanceFieldSet(inputs[0],
+                                                              inputs[1],
+                                                              info.GetFieldType(),
+                                                              info.GetFieldOffset(),
+                                                              info.IsVolatile(),
+                                                              info.GetFieldIndex(),
+                                                              info.GetDexFile(),
+                                                              info.GetDexCache(),
+                                                              dex_pc);
+      if (!field_set->GetValueCanBeNull()) {
+        copy->ClearValueCanBeNull();
+      }
+      return copy;
+    }
+    case HInstruction::kInstanceOf: {
+      HInstanceOf* instance_of = instruction->AsInstanceOf();
+      HInstanceOf* copy = new (arena) HInstanceOf(
+          inputs[0], inputs[1]->AsLoadClass(), instance_of->GetTypeCheckKind(), dex_pc);
+      if (!instance_of->MustDoNullCheck()) {
+        copy->ClearMustDoNullCheck();
+      }
+      return copy;
+    }
+    case HInstruction::kCheckCast: {
+      HCheckCast* check_cast = instruction->AsCheckCast();
+      HCheckCast* copy = new (arena) HCheckCast(
+          inputs[0], inputs[1]->AsLoadClass(), check_cast->GetTypeCheckKind(), dex_pc);
+      if (!check_cast->MustDoNullCheck()) {
+        copy->ClearMustDoNullCheck();
+      }
+      return copy;
+    }
+    case HInstruction::kBoundType: {
+      HBoundType* bound_type = instruction->AsBoundType();
+      HBoundType* copy = new (arena) HBoundType(inputs[0],
+                                                bound_type->GetUpperBound(),
+                                                bound_type->GetUpperCanBeNull(),
+                                                dex_pc);
+      copy->SetCanBeNull(bound_type->CanBeNull());
+      return copy;
+    }
+    case HInstruction::kIf:
+      return new (arena) HIf(inputs[0], dex_pc);
+    default:
+      LOG(FATAL) << "Unexpected instruction " << instruction->DebugName();
+      UNREACHABLE();
+  }
+}
+
+HLoopOptimization::HLoopOptimization(HGraph* graph,
+                                     HInductionVarAnalysis* induction_analysis,
+                                     const CompilerOptions& compiler_options,
+                                     OptimizingCompilerStats* stats)
+    : HOptimization(graph, kLoopOptimizationPassName, stats),
+      induction_range_(induction_analysis),
+      max_unroll_factor_(compiler_options.GetLoopUnrollFactor()),
+      max_unrolled_loop_size_(compiler_options.GetLoopUnrollMaxSize()),
+      max_peeled_loop_size_(compiler_options.GetLoopPeelMaxSize()) {}
+
+void HLoopOptimization::Run() {
+  // The copied blocks would need try/catch information.
+  if (graph_->HasTryCatch()) {
+    return;
+  }
+
+  // Collect the loops first, as the transformations below change the block order.
+  ArenaAllocator* arena = graph_->GetArena();
+  ArenaVector<HLoopInformation*> loops(arena->Adapter(kArenaAllocLoopOptimization));
+  for (HPostOrderIterator it(*graph_); !it.Done(); it.Advance()) {
+    if (it.Current()->IsLoopHeader()) {
+      loops.push_back(it.Current()->GetLoopInformation());
+    }
+  }
+
+  ArenaVector<HPhi*> exit_values(arena->Adapter(kArenaAllocLoopOptimization));
+  ArenaVector<HInstruction*> checks(arena->Adapter(kArenaAllocLoopOptimization));
+  for (HLoopInformation* loop : loops) {
+    HBasicBlock* exit = nullptr;
+    exit_values.clear();
+    if (!IsSimpleLoop(loop, &exit) || !CollectExitValues(loop, &exit_values)) {
+      continue;
+    }
+    int64_t trip_count = 0;
+    bool has_constant_trip_count = induction_range_.GetConstantTripCount(loop, &trip_count);
+    if (has_constant_trip_count && trip_count <= 1) {
+      // Nothing to gain, the loop is left to other optimizations.
+      continue;
+    }
+
+    checks.clear();
+    CollectInvariantChecks(loop, &checks);
+    if (!checks.empty() && GetLoopSize(loop) <= max_peeled_loop_size_) {
+      PeelFirstIteration(loop, exit, exit_values, checks);
+      MaybeRecordStat(kPeeledLoop);
+      --trip_count;
+      // The loop now exits through a new block, and its header phis are only used after
+      // the loop by the phis merging them with the values of the peeled iteration.
+      exit_values.clear();
+      bool is_simple = IsSimpleLoop(loop, &exit) && CollectExitValues(loop, &exit_values);
+      DCHECK(is_simple);
+    }
+
+    // Unroll by the largest factor which keeps the loop small and, when the trip count
+    // is known, divides it.
+    size_t size = GetLoopSize(loop);
+    size_t factor = max_unroll_factor_;
+    while (factor > 1 &&
+           (size * factor > max_unrolled_loop_size_ ||
+            (has_constant_trip_count &&
+             (trip_count < static_cast<int64_t>(factor) || trip_count % factor != 0)))) {
+      --factor;
+    }
+    if (factor > 1) {
+      Unroll(loop, exit, exit_values, factor, /* keep_exit_tests */ !has_constant_trip_count);
+      MaybeRecordStat(kUnrolledLoop);
+    }
+  }
+}
+
+bool HLoopOptimization::IsSimpleLoop(HLoopInformation* loop, HBasicBlock** exit) const {
+  HBasicBlock* header = loop->GetHeader();
+  if (loop->NumberOfBackEdges() != 1 ||
+      loop->GetBlocks().NumSetBits() != 2 ||
+      header->GetPredecessors().size() != 2 ||
+      !header->GetLastInstruction()->IsIf()) {
+    return false;
+  }
+  HBasicBlock* body = loop->GetBackEdges()[0];
+  if (body == header ||
+      body->GetPredecessors().size() != 1 ||
+      body->GetSuccessors().size() != 1 ||
+      !body->GetPhis().IsEmpty() ||
+      !body->GetLastInstruction()->IsGoto()) {
+    return false;
+  }
+  HBasicBlock* successor = header->GetSuccessors()[0];
+  *exit = (successor == body) ? header->GetSuccessors()[1] : successor;
+  if ((*exit)->GetPredecessors().size() != 1 || !(*exit)->GetPhis().IsEmpty()) {
+    return false;
+  }
+
+  for (HInstructionIterator it(header->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if (instruction != loop->GetSuspendCheck() && !IsCopyable(instruction)) {
+      return false;
+    }
+  }
+  for (HInstructionIterator it(body->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if (!instruction->IsGoto() && (instruction->IsIf() || !IsCopyable(instruction))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HLoopOptimization::CollectExitValues(HLoopInformation* loop,
+                                          ArenaVector<HPhi*>* exit_values) const {
+  HBasicBlock* header = loop->GetHeader();
+  // Values defined in the body do not dominate the exit, so only the header needs
+  // to be checked.
+  for (HInstructionIterator it(header->GetInstructions()); !it.Done(); it.Advance()) {
+    if (IsUsedOutOfTheLoop(it.Current(), loop)) {
+      return false;
+    }
+  }
+  for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+    HPhi* phi = it.Current()->AsPhi();
+    if (IsUsedOutOfTheLoop(phi, loop)) {
+      // Phis for the same vreg would be equivalents in the exit block.
+      for (HPhi* other : *exit_values) {
+        if (other->GetRegNumber() == phi->GetRegNumber()) {
+          return false;
+        }
+      }
+      exit_values->push_back(phi);
+    }
+  }
+  return true;
+}
+
+void HLoopOptimization::CollectInvariantChecks(HLoopInformation* loop,
+                                               ArenaVector<HInstruction*>* checks) const {
+  for (HBasicBlock* block : { loop->GetHeader(), loop->GetBackEdges()[0] }) {
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      HInstruction* instruction = it.Current();
+      if (!instruction->IsNullCheck() &&
+          !instruction->IsBoundsCheck() &&
+          !instruction->IsDivZeroCheck() &&
+          !instruction->IsCheckCast()) {
+        continue;
+      }
+      bool is_invariant = true;
+      for (size_t i = 0, e = instruction->InputCount(); i < e; ++i) {
+        is_invariant = is_invariant && IsDefinedOutOfTheLoop(instruction->InputAt(i), loop);
+      }
+      if (is_invariant) {
+        checks->push_back(instruction);
+      }
+    }
+  }
+}
+
+void HLoopOptimization::PeelFirstIteration(HLoopInformation* loop,
+                                           HBasicBlock* exit,
+                                           const ArenaVector<HPhi*>& exit_values,
+                                           const ArenaVector<HInstruction*>& checks) {
+  ArenaAllocator* arena = graph_->GetArena();
+  HBasicBlock* header = loop->GetHeader();
+  HBasicBlock* pre_header = header->GetPredecessors()[0];
+  HBasicBlock* body = loop->GetBackEdges()[0];
+
+  // The peeled iteration is inserted between the pre-header and a new pre-header:
+  //
+  //   pre_header -> header_copy -> body_copy -> new_pre_header -> header
+  //                      |                                           |
+  //                  exit_copy ----------> exit <----------------- loop_exit
+  SplitExitEdge(header, exit);
+  HBasicBlock* header_copy = NewBlockInLoopsOf(pre_header);
+  HBasicBlock* body_copy = NewBlockInLoopsOf(pre_header);
+  HBasicBlock* new_pre_header = NewBlockInLoopsOf(pre_header);
+  HBasicBlock* exit_copy = NewBlockInLoopsOf(exit);
+
+  // In the first iteration, the header phis have their initial values.
+  ValueMap map(std::less<HInstruction*>(), arena->Adapter(kArenaAllocLoopOptimization));
+  for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+    map.Put(it.Current(), it.Current()->InputAt(0));
+  }
+  CopyLoopBody(loop, header_copy, body_copy, /* copy_exit_test */ true, &map);
+  new_pre_header->AddInstruction(new (arena) HGoto(header->GetDexPc()));
+  exit_copy->AddInstruction(new (arena) HGoto(exit->GetDexPc()));
+
+  header->ReplacePredecessor(pre_header, new_pre_header);
+  pre_header->AddSuccessor(header_copy);
+  for (HBasicBlock* successor : header->GetSuccessors()) {
+    header_copy->AddSuccessor(successor == body ? body_copy : exit_copy);
+  }
+  body_copy->AddSuccessor(new_pre_header);
+  exit_copy->AddSuccessor(exit);
+
+  // The loop now starts with the values computed by the peeled iteration.
+  ArenaVector<HInstruction*> entry_values(arena->Adapter(kArenaAllocLoopOptimization));
+  for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+    entry_values.push_back(Lookup(map, it.Current()->InputAt(1)));
+  }
+  size_t index = 0;
+  for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+    it.Current()->ReplaceInput(entry_values[index++], 0);
+  }
+
+  ArenaVector<HPhi*> exit_phis(arena->Adapter(kArenaAllocLoopOptimization));
+  CreateExitPhis(exit, exit_values, &exit_phis);
+  for (size_t i = 0, e = exit_values.size(); i < e; ++i) {
+    exit_phis[i]->AddInput(Lookup(map, exit_values[i]));
+  }
+  ReplaceExitUses(loop, exit_values, exit_phis);
+
+  // The copies of the checks dominate the loop and check the same values.
+  for (HInstruction* check : checks) {
+    check->ReplaceWith(map.Get(check));
+    check->GetBlock()->RemoveInstruction(check);
+  }
+
+  graph_->ClearDominanceInformation();
+  graph_->ComputeDominanceInformation();
+}
+
+void HLoopOptimization::Unroll(HLoopInformation* loop,
+                               HBasicBlock* exit,
+                               const ArenaVector<HPhi*>& exit_values,
+                               size_t factor,
+                               bool keep_exit_tests) {
+  ArenaAllocator* arena = graph_->GetArena();
+  HBasicBlock* header = loop->GetHeader();
+  HBasicBlock* body = loop->GetBackEdges()[0];
+
+  // Each copy with an exit test gets its own exit block, which avoids critical edges:
+  //
+  //   header -> body -> header_copy -> body_copy -> ... -> header
+  //     |                   |
+  //   loop_exit         exit_copy
+  //       \                 |
+  //        ---------------> exit
+  ArenaVector<HPhi*> exit_phis(arena->Adapter(kArenaAllocLoopOptimization));
+  if (keep_exit_tests) {
+    SplitExitEdge(header, exit);
+    CreateExitPhis(exit, exit_values, &exit_phis);
+  }
+
+  // `map` holds the values of the copy being created, `previous_map` those of the
+  // previous copy. The values of the original loop body are not mapped.
+  ValueMap map(std::less<HInstruction*>(), arena->Adapter(kArenaAllocLoopOptimization));
+  ValueMap previous_map(std::less<HInstruction*>(), arena->Adapter(kArenaAllocLoopOptimization));
+  HBasicBlock* back_edge = body;
+  for (size_t i = 1; i < factor; ++i) {
+    // The header phis take the values computed by the back edge of the previous copy.
+    map.clear();
+    for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+      map.Put(it.Current(), Lookup(previous_map, it.Current()->InputAt(1)));
+    }
+    HBasicBlock* header_copy = NewBlockInLoopsOf(header);
+    HBasicBlock* body_copy = keep_exit_tests ? NewBlockInLoopsOf(header) : header_copy;
+    CopyLoopBody(loop, header_copy, body_copy, keep_exit_tests, &map);
+
+    back_edge->ReplaceSuccessor(header, header_copy);
+    if (keep_exit_tests) {
+      HBasicBlock* exit_copy = NewBlockInLoopsOf(exit);
+      exit_copy->AddInstruction(new (arena) HGoto(exit->GetDexPc()));
+      for (HBasicBlock* successor : header->GetSuccessors()) {
+        header_copy->AddSuccessor(successor == body ? body_copy : exit_copy);
+      }
+      exit_copy->AddSuccessor(exit);
+      for (size_t j = 0, e = exit_values.size(); j < e; ++j) {
+        exit_phis[j]->AddInput(Lookup(map, exit_values[j]));
+      }
+    }
+    body_copy->AddSuccessor(header);
+    back_edge = body_copy;
+    previous_map.swap(map);
+  }
+  loop->ReplaceBackEdge(body, back_edge);
+
+  // The header phis now take the values computed by the last copy.
+  ArenaVector<HInstruction*> back_edge_values(arena->Adapter(kArenaAllocLoopOptimization));
+  for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+    back_edge_values.push_back(Lookup(previous_map, it.Current()->InputAt(1)));
+  }
+  size_t index = 0;
+  for (HInstructionIterator it(header->GetPhis()); !it.Done(); it.Advance()) {
+    it.Current()->ReplaceInput(back_edge_values[index++], 1);
+  }
+
+  if (keep_exit_tests) {
+    ReplaceExitUses(loop, exit_values, exit_phis);
+  }
+
+  graph_->ClearDominanceInformation();
+  graph_->ComputeDominanceInformation();
+}
+
+void HLoopOptimization::CopyLoopBody(HLoopInformation* loop,
+                                     HBasicBlock* header_copy,
+                                     HBasicBlock* body_copy,
+                                     bool copy_exit_test,
+                                     ValueMap* map) {
+  HBasicBlock* header = loop->GetHeader();
+  HBasicBlock* body = loop->GetBackEdges()[0];
+  for (HInstructionIterator it(header->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if (!instruction->IsSuspendCheck() && (copy_exit_test || !instruction->IsIf())) {
+      CopyInstruction(instruction, header_copy, map);
+    }
+  }
+  for (HInstructionIterator it(body->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if (!instruction->IsGoto()) {
+      CopyInstruction(instruction, body_copy, map);
+    }
+  }
+  body_copy->AddInstruction(
+      new (graph_->GetArena()) HGoto(body->GetLastInstruction()->GetDexPc()));
+}
+
+void HLoopOptimization::CopyInstruction(HInstruction* instruction,
+                                        HBasicBlock* block,
+                                        ValueMap* map) {
+  HInstruction* inputs[3];
+  DCHECK_LE(instruction->InputCount(), arraysize(inputs));
+  for (size_t i = 0, e = instruction->InputCount(); i < e; ++i) {
+    inputs[i] = Lookup(*map, instruction->InputAt(i));
+  }
+  HInstruction* copy = CreateCopy(graph_->GetArena(), instruction, inputs);
+  block->AddInstruction(copy);
+  if (instruction->GetType() == Primitive::kPrimNot &&
+      instruction->GetReferenceTypeInfo().IsValid()) {
+    copy->SetReferenceTypeInfo(instruction->GetReferenceTypeInfo());
+  }
+  if (instruction->HasEnvironment()) {
+    copy->CopyEnvironmentFrom(instruction->GetEnvironment());
+    for (HEnvironment* environment = copy->GetEnvironment();
+         environment != nullptr;
+         environment = environment->GetParent()) {
+      for (size_t i = 0, e = environment->Size(); i < e; ++i) {
+        HInstruction* value = environment->GetInstructionAt(i);
+        if (value != nullptr && Lookup(*map, value) != value) {
+          HInstruction* mapped_value = Lookup(*map, value);
+          environment->RemoveAsUserOfInput(i);
+          environment->SetRawEnvAt(i, mapped_value);
+          mapped_value->AddEnvUseAt(environment, i);
+        }
+      }
+    }
+  }
+  map->Put(instruction, copy);
+}
+
+void HLoopOptimization::CreateExitPhis(HBasicBlock* exit,
+                                       const ArenaVector<HPhi*>& exit_values,
+                                       ArenaVector<HPhi*>* exit_phis) {
+  ArenaAllocator* arena = graph_->GetArena();
+  for (HPhi* value : exit_values) {
+    HPhi* phi = new (arena) HPhi(arena, value->GetRegNumber(), 0, value->GetType());
+    phi->AddInput(value);
+    phi->SetCanBeNull(value->CanBeNull());
+    exit->AddPhi(phi);
+    if (value->GetType() == Primitive::kPrimNot && value->GetReferenceTypeInfo().IsValid()) {
+      phi->SetReferenceTypeInfo(value->GetReferenceTypeInfo());
+    }
+    exit_phis->push_back(phi);
+  }
+}
+
+void HLoopOptimization::ReplaceExitUses(HLoopInformation* loop,
+                                        const ArenaVector<HPhi*>& exit_values,
+                                        const ArenaVector<HPhi*>& exit_phis) {
+  for (size_t i = 0, e = exit_values.size(); i < e; ++i) {
+    HPhi* value = exit_values[i];
+    HPhi* phi = exit_phis[i];
+    // All uses after the loop are dominated by the exit block.
+    for (HUseIterator<HInstruction*> it(value->GetUses()); !it.Done();) {
+      HUseListNode<HInstruction*>* use = it.Current();
+      it.Advance();
+      HInstruction* user = use->GetUser();
+      if (user != phi && !loop->Contains(*user->GetBlock())) {
+        user->ReplaceInput(phi, use->GetIndex());
+      }
+    }
+    for (HUseIterator<HEnvironment*> it(value->GetEnvUses()); !it.Done();) {
+      HUseListNode<HEnvironment*>* use = it.Current();
+      it.Advance();
+      HEnvironment* user = use->GetUser();
+      if (!loop->Contains(*user->GetHolder()->GetBlock())) {
+        size_t index = use->GetIndex();
+        user->RemoveAsUserOfInput(index);
+        user->SetRawEnvAt(index, phi);
+        phi->AddEnvUseAt(user, index);
+      }
+    }
+  }
+}
+
+HBasicBlock* HLoopOptimization::NewBlockInLoopsOf(HBasicBlock* block) {
+  HBasicBlock* new_block = new (graph_->GetArena()) HBasicBlock(graph_, block->GetDexPc());
+  graph_->AddBlock(new_block);
+  if (block->IsInLoop()) {
+    new_block->SetLoopInformation(block->GetLoopInformation());
+    for (HLoopInformationOutwardIterator it(*block); !it.Done(); it.Advance()) {
+      it.Current()->Add(new_block);
+    }
+  }
+  return new_block;
+}
+
+HBasicBlock* HLoopOptimization::SplitExitEdge(HBasicBlock* header, HBasicBlock* exit) {
+  HBasicBlock* new_block = NewBlockInLoopsOf(exit);
+  new_block->InsertBetween(header, exit);
+  new_block->AddInstruction(new (graph_->GetArena()) HGoto(exit->GetDexPc()));
+  return new_block;
+}
+
+}  // namespace art
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_LOOP_OPTIMIZATION_H_
+#define ART_COMPILER_OPTIMIZING_LOOP_OPTIMIZATION_H_
+
+#include "base/arena_containers.h"
+#include "driver/compiler_options.h"
+#include "induction_var_range.h"
+#include "nodes.h"
+#include "optimization.h"
+
+namespace art {
+
+/**
+ * Loop unrolling and loop peeling of small innermost loops. The pass only handles loops
+ * that consist of a header, which holds the only exit test, and a single body block.
+ *
+ * Peeling copies the first iteration in front of the loop when the loop contains a
+ * null check, bounds check, division by zero check or type check on loop invariant
+ * values. The copy dominates the remaining loop, so these checks are removed from it.
+ *
+ * Unrolling chains copies of the loop body so that the back edge, and its suspend check,
+ * is only taken once per several iterations. If the trip count is a constant known to
+ * induction variable analysis and is a multiple of the unroll factor, the exit tests of
+ * the copies are omitted. Otherwise, every copy keeps its own exit test.
+ */
+class HLoopOptimization : public HOptimization {
+ public:
+  // The unroll factor and the loop size limits are taken from `compiler_options`.
+  HLoopOptimization(HGraph* graph,
+                    HInductionVarAnalysis* induction_analysis,
+                    const CompilerOptions& compiler_options,
+                    OptimizingCompilerStats* stats = nullptr);
+
+  void Run() OVERRIDE;
+
+  static constexpr const char* kLoopOptimizationPassName = "loop_optimization";
+
+ private:
+  typedef ArenaSafeMap<HInstruction*, HInstruction*> ValueMap;
+
+  // Returns whether `loop` has the shape handled by this pass and only contains
+  // instructions that can be copied. The block the loop exits to is returned in `exit`.
+  bool IsSimpleLoop(HLoopInformation* loop, /*out*/HBasicBlock** exit) const;
+
+  // Collects the header phis of `loop` that are used after the loop. Returns false if
+  // other values defined in the loop are used after it.
+  bool CollectExitValues(HLoopInformation* loop, /*out*/ArenaVector<HPhi*>* exit_values) const;
+
+  // Collects the checks of loop invariant values in `loop`. These checks become
+  // redundant in the loop once its first iteration is peeled.
+  void CollectInvariantChecks(HLoopInformation* loop,
+                              /*out*/ArenaVector<HInstruction*>* checks) const;
+
+  // Copies the first iteration of `loop` in front of it and removes `checks` from the loop.
+  void PeelFirstIteration(HLoopInformation* loop,
+                          HBasicBlock* exit,
+                          const ArenaVector<HPhi*>& exit_values,
+                          const ArenaVector<HInstruction*>& checks);
+
+  // Chains `factor` copies of the body of `loop`. If `keep_exit_tests` is false,
+  // the copies do not test the loop condition.
+  void Unroll(HLoopInformation* loop,
+              HBasicBlock* exit,
+              const ArenaVector<HPhi*>& exit_values,
+              size_t factor,
+              bool keep_exit_tests);
+
+  // Copies the non-phi instructions of the loop header into `header_copy` and the
+  // instructions of the loop body into `body_copy`, which ends with a goto. The values
+  // of the header phis must be given in `map`, which receives the copied instructions.
+  // The suspend check is not copied, and the exit test is only copied if
+  // `copy_exit_test` is true.
+  void CopyLoopBody(HLoopInformation* loop,
+                    HBasicBlock* header_copy,
+                    HBasicBlock* body_copy,
+                    bool copy_exit_test,
+                    ValueMap* map);
+
+  // Copies `instruction` at the end of `block`, with its inputs and environment mapped
+  // through `map`.
+  void CopyInstruction(HInstruction* instruction, HBasicBlock* block, ValueMap* map);
+
+  // Creates a phi in `exit` for each of `exit_values`, which is also its first input.
+  void CreateExitPhis(HBasicBlock* exit,
+                      const ArenaVector<HPhi*>& exit_values,
+                      /*out*/ArenaVector<HPhi*>* exit_phis);
+
+  // Replaces the uses after `loop` of `exit_values` with the corresponding `exit_phis`.
+  void ReplaceExitUses(HLoopInformation* loop,
+                       const ArenaVector<HPhi*>& exit_values,
+                       const ArenaVector<HPhi*>& exit_phis);
+
+  // Creates a new block that belongs to the same loops as `block`.
+  HBasicBlock* NewBlockInLoopsOf(HBasicBlock* block);
+
+  // Splits the edge from `header` to `exit` with a new block, which is returned.
+  HBasicBlock* SplitExitEdge(HBasicBlock* header, HBasicBlock* exit);
+
+  // Range analysis based on induction variables, used to find constant trip counts.
+  InductionVarRange induction_range_;
+
+  // Maximum number of copies of the loop body in an unrolled loop.
+  const size_t max_unroll_factor_;
+
+  // Maximum number of instructions in the body of an unrolled loop, all copies included.
+  const size_t max_unrolled_loop_size_;
+
+  // Maximum number of instructions in a loop whose first iteration is peeled.
+  const size_t max_peeled_loop_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(HLoopOptimization);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_LOOP_OPTIMIZATION_H_
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "base/arena_allocator.h"
+#include "graph_checker.h"
+#include "gtest/gtest.h"
+#include "induction_var_analysis.h"
+#include "loop_optimization.h"
+#include "nodes.h"
+#include "optimizing_unit_test.h"
+
+namespace art {
+
+/**
+ * Fixture class for the loop optimization tests.
+ */
+class LoopOptimizationTest : public testing::Test {
+ public:
+  LoopOptimizationTest() : pool_(), allocator_(&pool_) {
+    graph_ = CreateGraph(&allocator_);
+  }
+
+  ~LoopOptimizationTest() { }
+
+  // Builds the loop
+  //   for (int i = 0; i < bound; i++) { array[i] = 1; }
+  //   return i;
+  // where the bound is the constant 8 if `use_constant_bound` is true, and a parameter
+  // otherwise. If `with_null_check` is true, the array is null checked in the loop body.
+  void BuildLoop(bool use_constant_bound, bool with_null_check) {
+    entry_ = new (&allocator_) HBasicBlock(graph_);
+    HBasicBlock* pre_header = new (&allocator_) HBasicBlock(graph_);
+    loop_header_ = new (&allocator_) HBasicBlock(graph_);
+    loop_body_ = new (&allocator_) HBasicBlock(graph_);
+    return_block_ = new (&allocator_) HBasicBlock(graph_);
+    HBasicBlock* exit = new (&allocator_) HBasicBlock(graph_);
+
+    graph_->AddBlock(entry_);
+    graph_->AddBlock(pre_header);
+    graph_->AddBlock(loop_header_);
+    graph_->AddBlock(loop_body_);
+    graph_->AddBlock(return_block_);
+    graph_->AddBlock(exit);
+    graph_->SetEntryBlock(entry_);
+    graph_->SetExitBlock(exit);
+
+    entry_->AddSuccessor(pre_header);
+    pre_header->AddSuccessor(loop_header_);
+    loop_header_->AddSuccessor(return_block_);  // True successor.
+    loop_header_->AddSuccessor(loop_body_);     // False successor.
+    loop_body_->AddSuccessor(loop_header_);
+    return_block_->AddSuccessor(exit);
+
+    HInstruction* array = new (&allocator_) HParameterValue(
+        graph_->GetDexFile(), 0, 0, Primitive::kPrimNot);
+    HInstruction* parameter = new (&allocator_) HParameterValue(
+        graph_->GetDexFile(), 0, 1, Primitive::kPrimInt);
+    entry_->AddInstruction(array);
+    entry_->AddInstruction(parameter);
+    entry_->AddInstruction(new (&allocator_) HGoto());
+    pre_header->AddInstruction(new (&allocator_) HGoto());
+    HInstruction* constant_0 = graph_->GetIntConstant(0);
+    HInstruction* constant_1 = graph_->GetIntConstant(1);
+    HInstruction* bound = use_constant_bound ? graph_->GetIntConstant(8) : parameter;
+
+    phi_ = new (&allocator_) HPhi(&allocator_, 0, 0, Primitive::kPrimInt);
+    loop_header_->AddPhi(phi_);
+    HInstruction* cmp = new (&allocator_) HGreaterThanOrEqual(phi_, bound);
+    loop_header_->AddInstruction(cmp);
+    loop_header_->AddInstruction(new (&allocator_) HIf(cmp));
+
+    null_check_ = nullptr;
+    if (with_null_check) {
+      null_check_ = new (&allocator_) HNullCheck(array, 0);
+      loop_body_->AddInstruction(null_check_);
+      array = null_check_;
+    }
+    loop_body_->AddInstruction(
+        new (&allocator_) HArraySet(array, phi_, constant_1, Primitive::kPrimInt, 0));
+    HInstruction* add = new (&allocator_) HAdd(Primitive::kPrimInt, phi_, constant_1);
+    loop_body_->AddInstruction(add);
+    loop_body_->AddInstruction(new (&allocator_) HGoto());
+    phi_->AddInput(constant_0);
+    phi_->AddInput(add);
+
+    return_ = new (&allocator_) HReturn(phi_);
+    return_block_->AddInstruction(return_);
+    exit->AddInstruction(new (&allocator_) HExit());
+  }
+
+  // Performs the loop optimizations (after proper set up), and checks the resulting graph.
+  void PerformLoopOptimization() {
+    graph_->BuildDominatorTree();
+    ASSERT_TRUE(graph_->AnalyzeNaturalLoops());
+    HInductionVarAnalysis induction(graph_);
+    induction.Run();
+    HLoopOptimization(graph_, &induction, compiler_options_).Run();
+
+    SSAChecker checker(graph_);
+    checker.Run();
+    ASSERT_TRUE(checker.IsValid());
+  }
+
+  // Counts the instructions of the given kind, inside the loop or outside of it.
+  size_t CountInstructions(HInstruction::InstructionKind kind, bool in_loop) {
+    HLoopInformation* loop = loop_header_->GetLoopInformation();
+    size_t count = 0;
+    for (HReversePostOrderIterator block_it(*graph_); !block_it.Done(); block_it.Advance()) {
+      HBasicBlock* block = block_it.Current();
+      if (loop->Contains(*block) != in_loop) {
+        continue;
+      }
+      for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+        if (it.Current()->GetKind() == kind) {
+          ++count;
+        }
+      }
+    }
+    return count;
+  }
+
+  // General building fields.
+  ArenaPool pool_;
+  ArenaAllocator allocator_;
+  HGraph* graph_;
+  CompilerOptions compiler_options_;
+
+  // Specific basic blocks.
+  HBasicBlock* entry_;
+  HBasicBlock* loop_header_;
+  HBasicBlock* loop_body_;
+  HBasicBlock* return_block_;
+
+  HPhi* phi_;
+  HInstruction* null_check_;
+  HInstruction* return_;
+};
+
+//
+// The actual loop optimization tests.
+//
+
+TEST_F(LoopOptimizationTest, UnrollConstantTripCount) {
+  BuildLoop(/* use_constant_bound */ true, /* with_null_check */ false);
+  PerformLoopOptimization();
+
+  // The trip count is a multiple of the unroll factor, so the copies have no exit test.
+  HLoopInformation* loop = loop_header_->GetLoopInformation();
+  EXPECT_EQ(compiler_options_.GetLoopUnrollFactor(),
+            CountInstructions(HInstruction::kArraySet, /* in_loop */ true));
+  EXPECT_EQ(1u, CountInstructions(HInstruction::kIf, /* in_loop */ true));
+  EXPECT_FALSE(loop->IsBackEdge(*loop_body_));
+  EXPECT_EQ(return_block_, return_->GetBlock());
+  EXPECT_EQ(phi_, return_->InputAt(0));
+}
+
+TEST_F(LoopOptimizationTest, UnrollWithExitTests) {
+  BuildLoop(/* use_constant_bound */ false, /* with_null_check */ false);
+  PerformLoopOptimization();
+
+  // Each copy tests the loop condition, and the loop value is merged after the loop.
+  EXPECT_EQ(compiler_options_.GetLoopUnrollFactor(),
+            CountInstructions(HInstruction::kArraySet, /* in_loop */ true));
+  EXPECT_EQ(compiler_options_.GetLoopUnrollFactor(),
+            CountInstructions(HInstruction::kIf, /* in_loop */ true));
+  HInstruction* exit_value = return_->InputAt(0);
+  ASSERT_TRUE(exit_value->IsPhi());
+  EXPECT_EQ(return_block_, exit_value->GetBlock());
+  EXPECT_EQ(compiler_options_.GetLoopUnrollFactor(), exit_value->InputCount());
+  EXPECT_EQ(phi_, exit_value->InputAt(0));
+}
+
+TEST_F(LoopOptimizationTest, PeelInvariantNullCheck) {
+  BuildLoop(/* use_constant_bound */ false, /* with_null_check */ true);
+  PerformLoopOptimization();
+
+  // The null check of the peeled iteration makes the one in the loop redundant.
+  EXPECT_EQ(nullptr, null_check_->GetBlock());
+  EXPECT_EQ(0u, CountInstructions(HInstruction::kNullCheck, /* in_loop */ true));
+  EXPECT_EQ(1u, CountInstructions(HInstruction::kNullCheck, /* in_loop */ false));
+  EXPECT_EQ(1u, CountInstructions(HInstruction::kArraySet, /* in_loop */ false));
+  EXPECT_TRUE(return_->InputAt(0)->IsPhi());
+  EXPECT_NE(phi_, return_->InputAt(0));
+}
+
+TEST_F(LoopOptimizationTest, NoUnrollOfUnsupportedInstruction) {
+  BuildLoop(/* use_constant_bound */ true, /* with_null_check */ false);
+  HInstruction* barrier = new (&allocator_) HMemoryBarrier(kAnyAny);
+  loop_body_->InsertInstructionBefore(barrier, loop_body_->GetLastInstruction());
+  PerformLoopOptimization();
+
+  EXPECT_EQ(1u, CountInstructions(HInstruction::kArraySet, /* in_loop */ true));
+  EXPECT_TRUE(loop_header_->GetLoopInformation()->IsBackEdge(*loop_body_));
+}
+
+}  // namespace art
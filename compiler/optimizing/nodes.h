@@ -2623,6 +2623,8 @@ class HCondition : public HBinaryOperation {
 
   bool IsGtBias() const { return bias_ == ComparisonBias::kGtBias; }
 
+  ComparisonBias GetBias() const { return bias_; }
+
   void SetBias(ComparisonBias bias) { bias_ = bias; }
 
   bool InstructionDataEquals(HInstruction* other) const OVERRIDE {
@@ -64,6 +64,7 @@
 #include "instruction_simplifier.h"
 #include "intrinsics.h"
 #include "licm.h"
+#include "loop_optimization.h"
 #include "jni/quick/jni_compiler.h"
 #include "nodes.h"
 #include "prepare_for_register_allocation.h"
@@ -481,6 +482,8 @@ static void RunOptimizations(HGraph* graph,
   LICM* licm = new (arena) LICM(graph, *side_effects);
   HInductionVarAnalysis* induction = new (arena) HInductionVarAnalysis(graph);
   BoundsCheckElimination* bce = new (arena) BoundsCheckElimination(graph, induction);
+  HLoopOptimization* loop = new (arena) HLoopOptimization(
+      graph, induction, driver->GetCompilerOptions(), stats);
   ReferenceTypePropagation* type_propagation =
       new (arena) ReferenceTypePropagation(graph, handles);
   InstructionSimplifier* simplify2 = new (arena) InstructionSimplifier(
@@ -530,6 +533,7 @@ static void RunOptimizations(HGraph* graph,
       licm,
       induction,
       bce,
+      loop,
       simplify3,
       dce2,
       // The codegen has a few assumptions that only the instruction simplifier
@@ -558,7 +562,8 @@ static ArrayRef<const uint8_t> AlignVectorSize(ArenaVector<uint8_t>& vector) {
 NO_INLINE  // Avoid increasing caller's frame size by large stack-allocated objects.
 static void AllocateRegisters(HGraph* graph,
                               CodeGenerator* codegen,
-                              PassObserver* pass_observer) {
+                              PassObserver* pass_observer,
+                              RegisterAllocationStrategy strategy) {
   PrepareForRegisterAllocation(graph).Run();
   SsaLivenessAnalysis liveness(graph, codegen);
   {
@@ -567,7 +572,7 @@ static void AllocateRegisters(HGraph* graph,
   }
   {
     PassScope scope(RegisterAllocator::kRegisterAllocatorPassName, pass_observer);
-    RegisterAllocator(graph->GetArena(), codegen, liveness).AllocateRegisters();
+    RegisterAllocator(graph->GetArena(), codegen, liveness, strategy).AllocateRegisters();
   }
 }
 
@@ -595,7 +600,10 @@ CompiledMethod* OptimizingCompiler::CompileOptimized(HGraph* graph,
   RunOptimizations(graph, compiler_driver, compilation_stats_.get(),
                    dex_compilation_unit, pass_observer, &handles);
 
-  AllocateRegisters(graph, codegen, pass_observer);
+  AllocateRegisters(graph,
+                    codegen,
+                    pass_observer,
+                    compiler_driver->GetCompilerOptions().GetRegisterAllocationStrategy());
 
   ArenaAllocator* arena = graph->GetArena();
   CodeVectorAllocator allocator(arena);
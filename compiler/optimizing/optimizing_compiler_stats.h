@@ -51,9 +51,11 @@ enum MethodCompilationStat {
   kNotOptimizedDisabled,
   kNotOptimizedRegisterAllocator,
   kNotOptimizedTryCatch,
+  kPeeledLoop,
   kRemovedCheckedCast,
   kRemovedDeadInstruction,
   kRemovedNullCheck,
+  kUnrolledLoop,
   kLastStat
 };
 
@@ -118,9 +120,11 @@ class OptimizingCompilerStats {
       case kNotOptimizedDisabled : return "kNotOptimizedDisabled";
       case kNotOptimizedRegisterAllocator : return "kNotOptimizedRegisterAllocator";
       case kNotOptimizedTryCatch : return "kNotOptimizedTryCatch";
+      case kPeeledLoop : return "kPeeledLoop";
       case kRemovedCheckedCast: return "kRemovedCheckedCast";
       case kRemovedDeadInstruction: return "kRemovedDeadInstruction";
       case kRemovedNullCheck: return "kRemovedNullCheck";
+      case kUnrolledLoop: return "kUnrolledLoop";
 
       case kLastStat: break;  // Invalid to print out.
     }
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_REGISTER_ALLOCATION_STRATEGY_H_
+#define ART_COMPILER_OPTIMIZING_REGISTER_ALLOCATION_STRATEGY_H_
+
+namespace art {
+
+// How the optimizing compiler allocates registers, see RegisterAllocator. Separate from
+// register_allocator.h so that the compiler options do not depend on the optimizing backend.
+enum RegisterAllocationStrategy {
+  // Fast allocation, suitable for JIT compilation.
+  kRegisterAllocatorLinearScan,
+  // Chaitin-Briggs graph coloring with move coalescing. Slower to run, but usually
+  // generates fewer moves and spills. Intended for ahead-of-time compilation.
+  kRegisterAllocatorGraphColor
+};
+
+static constexpr RegisterAllocationStrategy kRegisterAllocatorDefault =
+    kRegisterAllocatorLinearScan;
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_REGISTER_ALLOCATION_STRATEGY_H_
@@ -39,10 +39,12 @@ static bool IsLowOfUnalignedPairInterval(LiveInterval* low) {
 
 RegisterAllocator::RegisterAllocator(ArenaAllocator* allocator,
                                      CodeGenerator* codegen,
-                                     const SsaLivenessAnalysis& liveness)
+                                     const SsaLivenessAnalysis& liveness,
+                                     RegisterAllocationStrategy strategy)
       : allocator_(allocator),
         codegen_(codegen),
         liveness_(liveness),
+        strategy_(strategy),
         unhandled_core_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
         unhandled_fp_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
         unhandled_(nullptr),
@@ -200,7 +202,11 @@ void RegisterAllocator::AllocateRegistersInternal() {
       inactive_.push_back(fixed);
     }
   }
-  LinearScan();
+  if (strategy_ == kRegisterAllocatorGraphColor) {
+    ColorGraph();
+  } else {
+    LinearScan();
+  }
 
   inactive_.clear();
   active_.clear();
@@ -220,7 +226,11 @@ void RegisterAllocator::AllocateRegistersInternal() {
       inactive_.push_back(fixed);
     }
   }
-  LinearScan();
+  if (strategy_ == kRegisterAllocatorGraphColor) {
+    ColorGraph();
+  } else {
+    LinearScan();
+  }
 }
 
 void RegisterAllocator::ProcessInstruction(HInstruction* instruction) {
@@ -21,6 +21,7 @@
 #include "base/arena_containers.h"
 #include "base/macros.h"
 #include "primitive.h"
+#include "register_allocation_strategy.h"
 
 namespace art {
 
@@ -35,13 +36,16 @@ class Location;
 class SsaLivenessAnalysis;
 
 /**
- * An implementation of a linear scan register allocator on an `HGraph` with SSA form.
+ * A register allocator on an `HGraph` with SSA form. Live intervals are allocated
+ * either by linear scan, or by coloring their interference graph. Both strategies
+ * share the construction of the intervals and the resolution of their locations.
  */
 class RegisterAllocator {
  public:
   RegisterAllocator(ArenaAllocator* allocator,
                     CodeGenerator* codegen,
-                    const SsaLivenessAnalysis& analysis);
+                    const SsaLivenessAnalysis& analysis,
+                    RegisterAllocationStrategy strategy = kRegisterAllocatorDefault);
 
   // Main entry point for the register allocator. Given the liveness analysis,
   // allocates registers to live intervals.
@@ -86,6 +90,30 @@ class RegisterAllocator {
   bool AllocateBlockedReg(LiveInterval* interval);
   void Resolve();
 
+  // Main methods of the graph coloring strategy, see register_allocator_graph_color.cc.
+  // `ColorGraph` allocates the intervals of `unhandled_` in place of `LinearScan`.
+  void ColorGraph();
+  // Returns whether `intervals` could be colored. If not, the intervals preventing the
+  // coloring are replaced by their siblings around register uses, and `split_intervals`
+  // tells whether any was.
+  bool TryColorIntervals(ArenaVector<LiveInterval*>* intervals, bool* split_intervals);
+
+  // Split `interval` so that each of its register uses is covered by a short sibling,
+  // added to `intervals`. The siblings in between are left without a register. If
+  // `at_use_site` is false, siblings start at a block boundary when possible.
+  void SplitAroundRegisterUses(LiveInterval* interval,
+                               bool at_use_site,
+                               ArenaVector<LiveInterval*>* intervals);
+
+  // Record the maximum number of live registers at the slow path safepoints
+  // `safepoint_intervals`, once `intervals` have their registers.
+  void ComputeLiveRegistersAtSlowPaths(const ArenaVector<LiveInterval*>& intervals,
+                                       const ArenaVector<LiveInterval*>& safepoint_intervals);
+
+  // Allocate a spill slot for each value of the current register kind which is
+  // not in a register for its whole lifetime.
+  void AllocateSpillSlotsForSpilledIntervals();
+
   // Add `interval` in the given sorted list.
   static void AddSorted(ArenaVector<LiveInterval*>* array, LiveInterval* interval);
 
@@ -162,6 +190,7 @@ class RegisterAllocator {
   ArenaAllocator* const allocator_;
   CodeGenerator* const codegen_;
   const SsaLivenessAnalysis& liveness_;
+  const RegisterAllocationStrategy strategy_;
 
   // List of intervals for core registers that must be processed, ordered by start
   // position. Last entry is the interval that has the lowest start position.
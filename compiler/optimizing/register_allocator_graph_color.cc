@@ -0,0 +1,1039 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "register_allocator.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/bit_utils.h"
+#include "code_generator.h"
+#include "ssa_liveness_analysis.h"
+#include "utils/arena_bit_vector.h"
+
+// Graph coloring register allocation, in the style of Chaitin-Briggs.
+//
+// The intervals of a register kind are the nodes of an interference graph. Two nodes
+// interfere when their live ranges intersect, and the registers blocked by fixed
+// intervals are forbidden for the nodes they intersect. Nodes related by a move (split
+// siblings, phis and their inputs, and outputs which reuse the register of an input)
+// are merged beforehand when Briggs' conservative test shows this cannot make the graph
+// harder to color. Nodes are then removed from the graph by increasing degree and colored
+// in the reverse order, preferring the colors of the nodes they have a move with.
+//
+// When some nodes cannot be colored, the intervals involved are split around their
+// register uses and spilled in between, and the graph is built again. If coloring does
+// not succeed after a few attempts, the remaining intervals are handed to linear scan.
+//
+// Both strategies share the construction of the intervals and `Resolve`, which inserts
+// the moves between split siblings, and the moves for phis.
+
+namespace art {
+
+// Number of times the interference graph is built before falling back to linear scan.
+static constexpr size_t kMaxGraphColoringAttempts = 16;
+
+static constexpr int kNoColor = -1;
+
+static constexpr float kInfiniteSpillWeight = std::numeric_limits<float>::max();
+
+// Loop nesting deeper than this does not make a use more expensive.
+static constexpr size_t kMaxLoopDepthForWeight = 6;
+
+// Register pairs are (reg, reg + 1), see register_allocator.cc.
+static constexpr uint64_t kLowRegistersMask = UINT64_C(0x5555555555555555);
+
+static uint64_t RegisterMask(int reg) {
+  return UINT64_C(1) << reg;
+}
+
+// Returns the mask of the low registers of the pairs available in `registers`.
+static uint64_t PairsIn(uint64_t registers) {
+  return registers & (registers >> 1) & kLowRegistersMask;
+}
+
+// The cost of a move or a spill in `block`: 10 to the power of its loop depth.
+static float GetLoopWeight(HBasicBlock* block) {
+  float weight = 1.0f;
+  size_t depth = 0;
+  for (HLoopInformationOutwardIterator it(*block);
+       !it.Done() && depth != kMaxLoopDepthForWeight;
+       it.Advance(), ++depth) {
+    weight *= 10.0f;
+  }
+  return weight;
+}
+
+// Returns the position up to which `interval` needs a register for its register
+// use at `position`. Splitting `interval` at the returned position keeps all the
+// uses of the instruction at `position` in the first sibling.
+static size_t EndOfRegisterUse(LiveInterval* interval,
+                               size_t position,
+                               const SsaLivenessAnalysis& liveness) {
+  size_t end = position;
+  if (interval->IsTemp() || (interval->IsParent() && position == interval->GetStart())) {
+    // The definition needs the register until the end of the instruction.
+    end = position + 1;
+  } else if ((position & 1) == 0) {
+    // A use at the start of the instruction, for the first input of an instruction whose
+    // output is the same as its first input. The other inputs are used at the end.
+    for (UsePosition* use = interval->GetFirstUse();
+         use != nullptr && use->GetPosition() <= position + 1;
+         use = use->GetNext()) {
+      if (use->GetPosition() == position + 1) {
+        end = position + 1;
+        break;
+      }
+    }
+  }
+  if ((end & 1) == 1) {
+    HInstruction* instruction = liveness.GetInstructionFromPosition(end / 2);
+    if (instruction != nullptr && instruction->IsControlFlow()) {
+      // Moves cannot be inserted after a branch, keep the register until the next block.
+      ++end;
+    }
+  }
+  return end;
+}
+
+// Returns whether `interval` cannot be split around its register uses any further.
+static bool IsTightInterval(LiveInterval* interval, const SsaLivenessAnalysis& liveness) {
+  if (interval->IsTemp() || interval->HasRegister()) {
+    return true;
+  }
+  size_t first_register_use = interval->FirstRegisterUse();
+  if (first_register_use == kNoLifetime) {
+    return false;
+  }
+  return first_register_use <= interval->GetStart() + 1
+      && interval->GetEnd() <= EndOfRegisterUse(interval, first_register_use, liveness);
+}
+
+// Calls `visitor` on the uses of the instructions which `interval` covers. Uses are
+// shared amongst siblings, and a use at the end of a sibling belongs to that sibling.
+template <typename Visitor>
+static void ForEachUseIn(LiveInterval* interval, Visitor&& visitor) {
+  size_t start = interval->GetStart();
+  size_t end = interval->GetEnd();
+  for (UsePosition* use = interval->GetFirstUse();
+       use != nullptr && use->GetPosition() <= end;
+       use = use->GetNext()) {
+    if (use->GetPosition() > start && !use->IsSynthesized()) {
+      visitor(use);
+    }
+  }
+}
+
+// The spill weight of `interval` is the cost of its uses per lifetime position it covers.
+// Intervals that cannot be split further must get a register.
+static float ComputeSpillWeight(LiveInterval* interval, const SsaLivenessAnalysis& liveness) {
+  if (IsTightInterval(interval, liveness)) {
+    return kInfiniteSpillWeight;
+  }
+  float use_weight = 0.0f;
+  if (interval->IsParent() && interval->GetDefinedBy() != nullptr) {
+    use_weight += GetLoopWeight(interval->GetDefinedBy()->GetBlock());
+  }
+  ForEachUseIn(interval, [&use_weight](UsePosition* use) {
+    use_weight += GetLoopWeight(use->GetUser()->GetBlock());
+  });
+  size_t length = 0;
+  for (LiveRange* range = interval->GetFirstRange(); range != nullptr; range = range->GetNext()) {
+    length += range->GetEnd() - range->GetStart();
+  }
+  return use_weight / length;
+}
+
+// Returns whether `output` can use the register of `input` at its definition. This is
+// the same rule as linear scan's: an output which cannot overlap with the inputs of its
+// instruction may take the register of an input which dies at that instruction.
+static bool CanUseInputRegister(LiveInterval* output, LiveInterval* input) {
+  HInstruction* defined_by = output->GetDefinedBy();
+  if (defined_by == nullptr || !output->IsParent() || defined_by->IsPhi() || input->IsTemp()) {
+    return false;
+  }
+  LocationSummary* locations = defined_by->GetLocations();
+  if (locations->OutputCanOverlapWithInputs() || !locations->Out().IsUnallocated()) {
+    return false;
+  }
+  size_t position = defined_by->GetLifetimePosition();
+  if (output->GetStart() != position
+      || input->GetEnd() != position + 1
+      || !input->CoversSlow(position)
+      || output->HasHighInterval() != input->HasHighInterval()) {
+    return false;
+  }
+  HInstruction* input_value = input->GetParent()->GetDefinedBy();
+  for (HInputIterator it(defined_by); !it.Done(); it.Advance()) {
+    if (it.Current() == input_value) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool Interfere(LiveInterval* first, LiveInterval* second) {
+  LiveRange* first_range = first->GetFirstRange();
+  LiveRange* second_range = second->GetFirstRange();
+  while (first_range != nullptr && second_range != nullptr) {
+    if (first_range->IsBefore(*second_range)) {
+      first_range = first_range->GetNext();
+    } else if (second_range->IsBefore(*first_range)) {
+      second_range = second_range->GetNext();
+    } else {
+      return !CanUseInputRegister(first, second) && !CanUseInputRegister(second, first);
+    }
+  }
+  return false;
+}
+
+class InterferenceNode : public ArenaObject<kArenaAllocRegisterAllocator> {
+ public:
+  InterferenceNode(ArenaAllocator* allocator, LiveInterval* interval, size_t id)
+      : interval_(interval),
+        id_(id),
+        alias_(this),
+        members_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        adjacent_nodes_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        affinities_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        is_pair_(interval->HasHighInterval()),
+        is_precolored_(interval->HasRegister()),
+        is_tight_(false),
+        forbidden_registers_(0u),
+        preferred_registers_(0u),
+        spill_weight_(0.0f),
+        degree_(0u),
+        in_low_degree_worklist_(false),
+        removed_(false),
+        color_(kNoColor),
+        color_mask_(0u) {
+    members_.push_back(this);
+  }
+
+ private:
+  // The interval of this node, and its index in the intervals given to the graph.
+  LiveInterval* const interval_;
+  const size_t id_;
+
+  // The node this node was coalesced into, or this node.
+  InterferenceNode* alias_;
+
+  // For a node which is its own alias, the nodes coalesced into it, including itself.
+  ArenaVector<InterferenceNode*> members_;
+
+  // Interfering nodes, sorted by id. After coalescing, nodes are not updated to the
+  // node they were coalesced into until `Canonicalize` is called.
+  ArenaVector<InterferenceNode*> adjacent_nodes_;
+
+  // Nodes connected to this node by a move.
+  ArenaVector<InterferenceNode*> affinities_;
+
+  const bool is_pair_;
+  const bool is_precolored_;
+  bool is_tight_;
+  uint64_t forbidden_registers_;
+  uint64_t preferred_registers_;
+  float spill_weight_;
+
+  // State of simplification and selection.
+  size_t degree_;
+  bool in_low_degree_worklist_;
+  bool removed_;
+  int color_;
+  uint64_t color_mask_;
+
+  friend class InterferenceGraph;
+
+  DISALLOW_COPY_AND_ASSIGN(InterferenceNode);
+};
+
+class InterferenceGraph : public ValueObject {
+ public:
+  InterferenceGraph(ArenaAllocator* allocator,
+                    const SsaLivenessAnalysis& liveness,
+                    uint64_t allocatable_registers,
+                    uint64_t caller_save_registers)
+      : allocator_(allocator),
+        liveness_(liveness),
+        allocatable_registers_(allocatable_registers),
+        caller_save_registers_(caller_save_registers),
+        nodes_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        interval_nodes_(std::less<LiveInterval*>(),
+                        allocator->Adapter(kArenaAllocRegisterAllocator)),
+        coalesce_opportunities_(allocator->Adapter(kArenaAllocRegisterAllocator)) {}
+
+  // Build the graph of `intervals`. They cannot use the register of an interval
+  // in `fixed_intervals` where it is live.
+  void Build(const ArenaVector<LiveInterval*>& intervals,
+             const ArenaVector<LiveInterval*>& fixed_intervals);
+
+  // Merge the nodes related by a move, when it cannot make the graph harder to color.
+  void Coalesce();
+
+  // Simplify the graph and select a color for each node. Returns whether all nodes
+  // got a color.
+  bool Color();
+
+  // After a successful `Color`, the register of the interval at `index`.
+  int GetColor(size_t index) const {
+    return Find(nodes_[index])->color_;
+  }
+
+  // After an unsuccessful `Color`, mark in `should_split` the intervals to split
+  // before coloring the graph again.
+  void FindIntervalsToSplit(ArenaBitVector* should_split) const;
+
+ private:
+  struct CoalesceOpportunity {
+    InterferenceNode* first;
+    InterferenceNode* second;
+    float weight;
+  };
+
+  static InterferenceNode* Find(InterferenceNode* node) {
+    while (node->alias_ != node) {
+      node->alias_ = node->alias_->alias_;
+      node = node->alias_;
+    }
+    return node;
+  }
+
+  static size_t GetDegreeWeight(InterferenceNode* node) {
+    return node->is_pair_ ? 2u : 1u;
+  }
+
+  uint64_t GetAvailableColors(bool is_pair, uint64_t forbidden_registers) const {
+    uint64_t registers = allocatable_registers_ & ~forbidden_registers;
+    return is_pair ? PairsIn(registers) : registers;
+  }
+
+  size_t GetNumberOfAvailableColors(InterferenceNode* node) const {
+    return POPCOUNT(GetAvailableColors(node->is_pair_, node->forbidden_registers_));
+  }
+
+  void AddInterferences();
+  void AddFixedRegisterConstraints(const ArenaVector<LiveInterval*>& fixed_intervals);
+  void AddPreferredRegisters(InterferenceNode* node);
+  void AddCoalesceOpportunities();
+  void AddCoalesceOpportunity(InterferenceNode* node, LiveInterval* other, HBasicBlock* block);
+  bool AreAdjacent(InterferenceNode* first, InterferenceNode* second) const;
+  void MergeAdjacentNodes(InterferenceNode* first,
+                          InterferenceNode* second,
+                          ArenaVector<InterferenceNode*>* merged) const;
+  void Canonicalize(InterferenceNode* node) const;
+  int ChooseColor(InterferenceNode* node, uint64_t occupied_registers) const;
+
+  ArenaAllocator* const allocator_;
+  const SsaLivenessAnalysis& liveness_;
+  const uint64_t allocatable_registers_;
+  const uint64_t caller_save_registers_;
+
+  ArenaVector<InterferenceNode*> nodes_;
+  ArenaSafeMap<LiveInterval*, InterferenceNode*> interval_nodes_;
+  ArenaVector<CoalesceOpportunity> coalesce_opportunities_;
+
+  DISALLOW_COPY_AND_ASSIGN(InterferenceGraph);
+};
+
+void InterferenceGraph::Build(const ArenaVector<LiveInterval*>& intervals,
+                              const ArenaVector<LiveInterval*>& fixed_intervals) {
+  nodes_.reserve(intervals.size());
+  for (size_t i = 0, e = intervals.size(); i != e; ++i) {
+    InterferenceNode* node = new (allocator_) InterferenceNode(allocator_, intervals[i], i);
+    nodes_.push_back(node);
+    interval_nodes_.Put(intervals[i], node);
+  }
+
+  AddInterferences();
+  AddFixedRegisterConstraints(fixed_intervals);
+
+  for (InterferenceNode* node : nodes_) {
+    LiveInterval* interval = node->interval_;
+    node->is_tight_ = IsTightInterval(interval, liveness_);
+    node->spill_weight_ = ComputeSpillWeight(interval, liveness_);
+    AddPreferredRegisters(node);
+    if (node->is_precolored_) {
+      node->color_ = interval->GetRegister();
+      node->color_mask_ = RegisterMask(node->color_);
+      if (node->is_pair_) {
+        DCHECK(interval->GetHighInterval()->HasRegister());
+        node->color_mask_ |= RegisterMask(interval->GetHighInterval()->GetRegister());
+      }
+    }
+  }
+
+  AddCoalesceOpportunities();
+}
+
+void InterferenceGraph::AddInterferences() {
+  // Sweep over the intervals by increasing start position, keeping the intervals
+  // which are still live.
+  ArenaVector<InterferenceNode*> sorted_nodes(nodes_.begin(),
+                                              nodes_.end(),
+                                              allocator_->Adapter(kArenaAllocRegisterAllocator));
+  std::stable_sort(sorted_nodes.begin(),
+                   sorted_nodes.end(),
+                   [](InterferenceNode* lhs, InterferenceNode* rhs) {
+                     return lhs->interval_->GetStart() < rhs->interval_->GetStart();
+                   });
+  ArenaVector<InterferenceNode*> live_nodes(allocator_->Adapter(kArenaAllocRegisterAllocator));
+  for (InterferenceNode* node : sorted_nodes) {
+    size_t start = node->interval_->GetStart();
+    live_nodes.erase(std::remove_if(live_nodes.begin(),
+                                    live_nodes.end(),
+                                    [start](InterferenceNode* live) {
+                                      return live->interval_->IsDeadAt(start);
+                                    }),
+                     live_nodes.end());
+    for (InterferenceNode* live : live_nodes) {
+      if (Interfere(node->interval_, live->interval_)) {
+        node->adjacent_nodes_.push_back(live);
+        live->adjacent_nodes_.push_back(node);
+      }
+    }
+    live_nodes.push_back(node);
+  }
+  for (InterferenceNode* node : nodes_) {
+    std::sort(node->adjacent_nodes_.begin(),
+              node->adjacent_nodes_.end(),
+              [](InterferenceNode* lhs, InterferenceNode* rhs) { return lhs->id_ < rhs->id_; });
+  }
+}
+
+void InterferenceGraph::AddFixedRegisterConstraints(
+    const ArenaVector<LiveInterval*>& fixed_intervals) {
+  // Fixed intervals block their register at a few positions only: the instructions
+  // which use or define that register, calls, and the start of catch blocks.
+  ArenaVector<std::pair<size_t, uint64_t>> blocked(
+      allocator_->Adapter(kArenaAllocRegisterAllocator));
+  for (LiveInterval* fixed : fixed_intervals) {
+    if (fixed == nullptr) {
+      continue;
+    }
+    uint64_t mask = RegisterMask(fixed->GetRegister());
+    for (LiveRange* range = fixed->GetFirstRange(); range != nullptr; range = range->GetNext()) {
+      for (size_t position = range->GetStart(); position != range->GetEnd(); ++position) {
+        blocked.push_back(std::make_pair(position, mask));
+      }
+    }
+  }
+  std::sort(blocked.begin(), blocked.end());
+  size_t merged_size = 0;
+  for (const std::pair<size_t, uint64_t>& entry : blocked) {
+    if (merged_size != 0 && blocked[merged_size - 1].first == entry.first) {
+      blocked[merged_size - 1].second |= entry.second;
+    } else {
+      blocked[merged_size++] = entry;
+    }
+  }
+  blocked.resize(merged_size);
+  if (blocked.empty()) {
+    return;
+  }
+
+  for (InterferenceNode* node : nodes_) {
+    for (LiveRange* range = node->interval_->GetFirstRange();
+         range != nullptr;
+         range = range->GetNext()) {
+      auto it = std::lower_bound(blocked.begin(),
+                                 blocked.end(),
+                                 std::make_pair(range->GetStart(), UINT64_C(0)));
+      for (; it != blocked.end() && it->first < range->GetEnd(); ++it) {
+        node->forbidden_registers_ |= it->second;
+      }
+    }
+  }
+}
+
+void InterferenceGraph::AddPreferredRegisters(InterferenceNode* node) {
+  // Prefer the registers that the uses of the interval expect, to save input moves.
+  ForEachUseIn(node->interval_, [node](UsePosition* use) {
+    if (use->GetUser()->IsPhi()) {
+      return;
+    }
+    Location input = use->GetUser()->GetLocations()->InAt(use->GetInputIndex());
+    if (input.IsRegister() || input.IsFpuRegister()) {
+      node->preferred_registers_ |= RegisterMask(input.reg());
+    } else if (input.IsPair()) {
+      node->preferred_registers_ |= RegisterMask(input.low());
+    }
+  });
+}
+
+void InterferenceGraph::AddCoalesceOpportunity(InterferenceNode* node,
+                                               LiveInterval* other,
+                                               HBasicBlock* block) {
+  if (other == nullptr) {
+    return;
+  }
+  auto it = interval_nodes_.find(other);
+  if (it == interval_nodes_.end() || it->second == node) {
+    return;
+  }
+  InterferenceNode* other_node = it->second;
+  coalesce_opportunities_.push_back({ node, other_node, GetLoopWeight(block) });
+  node->affinities_.push_back(other_node);
+  other_node->affinities_.push_back(node);
+}
+
+void InterferenceGraph::AddCoalesceOpportunities() {
+  for (InterferenceNode* node : nodes_) {
+    LiveInterval* interval = node->interval_;
+    if (interval->IsTemp()) {
+      continue;
+    }
+    size_t start = interval->GetStart();
+
+    // Moves connecting `interval` to the sibling which follows it in the same block.
+    LiveInterval* next_sibling = interval->GetNextSibling();
+    if (next_sibling != nullptr
+        && next_sibling->GetStart() == interval->GetEnd()
+        && !liveness_.IsAtBlockBoundary(interval->GetEnd() / 2)) {
+      AddCoalesceOpportunity(
+          node, next_sibling, liveness_.GetBlockFromPosition(interval->GetEnd() / 2));
+    }
+
+    if (!interval->IsParent()) {
+      // Moves connecting `interval` to the siblings live at the end of the
+      // predecessors of its block, see `ConnectSplitSiblings`.
+      if (liveness_.IsAtBlockBoundary(start / 2)) {
+        HBasicBlock* block = liveness_.GetBlockFromPosition(start / 2);
+        for (HBasicBlock* predecessor : block->GetPredecessors()) {
+          LiveInterval* sibling =
+              interval->GetParent()->GetSiblingAt(predecessor->GetLifetimeEnd() - 1);
+          AddCoalesceOpportunity(node, sibling, predecessor);
+        }
+      }
+      continue;
+    }
+
+    HInstruction* defined_by = interval->GetDefinedBy();
+    if (defined_by->IsPhi()) {
+      if (defined_by->AsPhi()->IsCatchPhi()) {
+        continue;
+      }
+      // Moves of the inputs at the end of the predecessors.
+      HBasicBlock* block = defined_by->GetBlock();
+      for (size_t i = 0, e = defined_by->InputCount(); i != e; ++i) {
+        HBasicBlock* predecessor = block->GetPredecessors()[i];
+        LiveInterval* input = defined_by->InputAt(i)->GetLiveInterval();
+        AddCoalesceOpportunity(
+            node, input->GetSiblingAt(predecessor->GetLifetimeEnd() - 1), predecessor);
+      }
+      continue;
+    }
+
+    LocationSummary* locations = defined_by->GetLocations();
+    Location out = locations->Out();
+    if (!out.IsUnallocated()) {
+      continue;
+    }
+    if (out.GetPolicy() == Location::kSameAsFirstInput) {
+      // The move of the first input to the output before the instruction.
+      if (locations->InAt(0).IsUnallocated()) {
+        LiveInterval* input = defined_by->InputAt(0)->GetLiveInterval();
+        AddCoalesceOpportunity(node, input->GetSiblingAt(start - 1), defined_by->GetBlock());
+      }
+    } else if (!locations->OutputCanOverlapWithInputs()) {
+      // The register of an input which dies at the instruction is free for the output.
+      for (HInputIterator it(defined_by); !it.Done(); it.Advance()) {
+        LiveInterval* input = it.Current()->GetLiveInterval();
+        if (input == nullptr) {
+          continue;
+        }
+        LiveInterval* sibling = input->GetSiblingAt(start);
+        if (sibling != nullptr && sibling->GetEnd() == start + 1) {
+          AddCoalesceOpportunity(node, sibling, defined_by->GetBlock());
+        }
+      }
+    }
+  }
+}
+
+bool InterferenceGraph::AreAdjacent(InterferenceNode* first, InterferenceNode* second) const {
+  if (first->adjacent_nodes_.size() > second->adjacent_nodes_.size()) {
+    std::swap(first, second);
+  }
+  for (InterferenceNode* adjacent : first->adjacent_nodes_) {
+    if (Find(adjacent) == second) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void InterferenceGraph::MergeAdjacentNodes(InterferenceNode* first,
+                                           InterferenceNode* second,
+                                           ArenaVector<InterferenceNode*>* merged) const {
+  merged->clear();
+  for (InterferenceNode* node : { first, second }) {
+    for (InterferenceNode* adjacent : node->adjacent_nodes_) {
+      InterferenceNode* alias = Find(adjacent);
+      if (alias != first && alias != second) {
+        merged->push_back(alias);
+      }
+    }
+  }
+  std::sort(merged->begin(),
+            merged->end(),
+            [](InterferenceNode* lhs, InterferenceNode* rhs) { return lhs->id_ < rhs->id_; });
+  merged->erase(std::unique(merged->begin(), merged->end()), merged->end());
+}
+
+void InterferenceGraph::Canonicalize(InterferenceNode* node) const {
+  for (InterferenceNode*& adjacent : node->adjacent_nodes_) {
+    adjacent = Find(adjacent);
+  }
+  std::sort(node->adjacent_nodes_.begin(),
+            node->adjacent_nodes_.end(),
+            [](InterferenceNode* lhs, InterferenceNode* rhs) { return lhs->id_ < rhs->id_; });
+  node->adjacent_nodes_.erase(
+      std::unique(node->adjacent_nodes_.begin(), node->adjacent_nodes_.end()),
+      node->adjacent_nodes_.end());
+}
+
+void InterferenceGraph::Coalesce() {
+  // Coalesce the most expensive moves first.
+  std::stable_sort(coalesce_opportunities_.begin(),
+                   coalesce_opportunities_.end(),
+                   [](const CoalesceOpportunity& lhs, const CoalesceOpportunity& rhs) {
+                     return lhs.weight > rhs.weight;
+                   });
+
+  ArenaVector<InterferenceNode*> merged(allocator_->Adapter(kArenaAllocRegisterAllocator));
+  for (const CoalesceOpportunity& opportunity : coalesce_opportunities_) {
+    InterferenceNode* first = Find(opportunity.first);
+    InterferenceNode* second = Find(opportunity.second);
+    if (first == second
+        || first->is_precolored_
+        || second->is_precolored_
+        || first->interval_->IsTemp()
+        || second->interval_->IsTemp()
+        || first->is_pair_ != second->is_pair_
+        || AreAdjacent(first, second)) {
+      continue;
+    }
+    uint64_t forbidden_registers = first->forbidden_registers_ | second->forbidden_registers_;
+    size_t number_of_colors = POPCOUNT(GetAvailableColors(first->is_pair_, forbidden_registers));
+    if (number_of_colors == 0) {
+      continue;
+    }
+
+    // Briggs' test: the merged node will be removed by simplification if it has
+    // fewer neighbors of significant degree than available colors.
+    MergeAdjacentNodes(first, second, &merged);
+    size_t significant_degree = 0;
+    for (InterferenceNode* adjacent : merged) {
+      if (adjacent->is_precolored_
+          || adjacent->adjacent_nodes_.size() >= GetNumberOfAvailableColors(adjacent)) {
+        significant_degree += GetDegreeWeight(adjacent);
+      }
+    }
+    if (significant_degree >= number_of_colors) {
+      continue;
+    }
+
+    second->alias_ = first;
+    first->members_.insert(first->members_.end(),
+                           second->members_.begin(),
+                           second->members_.end());
+    first->affinities_.insert(first->affinities_.end(),
+                              second->affinities_.begin(),
+                              second->affinities_.end());
+    first->adjacent_nodes_.swap(merged);
+    first->forbidden_registers_ = forbidden_registers;
+    first->preferred_registers_ |= second->preferred_registers_;
+    first->spill_weight_ = std::max(first->spill_weight_, second->spill_weight_);
+  }
+
+  for (InterferenceNode* node : nodes_) {
+    if (Find(node) == node) {
+      Canonicalize(node);
+    }
+  }
+}
+
+int InterferenceGraph::ChooseColor(InterferenceNode* node, uint64_t occupied_registers) const {
+  uint64_t colors = GetAvailableColors(node->is_pair_,
+                                       node->forbidden_registers_ | occupied_registers);
+  if (colors == 0) {
+    return kNoColor;
+  }
+  // Take the color of a node related by a move, to remove that move.
+  for (InterferenceNode* affinity : node->affinities_) {
+    InterferenceNode* other = Find(affinity);
+    if (other->color_ != kNoColor
+        && other->is_pair_ == node->is_pair_
+        && (colors & RegisterMask(other->color_)) != 0) {
+      return other->color_;
+    }
+  }
+  // Then a register expected by a use, to save an input move.
+  if ((colors & node->preferred_registers_) != 0) {
+    return CTZ(colors & node->preferred_registers_);
+  }
+  // Then a caller save register, which does not need to be saved in the frame.
+  if ((colors & caller_save_registers_) != 0) {
+    return CTZ(colors & caller_save_registers_);
+  }
+  return CTZ(colors);
+}
+
+bool InterferenceGraph::Color() {
+  ArenaVector<InterferenceNode*> low_degree_nodes(
+      allocator_->Adapter(kArenaAllocRegisterAllocator));
+  ArenaVector<InterferenceNode*> high_degree_nodes(
+      allocator_->Adapter(kArenaAllocRegisterAllocator));
+  ArenaVector<InterferenceNode*> stack(allocator_->Adapter(kArenaAllocRegisterAllocator));
+
+  size_t number_of_nodes_to_remove = 0;
+  for (InterferenceNode* node : nodes_) {
+    if (Find(node) != node || node->is_precolored_) {
+      continue;
+    }
+    node->degree_ = 0;
+    for (InterferenceNode* adjacent : node->adjacent_nodes_) {
+      node->degree_ += GetDegreeWeight(adjacent);
+    }
+    if (node->degree_ < GetNumberOfAvailableColors(node)) {
+      node->in_low_degree_worklist_ = true;
+      low_degree_nodes.push_back(node);
+    } else {
+      high_degree_nodes.push_back(node);
+    }
+    ++number_of_nodes_to_remove;
+  }
+
+  // Simplify: remove the nodes which are sure to get a color. When there is none,
+  // optimistically remove the node which is cheapest to spill per neighbor, it may
+  // still get a color if some of its neighbors get the same one.
+  while (number_of_nodes_to_remove != 0) {
+    InterferenceNode* node = nullptr;
+    if (!low_degree_nodes.empty()) {
+      node = low_degree_nodes.back();
+      low_degree_nodes.pop_back();
+    } else {
+      auto best = high_degree_nodes.end();
+      float best_cost = 0.0f;
+      for (auto it = high_degree_nodes.begin(); it != high_degree_nodes.end(); ++it) {
+        InterferenceNode* candidate = *it;
+        if (candidate->removed_ || candidate->in_low_degree_worklist_) {
+          continue;
+        }
+        float cost = candidate->spill_weight_ / (candidate->degree_ + 1);
+        if (best == high_degree_nodes.end() || cost < best_cost) {
+          best = it;
+          best_cost = cost;
+        }
+      }
+      DCHECK(best != high_degree_nodes.end());
+      node = *best;
+      high_degree_nodes.erase(best);
+    }
+    node->removed_ = true;
+    stack.push_back(node);
+    --number_of_nodes_to_remove;
+    for (InterferenceNode* adjacent : node->adjacent_nodes_) {
+      if (adjacent->removed_ || adjacent->is_precolored_) {
+        continue;
+      }
+      DCHECK_GE(adjacent->degree_, GetDegreeWeight(node));
+      adjacent->degree_ -= GetDegreeWeight(node);
+      if (!adjacent->in_low_degree_worklist_
+          && adjacent->degree_ < GetNumberOfAvailableColors(adjacent)) {
+        adjacent->in_low_degree_worklist_ = true;
+        low_degree_nodes.push_back(adjacent);
+      }
+    }
+  }
+
+  // Select: color the nodes in the reverse order of their removal.
+  bool success = true;
+  for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+    InterferenceNode* node = *it;
+    uint64_t occupied_registers = 0u;
+    for (InterferenceNode* adjacent : node->adjacent_nodes_) {
+      occupied_registers |= adjacent->color_mask_;
+    }
+    node->color_ = ChooseColor(node, occupied_registers);
+    if (node->color_ == kNoColor) {
+      success = false;
+    } else {
+      node->color_mask_ = node->is_pair_
+          ? RegisterMask(node->color_) | RegisterMask(node->color_ + 1)
+          : RegisterMask(node->color_);
+    }
+  }
+  return success;
+}
+
+void InterferenceGraph::FindIntervalsToSplit(ArenaBitVector* should_split) const {
+  for (InterferenceNode* node : nodes_) {
+    InterferenceNode* alias = Find(node);
+    if (alias->color_ != kNoColor) {
+      continue;
+    }
+    if (!node->is_tight_) {
+      should_split->SetBit(node->id_);
+      continue;
+    }
+    // The interval of `node` cannot be split further. Free a register for it by
+    // splitting the cheapest neighbor which can be split.
+    InterferenceNode* cheapest = nullptr;
+    for (InterferenceNode* adjacent : alias->adjacent_nodes_) {
+      if (adjacent->is_precolored_) {
+        continue;
+      }
+      bool can_split = false;
+      for (InterferenceNode* member : adjacent->members_) {
+        can_split = can_split || !member->is_tight_;
+      }
+      if (can_split && (cheapest == nullptr || adjacent->spill_weight_ < cheapest->spill_weight_)) {
+        cheapest = adjacent;
+      }
+    }
+    if (cheapest != nullptr) {
+      for (InterferenceNode* member : cheapest->members_) {
+        if (!member->is_tight_) {
+          should_split->SetBit(member->id_);
+        }
+      }
+    }
+  }
+}
+
+void RegisterAllocator::ColorGraph() {
+  DCHECK_LE(number_of_registers_, 64u);
+  ArenaVector<LiveInterval*> intervals(allocator_->Adapter(kArenaAllocRegisterAllocator));
+  ArenaVector<LiveInterval*> safepoint_intervals(
+      allocator_->Adapter(kArenaAllocRegisterAllocator));
+  // The last entry of `unhandled_` is the interval with the lowest start position.
+  for (auto it = unhandled_->rbegin(); it != unhandled_->rend(); ++it) {
+    LiveInterval* interval = *it;
+    if (interval->IsSlowPathSafepoint()) {
+      safepoint_intervals.push_back(interval);
+    } else if (!interval->IsHighInterval()) {
+      // High intervals get the register following the one of their low interval.
+      intervals.push_back(interval);
+    }
+  }
+  unhandled_->clear();
+
+  // Values defined in a fixed register only need it at their definition: split them
+  // after it, so that the rest of their lifetime can be colored like other values.
+  for (size_t i = 0, e = intervals.size(); i != e; ++i) {
+    LiveInterval* interval = intervals[i];
+    if (interval->HasRegister() && !interval->IsTemp()
+        && interval->GetStart() + 1 < interval->GetEnd()) {
+      intervals.push_back(Split(interval, interval->GetStart() + 1));
+    }
+  }
+
+  bool success = false;
+  for (size_t attempt = 0; attempt != kMaxGraphColoringAttempts; ++attempt) {
+    bool split_intervals = false;
+    success = TryColorIntervals(&intervals, &split_intervals);
+    if (success || !split_intervals) {
+      break;
+    }
+  }
+
+  if (success) {
+    ComputeLiveRegistersAtSlowPaths(intervals, safepoint_intervals);
+  } else {
+    // Coloring did not converge, allocate the intervals as split so far with linear scan.
+    // Values defined in a fixed register go first, as they cannot take another register.
+    for (LiveInterval* interval : intervals) {
+      if (interval->HasRegister()) {
+        AddSorted(unhandled_, interval);
+      }
+    }
+    for (LiveInterval* interval : intervals) {
+      if (!interval->HasRegister()) {
+        AddSorted(unhandled_, interval);
+      }
+    }
+    for (LiveInterval* interval : safepoint_intervals) {
+      AddSorted(unhandled_, interval);
+    }
+    LinearScan();
+  }
+
+  AllocateSpillSlotsForSpilledIntervals();
+}
+
+bool RegisterAllocator::TryColorIntervals(ArenaVector<LiveInterval*>* intervals,
+                                          bool* split_intervals) {
+  uint64_t allocatable_registers = 0u;
+  uint64_t caller_save_registers = 0u;
+  for (size_t reg = 0; reg < number_of_registers_; ++reg) {
+    if (!IsBlocked(reg)) {
+      allocatable_registers |= RegisterMask(reg);
+      if (IsCallerSaveRegister(reg)) {
+        caller_save_registers |= RegisterMask(reg);
+      }
+    }
+  }
+  const ArenaVector<LiveInterval*>& physical_register_intervals = processing_core_registers_
+      ? physical_core_register_intervals_
+      : physical_fp_register_intervals_;
+
+  auto add_allocated_register = [this](int reg) {
+    codegen_->AddAllocatedRegister(processing_core_registers_
+        ? Location::RegisterLocation(reg)
+        : Location::FpuRegisterLocation(reg));
+  };
+
+  InterferenceGraph graph(allocator_, liveness_, allocatable_registers, caller_save_registers);
+  graph.Build(*intervals, physical_register_intervals);
+  graph.Coalesce();
+
+  if (graph.Color()) {
+    for (size_t i = 0, e = intervals->size(); i != e; ++i) {
+      LiveInterval* interval = (*intervals)[i];
+      if (!interval->HasRegister()) {
+        interval->SetRegister(graph.GetColor(i));
+      }
+      add_allocated_register(interval->GetRegister());
+      if (interval->HasHighInterval()) {
+        LiveInterval* high = interval->GetHighInterval();
+        if (!high->HasRegister()) {
+          // Register pairs are (reg, reg + 1), see `PairsIn`.
+          high->SetRegister(interval->GetRegister() + 1);
+        }
+        add_allocated_register(high->GetRegister());
+      }
+    }
+    return true;
+  }
+
+  ArenaBitVector should_split(allocator_, intervals->size(), /* expandable */ false);
+  graph.FindIntervalsToSplit(&should_split);
+
+  ArenaVector<LiveInterval*> new_intervals(allocator_->Adapter(kArenaAllocRegisterAllocator));
+  new_intervals.reserve(intervals->size());
+  *split_intervals = false;
+  for (size_t i = 0, e = intervals->size(); i != e; ++i) {
+    LiveInterval* interval = (*intervals)[i];
+    if (!should_split.IsBitSet(i)) {
+      new_intervals.push_back(interval);
+      continue;
+    }
+    *split_intervals = true;
+    size_t first_register_use = interval->FirstRegisterUse();
+    if (first_register_use == kNoLifetime) {
+      // Spill the whole interval.
+      continue;
+    }
+    // An interval which is not needed after its first register use is split right
+    // before that use. Otherwise, find a block boundary to split at.
+    bool at_use_site =
+        interval->GetEnd() <= EndOfRegisterUse(interval, first_register_use, liveness_);
+    SplitAroundRegisterUses(interval, at_use_site, &new_intervals);
+  }
+  intervals->swap(new_intervals);
+  return false;
+}
+
+void RegisterAllocator::SplitAroundRegisterUses(LiveInterval* interval,
+                                                bool at_use_site,
+                                                ArenaVector<LiveInterval*>* intervals) {
+  LiveInterval* current = interval;
+  size_t use = current->FirstRegisterUse();
+  while (use != kNoLifetime) {
+    if (use > current->GetStart() + 1) {
+      // The value stays in its spill slot until just before the use.
+      current = at_use_site
+          ? Split(current, use - 1)
+          : SplitBetween(current, current->GetStart(), use - 1);
+    }
+    intervals->push_back(current);
+    size_t end = EndOfRegisterUse(current, use, liveness_);
+    if (end >= current->GetEnd()) {
+      return;
+    }
+    current = Split(current, end);
+    use = current->FirstRegisterUse();
+  }
+}
+
+void RegisterAllocator::ComputeLiveRegistersAtSlowPaths(
+    const ArenaVector<LiveInterval*>& intervals,
+    const ArenaVector<LiveInterval*>& safepoint_intervals) {
+  if (safepoint_intervals.empty()) {
+    return;
+  }
+  ArenaVector<size_t> positions(allocator_->Adapter(kArenaAllocRegisterAllocator));
+  for (LiveInterval* safepoint : safepoint_intervals) {
+    positions.push_back(safepoint->GetStart());
+  }
+  std::sort(positions.begin(), positions.end());
+  ArenaVector<size_t> live_registers(
+      positions.size(), 0u, allocator_->Adapter(kArenaAllocRegisterAllocator));
+
+  auto count_live_register = [&positions, &live_registers](LiveInterval* interval) {
+    for (LiveRange* range = interval->GetFirstRange(); range != nullptr; range = range->GetNext()) {
+      auto it = std::lower_bound(positions.begin(), positions.end(), range->GetStart());
+      for (; it != positions.end() && *it < range->GetEnd(); ++it) {
+        ++live_registers[it - positions.begin()];
+      }
+    }
+  };
+  for (LiveInterval* interval : intervals) {
+    DCHECK(interval->HasRegister());
+    count_live_register(interval);
+    if (interval->HasHighInterval()) {
+      count_live_register(interval->GetHighInterval());
+    }
+  }
+  const ArenaVector<LiveInterval*>& physical_register_intervals = processing_core_registers_
+      ? physical_core_register_intervals_
+      : physical_fp_register_intervals_;
+  for (LiveInterval* fixed : physical_register_intervals) {
+    if (fixed != nullptr) {
+      count_live_register(fixed);
+    }
+  }
+
+  size_t maximum = *std::max_element(live_registers.begin(), live_registers.end());
+  if (processing_core_registers_) {
+    maximum_number_of_live_core_registers_ =
+        std::max(maximum_number_of_live_core_registers_, maximum);
+  } else {
+    maximum_number_of_live_fp_registers_ =
+        std::max(maximum_number_of_live_fp_registers_, maximum);
+  }
+}
+
+void RegisterAllocator::AllocateSpillSlotsForSpilledIntervals() {
+  // Spill slots are allocated in the order of the values, which is the linear order,
+  // so that values with disjoint lifetimes can share a slot.
+  for (size_t i = 0; i < liveness_.GetNumberOfSsaValues(); ++i) {
+    LiveInterval* interval = liveness_.GetInstructionFromSsaIndex(i)->GetLiveInterval();
+    if (interval == nullptr || interval->IsFloatingPoint() == processing_core_registers_) {
+      continue;
+    }
+    LiveInterval* sibling = interval;
+    while (sibling != nullptr && sibling->HasRegister()) {
+      sibling = sibling->GetNextSibling();
+    }
+    if (sibling != nullptr) {
+      AllocateSpillSlotFor(sibling);
+    }
+  }
+}
+
+}  // namespace art
@@ -35,7 +35,7 @@ namespace art {
 // Note: the register allocator tests rely on the fact that constants have live
 // intervals and registers get allocated to them.
 
-static bool Check(const uint16_t* data) {
+static bool Check(const uint16_t* data, RegisterAllocationStrategy strategy) {
   ArenaPool pool;
   ArenaAllocator allocator(&pool);
   HGraph* graph = CreateGraph(&allocator);
@@ -48,11 +48,16 @@ static bool Check(const uint16_t* data) {
   x86::CodeGeneratorX86 codegen(graph, *features_x86.get(), CompilerOptions());
   SsaLivenessAnalysis liveness(graph, &codegen);
   liveness.Analyze();
-  RegisterAllocator register_allocator(&allocator, &codegen, liveness);
+  RegisterAllocator register_allocator(&allocator, &codegen, liveness, strategy);
   register_allocator.AllocateRegisters();
   return register_allocator.Validate(false);
 }
 
+static bool Check(const uint16_t* data) {
+  return Check(data, kRegisterAllocatorLinearScan)
+      && Check(data, kRegisterAllocatorGraphColor);
+}
+
 /**
  * Unit testing of RegisterAllocator::ValidateIntervals. Register allocator
  * tests are based on this validation method.
@@ -617,6 +622,53 @@ TEST(RegisterAllocatorTest, PhiHint) {
   }
 }
 
+TEST(RegisterAllocatorTest, PhiCoalescingGraphColor) {
+  ArenaPool pool;
+  ArenaAllocator allocator(&pool);
+  HPhi *phi;
+  HInstruction *input1, *input2;
+
+  {
+    HGraph* graph = BuildIfElseWithPhi(&allocator, &phi, &input1, &input2);
+    std::unique_ptr<const X86InstructionSetFeatures> features_x86(
+        X86InstructionSetFeatures::FromCppDefines());
+    x86::CodeGeneratorX86 codegen(graph, *features_x86.get(), CompilerOptions());
+    SsaLivenessAnalysis liveness(graph, &codegen);
+    liveness.Analyze();
+
+    // Check that the phi and its inputs are coalesced, so that no move is needed.
+    RegisterAllocator register_allocator(
+        &allocator, &codegen, liveness, kRegisterAllocatorGraphColor);
+    register_allocator.AllocateRegisters();
+    ASSERT_TRUE(register_allocator.Validate(false));
+
+    ASSERT_TRUE(phi->GetLiveInterval()->HasRegister());
+    ASSERT_EQ(input1->GetLiveInterval()->GetRegister(), phi->GetLiveInterval()->GetRegister());
+    ASSERT_EQ(input2->GetLiveInterval()->GetRegister(), phi->GetLiveInterval()->GetRegister());
+  }
+
+  {
+    HGraph* graph = BuildIfElseWithPhi(&allocator, &phi, &input1, &input2);
+    std::unique_ptr<const X86InstructionSetFeatures> features_x86(
+        X86InstructionSetFeatures::FromCppDefines());
+    x86::CodeGeneratorX86 codegen(graph, *features_x86.get(), CompilerOptions());
+    SsaLivenessAnalysis liveness(graph, &codegen);
+    liveness.Analyze();
+
+    // Set the phi to a specific register, and check that the inputs get allocated
+    // the same register.
+    phi->GetLocations()->UpdateOut(Location::RegisterLocation(2));
+    RegisterAllocator register_allocator(
+        &allocator, &codegen, liveness, kRegisterAllocatorGraphColor);
+    register_allocator.AllocateRegisters();
+    ASSERT_TRUE(register_allocator.Validate(false));
+
+    ASSERT_EQ(input1->GetLiveInterval()->GetRegister(), 2);
+    ASSERT_EQ(input2->GetLiveInterval()->GetRegister(), 2);
+    ASSERT_EQ(phi->GetLiveInterval()->GetRegister(), 2);
+  }
+}
+
 static HGraph* BuildFieldReturn(ArenaAllocator* allocator,
                                 HInstruction** field,
                                 HInstruction** ret) {
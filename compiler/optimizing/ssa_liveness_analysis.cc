@@ -59,10 +59,46 @@ static void AddToListForLinearization(ArenaVector<HBasicBlock*>* worklist, HBasi
   worklist->insert(insert_pos.base(), block);
 }
 
+// Whether blocks which always end up throwing are moved to the end of the linear order.
+static constexpr bool kMoveThrowingBlocksLast = true;
+
+void SsaLivenessAnalysis::FindThrowingBlocks(ArenaBitVector* throwing_blocks) const {
+  // We look for blocks outside of loops whose every path ends with an HThrow. Successors
+  // are visited before their predecessors in post order, so a single pass is enough.
+  // Moving blocks out of a loop would break the loop ranges computed in ComputeLiveRanges,
+  // and with try/catch a throwing block continues in a catch block, so we skip both cases.
+  if (graph_->HasTryCatch()) {
+    return;
+  }
+  for (HPostOrderIterator it(*graph_); !it.Done(); it.Advance()) {
+    HBasicBlock* block = it.Current();
+    if (block->IsEntryBlock() || block->IsExitBlock() || block->IsInLoop()) {
+      continue;
+    }
+    bool throws;
+    if (block->GetLastInstruction()->IsThrow()) {
+      throws = true;
+    } else {
+      throws = !block->GetSuccessors().empty();
+      for (HBasicBlock* successor : block->GetSuccessors()) {
+        if (!throwing_blocks->IsBitSet(successor->GetBlockId())) {
+          throws = false;
+          break;
+        }
+      }
+    }
+    if (throws) {
+      throwing_blocks->SetBit(block->GetBlockId());
+    }
+  }
+}
+
 void SsaLivenessAnalysis::LinearizeGraph() {
   // Create a reverse post ordering with the following properties:
   // - Blocks in a loop are consecutive,
-  // - Back-edge is the last block before loop exits.
+  // - Back-edge is the last block before loop exits,
+  // - Blocks outside of loops which always throw come last, so that the code
+  //   of unlikely paths does not get interleaved with the hot code.
 
   // (1): Record the number of forward predecessors for each block. This is to
   //      ensure the resulting order is reverse post order. We could use the
@@ -84,13 +120,24 @@ void SsaLivenessAnalysis::LinearizeGraph() {
   //      iterate over the successors. When all non-back edge predecessors of a
   //      successor block are visited, the successor block is added in the worklist
   //      following an order that satisfies the requirements to build our linear graph.
+  ArenaBitVector throwing_blocks(graph_->GetArena(), graph_->GetBlocks().size(), false);
+  if (kMoveThrowingBlocksLast) {
+    FindThrowingBlocks(&throwing_blocks);
+  }
+  ArenaVector<HBasicBlock*> deferred_blocks(graph_->GetArena()->Adapter(kArenaAllocSsaLiveness));
   graph_->linear_order_.reserve(graph_->GetReversePostOrder().size());
   ArenaVector<HBasicBlock*> worklist(graph_->GetArena()->Adapter(kArenaAllocSsaLiveness));
   worklist.push_back(graph_->GetEntryBlock());
   do {
     HBasicBlock* current = worklist.back();
     worklist.pop_back();
-    graph_->linear_order_.push_back(current);
+    if (throwing_blocks.IsBitSet(current->GetBlockId()) || current->IsExitBlock()) {
+      // Keeping the relative order of the deferred blocks keeps dominators before the
+      // blocks they dominate. The exit block goes after all of them.
+      deferred_blocks.push_back(current);
+    } else {
+      graph_->linear_order_.push_back(current);
+    }
     for (HBasicBlock* successor : current->GetSuccessors()) {
       int block_id = successor->GetBlockId();
       size_t number_of_remaining_predecessors = forward_predecessors[block_id];
@@ -100,6 +147,18 @@ void SsaLivenessAnalysis::LinearizeGraph() {
       forward_predecessors[block_id] = number_of_remaining_predecessors - 1;
     }
   } while (!worklist.empty());
+
+  HBasicBlock* exit_block = nullptr;
+  for (HBasicBlock* block : deferred_blocks) {
+    if (block->IsExitBlock()) {
+      exit_block = block;
+    } else {
+      graph_->linear_order_.push_back(block);
+    }
+  }
+  if (exit_block != nullptr) {
+    graph_->linear_order_.push_back(exit_block);
+  }
 }
 
 void SsaLivenessAnalysis::NumberInstructions() {
@@ -1176,10 +1176,14 @@ class SsaLivenessAnalysis : public ValueObject {
  private:
   // Linearize the graph so that:
   // (1): a block is always after its dominator,
-  // (2): blocks of loops are contiguous.
+  // (2): blocks of loops are contiguous,
+  // (3): blocks outside of loops that always throw are after all other blocks but the exit.
   // This creates a natural and efficient ordering when visualizing live ranges.
   void LinearizeGraph();
 
+  // Set the bits of the blocks outside of loops from which every path ends with a throw.
+  void FindThrowingBlocks(ArenaBitVector* throwing_blocks) const;
+
   // Give an SSA number to each instruction that defines a value used by another instruction,
   // and setup the lifetime information of each instruction and block.
   void NumberInstructions();
@@ -334,6 +334,8 @@ class X86Assembler FINAL : public Assembler {
   void bsfl(Register dst, const Address& src);
   void bsrl(Register dst, Register src);
   void bsrl(Register dst, const Address& src);
+  void popcntl(Register dst, Register src);
+  void popcntl(Register dst, const Address& src);
 
   void rorl(Register reg, const Immediate& imm);
   void rorl(Register operand, Register shifter);
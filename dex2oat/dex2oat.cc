@@ -60,6 +60,7 @@
 #include "dex/verification_results.h"
 #include "dex/quick_compiler_callbacks.h"
 #include "dex/quick/dex_file_to_method_inliner_map.h"
+#include "driver/compiled_method_cache.h"
 #include "driver/compiler_driver.h"
 #include "driver/compiler_options.h"
 #ifndef MOE
@@ -75,12 +76,14 @@
 #include "mirror/class_loader.h"
 #include "mirror/object-inl.h"
 #include "mirror/object_array-inl.h"
+#include "oat_file.h"
 #include "oat_writer.h"
 #include "os.h"
 #include "runtime.h"
 #include "ScopedLocalRef.h"
 #include "scoped_thread_state_change.h"
 #include "utils.h"
+#include "verifier/verifier_deps.h"
 #include "vector_output_stream.h"
 #include "well_known_classes.h"
 #include "zip_archive.h"
@@ -221,6 +224,11 @@ NO_RETURN static void Usage(const char* fmt, ...) {
   UsageError("  --base=<hex-address>: specifies the base address when creating a boot image.");
   UsageError("      Example: --base=0x50000000");
   UsageError("");
+  UsageError("  --image-format=(uncompressed|zlib): which format to store the image in.");
+  UsageError("      zlib images are smaller on disk but are decompressed into memory when loaded.");
+  UsageError("      Example: --image-format=zlib");
+  UsageError("      Default: uncompressed");
+  UsageError("");
   UsageError("  --boot-image=<file.art>: provide the image file for the boot class path.");
   UsageError("      Example: --boot-image=/system/framework/boot.art");
   UsageError("      Default: $ANDROID_ROOT/system/framework/boot.art");
@@ -258,6 +266,12 @@ NO_RETURN static void Usage(const char* fmt, ...) {
   UsageError("      Example: --compiler-filter=everything");
   UsageError("      Default: speed");
   UsageError("");
+  UsageError("  --register-allocation-strategy=(linear-scan|graph-color): select the register");
+  UsageError("      allocator of the Optimizing backend. graph-color takes longer to compile");
+  UsageError("      but usually generates fewer moves and spills.");
+  UsageError("      Example: --register-allocation-strategy=graph-color");
+  UsageError("      Default: linear-scan");
+  UsageError("");
   UsageError("  --huge-method-max=<method-instruction-count>: threshold size for a huge");
   UsageError("      method for compiler filter tuning.");
   UsageError("      Example: --huge-method-max=%d", CompilerOptions::kDefaultHugeMethodThreshold);
@@ -300,6 +314,25 @@ NO_RETURN static void Usage(const char* fmt, ...) {
              CompilerOptions::kDefaultInlineMaxCodeUnits);
   UsageError("      Default: %d", CompilerOptions::kDefaultInlineMaxCodeUnits);
   UsageError("");
+  UsageError("  --loop-unroll-factor=<copies>: the maximum number of copies of the body of an");
+  UsageError("      unrolled loop. A value of zero or one disables loop unrolling. Honored only");
+  UsageError("      by Optimizing. Intended for development/experimental use.");
+  UsageError("      Example: --loop-unroll-factor=%d", CompilerOptions::kDefaultLoopUnrollFactor);
+  UsageError("      Default: %d", CompilerOptions::kDefaultLoopUnrollFactor);
+  UsageError("");
+  UsageError("  --loop-unroll-max-size=<instruction-count>: the maximum number of instructions");
+  UsageError("      in an unrolled loop, all copies of the body included. Honored only by");
+  UsageError("      Optimizing. Intended for development/experimental use.");
+  UsageError("      Example: --loop-unroll-max-size=%d",
+             CompilerOptions::kDefaultLoopUnrollMaxSize);
+  UsageError("      Default: %d", CompilerOptions::kDefaultLoopUnrollMaxSize);
+  UsageError("");
+  UsageError("  --loop-peel-max-size=<instruction-count>: the maximum number of instructions in");
+  UsageError("      a loop whose first iteration is peeled. A zero value disables loop peeling.");
+  UsageError("      Honored only by Optimizing. Intended for development/experimental use.");
+  UsageError("      Example: --loop-peel-max-size=%d", CompilerOptions::kDefaultLoopPeelMaxSize);
+  UsageError("      Default: %d", CompilerOptions::kDefaultLoopPeelMaxSize);
+  UsageError("");
   UsageError("  --dump-timing: display a breakdown of where time was spent");
   UsageError("");
   UsageError("  --include-patch-information: Include patching information so the generated code");
@@ -339,6 +372,18 @@ NO_RETURN static void Usage(const char* fmt, ...) {
   UsageError("      Used to specify a pass specific option. The setting itself must be integer.");
   UsageError("      Separator used between options is a comma.");
   UsageError("");
+  UsageError("  --input-verifier-deps=<file.oat>: specifies an oat file of an earlier compilation");
+  UsageError("      of the same dex files. Classes it recorded as verified are not verified again");
+  UsageError("      if the classpath still satisfies its verifier dependencies. Only used with a");
+  UsageError("      compiler filter that does not compile, e.g. interpret-only.");
+  UsageError("      Example: --input-verifier-deps=/data/dalvik-cache/arm/app.odex");
+  UsageError("");
+  UsageError("  --compiled-method-cache=<directory>: specifies a directory in which compiled");
+  UsageError("      methods are kept across compilations. Methods found there with the same");
+  UsageError("      code, compiler options and instruction set features are not compiled again.");
+  UsageError("      Only JNI stubs and methods that do not refer to other classes are cached.");
+  UsageError("      Example: --compiled-method-cache=/data/tmp/dex2oat-cache");
+  UsageError("");
   UsageError("  --swap-file=<file-name>:  specifies a file to use for swap.");
   UsageError("      Example: --swap-file=/data/tmp/swap.001");
   UsageError("");
@@ -523,6 +568,7 @@ class Dex2Oat FINAL {
 #else
       image_base_(0x10000000U),
 #endif
+      image_storage_mode_(ImageHeader::kDefaultStorageMode),
       image_classes_zip_filename_(nullptr),
       image_classes_filename_(nullptr),
       compiled_classes_zip_filename_(nullptr),
@@ -576,6 +622,9 @@ class Dex2Oat FINAL {
     int inline_depth_limit = kUnsetInlineDepthLimit;
     static constexpr int kUnsetInlineMaxCodeUnits = -1;
     int inline_max_code_units = kUnsetInlineMaxCodeUnits;
+    int loop_unroll_factor = CompilerOptions::kDefaultLoopUnrollFactor;
+    int loop_unroll_max_size = CompilerOptions::kDefaultLoopUnrollMaxSize;
+    int loop_peel_max_size = CompilerOptions::kDefaultLoopPeelMaxSize;
 
     // Profile file to use
     double top_k_profile_threshold = CompilerOptions::kDefaultTopKProfileThreshold;
@@ -586,6 +635,7 @@ class Dex2Oat FINAL {
     bool watch_dog_enabled = true;
     bool abort_on_hard_verifier_error = false;
     bool requested_specific_compiler = false;
+    RegisterAllocationStrategy register_allocation_strategy = kRegisterAllocatorDefault;
 
     bool implicit_null_checks = false;
     bool implicit_so_checks = false;
@@ -636,6 +686,18 @@ class Dex2Oat FINAL {
     }
   }
 
+  void ParseImageFormat(const StringPiece& option) {
+    DCHECK(option.starts_with("--image-format="));
+    const StringPiece image_format = option.substr(strlen("--image-format="));
+    if (image_format == "uncompressed") {
+      image_storage_mode_ = ImageHeader::kStorageModeUncompressed;
+    } else if (image_format == "zlib") {
+      image_storage_mode_ = ImageHeader::kStorageModeZlib;
+    } else {
+      Usage("Unknown image format: %s", image_format.data());
+    }
+  }
+
   void ParseInstructionSet(const StringPiece& option) {
     DCHECK(option.starts_with("--instruction-set="));
     StringPiece instruction_set_str = option.substr(strlen("--instruction-set=")).data();
@@ -722,6 +784,18 @@ class Dex2Oat FINAL {
     ParseUintOption(option, "--inline-max-code-units=", &parser_options->inline_max_code_units);
   }
 
+  void ParseLoopUnrollFactor(const StringPiece& option, ParserOptions* parser_options) {
+    ParseUintOption(option, "--loop-unroll-factor", &parser_options->loop_unroll_factor);
+  }
+
+  void ParseLoopUnrollMaxSize(const StringPiece& option, ParserOptions* parser_options) {
+    ParseUintOption(option, "--loop-unroll-max-size", &parser_options->loop_unroll_max_size);
+  }
+
+  void ParseLoopPeelMaxSize(const StringPiece& option, ParserOptions* parser_options) {
+    ParseUintOption(option, "--loop-peel-max-size", &parser_options->loop_peel_max_size);
+  }
+
   void ParseDisablePasses(const StringPiece& option, ParserOptions* parser_options) {
     DCHECK(option.starts_with("--disable-passes="));
     const std::string disable_passes = option.substr(strlen("--disable-passes=")).data();
@@ -867,6 +941,12 @@ class Dex2Oat FINAL {
       }
     }
 
+    if (!compiled_method_cache_dir_.empty() &&
+        !OS::DirectoryExists(compiled_method_cache_dir_.c_str())) {
+      Usage("--compiled-method-cache directory %s does not exist",
+            compiled_method_cache_dir_.c_str());
+    }
+
     oat_stripped_ = oat_filename_;
     if (!parser_options->oat_symbols.empty()) {
       oat_unstripped_ = parser_options->oat_symbols;
@@ -969,6 +1049,9 @@ class Dex2Oat FINAL {
                                                 parser_options->num_dex_methods_threshold,
                                                 parser_options->inline_depth_limit,
                                                 parser_options->inline_max_code_units,
+                                                parser_options->loop_unroll_factor,
+                                                parser_options->loop_unroll_max_size,
+                                                parser_options->loop_peel_max_size,
                                                 parser_options->include_patch_information,
                                                 parser_options->top_k_profile_threshold,
                                                 parser_options->debuggable,
@@ -983,7 +1066,8 @@ class Dex2Oat FINAL {
                                                 new PassManagerOptions(
                                                     parser_options->pass_manager_options),
                                                 init_failure_output_.get(),
-                                                parser_options->abort_on_hard_verifier_error));
+                                                parser_options->abort_on_hard_verifier_error,
+                                                parser_options->register_allocation_strategy));
 
     // Done with usage checks, enable watchdog if requested
     if (parser_options->watch_dog_enabled) {
@@ -1095,6 +1179,8 @@ class Dex2Oat FINAL {
         compiled_methods_zip_filename_ = option.substr(strlen("--compiled-methods-zip=")).data();
       } else if (option.starts_with("--base=")) {
         ParseBase(option);
+      } else if (option.starts_with("--image-format=")) {
+        ParseImageFormat(option);
       } else if (option.starts_with("--boot-image=")) {
         parser_options->boot_image_filename = option.substr(strlen("--boot-image=")).data();
       } else if (option.starts_with("--android-root=")) {
@@ -1125,6 +1211,12 @@ class Dex2Oat FINAL {
         ParseInlineDepthLimit(option, parser_options.get());
       } else if (option.starts_with("--inline-max-code-units=")) {
         ParseInlineMaxCodeUnits(option, parser_options.get());
+      } else if (option.starts_with("--loop-unroll-factor=")) {
+        ParseLoopUnrollFactor(option, parser_options.get());
+      } else if (option.starts_with("--loop-unroll-max-size=")) {
+        ParseLoopUnrollMaxSize(option, parser_options.get());
+      } else if (option.starts_with("--loop-peel-max-size=")) {
+        ParseLoopPeelMaxSize(option, parser_options.get());
       } else if (option == "--host") {
         is_host_ = true;
       } else if (option == "--runtime-arg") {
@@ -1184,12 +1276,25 @@ class Dex2Oat FINAL {
         Split(option.substr(strlen("--verbose-methods=")).ToString(), ',', &verbose_methods_);
       } else if (option.starts_with("--dump-init-failures=")) {
         ParseDumpInitFailures(option);
+      } else if (option.starts_with("--input-verifier-deps=")) {
+        input_verifier_deps_filename_ = option.substr(strlen("--input-verifier-deps=")).data();
+      } else if (option.starts_with("--compiled-method-cache=")) {
+        compiled_method_cache_dir_ = option.substr(strlen("--compiled-method-cache=")).data();
       } else if (option.starts_with("--swap-file=")) {
         swap_file_name_ = option.substr(strlen("--swap-file=")).data();
       } else if (option.starts_with("--swap-fd=")) {
         ParseSwapFd(option);
       } else if (option == "--abort-on-hard-verifier-error") {
         parser_options->abort_on_hard_verifier_error = true;
+      } else if (option.starts_with("--register-allocation-strategy=")) {
+        StringPiece strategy = option.substr(strlen("--register-allocation-strategy="));
+        if (strategy == "linear-scan") {
+          parser_options->register_allocation_strategy = kRegisterAllocatorLinearScan;
+        } else if (strategy == "graph-color") {
+          parser_options->register_allocation_strategy = kRegisterAllocatorGraphColor;
+        } else {
+          Usage("Unknown --register-allocation-strategy value %s", strategy.data());
+        }
       } else {
         Usage("Unknown argument %s", option.data());
       }
@@ -1530,7 +1635,81 @@ class Dex2Oat FINAL {
                                  swap_fd_,
                                  profile_file_);
 
+    if (!image_ && compiler_options_->IsVerificationEnabled()) {
+      SetUpVerifierDeps(class_loader);
+    }
+
+    if (!compiled_method_cache_dir_.empty()) {
+      driver_->SetCompiledMethodCacheDirectory(compiled_method_cache_dir_);
+    }
+
     driver_->CompileAll(class_loader, dex_files_, timings_);
+
+    if (driver_->GetCompiledMethodCache() != nullptr) {
+      LOG(INFO) << "Compiled method cache " << compiled_method_cache_dir_ << ": "
+                << driver_->GetCompiledMethodCache()->GetHits() << " hits, "
+                << driver_->GetCompiledMethodCache()->GetMisses() << " misses";
+    }
+  }
+
+  // Record the verifier dependencies of the dex files in the oat file. Reuse the ones from
+  // --input-verifier-deps if they still hold, so that the classes they list as verified are not
+  // verified again.
+  void SetUpVerifierDeps(jobject class_loader) {
+    verifier_deps_.reset(new verifier::VerifierDeps(dex_files_));
+    if (!input_verifier_deps_filename_.empty()) {
+      if (compiler_options_->IsCompilationEnabled()) {
+        // Compiled code needs the per-method results of the verifier.
+        LOG(WARNING) << "Ignoring --input-verifier-deps, the compiler filter compiles code";
+      } else {
+        std::unique_ptr<verifier::VerifierDeps> input_deps(
+            new verifier::VerifierDeps(dex_files_));
+        std::string error_msg;
+        if (!LoadVerifierDeps(input_deps.get(), &error_msg)) {
+          LOG(WARNING) << "Could not use verifier deps of " << input_verifier_deps_filename_
+                       << ": " << error_msg;
+        } else {
+          ScopedObjectAccess soa(Thread::Current());
+          StackHandleScope<1> hs(soa.Self());
+          Handle<mirror::ClassLoader> loader(
+              hs.NewHandle(soa.Decode<mirror::ClassLoader*>(class_loader)));
+          if (input_deps->ValidateDependencies(loader, soa.Self())) {
+            VLOG(compiler) << "Reusing verifier deps of " << input_verifier_deps_filename_;
+            verifier_deps_.swap(input_deps);
+          } else {
+            LOG(WARNING) << "Verifier deps of " << input_verifier_deps_filename_
+                         << " do not hold for the current classpath";
+          }
+        }
+      }
+    }
+    callbacks_->SetVerifierDeps(verifier_deps_.get());
+  }
+
+  bool LoadVerifierDeps(verifier::VerifierDeps* deps, std::string* error_msg) {
+    std::unique_ptr<OatFile> oat_file(OatFile::Open(input_verifier_deps_filename_,
+                                                    input_verifier_deps_filename_,
+                                                    nullptr,
+                                                    nullptr,
+                                                    false,
+                                                    nullptr,
+                                                    error_msg));
+    if (oat_file == nullptr) {
+      return false;
+    }
+    const OatHeader& oat_header = oat_file->GetOatHeader();
+    uint64_t offset = oat_header.GetVerifierDepsOffset();
+    uint64_t size = oat_header.GetVerifierDepsSize();
+    if (size == 0u || offset + size > oat_file->Size()) {
+      *error_msg = StringPrintf("No valid verifier deps section, offset=%" PRIu64
+                                " size=%" PRIu64, offset, size);
+      return false;
+    }
+    if (!deps->Decode(oat_file->Begin() + offset, size)) {
+      *error_msg = "Verifier deps were recorded for different dex files";
+      return false;
+    }
+    return true;
   }
 
   // Notes on the interleaving of creating the image and oat file to
@@ -1869,11 +2048,18 @@ class Dex2Oat FINAL {
 
 #ifndef MOE
   void PrepareImageWriter(uintptr_t image_base) {
-    image_writer_.reset(new ImageWriter(*driver_, image_base, compiler_options_->GetCompilePic()));
+    image_writer_.reset(new ImageWriter(*driver_,
+                                        image_base,
+                                        compiler_options_->GetCompilePic(),
+                                        image_storage_mode_));
   }
 #else
   void PrepareImageWriter(uintptr_t image_base, InstructionSet instruction_set) {
-    image_writer_.reset(new ImageWriter(*driver_, image_base, instruction_set, compiler_options_->GetCompilePic()));
+    image_writer_.reset(new ImageWriter(*driver_,
+                                        image_base,
+                                        instruction_set,
+                                        compiler_options_->GetCompilePic(),
+                                        image_storage_mode_));
   }
 #endif
 
@@ -2026,6 +2212,8 @@ class Dex2Oat FINAL {
   VerificationResults* verification_results_;
 
   DexFileToMethodInlinerMap method_inliner_map_;
+  std::string input_verifier_deps_filename_;
+  std::unique_ptr<verifier::VerifierDeps> verifier_deps_;
   std::unique_ptr<QuickCompilerCallbacks> callbacks_;
 
   // Ownership for the class path files.
@@ -2057,6 +2245,7 @@ class Dex2Oat FINAL {
   std::vector<const char*> runtime_args_;
   std::string image_filename_;
   uintptr_t image_base_;
+  ImageHeader::StorageMode image_storage_mode_;
   const char* image_classes_zip_filename_;
   const char* image_classes_filename_;
   const char* compiled_classes_zip_filename_;
@@ -2085,6 +2274,7 @@ class Dex2Oat FINAL {
   bool dump_slow_timing_;
   std::string dump_cfg_file_name_;
   bool dump_cfg_append_;
+  std::string compiled_method_cache_dir_;
   std::string swap_file_name_;
   int swap_fd_;
   std::string profile_file_;  // Profile file to use
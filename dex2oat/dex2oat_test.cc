@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common_runtime_test.h"
+
+#include "arch/instruction_set.h"
+#include "os.h"
+#include "utils.h"
+
+namespace art {
+
+class Dex2oatTest : public CommonRuntimeTest {
+ protected:
+  virtual void SetUp() {
+    CommonRuntimeTest::SetUp();
+    scratch_dir_ = android_data_ + "/Dex2oatTest";
+    ASSERT_EQ(0, mkdir(scratch_dir_.c_str(), 0700));
+    cache_dir_ = scratch_dir_ + "/cache";
+    ASSERT_EQ(0, mkdir(cache_dir_.c_str(), 0700));
+  }
+
+  virtual void TearDown() {
+    ClearDirectory(scratch_dir_.c_str());
+    ASSERT_EQ(0, rmdir(scratch_dir_.c_str()));
+    CommonRuntimeTest::TearDown();
+  }
+
+  // Returns path to the dex2oat binary.
+  std::string GetDex2OatFilePath() {
+    std::string root = GetTestAndroidRoot();
+    root += "/bin/dex2oat";
+    if (kIsDebugBuild) {
+      root += "d";
+    }
+    return root;
+  }
+
+  // Compile StaticLeafMethods against the core image, using the compiled method cache.
+  bool CompileWithCache(const std::vector<std::string>& extra_args, std::string* error_msg) {
+    std::string file_path = GetDex2OatFilePath();
+    EXPECT_TRUE(OS::FileExists(file_path.c_str())) << file_path << " should be a valid file path";
+
+    std::vector<std::string> argv = {
+        file_path,
+        "--runtime-arg",
+        "-Xnorelocate",
+        "--boot-image=" + GetCoreArtLocation(),
+        "--instruction-set=" + std::string(GetInstructionSetString(kRuntimeISA)),
+        "--dex-file=" + GetTestDexFileName("StaticLeafMethods"),
+        "--oat-file=" + scratch_dir_ + "/StaticLeafMethods.oat",
+        "--compiled-method-cache=" + cache_dir_
+    };
+    if (IsHost()) {
+      argv.push_back("--host");
+    }
+    argv.insert(argv.end(), extra_args.begin(), extra_args.end());
+    return Exec(argv, error_msg);
+  }
+
+  // Returns the paths of the cache entries.
+  std::vector<std::string> GetCacheEntries() {
+    std::vector<std::string> entries;
+    DIR* dir = opendir(cache_dir_.c_str());
+    EXPECT_TRUE(dir != nullptr);
+    if (dir == nullptr) {
+      return entries;
+    }
+    dirent* e;
+    while ((e = readdir(dir)) != nullptr) {
+      if ((strcmp(e->d_name, ".") == 0) || (strcmp(e->d_name, "..") == 0)) {
+        continue;
+      }
+      entries.push_back(cache_dir_ + "/" + e->d_name);
+    }
+    closedir(dir);
+    std::sort(entries.begin(), entries.end());
+    return entries;
+  }
+
+  std::string ReadEntry(const std::string& path) {
+    std::ifstream stream(path, std::ios::binary);
+    std::ostringstream contents;
+    contents << stream.rdbuf();
+    return contents.str();
+  }
+
+  // Set the modification time of all entries far into the past. Cache hits bump it.
+  void AgeEntries() {
+    struct timeval times[2] = { { 1, 0 }, { 1, 0 } };
+    for (const std::string& entry : GetCacheEntries()) {
+      ASSERT_EQ(0, utimes(entry.c_str(), times)) << entry;
+    }
+  }
+
+  bool IsAged(const std::string& path) {
+    struct stat st;
+    EXPECT_EQ(0, stat(path.c_str(), &st)) << path;
+    return st.st_mtime == 1;
+  }
+
+  std::string scratch_dir_;
+  std::string cache_dir_;
+};
+
+TEST_F(Dex2oatTest, CompiledMethodCacheHit) {
+  std::string error_msg;
+  ASSERT_TRUE(CompileWithCache({}, &error_msg)) << error_msg;
+  // The leaf methods only compute on their arguments, each signature gets an entry.
+  std::vector<std::string> entries = GetCacheEntries();
+  ASSERT_FALSE(entries.empty());
+
+  AgeEntries();
+  ASSERT_TRUE(CompileWithCache({}, &error_msg)) << error_msg;
+  // Every method compiled in the first run was taken from the cache.
+  EXPECT_EQ(entries, GetCacheEntries());
+  for (const std::string& entry : entries) {
+    EXPECT_FALSE(IsAged(entry)) << entry;
+  }
+}
+
+TEST_F(Dex2oatTest, CompiledMethodCacheKeysOnCompilerOptions) {
+  std::string error_msg;
+  ASSERT_TRUE(CompileWithCache({}, &error_msg)) << error_msg;
+  std::vector<std::string> entries = GetCacheEntries();
+  ASSERT_FALSE(entries.empty());
+
+  AgeEntries();
+  ASSERT_TRUE(CompileWithCache({ "--debuggable" }, &error_msg)) << error_msg;
+  // Debuggable code is cached under different keys, the earlier entries were not used.
+  std::vector<std::string> debuggable_entries = GetCacheEntries();
+  EXPECT_EQ(2 * entries.size(), debuggable_entries.size());
+  for (const std::string& entry : entries) {
+    EXPECT_TRUE(IsAged(entry)) << entry;
+  }
+}
+
+TEST_F(Dex2oatTest, CompiledMethodCacheDropsInvalidEntries) {
+  std::string error_msg;
+  ASSERT_TRUE(CompileWithCache({}, &error_msg)) << error_msg;
+  std::vector<std::string> entries = GetCacheEntries();
+  ASSERT_FALSE(entries.empty());
+  std::map<std::string, std::string> contents;
+  for (const std::string& entry : entries) {
+    contents[entry] = ReadEntry(entry);
+    // Keep the header but cut the entry short, or garble it completely.
+    std::string invalid = (contents.size() % 2 == 0)
+        ? contents[entry].substr(0, contents[entry].size() / 2)
+        : std::string("not a compiled method");
+    std::ofstream stream(entry, std::ios::binary | std::ios::trunc);
+    stream << invalid;
+  }
+
+  ASSERT_TRUE(CompileWithCache({}, &error_msg)) << error_msg;
+  // The invalid entries were dropped and written again after compiling the methods.
+  EXPECT_EQ(entries, GetCacheEntries());
+  for (const std::string& entry : entries) {
+    EXPECT_EQ(contents[entry], ReadEntry(entry)) << entry;
+  }
+}
+
+}  // namespace art
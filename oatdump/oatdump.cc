@@ -1496,6 +1496,10 @@ class ImageDumper {
 
     os << "IMAGE SIZE: " << image_header_.GetImageSize() << "\n\n";
 
+    os << "IMAGE STORAGE MODE: " << image_header_.GetStorageMode() << "\n\n";
+
+    os << "IMAGE DATA SIZE: " << image_header_.GetDataSize() << "\n\n";
+
     for (size_t i = 0; i < ImageHeader::kSectionCount; ++i) {
       auto section = static_cast<ImageHeader::ImageSections>(i);
       os << "IMAGE SECTION " << section << ": " << image_header_.GetImageSection(section) << "\n\n";
@@ -1664,6 +1668,11 @@ class ImageDumper {
         ImageHeader::kSectionDexCacheArrays);
     const auto& intern_section = image_header_.GetImageSection(
         ImageHeader::kSectionInternedStrings);
+    if (image_header_.GetStorageMode() != ImageHeader::kStorageModeUncompressed) {
+      // Break down the decompressed image, as it is laid out in memory.
+      os << "compressed_art_file_bytes = " << PrettySize(stats_.file_bytes) << "\n\n";
+      stats_.file_bytes = bitmap_section.End();
+    }
     stats_.header_bytes = header_bytes;
     stats_.alignment_bytes += RoundUp(header_bytes, kObjectAlignment) - header_bytes;
     // Add padding between the field and method section.
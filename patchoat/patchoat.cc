@@ -118,6 +118,51 @@ static bool ReadOatPatchDelta(const ElfFile* elf_file, off_t* delta, std::string
   return true;
 }
 
+// Map the image file for patching. A compressed image is decompressed into the layout of an
+// uncompressed image file since the patched image is always written out uncompressed.
+static MemMap* MapImageForPatching(File* input_image,
+                                   int64_t image_len,
+                                   const ImageHeader& image_header,
+                                   std::string* error_msg) {
+  if (image_header.GetStorageMode() == ImageHeader::kStorageModeUncompressed) {
+    return MemMap::MapFile(image_len, PROT_READ | PROT_WRITE, MAP_PRIVATE, input_image->Fd(), 0,
+                           input_image->GetPath().c_str(), error_msg);
+  }
+  const ImageSection& bitmap_section =
+      image_header.GetImageSection(ImageHeader::kSectionImageBitmap);
+  std::unique_ptr<MemMap> compressed(MemMap::MapFile(image_len, PROT_READ, MAP_PRIVATE,
+                                                     input_image->Fd(), 0,
+                                                     input_image->GetPath().c_str(), error_msg));
+  if (compressed.get() == nullptr) {
+    return nullptr;
+  }
+  if (image_header.GetBitmapFileOffset() + bitmap_section.Size() !=
+      static_cast<uint64_t>(image_len)) {
+    *error_msg = StringPrintf("Image file size does not equal end of bitmap: %" PRId64, image_len);
+    return nullptr;
+  }
+  std::unique_ptr<MemMap> image(MemMap::MapAnonymous(input_image->GetPath().c_str(), nullptr,
+                                                     bitmap_section.End(),
+                                                     PROT_READ | PROT_WRITE,
+                                                     /* low_4gb */ false, /* reuse */ false,
+                                                     error_msg));
+  if (image.get() == nullptr) {
+    return nullptr;
+  }
+  if (!image_header.DecompressData(compressed->Begin() + sizeof(ImageHeader),
+                                   image->Begin() + sizeof(ImageHeader),
+                                   error_msg)) {
+    return nullptr;
+  }
+  memcpy(image->Begin() + bitmap_section.Offset(),
+         compressed->Begin() + image_header.GetBitmapFileOffset(),
+         bitmap_section.Size());
+  ImageHeader* uncompressed_header = new (image->Begin()) ImageHeader(image_header);
+  uncompressed_header->SetStorageMode(ImageHeader::kStorageModeUncompressed,
+                                      image_header.GetImageSize() - sizeof(ImageHeader));
+  return image.release();
+}
+
 bool PatchOat::Patch(const std::string& image_location, off_t delta,
                      File* output_image, InstructionSet isa,
                      TimingLogger* timings) {
@@ -177,10 +222,8 @@ bool PatchOat::Patch(const std::string& image_location, off_t delta,
   t.NewTiming("Image and oat Patching setup");
   // Create the map where we will write the image patches to.
   std::string error_msg;
-  std::unique_ptr<MemMap> image(MemMap::MapFile(image_len, PROT_READ | PROT_WRITE, MAP_PRIVATE,
-                                                input_image->Fd(), 0,
-                                                input_image->GetPath().c_str(),
-                                                &error_msg));
+  std::unique_ptr<MemMap> image(
+      MapImageForPatching(input_image.get(), image_len, image_header, &error_msg));
   if (image.get() == nullptr) {
     LOG(ERROR) << "unable to map image file " << input_image->GetPath() << " : " << error_msg;
     return false;
@@ -289,10 +332,8 @@ bool PatchOat::Patch(File* input_oat, const std::string& image_location, off_t d
   t.NewTiming("Image and oat Patching setup");
   // Create the map where we will write the image patches to.
   std::string error_msg;
-  std::unique_ptr<MemMap> image(MemMap::MapFile(image_len, PROT_READ | PROT_WRITE, MAP_PRIVATE,
-                                                input_image->Fd(), 0,
-                                                input_image->GetPath().c_str(),
-                                                &error_msg));
+  std::unique_ptr<MemMap> image(
+      MapImageForPatching(input_image.get(), image_len, image_header, &error_msg));
   if (image.get() == nullptr) {
     LOG(ERROR) << "unable to map image file " << input_image->GetPath() << " : " << error_msg;
     return false;
@@ -47,6 +47,7 @@ LIBART_COMMON_SRC_FILES := \
   dex_instruction.cc \
   elf_file.cc \
   gc/allocation_record.cc \
+  gc/allocation_sampler.cc \
   gc/allocator/dlmalloc.cc \
   gc/allocator/rosalloc.cc \
   gc/accounting/bitmap.cc \
@@ -179,12 +180,14 @@ LIBART_COMMON_SRC_FILES := \
   fault_handler.cc \
   utf.cc \
   utils.cc \
+  verifier/background_verifier.cc \
   verifier/dex_gc_map.cc \
   verifier/instruction_flags.cc \
   verifier/method_verifier.cc \
   verifier/reg_type.cc \
   verifier/reg_type_cache.cc \
   verifier/register_line.cc \
+  verifier/verifier_deps.cc \
   well_known_classes.cc \
   zip_archive.cc
 
@@ -15,6 +15,8 @@
  * limitations under the License.
  */
 
+#include <math.h>
+
 #include "entrypoints/jni/jni_entrypoints.h"
 #include "entrypoints/quick/quick_alloc_entrypoints.h"
 #include "entrypoints/quick/quick_default_externs.h"
@@ -25,7 +27,6 @@
 #include "interpreter/interpreter.h"
 
 #ifdef MOE
-#include <math.h>
 #include "arm_eaabi_forward.cc"
 #include "thread-current-inl.h"
 #endif
@@ -212,6 +213,27 @@ void InitEntryPoints(JniEntryPoints* jpoints, QuickEntryPoints* qpoints) {
     qpoints->pF2l = art_quick_f2l;
     qpoints->pL2f = art_quick_l2f;
   }
+  // The libm functions use the soft-float calling convention, so they can only be called
+  // directly from soft-float quick code. They are not intrinsified on ARM.
+  if (kArm32QuickCodeUseSoftFloat) {
+    qpoints->pCos = cos;
+    qpoints->pSin = sin;
+    qpoints->pTan = tan;
+    qpoints->pAtan2 = atan2;
+    qpoints->pExp = exp;
+    qpoints->pLog = log;
+    qpoints->pPow = art_pow;
+    qpoints->pHypot = hypot;
+  } else {
+    qpoints->pCos = nullptr;
+    qpoints->pSin = nullptr;
+    qpoints->pTan = nullptr;
+    qpoints->pAtan2 = nullptr;
+    qpoints->pExp = nullptr;
+    qpoints->pLog = nullptr;
+    qpoints->pPow = nullptr;
+    qpoints->pHypot = nullptr;
+  }
 
   // Intrinsics
   qpoints->pIndexOf = art_quick_indexof;
@@ -31,6 +31,14 @@ static constexpr bool IsDirectEntrypoint(QuickEntrypointEnum entrypoint) {
       entrypoint == kQuickA64Store ||
       entrypoint == kQuickFmod ||
       entrypoint == kQuickFmodf ||
+      entrypoint == kQuickCos ||
+      entrypoint == kQuickSin ||
+      entrypoint == kQuickTan ||
+      entrypoint == kQuickAtan2 ||
+      entrypoint == kQuickExp ||
+      entrypoint == kQuickLog ||
+      entrypoint == kQuickPow ||
+      entrypoint == kQuickHypot ||
       entrypoint == kQuickMemcpy ||
       entrypoint == kQuickL2d ||
       entrypoint == kQuickL2f ||
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <math.h>
+
 #include "atomic.h"
 #include "entrypoints/jni/jni_entrypoints.h"
 #include "entrypoints/quick/quick_alloc_entrypoints.h"
@@ -138,6 +140,14 @@ void InitEntryPoints(JniEntryPoints* jpoints, QuickEntryPoints* qpoints) {
   qpoints->pShlLong = nullptr;
   qpoints->pShrLong = nullptr;
   qpoints->pUshrLong = nullptr;
+  qpoints->pCos = cos;
+  qpoints->pSin = sin;
+  qpoints->pTan = tan;
+  qpoints->pAtan2 = atan2;
+  qpoints->pExp = exp;
+  qpoints->pLog = log;
+  qpoints->pPow = art_pow;
+  qpoints->pHypot = hypot;
 
   // Intrinsics
   qpoints->pIndexOf = art_quick_indexof;
@@ -14,10 +14,13 @@
  * limitations under the License.
  */
 
+#include <math.h>
+
 #include "entrypoints/jni/jni_entrypoints.h"
 #include "entrypoints/quick/quick_alloc_entrypoints.h"
 #include "entrypoints/quick/quick_default_externs.h"
 #include "entrypoints/quick/quick_entrypoints.h"
+#include "entrypoints/math_entrypoints.h"
 #include "entrypoints/runtime_asm_entrypoints.h"
 #include "interpreter/interpreter.h"
 
@@ -101,6 +104,14 @@ void InitEntryPoints(JniEntryPoints* jpoints, QuickEntryPoints* qpoints) {
   qpoints->pShlLong = art_quick_lshl;
   qpoints->pShrLong = art_quick_lshr;
   qpoints->pUshrLong = art_quick_lushr;
+  qpoints->pCos = cos;
+  qpoints->pSin = sin;
+  qpoints->pTan = tan;
+  qpoints->pAtan2 = atan2;
+  qpoints->pExp = exp;
+  qpoints->pLog = log;
+  qpoints->pPow = art_pow;
+  qpoints->pHypot = hypot;
 
   // Intrinsics
   // qpoints->pIndexOf = nullptr;  // Not needed on x86
@@ -60,6 +60,9 @@ class X86InstructionSetFeatures : public InstructionSetFeatures {
 
   bool HasSSE4_1() const { return has_SSE4_1_; }
 
+  // POPCNT has its own CPUID bit, but every x86 core that implements SSE4.2 also has POPCNT.
+  bool HasPopCnt() const { return has_SSE4_2_; }
+
  protected:
   // Parse a string of the form "ssse3" adding these to a new InstructionSetFeatures.
   virtual const InstructionSetFeatures*
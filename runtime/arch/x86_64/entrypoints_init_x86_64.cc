@@ -15,6 +15,8 @@
  * limitations under the License.
  */
 
+#include <math.h>
+
 #include "entrypoints/jni/jni_entrypoints.h"
 #include "entrypoints/quick/quick_alloc_entrypoints.h"
 #include "entrypoints/quick/quick_default_externs.h"
@@ -107,6 +109,14 @@ void InitEntryPoints(JniEntryPoints* jpoints, QuickEntryPoints* qpoints) {
   qpoints->pShlLong = art_quick_lshl;
   qpoints->pShrLong = art_quick_lshr;
   qpoints->pUshrLong = art_quick_lushr;
+  qpoints->pCos = cos;
+  qpoints->pSin = sin;
+  qpoints->pTan = tan;
+  qpoints->pAtan2 = atan2;
+  qpoints->pExp = exp;
+  qpoints->pLog = log;
+  qpoints->pPow = art_pow;
+  qpoints->pHypot = hypot;
 
   // Intrinsics
   qpoints->pStringCompareTo = art_quick_string_compareto;
@@ -44,6 +44,11 @@
 
 namespace art {
 
+// Native methods with this annotation skip the transition out of Runnable like the ones
+// registered with a '!' signature prefix.
+static constexpr const char* kFastNativeAnnotationDescriptor =
+    "Ldalvik/annotation/optimization/FastNative;";
+
 extern "C" void art_quick_invoke_stub(ArtMethod*, uint32_t*, uint32_t, Thread*, JValue*,
                                       const char*);
 extern "C" void art_quick_invoke_static_stub(ArtMethod*, uint32_t*, uint32_t, Thread*, JValue*,
@@ -321,16 +326,28 @@ void ArtMethod::Invoke(Thread* self, uint32_t* args, uint32_t args_size, JValue*
 
 void ArtMethod::RegisterNative(const void* native_method, bool is_fast) {
   CHECK(IsNative()) << PrettyMethod(this);
-  CHECK(!IsFastNative()) << PrettyMethod(this);
   CHECK(native_method != nullptr) << PrettyMethod(this);
   if (is_fast) {
     SetAccessFlags(GetAccessFlags() | kAccFastNative);
+  } else if ((GetAccessFlags() & kAccFastNative) != 0 && !IsAnnotatedWithFastNative()) {
+    // The method was registered with a '!' signature before. Methods annotated with @FastNative
+    // are fast from the time they are loaded, registering them again keeps them fast.
+    SetAccessFlags(GetAccessFlags() & ~kAccFastNative);
   }
   SetEntryPointFromJni(native_method);
 }
 
+bool ArtMethod::IsAnnotatedWithFastNative() {
+  if (IsProxyMethod()) {
+    return false;
+  }
+  return GetDexFile()->IsMethodAnnotationPresent(GetClassDef(),
+                                                 GetDexMethodIndex(),
+                                                 kFastNativeAnnotationDescriptor);
+}
+
 void ArtMethod::UnregisterNative() {
-  CHECK(IsNative() && !IsFastNative()) << PrettyMethod(this);
+  CHECK(IsNative()) << PrettyMethod(this);
   // restore stub to lookup native pointer via dlsym
   RegisterNative(GetJniDlsymLookupStub(), false);
 }
@@ -285,6 +285,11 @@ class ArtMethod FINAL {
 
   void UnregisterNative() SHARED_REQUIRES(Locks::mutator_lock_);
 
+  // Whether this method is annotated with @dalvik.annotation.optimization.FastNative. Only reads
+  // the declaring class and the dex method index, so the class linker may call it before the
+  // access flags are set.
+  bool IsAnnotatedWithFastNative() SHARED_REQUIRES(Locks::mutator_lock_);
+
   static MemberOffset DexCacheResolvedMethodsOffset(size_t pointer_size) {
     return MemberOffset(PtrSizedFieldsOffset(pointer_size) + OFFSETOF_MEMBER(
         PtrSizedFields, dex_cache_resolved_methods_) / sizeof(void*) * pointer_size);
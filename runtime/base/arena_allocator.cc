@@ -85,6 +85,7 @@ const char* const ArenaAllocatorStatsImpl<kCount>::kAllocNames[] = {
   "GVN          ",
   "InductionVar ",
   "BCE          ",
+  "LoopOpt      ",
   "SsaLiveness  ",
   "SsaPhiElim   ",
   "RefTypeProp  ",
@@ -95,6 +96,7 @@ const char* const ArenaAllocatorStatsImpl<kCount>::kAllocNames[] = {
   "CodeGen      ",
   "ParallelMove ",
   "GraphChecker ",
+  "Verifier     ",
 };
 
 template <bool kCount>
@@ -18,6 +18,7 @@
 #define ART_RUNTIME_BASE_SCOPED_ARENA_CONTAINERS_H_
 
 #include <deque>
+#include <map>
 #include <queue>
 #include <set>
 #include <unordered_map>
@@ -57,6 +58,10 @@ template <typename K, typename V, typename Comparator = std::less<K>>
 using ScopedArenaSafeMap =
     SafeMap<K, V, Comparator, ScopedArenaAllocatorAdapter<std::pair<const K, V>>>;
 
+template <typename K, typename V, typename Comparator = std::less<K>>
+using ScopedArenaMultimap =
+    std::multimap<K, V, Comparator, ScopedArenaAllocatorAdapter<std::pair<const K, V>>>;
+
 template <typename K, typename V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
 using ScopedArenaUnorderedMap =
     std::unordered_map<K, V, Hash, KeyEqual, ScopedArenaAllocatorAdapter<std::pair<const K, V>>>;
@@ -86,6 +86,7 @@
 #include "trace.h"
 #include "utils.h"
 #include "utils/dex_cache_arrays_layout-inl.h"
+#include "verifier/background_verifier.h"
 #include "verifier/method_verifier.h"
 #include "well_known_classes.h"
 
@@ -1701,6 +1702,13 @@ mirror::Class* ClassLinker::DefineClass(Thread* self,
    */
   Dbg::PostClassPrepare(h_new_class.Get());
 
+  // Now that the class loader of the dex file is known, its remaining classes may be verified in
+  // the background.
+  verifier::BackgroundVerifier* background_verifier = Runtime::Current()->GetBackgroundVerifier();
+  if (background_verifier != nullptr && class_loader.Get() != nullptr) {
+    background_verifier->MaybeStartVerification(self, dex_file, class_loader);
+  }
+
   return h_new_class.Get();
 }
 
@@ -2244,6 +2252,11 @@ void ClassLinker::LoadMethod(Thread* self,
 
   uint32_t access_flags = it.GetMethodAccessFlags();
 
+  if (UNLIKELY((access_flags & kAccNative) != 0) && dst->IsAnnotatedWithFastNative()) {
+    // The native code opted into fast JNI, see JNI::RegisterNatives.
+    access_flags |= kAccFastNative;
+  }
+
   if (UNLIKELY(strcmp("finalize", method_name) == 0)) {
     // Set finalizable flag on declaring class.
     if (strcmp("V", dex_file.GetShorty(method_id.proto_idx_)) == 0) {
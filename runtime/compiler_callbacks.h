@@ -25,6 +25,7 @@ namespace art {
 namespace verifier {
 
 class MethodVerifier;
+class VerifierDeps;
 
 }  // namespace verifier
 
@@ -45,6 +46,10 @@ class CompilerCallbacks {
   // done so. Return false if relocating in this way would be problematic.
   virtual bool IsRelocationPossible() = 0;
 
+  // The verifier dependencies recorded while verifying the dex files being compiled, if any.
+  virtual verifier::VerifierDeps* GetVerifierDeps() const { return nullptr; }
+  virtual void SetVerifierDeps(verifier::VerifierDeps* deps ATTRIBUTE_UNUSED) {}
+
   bool IsBootImage() {
     return mode_ == CallbackMode::kCompileBootImage;
   }
@@ -1295,6 +1295,41 @@ bool DexFile::IsMethodAnnotationPresent(ArtMethod* method, Handle<mirror::Class>
   return annotation_item != nullptr;
 }
 
+bool DexFile::IsMethodAnnotationPresent(const ClassDef& class_def,
+                                        uint32_t method_idx,
+                                        const char* descriptor) const {
+  const AnnotationsDirectoryItem* annotations_dir = GetAnnotationsDirectory(class_def);
+  if (annotations_dir == nullptr) {
+    return false;
+  }
+  const MethodAnnotationsItem* method_annotations = GetMethodAnnotations(annotations_dir);
+  if (method_annotations == nullptr) {
+    return false;
+  }
+  for (uint32_t i = 0; i < annotations_dir->methods_size_; ++i) {
+    if (method_annotations[i].method_idx_ != method_idx) {
+      continue;
+    }
+    const AnnotationSetItem* annotation_set = GetMethodAnnotationSetItem(method_annotations[i]);
+    if (annotation_set == nullptr) {
+      return false;
+    }
+    for (uint32_t j = 0; j < annotation_set->size_; ++j) {
+      const AnnotationItem* annotation_item = GetAnnotationItem(annotation_set, j);
+      if (annotation_item == nullptr) {
+        continue;
+      }
+      const uint8_t* annotation = annotation_item->annotation_;
+      uint32_t type_index = DecodeUnsignedLeb128(&annotation);
+      if (strcmp(descriptor, StringByTypeIdx(type_index)) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+  return false;
+}
+
 const DexFile::AnnotationSetItem* DexFile::FindAnnotationSetForClass(Handle<mirror::Class> klass)
     const {
   const AnnotationsDirectoryItem* annotations_dir = GetAnnotationsDirectory(*klass->GetClassDef());
@@ -952,6 +952,11 @@ class DexFile {
       SHARED_REQUIRES(Locks::mutator_lock_);
   bool IsMethodAnnotationPresent(ArtMethod* method, Handle<mirror::Class> annotation_class) const
       SHARED_REQUIRES(Locks::mutator_lock_);
+  // Check for an annotation of any visibility on the method by comparing type descriptors. Does
+  // not resolve any type so it may be used while loading the class declaring the method.
+  bool IsMethodAnnotationPresent(const ClassDef& class_def,
+                                 uint32_t method_idx,
+                                 const char* descriptor) const;
 
   const AnnotationSetItem* FindAnnotationSetForClass(Handle<mirror::Class> klass) const
       SHARED_REQUIRES(Locks::mutator_lock_);
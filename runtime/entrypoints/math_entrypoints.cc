@@ -16,6 +16,10 @@
 
 #include "math_entrypoints.h"
 
+#include <math.h>
+
+#include <limits>
+
 #include "entrypoint_utils-inl.h"
 
 namespace art {
@@ -48,4 +52,15 @@ extern "C" int32_t art_f2i(float f) {
   return art_float_to_integral<int32_t, float>(f);
 }
 
+/*
+ * C99 pow returns 1.0 for pow(1.0, y) and pow(-1.0, +/-infinity), even when y is NaN,
+ * while java.lang.Math.pow returns NaN. The other special cases agree.
+ */
+extern "C" double art_pow(double x, double y) {
+  if (fabs(x) == 1.0 && !isfinite(y)) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  return pow(x, y);
+}
+
 }  // namespace art
@@ -25,5 +25,6 @@ extern "C" int64_t art_d2l(double d);
 extern "C" int32_t art_d2i(double d);
 extern "C" int64_t art_f2l(float f);
 extern "C" int32_t art_f2i(float f);
+extern "C" double art_pow(double x, double y);
 
 #endif  // ART_RUNTIME_ENTRYPOINTS_MATH_ENTRYPOINTS_H_
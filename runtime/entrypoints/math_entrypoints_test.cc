@@ -16,6 +16,7 @@
 
 #include "math_entrypoints.h"
 
+#include <cmath>
 #include <limits>
 
 #include "common_runtime_test.h"
@@ -72,4 +73,16 @@ TEST_F(MathEntrypointsTest, FloatToInt) {
   EXPECT_EQ(-100L, art_f2i(-100.0));
 }
 
+TEST_F(MathEntrypointsTest, Pow) {
+  EXPECT_EQ(1024.0, art_pow(2.0, 10.0));
+  EXPECT_EQ(0.25, art_pow(-2.0, -2.0));
+  EXPECT_EQ(1.0, art_pow(1.0, 0.0));
+  EXPECT_EQ(1.0, art_pow(-1.0, 2.0));
+  EXPECT_EQ(1.0, art_pow(std::numeric_limits<double>::quiet_NaN(), 0.0));
+  EXPECT_TRUE(std::isnan(art_pow(1.0, std::numeric_limits<double>::quiet_NaN())));
+  EXPECT_TRUE(std::isnan(art_pow(1.0, std::numeric_limits<double>::infinity())));
+  EXPECT_TRUE(std::isnan(art_pow(-1.0, -std::numeric_limits<double>::infinity())));
+  EXPECT_TRUE(std::isnan(art_pow(-2.0, 0.5)));
+}
+
 }  // namespace art
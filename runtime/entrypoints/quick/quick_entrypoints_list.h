@@ -101,6 +101,14 @@
   V(ShlLong, uint64_t, uint64_t, uint32_t) \
   V(ShrLong, uint64_t, uint64_t, uint32_t) \
   V(UshrLong, uint64_t, uint64_t, uint32_t) \
+  V(Cos, double, double) \
+  V(Sin, double, double) \
+  V(Tan, double, double) \
+  V(Atan2, double, double, double) \
+  V(Exp, double, double) \
+  V(Log, double, double) \
+  V(Pow, double, double, double) \
+  V(Hypot, double, double, double) \
 \
   V(IndexOf, int32_t, void*, uint32_t, uint32_t, uint32_t) \
   V(StringCompareTo, int32_t, void*, void*) \
@@ -50,8 +50,9 @@ extern uint32_t JniMethodStartSynchronized(jobject to_lock, Thread* self) {
 
 // TODO: NO_THREAD_SAFETY_ANALYSIS due to different control paths depending on fast JNI.
 static void GoToRunnable(Thread* self) NO_THREAD_SAFETY_ANALYSIS {
-  ArtMethod* native_method = *self->GetManagedStack()->GetTopQuickFrame();
-  bool is_fast = native_method->IsFastNative();
+  // Follow the transition JniMethodStart() made rather than the flag of the method, which
+  // RegisterNatives() and UnregisterNatives() may change while the native code runs.
+  bool is_fast = (self->GetState() == kRunnable);
   if (!is_fast) {
     self->TransitionFromSuspendedToRunnable();
   } else if (UNLIKELY(self->TestAllFlags())) {
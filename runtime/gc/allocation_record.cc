@@ -213,6 +213,12 @@ struct AllocRecordStackVisitor : public StackVisitor {
   const size_t max_depth;
 };
 
+void AllocRecordStackTrace::Record(Thread* self, size_t max_depth) {
+  // The visitor sets the depth of the trace when destroyed.
+  AllocRecordStackVisitor visitor(self, this, max_depth);
+  visitor.WalkStack();
+}
+
 void AllocRecordObjectMap::SetAllocTrackingEnabled(bool enable) {
   Thread* self = Thread::Current();
   Heap* heap = Runtime::Current()->GetHeap();
@@ -281,11 +287,7 @@ void AllocRecordObjectMap::RecordAllocation(Thread* self, mirror::Object* obj, m
   DCHECK_LE(records->Size(), records->alloc_record_max_);
 
   // Get stack trace.
-  // add scope to make "visitor" destroyed promptly, in order to set the scratch_trace_->depth_
-  {
-    AllocRecordStackVisitor visitor(self, &records->scratch_trace_, records->max_stack_depth_);
-    visitor.WalkStack();
-  }
+  records->scratch_trace_.Record(self, records->max_stack_depth_);
   records->scratch_trace_.SetTid(self->GetTid());
   AllocRecordStackTrace* trace = new AllocRecordStackTrace(records->scratch_trace_);
 
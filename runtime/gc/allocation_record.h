@@ -111,6 +111,10 @@ class AllocRecordStackTrace {
     stack_[index].SetDexPc(dex_pc);
   }
 
+  // Records the top max_depth frames of the stack of self, skipping runtime methods. max_depth
+  // must not exceed the depth given at construction.
+  void Record(Thread* self, size_t max_depth) SHARED_REQUIRES(Locks::mutator_lock_);
+
   bool operator==(const AllocRecordStackTrace& other) const {
     if (this == &other) return true;
     if (tid_ != other.tid_) return false;
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "allocation_sampler.h"
+
+#include <fcntl.h>
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "allocation_record.h"
+#include "art_method-inl.h"
+#include "base/stringprintf.h"
+#include "base/unix_file/fd_file.h"
+#include "mirror/class-inl.h"
+#include "thread.h"
+#include "utils.h"
+
+namespace art {
+namespace gc {
+
+AllocationSampler::AllocationSampler(size_t interval, const std::string& dump_file)
+    : interval_(interval),
+      dump_file_(dump_file),
+      lock_("allocation sampler lock", kAllocTrackerLock),
+      total_samples_(0),
+      dropped_samples_(0) {
+  CHECK_GT(interval_, 0u);
+}
+
+void AllocationSampler::CountAllocation(Thread* self,
+                                        mirror::Class* klass,
+                                        size_t object_bytes,
+                                        size_t bytes) {
+  int64_t bytes_left = self->GetAllocSampleBytesLeft();
+  if (UNLIKELY(bytes_left == 0)) {
+    // First allocation of the thread, the count is never zero after that.
+    bytes_left = interval_;
+  }
+  bytes_left -= static_cast<int64_t>(bytes);
+  if (LIKELY(bytes_left > 0)) {
+    self->SetAllocSampleBytesLeft(bytes_left);
+    return;
+  }
+  // An allocation spanning several intervals stands for as many samples.
+  const uint64_t overshoot = static_cast<uint64_t>(-bytes_left);
+  self->SetAllocSampleBytesLeft(interval_ - overshoot % interval_);
+  RecordSample(self, klass, object_bytes, 1 + overshoot / interval_);
+}
+
+void AllocationSampler::RecordSample(Thread* self,
+                                     mirror::Class* klass,
+                                     size_t object_bytes,
+                                     uint64_t samples) {
+  // Build the site before taking the lock, this is the expensive part of sampling.
+  AllocRecordStackTrace trace(kMaxStackDepth);
+  trace.Record(self, kMaxStackDepth);
+  std::string site = PrettyDescriptor(klass);
+  for (size_t i = 0; i < trace.GetDepth(); ++i) {
+    const AllocRecordStackTraceElement& element = trace.GetStackElement(i);
+    ArtMethod* method = element.GetMethod();
+    const char* source_file = method->GetDeclaringClassSourceFile();
+    StringAppendF(&site, "\n  at %s(%s:%d)",
+                  PrettyMethod(method, false).c_str(),
+                  source_file != nullptr ? source_file : "unknown",
+                  element.ComputeLineNumber());
+  }
+  MutexLock mu(self, lock_);
+  total_samples_ += samples;
+  auto it = sites_.find(site);
+  if (it == sites_.end()) {
+    if (sites_.size() >= kMaxSites) {
+      dropped_samples_ += samples;
+      return;
+    }
+    it = sites_.emplace(site, Site()).first;
+  }
+  it->second.samples += samples;
+  ++it->second.objects;
+  it->second.object_bytes += object_bytes;
+}
+
+void AllocationSampler::Dump(std::ostream& os) {
+  MutexLock mu(Thread::Current(), lock_);
+  os << "Allocation samples: " << total_samples_ << " taken every " << PrettySize(interval_)
+     << ", " << sites_.size() << " sites";
+  if (dropped_samples_ != 0) {
+    os << ", " << dropped_samples_ << " samples of dropped sites";
+  }
+  os << "\n";
+  std::vector<std::pair<const std::string*, const Site*>> sorted_sites;
+  sorted_sites.reserve(sites_.size());
+  for (const auto& pair : sites_) {
+    sorted_sites.emplace_back(&pair.first, &pair.second);
+  }
+  std::sort(sorted_sites.begin(), sorted_sites.end(),
+            [](const std::pair<const std::string*, const Site*>& a,
+               const std::pair<const std::string*, const Site*>& b) {
+    return a.second->samples > b.second->samples;
+  });
+  const size_t num_dumped = std::min(sorted_sites.size(), kMaxDumpedSites);
+  for (size_t i = 0; i < num_dumped; ++i) {
+    const Site* site = sorted_sites[i].second;
+    os << site->samples << " samples, ~" << PrettySize(site->samples * interval_)
+       << " allocated, " << site->object_bytes / site->objects << " bytes per object: "
+       << *sorted_sites[i].first << "\n";
+  }
+}
+
+void AllocationSampler::DumpForSigQuit(std::ostream& os) {
+  if (dump_file_.empty()) {
+    Dump(os);
+    return;
+  }
+  std::ostringstream oss;
+  Dump(oss);
+  const std::string s = oss.str();
+  int fd = open(dump_file_.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0666);
+  if (fd == -1) {
+    PLOG(ERROR) << "Unable to open allocation sample file '" << dump_file_ << "'";
+    return;
+  }
+  std::unique_ptr<File> file(new File(fd, dump_file_, true));
+  bool success = file->WriteFully(s.data(), s.size());
+  if (success) {
+    success = file->FlushCloseOrErase() == 0;
+  } else {
+    file->Erase();
+  }
+  if (success) {
+    os << "Allocation samples written to '" << dump_file_ << "'\n";
+  } else {
+    PLOG(ERROR) << "Failed to write allocation samples to '" << dump_file_ << "'";
+  }
+}
+
+uint64_t AllocationSampler::GetTotalSamples() {
+  MutexLock mu(Thread::Current(), lock_);
+  return total_samples_;
+}
+
+}  // namespace gc
+}  // namespace art
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_GC_ALLOCATION_SAMPLER_H_
+#define ART_RUNTIME_GC_ALLOCATION_SAMPLER_H_
+
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "base/mutex.h"
+
+namespace art {
+
+class Thread;
+
+namespace mirror {
+  class Class;
+}  // namespace mirror
+
+namespace gc {
+
+// Samples the allocations of each thread about once every interval bytes, and aggregates the
+// samples by allocated type and allocation site. Unlike the allocation tracker, which records every
+// allocation, it is cheap enough to leave enabled in production.
+//
+// The bytes are only counted when a thread allocates outside of its thread-local buffer or run,
+// which includes refilling it, so the allocation fast paths are unchanged. The bytes of a refilled
+// buffer are attributed to the allocation which triggered the refill.
+class AllocationSampler {
+ public:
+  // Number of frames recorded for an allocation site.
+  static constexpr size_t kMaxStackDepth = 8;
+  // Maximum number of distinct sites, later sites are only counted in the total.
+  static constexpr size_t kMaxSites = 4096;
+  // Number of sites, with the most samples, printed by Dump.
+  static constexpr size_t kMaxDumpedSites = 64;
+
+  // If dump_file is not empty, DumpForSigQuit writes the samples to it.
+  AllocationSampler(size_t interval, const std::string& dump_file);
+
+  size_t GetInterval() const {
+    return interval_;
+  }
+
+  // Counts bytes allocated by self outside of its thread-local buffers for an object of klass
+  // taking object_bytes, and samples this allocation once the thread has allocated interval
+  // bytes since its last sample.
+  void CountAllocation(Thread* self, mirror::Class* klass, size_t object_bytes, size_t bytes)
+      SHARED_REQUIRES(Locks::mutator_lock_)
+      REQUIRES(!lock_);
+
+  // Prints the sites with the most samples and their estimated allocated bytes.
+  void Dump(std::ostream& os) REQUIRES(!lock_);
+  // Writes the samples to the dump file if there is one, prints them to os otherwise.
+  void DumpForSigQuit(std::ostream& os) REQUIRES(!lock_);
+
+  uint64_t GetTotalSamples() REQUIRES(!lock_);
+
+ private:
+  struct Site {
+    Site() : samples(0), objects(0), object_bytes(0) {}
+
+    // Number of samples of this site, each of them standing for interval_ allocated bytes.
+    uint64_t samples;
+    // Number of sampled objects and the sum of their sizes, used to report their mean size.
+    uint64_t objects;
+    uint64_t object_bytes;
+  };
+
+  void RecordSample(Thread* self, mirror::Class* klass, size_t object_bytes, uint64_t samples)
+      SHARED_REQUIRES(Locks::mutator_lock_)
+      REQUIRES(!lock_);
+
+  const size_t interval_;
+  const std::string dump_file_;
+  Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  // Samples by type descriptor followed by the stack of the allocation site.
+  std::unordered_map<std::string, Site> sites_ GUARDED_BY(lock_);
+  uint64_t total_samples_ GUARDED_BY(lock_);
+  // Samples of the sites which did not fit in sites_.
+  uint64_t dropped_samples_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationSampler);
+};
+
+}  // namespace gc
+}  // namespace art
+
+#endif  // ART_RUNTIME_GC_ALLOCATION_SAMPLER_H_
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "allocation_sampler.h"
+
+#include <sstream>
+
+#include "class_linker.h"
+#include "common_runtime_test.h"
+#include "mirror/class-inl.h"
+#include "scoped_thread_state_change.h"
+
+namespace art {
+namespace gc {
+
+class AllocationSamplerTest : public CommonRuntimeTest {};
+
+TEST_F(AllocationSamplerTest, CountAllocation) {
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  mirror::Class* klass = class_linker_->FindSystemClass(self, "Ljava/lang/Object;");
+  ASSERT_TRUE(klass != nullptr);
+  AllocationSampler sampler(1000, "");
+  self->SetAllocSampleBytesLeft(0);
+
+  // 3000 bytes in allocations smaller than the interval make 3 samples.
+  for (size_t i = 0; i < 10; ++i) {
+    sampler.CountAllocation(self, klass, 16, 300);
+  }
+  EXPECT_EQ(3u, sampler.GetTotalSamples());
+  EXPECT_EQ(1000, self->GetAllocSampleBytesLeft());
+
+  // An allocation spanning several intervals stands for as many samples.
+  sampler.CountAllocation(self, klass, 16, 4500);
+  EXPECT_EQ(7u, sampler.GetTotalSamples());
+  EXPECT_EQ(500, self->GetAllocSampleBytesLeft());
+
+  std::ostringstream oss;
+  sampler.Dump(oss);
+  // There are no managed frames, so all the samples have the same site.
+  EXPECT_NE(std::string::npos, oss.str().find("Allocation samples: 7 taken every"));
+  EXPECT_NE(std::string::npos, oss.str().find("7 samples, ~6KB allocated, 16 bytes per object: "
+                                              "java.lang.Object"));
+}
+
+}  // namespace gc
+}  // namespace art
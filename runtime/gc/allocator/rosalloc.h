@@ -632,11 +632,13 @@ class RosAlloc {
 
   // We use thread-local runs for the size Brackets whose indexes
   // are less than this index. We use shared (current) runs for the rest.
-  static const size_t kNumThreadLocalSizeBrackets = 8;
+  // The brackets up to 256 bytes take at most 4 pages per run, which bounds
+  // the memory a thread can hold in partially used thread-local runs.
+  static const size_t kNumThreadLocalSizeBrackets = 16;
 
   // The size of the largest bracket we use thread-local runs for.
   // This should be equal to bracketSizes[kNumThreadLocalSizeBrackets - 1].
-  static const size_t kMaxThreadLocalBracketSize = 128;
+  static const size_t kMaxThreadLocalBracketSize = 256;
 
   // The bracket size increment for the brackets of size <= 512 bytes.
   static constexpr size_t kBracketQuantumSize = 16;
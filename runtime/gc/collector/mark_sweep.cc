@@ -81,6 +81,9 @@ static constexpr bool kVerifyRootsMarked = kIsDebugBuild;
 // If true, revoke the rosalloc thread-local buffers at the
 // checkpoint, as opposed to during the pause.
 static constexpr bool kRevokeRosAllocThreadLocalBuffersAtCheckpoint = true;
+// If true, the remark pause only visits the roots of threads which became runnable since the
+// marking checkpoints visited them.
+static constexpr bool kReMarkOnlyDirtyThreadRoots = true;
 
 void MarkSweep::BindBitmaps() {
   TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
@@ -1066,8 +1069,20 @@ void MarkSweep::RecursiveMarkDirtyObjects(bool paused, uint8_t minimum_age) {
 void MarkSweep::ReMarkRoots() {
   TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
   Locks::mutator_lock_->AssertExclusiveHeld(Thread::Current());
-  Runtime::Current()->VisitRoots(this, static_cast<VisitRootFlags>(
-      kVisitRootFlagNewRoots | kVisitRootFlagStopLoggingNewRoots | kVisitRootFlagClearRootLog));
+  Runtime* const runtime = Runtime::Current();
+  const VisitRootFlags flags = static_cast<VisitRootFlags>(
+      kVisitRootFlagNewRoots | kVisitRootFlagStopLoggingNewRoots | kVisitRootFlagClearRootLog);
+  if (kReMarkOnlyDirtyThreadRoots) {
+    // The thread roots were all marked by the concurrent checkpoints. Only threads which ran
+    // since then need to be rescanned, which keeps the pause independent of the number of threads
+    // blocked or in native code.
+    size_t skipped = runtime->GetThreadList()->VisitDirtyThreadRoots(this);
+    VLOG(heap) << "Skipped remarking roots of " << skipped << " clean threads";
+    runtime->VisitNonThreadRoots(this);
+    runtime->VisitConcurrentRoots(this, flags);
+  } else {
+    runtime->VisitRoots(this, flags);
+  }
   if (kVerifyRootsMarked) {
     TimingLogger::ScopedTiming t2("(Paused)VerifyRoots", GetTimings());
     VerifyRootMarkedVisitor visitor(this);
@@ -1144,6 +1159,9 @@ class CheckpointMarkThreadRoots : public Closure, public RootVisitor {
     CHECK(thread == self || thread->IsSuspended() || thread->GetState() == kWaitingPerformingGc)
         << thread->GetState() << " thread " << thread << " self " << self;
     thread->VisitRoots(this);
+    // A suspended thread cannot change its roots until it becomes runnable again, which marks
+    // it dirty. A thread running the checkpoint itself keeps running after it.
+    thread->SetRootsDirty(thread == self);
     ATRACE_END();
     if (revoke_ros_alloc_thread_local_buffers_at_checkpoint_) {
       ATRACE_BEGIN("RevokeRosAllocThreadLocalBuffers");
@@ -22,6 +22,7 @@
 #include "base/time_utils.h"
 #include "gc/accounting/card_table-inl.h"
 #include "gc/allocation_record.h"
+#include "gc/allocation_sampler.h"
 #include "gc/collector/semi_space.h"
 #include "gc/space/bump_pointer_space-inl.h"
 #include "gc/space/dlmalloc_space-inl.h"
@@ -148,6 +149,12 @@ inline mirror::Object* Heap::AllocObjectWithAllocator(Thread* self,
     new_num_bytes_allocated = static_cast<size_t>(
         num_bytes_allocated_.FetchAndAddSequentiallyConsistent(bytes_tl_bulk_allocated))
         + bytes_tl_bulk_allocated;
+    // Only the allocations which refill a thread-local buffer or bypass it are counted, the bytes
+    // allocated in the buffer are the bulk allocated bytes.
+    if (UNLIKELY(allocation_sampler_ != nullptr) && bytes_tl_bulk_allocated != 0) {
+      allocation_sampler_->CountAllocation(self, obj->GetClass(), bytes_allocated,
+                                           bytes_tl_bulk_allocated);
+    }
   }
   if (kIsDebugBuild && Runtime::Current()->IsStarted()) {
     CHECK_LE(obj->SizeOf(), usable_size);
@@ -302,6 +309,19 @@ inline mirror::Object* Heap::TryToAllocate(Thread* self,
     case kAllocatorTypeTLAB: {
       DCHECK_ALIGNED(alloc_size, space::BumpPointerSpace::kAlignment);
       if (UNLIKELY(self->TlabSize() < alloc_size)) {
+        if (UNLIKELY(allocation_entrypoints_instrumented_)) {
+          // Allocations from a new TLAB in compiled code would not be instrumented.
+          if (UNLIKELY(IsOutOfMemoryOnAllocation<kGrow>(allocator_type, alloc_size))) {
+            return nullptr;
+          }
+          ret = bump_pointer_space_->AllocNonvirtual(alloc_size);
+          if (LIKELY(ret != nullptr)) {
+            *bytes_allocated = alloc_size;
+            *usable_size = alloc_size;
+            *bytes_tl_bulk_allocated = alloc_size;
+          }
+          break;
+        }
         const size_t new_tlab_size = alloc_size + kDefaultTLABSize;
         if (UNLIKELY(IsOutOfMemoryOnAllocation<kGrow>(allocator_type, new_tlab_size))) {
           return nullptr;
@@ -45,6 +45,7 @@
 #include "gc/accounting/mod_union_table-inl.h"
 #include "gc/accounting/remembered_set.h"
 #include "gc/accounting/space_bitmap-inl.h"
+#include "gc/allocation_sampler.h"
 #include "gc/collector/concurrent_copying.h"
 #include "gc/collector/mark_compact.h"
 #include "gc/collector/mark_sweep.h"
@@ -114,9 +115,11 @@ static constexpr size_t kVerifyObjectAllocationStackSize = 16 * KB /
     sizeof(mirror::HeapReference<mirror::Object>);
 static constexpr size_t kDefaultAllocationStackSize = 8 * MB /
     sizeof(mirror::HeapReference<mirror::Object>);
-// System.runFinalization can deadlock with native allocations, to deal with this, we have a
-// timeout on how long we wait for finalizers to run. b/21544853
-static constexpr uint64_t kNativeAllocationFinalizeTimeout = MsToNs(250u);
+// Maximum time a thread registering native allocations past the growth limit is throttled for.
+// This is bounded since the finalizers may be blocked by the thread itself. b/21544853
+static constexpr uint64_t kNativeAllocationMaxStall = MsToNs(250u);
+// Interval at which a throttled thread checks whether the finalizers freed enough native memory.
+static constexpr uint64_t kNativeAllocationStallCheckInterval = MsToNs(2u);
 
 Heap::Heap(size_t initial_size,
            size_t growth_limit,
@@ -175,7 +178,7 @@ Heap::Heap(size_t initial_size,
       growth_limit_(growth_limit),
       max_allowed_footprint_(initial_size),
       native_footprint_gc_watermark_(initial_size),
-      native_need_to_run_finalization_(false),
+      native_need_to_update_footprint_(false),
       // Initially assume we perceive jank in case the process state is never updated.
       process_state_(kProcessStateJankPerceptible),
       concurrent_start_bytes_(std::numeric_limits<size_t>::max()),
@@ -183,6 +186,7 @@ Heap::Heap(size_t initial_size,
       total_objects_freed_ever_(0),
       num_bytes_allocated_(0),
       native_bytes_allocated_(0),
+      old_native_bytes_allocated_(0),
       num_bytes_freed_revoke_(0),
       verify_missing_card_marks_(false),
       verify_system_weaks_(false),
@@ -212,10 +216,15 @@ Heap::Heap(size_t initial_size,
       target_utilization_(target_utilization),
       foreground_heap_growth_multiplier_(foreground_heap_growth_multiplier),
       total_wait_time_(0),
+      native_allocation_stall_count_(0),
+      native_allocation_stall_time_(0),
+      gcs_completed_(0),
+      native_allocation_stall_gcs_completed_(0),
       verify_object_mode_(kVerifyObjectModeDisabled),
       disable_moving_gc_count_(0),
       is_running_on_memory_tool_(Runtime::Current()->IsRunningOnMemoryTool()),
       use_tlab_(use_tlab),
+      allocation_entrypoints_instrumented_(false),
       main_space_backup_(nullptr),
       min_interval_homogeneous_space_compaction_by_oom_(
           min_interval_homogeneous_space_compaction_by_oom),
@@ -1167,6 +1176,7 @@ void Heap::DumpGcPerformanceInfo(std::ostream& os) {
   os << "Total GC time: " << PrettyDuration(GetGcTime()) << "\n";
   os << "Total blocking GC count: " << GetBlockingGcCount() << "\n";
   os << "Total blocking GC time: " << PrettyDuration(GetBlockingGcTime()) << "\n";
+  reference_processor_->DumpFinalizerInfo(os);
 
   {
     MutexLock mu(Thread::Current(), *gc_complete_lock_);
@@ -1181,7 +1191,13 @@ void Heap::DumpGcPerformanceInfo(std::ostream& os) {
       blocking_gc_count_rate_histogram_.DumpBins(os);
       os << "\n";
     }
+    if (native_allocation_stall_count_ > 0U) {
+      os << "Total native allocation stall count: " << native_allocation_stall_count_ << "\n";
+      os << "Total native allocation stall time: "
+         << PrettyDuration(native_allocation_stall_time_) << "\n";
+    }
   }
+  Runtime::Current()->GetThreadList()->DumpTimeToSuspendInfo(os);
 
   BaseMutex::DumpAll(os);
 }
@@ -1203,7 +1219,11 @@ void Heap::ResetGcPerformanceInfo() {
     MutexLock mu(Thread::Current(), *gc_complete_lock_);
     gc_count_rate_histogram_.Reset();
     blocking_gc_count_rate_histogram_.Reset();
+    native_allocation_stall_count_ = 0;
+    native_allocation_stall_time_ = 0;
   }
+  reference_processor_->ResetFinalizerInfo();
+  Runtime::Current()->GetThreadList()->ResetTimeToSuspendInfo();
 }
 
 uint64_t Heap::GetGcCount() const {
@@ -2745,6 +2765,7 @@ void Heap::FinishGC(Thread* self, collector::GcType gc_type) {
     last_gc_type_ = gc_type;
 
     // Update stats.
+    ++gcs_completed_;
     ++gc_count_last_window_;
     if (running_collection_is_blocking_) {
       // If the currently running collection was a blocking one,
@@ -3451,6 +3472,9 @@ void Heap::DumpForSigQuit(std::ostream& os) {
   os << "Heap: " << GetPercentFree() << "% free, " << PrettySize(GetBytesAllocated()) << "/"
      << PrettySize(GetTotalMemory()) << "; " << GetObjectsAllocated() << " objects\n";
   DumpGcPerformanceInfo(os);
+  if (allocation_sampler_ != nullptr) {
+    allocation_sampler_->DumpForSigQuit(os);
+  }
 }
 
 size_t Heap::GetPercentFree() {
@@ -3514,6 +3538,7 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
   const uint64_t bytes_allocated = GetBytesAllocated();
   uint64_t target_size;
   collector::GcType gc_type = collector_ran->GetGcType();
+  old_native_bytes_allocated_.StoreRelaxed(native_bytes_allocated_.LoadRelaxed());
   const double multiplier = HeapGrowthMultiplier();  // Use the multiplier to grow more for
   // foreground.
   const uint64_t adjusted_min_free = static_cast<uint64_t>(min_free_ * multiplier);
@@ -3525,7 +3550,7 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
     target_size = bytes_allocated + delta * multiplier;
     target_size = std::min(target_size, bytes_allocated + adjusted_max_free);
     target_size = std::max(target_size, bytes_allocated + adjusted_min_free);
-    native_need_to_run_finalization_ = true;
+    native_need_to_update_footprint_ = true;
     next_gc_type_ = collector::kGcTypeSticky;
   } else {
     collector::GcType non_sticky_gc_type =
@@ -3632,20 +3657,21 @@ void Heap::AddFinalizerReference(Thread* self, mirror::Object** object) {
 void Heap::RequestConcurrentGCAndSaveObject(Thread* self, bool force_full, mirror::Object** obj) {
   StackHandleScope<1> hs(self);
   HandleWrapper<mirror::Object> wrapper(hs.NewHandleWrapper(obj));
-  RequestConcurrentGC(self, force_full);
+  RequestConcurrentGC(self, kGcCauseBackground, force_full);
 }
 
 class Heap::ConcurrentGCTask : public HeapTask {
  public:
-  ConcurrentGCTask(uint64_t target_time, bool force_full)
-      : HeapTask(target_time), force_full_(force_full) { }
+  ConcurrentGCTask(uint64_t target_time, GcCause cause, bool force_full)
+      : HeapTask(target_time), cause_(cause), force_full_(force_full) { }
   virtual void Run(Thread* self) OVERRIDE {
     gc::Heap* heap = Runtime::Current()->GetHeap();
-    heap->ConcurrentGC(self, force_full_);
+    heap->ConcurrentGC(self, cause_, force_full_);
     heap->ClearConcurrentGCRequest();
   }
 
  private:
+  const GcCause cause_;
   const bool force_full_;  // If true, force full (or partial) collection.
 };
 
@@ -3659,18 +3685,19 @@ void Heap::ClearConcurrentGCRequest() {
   concurrent_gc_pending_.StoreRelaxed(false);
 }
 
-void Heap::RequestConcurrentGC(Thread* self, bool force_full) {
+void Heap::RequestConcurrentGC(Thread* self, GcCause cause, bool force_full) {
   if (CanAddHeapTask(self) &&
       concurrent_gc_pending_.CompareExchangeStrongSequentiallyConsistent(false, true)) {
     task_processor_->AddTask(self, new ConcurrentGCTask(NanoTime(),  // Start straight away.
+                                                        cause,
                                                         force_full));
   }
 }
 
-void Heap::ConcurrentGC(Thread* self, bool force_full) {
+void Heap::ConcurrentGC(Thread* self, GcCause cause, bool force_full) {
   if (!Runtime::Current()->IsShuttingDown(self)) {
     // Wait for any GCs currently running to finish.
-    if (WaitForGcToComplete(kGcCauseBackground, self) == collector::kGcTypeNone) {
+    if (WaitForGcToComplete(cause, self) == collector::kGcTypeNone) {
       // If the we can't run the GC type we wanted to run, find the next appropriate one and try that
       // instead. E.g. can't do partial, so do full instead.
       collector::GcType next_gc_type = next_gc_type_;
@@ -3678,12 +3705,11 @@ void Heap::ConcurrentGC(Thread* self, bool force_full) {
       if (force_full && next_gc_type == collector::kGcTypeSticky) {
         next_gc_type = HasZygoteSpace() ? collector::kGcTypePartial : collector::kGcTypeFull;
       }
-      if (CollectGarbageInternal(next_gc_type, kGcCauseBackground, false) ==
-          collector::kGcTypeNone) {
+      if (CollectGarbageInternal(next_gc_type, cause, false) == collector::kGcTypeNone) {
         for (collector::GcType gc_type : gc_plan_) {
           // Attempt to run the collector, if we succeed, we are done.
           if (gc_type > next_gc_type &&
-              CollectGarbageInternal(gc_type, kGcCauseBackground, false) !=
+              CollectGarbageInternal(gc_type, cause, false) !=
                   collector::kGcTypeNone) {
             break;
           }
@@ -3816,60 +3842,96 @@ void Heap::RevokeAllThreadLocalBuffers() {
   }
 }
 
-bool Heap::IsGCRequestPending() const {
-  return concurrent_gc_pending_.LoadRelaxed();
+void Heap::SetAllocationEntrypointsInstrumented(bool instrumented) {
+  allocation_entrypoints_instrumented_ = instrumented;
+  if (instrumented && bump_pointer_space_ != nullptr) {
+    CHECK_EQ(bump_pointer_space_->RevokeAllThreadLocalBuffers(), 0U);
+  }
 }
 
-void Heap::RunFinalization(JNIEnv* env, uint64_t timeout) {
-  env->CallStaticVoidMethod(WellKnownClasses::dalvik_system_VMRuntime,
-                            WellKnownClasses::dalvik_system_VMRuntime_runFinalization,
-                            static_cast<jlong>(timeout));
+bool Heap::IsGCRequestPending() const {
+  return concurrent_gc_pending_.LoadRelaxed();
 }
 
 void Heap::RegisterNativeAllocation(JNIEnv* env, size_t bytes) {
   Thread* self = ThreadForEnv(env);
-  if (native_need_to_run_finalization_) {
-    RunFinalization(env, kNativeAllocationFinalizeTimeout);
+  if (native_need_to_update_footprint_) {
     UpdateMaxNativeFootprint();
-    native_need_to_run_finalization_ = false;
+    native_need_to_update_footprint_ = false;
   }
   // Total number of native bytes allocated.
   size_t new_native_bytes_allocated = native_bytes_allocated_.FetchAndAddSequentiallyConsistent(bytes);
   new_native_bytes_allocated += bytes;
-  if (new_native_bytes_allocated > native_footprint_gc_watermark_) {
-    collector::GcType gc_type = HasZygoteSpace() ? collector::kGcTypePartial :
-        collector::kGcTypeFull;
-
+  // The native bytes allocated since the last GC also bring the next concurrent GC closer.
+  const size_t old_native_bytes_allocated = old_native_bytes_allocated_.LoadRelaxed();
+  const size_t native_bytes_since_gc = (new_native_bytes_allocated > old_native_bytes_allocated)
+      ? new_native_bytes_allocated - old_native_bytes_allocated
+      : 0u;
+  if (new_native_bytes_allocated > native_footprint_gc_watermark_ ||
+      GetBytesAllocated() + native_bytes_since_gc >= concurrent_start_bytes_) {
+    // Never collect on the allocating thread, which may be holding locks the finalizers need.
+    // The heap task daemon runs the GC, and the finalizer daemon then releases the native
+    // memory of the unreachable objects.
+    if (!IsGCRequestPending()) {
+      RequestConcurrentGC(self, kGcCauseForNativeAlloc, true);  // Request non-sticky type.
+    }
     // The second watermark is higher than the gc watermark. If you hit this it means you are
     // allocating native objects faster than the GC can keep up with.
     if (new_native_bytes_allocated > growth_limit_) {
-      if (WaitForGcToComplete(kGcCauseForNativeAlloc, self) != collector::kGcTypeNone) {
-        // Just finished a GC, attempt to run finalizers.
-        RunFinalization(env, kNativeAllocationFinalizeTimeout);
-        CHECK(!env->ExceptionCheck());
-        // Native bytes allocated may be updated by finalization, refresh it.
-        new_native_bytes_allocated = native_bytes_allocated_.LoadRelaxed();
-      }
-      // If we still are over the watermark, attempt a GC for alloc and run finalizers.
-      if (new_native_bytes_allocated > growth_limit_) {
-        CollectGarbageInternal(gc_type, kGcCauseForNativeAlloc, false);
-        RunFinalization(env, kNativeAllocationFinalizeTimeout);
-        native_need_to_run_finalization_ = false;
-        CHECK(!env->ExceptionCheck());
-      }
-      // We have just run finalizers, update the native watermark since it is very likely that
-      // finalizers released native managed allocations.
-      UpdateMaxNativeFootprint();
-    } else if (!IsGCRequestPending()) {
-      if (IsGcConcurrent()) {
-        RequestConcurrentGC(self, true);  // Request non-sticky type.
-      } else {
-        CollectGarbageInternal(gc_type, kGcCauseForNativeAlloc, false);
-      }
+      WaitForNativeAllocationBackPressure(self, new_native_bytes_allocated);
     }
   }
 }
 
+void Heap::WaitForNativeAllocationBackPressure(Thread* self, size_t native_bytes_allocated) {
+  // Stall from nothing at the growth limit up to kNativeAllocationMaxStall at twice the limit.
+  const uint64_t overshoot = std::min(native_bytes_allocated - growth_limit_, growth_limit_);
+  const uint64_t max_stall = kNativeAllocationMaxStall * overshoot / growth_limit_;
+  if (max_stall == 0) {
+    return;
+  }
+  ATRACE_BEGIN("GC: Native allocation back pressure");
+  ScopedThreadStateChange tsc(self, kWaitingForGcToComplete);
+  const uint64_t wait_start = NanoTime();
+  uint64_t wait_time = 0;
+  MutexLock mu(self, *gc_complete_lock_);
+  // Without a GC since the last stall, the finalizers have no more native memory to free than
+  // they had then. Wait for the GC requested by the caller, or by another thread, to complete
+  // first, so that threads keep being throttled while it runs.
+  if (gcs_completed_ == native_allocation_stall_gcs_completed_) {
+    const uint64_t gcs_completed = gcs_completed_;
+    while (gcs_completed_ == gcs_completed &&
+           (IsGCRequestPending() || collector_type_running_ != kCollectorTypeNone) &&
+           wait_time < max_stall) {
+      uint64_t timeout = std::min(max_stall - wait_time, kNativeAllocationStallCheckInterval);
+      gc_complete_cond_->TimedWait(self, NsToMs(timeout), timeout % MsToNs(1));
+      wait_time = NanoTime() - wait_start;
+    }
+  }
+  if (gcs_completed_ != native_allocation_stall_gcs_completed_) {
+    native_allocation_stall_gcs_completed_ = gcs_completed_;
+    // The finalizers do not signal us when they free native memory, so wake up periodically in
+    // addition to when a GC completes.
+    while (native_bytes_allocated_.LoadRelaxed() > growth_limit_ && wait_time < max_stall) {
+      uint64_t timeout = std::min(max_stall - wait_time, kNativeAllocationStallCheckInterval);
+      gc_complete_cond_->TimedWait(self, NsToMs(timeout), timeout % MsToNs(1));
+      wait_time = NanoTime() - wait_start;
+    }
+  }
+  // Nothing to wait for if no GC was pending and none completed since the last stall.
+  if (wait_time != 0) {
+    ++native_allocation_stall_count_;
+    native_allocation_stall_time_ += wait_time;
+    if (wait_time > long_pause_log_threshold_) {
+      LOG(INFO) << "Native allocation stalled for " << PrettyDuration(wait_time) << ", "
+                << PrettySize(native_bytes_allocated_.LoadRelaxed()) << " native bytes allocated";
+    }
+  }
+  // The finalizers most likely released native allocations, update the native watermark.
+  native_need_to_update_footprint_ = true;
+  ATRACE_END();
+}
+
 void Heap::RegisterNativeFree(JNIEnv* env, size_t bytes) {
   size_t expected_size;
   do {
@@ -3936,6 +3998,12 @@ void Heap::SetAllocationRecords(AllocRecordObjectMap* records) {
   allocation_records_.reset(records);
 }
 
+void Heap::EnableAllocationSampling(size_t interval, const std::string& dump_file) {
+  CHECK(allocation_sampler_ == nullptr);
+  allocation_sampler_.reset(new AllocationSampler(interval, dump_file));
+  LOG(INFO) << "Sampling allocations every " << PrettySize(interval);
+}
+
 void Heap::VisitAllocationRecords(RootVisitor* visitor) const {
   if (IsAllocTrackingEnabled()) {
     MutexLock mu(Thread::Current(), *Locks::alloc_tracker_lock_);
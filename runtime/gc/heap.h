@@ -57,6 +57,7 @@ namespace mirror {
 namespace gc {
 
 class AllocRecordObjectMap;
+class AllocationSampler;
 class ReferenceProcessor;
 class TaskProcessor;
 
@@ -322,7 +323,7 @@ class Heap {
 
   // Does a concurrent GC, should only be called by the GC daemon thread
   // through runtime.
-  void ConcurrentGC(Thread* self, bool force_full)
+  void ConcurrentGC(Thread* self, GcCause cause, bool force_full)
       REQUIRES(!Locks::runtime_shutdown_lock_, !*gc_complete_lock_, !*pending_task_lock_);
 
   // Implements VMDebug.countInstancesOfClass and JDWP VM_InstanceCount.
@@ -540,6 +541,10 @@ class Heap {
   void RevokeThreadLocalBuffers(Thread* thread);
   void RevokeRosAllocThreadLocalBuffers(Thread* thread);
   void RevokeAllThreadLocalBuffers();
+  // Called when the allocation entrypoints get instrumented or uninstrumented, with all other
+  // threads suspended. Compiled code bumps the TLAB pointer of its thread without calling the
+  // entrypoints, so TLABs are revoked and not handed out while allocations are instrumented.
+  void SetAllocationEntrypointsInstrumented(bool instrumented);
   void AssertThreadLocalBuffersAreRevoked(Thread* thread);
   void AssertAllBumpPointerSpaceThreadLocalBuffersAreRevoked();
   void RosAllocVerification(TimingLogger* timings, const char* name)
@@ -706,7 +711,8 @@ class Heap {
   void RequestTrim(Thread* self) REQUIRES(!*pending_task_lock_);
 
   // Request asynchronous GC.
-  void RequestConcurrentGC(Thread* self, bool force_full) REQUIRES(!*pending_task_lock_);
+  void RequestConcurrentGC(Thread* self, GcCause cause, bool force_full)
+      REQUIRES(!*pending_task_lock_);
 
   // Whether or not we may use a garbage collector, used so that we only create collectors we need.
   bool MayUseCollector(CollectorType type) const;
@@ -762,6 +768,15 @@ class Heap {
       SHARED_REQUIRES(Locks::mutator_lock_)
       REQUIRES(!Locks::alloc_tracker_lock_);
 
+  // Allocation sampling support, the sampler is null unless sampling is enabled.
+  AllocationSampler* GetAllocationSampler() const {
+    return allocation_sampler_.get();
+  }
+
+  // Samples the allocations once every interval bytes per thread. Must be called before threads
+  // other than the main thread are started, the allocation path reads the sampler without a lock.
+  void EnableAllocationSampling(size_t interval, const std::string& dump_file);
+
   void DisableGCForShutdown() REQUIRES(!*gc_complete_lock_);
 
   // Create a new alloc space and compact default alloc space to it.
@@ -878,8 +893,11 @@ class Heap {
   bool IsValidContinuousSpaceObjectAddress(const mirror::Object* obj) const
       SHARED_REQUIRES(Locks::mutator_lock_);
 
-  // Run the finalizers. If timeout is non zero, then we use the VMRuntime version.
-  void RunFinalization(JNIEnv* env, uint64_t timeout);
+  // Throttles a thread that registered native allocations past the growth limit, until the
+  // requested GC completes and the finalizers bring the native bytes back under the limit. The
+  // stall grows with how far the native bytes are past the limit, up to kNativeAllocationMaxStall.
+  void WaitForNativeAllocationBackPressure(Thread* self, size_t native_bytes_allocated)
+      REQUIRES(!*gc_complete_lock_);
 
   // Blocks the caller until the garbage collector becomes idle and returns the type of GC we
   // waited for.
@@ -1118,8 +1136,9 @@ class Heap {
   // The watermark at which a concurrent GC is requested by registerNativeAllocation.
   size_t native_footprint_gc_watermark_;
 
-  // Whether or not we need to run finalizers in the next native allocation.
-  bool native_need_to_run_finalization_;
+  // Whether the native watermark needs to be updated at the next native allocation. This is
+  // deferred after a non sticky GC to give the finalizers a chance to free native memory.
+  bool native_need_to_update_footprint_;
 
   // Whether or not we currently care about pause times.
   ProcessState process_state_;
@@ -1140,6 +1159,10 @@ class Heap {
   // Bytes which are allocated and managed by native code but still need to be accounted for.
   Atomic<size_t> native_bytes_allocated_;
 
+  // Native bytes allocated when the last GC finished. The native bytes allocated since then count
+  // towards concurrent_start_bytes_, like managed allocations.
+  Atomic<size_t> old_native_bytes_allocated_;
+
   // Number of bytes freed by thread local buffer revokes. This will
   // cancel out the ahead-of-time bulk counting of bytes allocated in
   // rosalloc thread-local buffers.  It is temporarily accumulated
@@ -1240,6 +1263,15 @@ class Heap {
   // Total time which mutators are paused or waiting for GC to complete.
   uint64_t total_wait_time_;
 
+  // Number of times and total time that threads registering native allocations were throttled.
+  uint64_t native_allocation_stall_count_ GUARDED_BY(gc_complete_lock_);
+  uint64_t native_allocation_stall_time_ GUARDED_BY(gc_complete_lock_);
+
+  // Number of GCs which completed, and its value at the last native allocation stall. Without
+  // another GC since then, a stall first waits for the pending GC to complete.
+  uint64_t gcs_completed_ GUARDED_BY(gc_complete_lock_);
+  uint64_t native_allocation_stall_gcs_completed_ GUARDED_BY(gc_complete_lock_);
+
   // The current state of heap verification, may be enabled or disabled.
   VerifyObjectMode verify_object_mode_;
 
@@ -1254,6 +1286,10 @@ class Heap {
   const bool is_running_on_memory_tool_;
   const bool use_tlab_;
 
+  // Whether the allocation entrypoints are instrumented, in which case objects are not
+  // allocated in bump pointer TLABs. Only written while other threads are suspended.
+  bool allocation_entrypoints_instrumented_;
+
   // Pointer to the space which becomes the new main space when we do homogeneous space compaction.
   // Use unique_ptr since the space is only added during the homogeneous compaction phase.
   std::unique_ptr<space::MallocSpace> main_space_backup_;
@@ -1313,6 +1349,9 @@ class Heap {
   std::unique_ptr<AllocRecordObjectMap> allocation_records_
       GUARDED_BY(Locks::alloc_tracker_lock_);
 
+  // Allocation sampling support.
+  std::unique_ptr<AllocationSampler> allocation_sampler_;
+
   // GC stress related data structures.
   Mutex* backtrace_lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
   // Debugging variables, seen backtraces vs unique backtraces.
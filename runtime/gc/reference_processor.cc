@@ -16,8 +16,13 @@
 
 #include "reference_processor.h"
 
+#include <algorithm>
+#include <sstream>
+
+#include "base/histogram-inl.h"
 #include "base/time_utils.h"
 #include "collector/garbage_collector.h"
+#include "debugger.h"
 #include "mirror/class-inl.h"
 #include "mirror/object-inl.h"
 #include "mirror/reference-inl.h"
@@ -26,6 +31,8 @@
 #include "ScopedLocalRef.h"
 #include "scoped_thread_state_change.h"
 #include "task_processor.h"
+#include "thread_list.h"
+#include "thread_pool.h"
 #include "utils.h"
 #include "well_known_classes.h"
 
@@ -34,15 +41,31 @@ namespace gc {
 
 static constexpr bool kAsyncReferenceQueueAdd = false;
 
+// Number of finalizer references run by one task of the finalizer thread pool.
+static constexpr size_t kFinalizerBatchSize = 32;
+// Longest a finalizer may run on the finalizer thread pool, same as the FinalizerWatchdogDaemon.
+static constexpr uint64_t kFinalizerTimeoutNs = MsToNs(10000);
+// Number of pending finalizers above which the finalizer threads run at the maximum priority, so
+// that they catch up with the threads allocating finalizable objects.
+static constexpr uint64_t kFinalizerBacklogThreshold = 16 * kFinalizerBatchSize;
+
 ReferenceProcessor::ReferenceProcessor()
     : collector_(nullptr),
       preserving_references_(false),
+      rp_state_(RpState::kStarting),
       condition_("reference processor condition", *Locks::reference_processor_lock_) ,
       soft_reference_queue_(Locks::reference_queue_soft_references_lock_),
       weak_reference_queue_(Locks::reference_queue_weak_references_lock_),
       finalizer_reference_queue_(Locks::reference_queue_finalizer_references_lock_),
       phantom_reference_queue_(Locks::reference_queue_phantom_references_lock_),
-      cleared_references_(Locks::reference_queue_cleared_references_lock_) {
+      cleared_references_(Locks::reference_queue_cleared_references_lock_),
+      finalizer_thread_pool_(nullptr),
+      finalizer_lock_("finalizer lock"),
+      finalizer_cond_("finalizer condition", finalizer_lock_),
+      dispatched_finalizers_(0u),
+      completed_finalizers_(0u),
+      finalizer_watchdog_scheduled_(false),
+      finalize_latency_histogram_("finalize latency", 1u) {
 }
 
 void ReferenceProcessor::EnableSlowPath() {
@@ -85,6 +108,13 @@ mirror::Object* ReferenceProcessor::GetReferent(Thread* self, mirror::Reference*
     // Try to see if the referent is already marked by using the is_marked_callback. We can return
     // it to the mutator as long as the GC is not preserving references.
     if (LIKELY(collector_ != nullptr)) {
+      const bool is_finalizer_reference = reference->IsFinalizerReferenceInstance();
+      // Once the soft and weak references with white referents are cleared, the referents of the
+      // references reachable by the mutator are final and marked, only the finalizer references
+      // still have to wait for the finalizer reachable objects to be marked.
+      if (rp_state_ == RpState::kInitClearingDone && LIKELY(!is_finalizer_reference)) {
+        break;
+      }
       // If it's null it means not marked, but it could become marked if the referent is reachable
       // by finalizer referents. So we can not return in this case and must block. Otherwise, we
       // can return it to the mutator as long as the GC is not preserving references, in which
@@ -93,9 +123,16 @@ mirror::Object* ReferenceProcessor::GetReferent(Thread* self, mirror::Reference*
       // in the heap causing corruption since this field would get swept.
       if (collector_->IsMarkedHeapReference(referent_addr)) {
         if (!preserving_references_ ||
-           (LIKELY(!reference->IsFinalizerReferenceInstance()) && !reference->IsEnqueued())) {
+           (LIKELY(!is_finalizer_reference) && !reference->IsEnqueued())) {
           return referent_addr->AsMirrorPtr();
         }
+      } else if (kUseReadBarrier &&
+                 rp_state_ == RpState::kInitMarkingDone &&
+                 LIKELY(!is_finalizer_reference)) {
+        // Marking is done and objects allocated since it started are in the to-space, so a white
+        // referent is dead and about to be cleared. The mark sweep collector does not mark new
+        // objects in its bitmaps, so it has to wait for the clearing to tell them apart.
+        return nullptr;
       }
     }
     condition_.WaitHoldingLocks(self);
@@ -124,6 +161,7 @@ void ReferenceProcessor::ProcessReferences(bool concurrent, TimingLogger* timing
   {
     MutexLock mu(self, *Locks::reference_processor_lock_);
     collector_ = collector;
+    DCHECK(rp_state_ == RpState::kStarting);
     if (!kUseReadBarrier) {
       CHECK_EQ(SlowPathEnabled(), concurrent) << "Slow path must be enabled iff concurrent";
     } else {
@@ -146,9 +184,20 @@ void ReferenceProcessor::ProcessReferences(bool concurrent, TimingLogger* timing
       StopPreservingReferences(self);
     }
   }
+  {
+    MutexLock mu(self, *Locks::reference_processor_lock_);
+    rp_state_ = RpState::kInitMarkingDone;
+  }
   // Clear all remaining soft and weak references with white referents.
   soft_reference_queue_.ClearWhiteReferences(&cleared_references_, collector);
   weak_reference_queue_.ClearWhiteReferences(&cleared_references_, collector);
+  {
+    MutexLock mu(self, *Locks::reference_processor_lock_);
+    rp_state_ = RpState::kInitClearingDone;
+    // Everything reachable by the mutator is now marked, wake up the threads waiting in
+    // GetReferent instead of making them wait for the finalizer reachable objects.
+    condition_.Broadcast(self);
+  }
   {
     TimingLogger::ScopedTiming t2(concurrent ? "EnqueueFinalizerReferences" :
         "(Paused)EnqueueFinalizerReferences", timings);
@@ -179,6 +228,7 @@ void ReferenceProcessor::ProcessReferences(bool concurrent, TimingLogger* timing
     // starts since there is a small window of time where slow_path_enabled_ is enabled but the
     // callback isn't yet set.
     collector_ = nullptr;
+    rp_state_ = RpState::kStarting;
     if (!kUseReadBarrier && concurrent) {
       // Done processing, disable the slow path and broadcast to the waiters.
       DisableSlowPath(self);
@@ -235,25 +285,261 @@ class ClearedReferenceTask : public HeapTask {
   const jobject cleared_references_;
 };
 
+class FinalizerTask : public SelfDeletingTask {
+ public:
+  FinalizerTask(ReferenceProcessor* reference_processor, jobject references)
+      : reference_processor_(reference_processor),
+        references_(references),
+        enqueue_time_(NanoTime()) {
+  }
+
+  virtual void Run(Thread* self) OVERRIDE {
+    reference_processor_->RunFinalizers(self, references_, enqueue_time_);
+  }
+
+ private:
+  ReferenceProcessor* const reference_processor_;
+  const jobject references_;
+  const uint64_t enqueue_time_;
+};
+
+class FinalizerWatchdogTask : public HeapTask {
+ public:
+  FinalizerWatchdogTask(ReferenceProcessor* reference_processor, uint64_t target_time)
+      : HeapTask(target_time), reference_processor_(reference_processor) {
+  }
+
+  virtual void Run(Thread* self) OVERRIDE {
+    reference_processor_->CheckFinalizerTimeout(self);
+  }
+
+ private:
+  ReferenceProcessor* const reference_processor_;
+};
+
+void ReferenceProcessor::StartFinalizerThreads(Thread* self, size_t num_threads) {
+  DCHECK_GT(num_threads, 0u);
+  if (finalizer_thread_pool_.LoadRelaxed() != nullptr) {
+    return;
+  }
+  ThreadPool* thread_pool = new ThreadPool("Finalizer thread pool", num_threads, true);
+  thread_pool->StartWorkers(self);
+  finalizer_thread_pool_.StoreSequentiallyConsistent(thread_pool);
+}
+
+void ReferenceProcessor::StopFinalizerThreads(Thread* self) {
+  ThreadPool* thread_pool = finalizer_thread_pool_.LoadSequentiallyConsistent();
+  finalizer_thread_pool_.StoreSequentiallyConsistent(nullptr);
+  if (thread_pool != nullptr) {
+    // Deliberately leak the pool, deleting it would wait for the workers.
+    thread_pool->StopWorkers(self);
+  }
+}
+
+void ReferenceProcessor::WaitForFinalizerThreads(Thread* self) {
+  MutexLock mu(self, finalizer_lock_);
+  // Only wait for the finalizers handed over so far, the finalizer threads may never catch up
+  // with objects becoming unreachable while we wait.
+  const uint64_t dispatched = dispatched_finalizers_;
+  while (completed_finalizers_ < dispatched) {
+    finalizer_cond_.Wait(self);
+  }
+}
+
+void ReferenceProcessor::DispatchFinalizerReferences(Thread* self, ThreadPool* thread_pool) {
+  ReferenceQueue other_references(Locks::reference_queue_cleared_references_lock_);
+  ReferenceQueue batch(Locks::reference_queue_cleared_references_lock_);
+  size_t batch_size = 0;
+  while (!cleared_references_.IsEmpty()) {
+    mirror::Reference* ref = cleared_references_.DequeuePendingReference();
+    if (ref->IsFinalizerReferenceInstance()) {
+      batch.EnqueuePendingReference(ref);
+      if (++batch_size == kFinalizerBatchSize) {
+        DispatchFinalizerBatch(self, thread_pool, &batch, batch_size);
+        batch_size = 0;
+      }
+    } else {
+      other_references.EnqueuePendingReference(ref);
+    }
+  }
+  if (batch_size != 0) {
+    DispatchFinalizerBatch(self, thread_pool, &batch, batch_size);
+  }
+  while (!other_references.IsEmpty()) {
+    cleared_references_.EnqueuePendingReference(other_references.DequeuePendingReference());
+  }
+}
+
+void ReferenceProcessor::DispatchFinalizerBatch(Thread* self,
+                                                ThreadPool* thread_pool,
+                                                ReferenceQueue* batch,
+                                                size_t batch_size) {
+  // The global reference keeps the whole circular list alive.
+  jobject references = self->GetJniEnv()->vm->AddGlobalRef(self, batch->GetList());
+  {
+    MutexLock mu(self, finalizer_lock_);
+    dispatched_finalizers_ += batch_size;
+  }
+  thread_pool->AddTask(self, new FinalizerTask(this, references));
+  batch->Clear();
+}
+
+void ReferenceProcessor::RunFinalizers(Thread* self, jobject references, uint64_t enqueue_time) {
+  // Finalizers handed over long ago keep their dead object graphs alive, raise the priority of
+  // this thread while the finalizer threads lag behind.
+  uint64_t pending;
+  {
+    MutexLock mu(self, finalizer_lock_);
+    pending = dispatched_finalizers_ - completed_finalizers_;
+  }
+  self->SetNativePriority(
+      (pending > kFinalizerBacklogThreshold) ? kMaxThreadPriority : kNormThreadPriority);
+
+  ScopedObjectAccess soa(self);
+  JNIEnv* env = soa.Env();
+  bool done = false;
+  while (!done) {
+    ScopedLocalRef<jobject> reference(env, nullptr);
+    ScopedLocalRef<jobject> zombie(env, nullptr);
+    {
+      // Unlink the first reference of the list. The finalizers may move the references, so the
+      // list is decoded again for every reference.
+      mirror::Reference* list = soa.Decode<mirror::Reference*>(references);
+      mirror::Reference* head = list->GetPendingNext();
+      if (head == list) {
+        done = true;
+      } else {
+        list->SetPendingNext<false>(head->GetPendingNext());
+      }
+      mirror::FinalizerReference* finalizer_reference = head->AsFinalizerReference();
+      reference.reset(soa.AddLocalReference<jobject>(finalizer_reference));
+      zombie.reset(soa.AddLocalReference<jobject>(finalizer_reference->GetZombie()));
+      finalizer_reference->SetZombie<false>(nullptr);
+    }
+    // Same as FinalizerDaemon.doFinalize(): unregister the reference, then run the finalizer and
+    // ignore its exceptions.
+    StartFinalize(self);
+    jvalue args[1];
+    args[0].l = reference.get();
+    InvokeWithJValues(soa, nullptr, WellKnownClasses::java_lang_ref_FinalizerReference_remove, args);
+    if (!self->IsExceptionPending() && zombie.get() != nullptr) {
+      InvokeVirtualOrInterfaceWithJValues(
+          soa, zombie.get(), WellKnownClasses::java_lang_Object_finalize, nullptr);
+    }
+    if (self->IsExceptionPending()) {
+      LOG(WARNING) << "Uncaught exception thrown by finalizer: "
+                   << self->GetException()->Dump();
+      self->ClearException();
+    }
+    FinishFinalize(self, enqueue_time);
+  }
+  env->DeleteGlobalRef(references);
+}
+
+void ReferenceProcessor::StartFinalize(Thread* self) {
+  const uint64_t now = NanoTime();
+  bool schedule_watchdog = false;
+  {
+    MutexLock mu(self, finalizer_lock_);
+    running_finalizers_[self] = now;
+    if (!finalizer_watchdog_scheduled_) {
+      finalizer_watchdog_scheduled_ = true;
+      schedule_watchdog = true;
+    }
+  }
+  if (schedule_watchdog) {
+    Runtime::Current()->GetHeap()->GetTaskProcessor()->AddTask(
+        self, new FinalizerWatchdogTask(this, now + kFinalizerTimeoutNs));
+  }
+}
+
+void ReferenceProcessor::FinishFinalize(Thread* self, uint64_t enqueue_time) {
+  MutexLock mu(self, finalizer_lock_);
+  running_finalizers_.erase(self);
+  ++completed_finalizers_;
+  finalizer_cond_.Broadcast(self);
+  finalize_latency_histogram_.AddValue(NsToMs(NanoTime() - enqueue_time));
+}
+
+void ReferenceProcessor::CheckFinalizerTimeout(Thread* self) {
+  const uint64_t now = NanoTime();
+  uint64_t oldest_start = now;
+  {
+    MutexLock mu(self, finalizer_lock_);
+    if (running_finalizers_.empty()) {
+      // The next finalizer to start schedules the next check.
+      finalizer_watchdog_scheduled_ = false;
+      return;
+    }
+    for (const auto& entry : running_finalizers_) {
+      oldest_start = std::min(oldest_start, entry.second);
+    }
+  }
+  uint64_t next_check = oldest_start + kFinalizerTimeoutNs;
+  if (now >= next_check) {
+    if (Dbg::IsDebuggerActive()) {
+      // The FinalizerWatchdogDaemon does not time out finalizers stopped by a debugger either.
+      next_check = now + kFinalizerTimeoutNs;
+    } else {
+      // The FinalizerWatchdogDaemon kills the process with a TimeoutException.
+      std::ostringstream threads;
+      Runtime::Current()->GetThreadList()->Dump(threads);
+      LOG(ERROR) << threads.str();
+      LOG(FATAL) << "A finalizer on the finalizer threads timed out after "
+                 << PrettyDuration(now - oldest_start);
+    }
+  }
+  Runtime::Current()->GetHeap()->GetTaskProcessor()->AddTask(
+      self, new FinalizerWatchdogTask(this, next_check));
+}
+
+void ReferenceProcessor::DumpFinalizerInfo(std::ostream& os) {
+  if (finalizer_thread_pool_.LoadRelaxed() == nullptr) {
+    return;
+  }
+  MutexLock mu(Thread::Current(), finalizer_lock_);
+  os << "Pending finalizers: " << dispatched_finalizers_ - completed_finalizers_ << "\n";
+  if (finalize_latency_histogram_.SampleSize() > 0U) {
+    os << "Finalized objects: " << finalize_latency_histogram_.SampleSize() << "\n";
+    os << "Mean finalize latency: "
+       << PrettyDuration(MsToNs(static_cast<uint64_t>(finalize_latency_histogram_.Mean())))
+       << ", max: " << PrettyDuration(MsToNs(finalize_latency_histogram_.Max())) << "\n";
+  }
+}
+
+void ReferenceProcessor::ResetFinalizerInfo() {
+  MutexLock mu(Thread::Current(), finalizer_lock_);
+  finalize_latency_histogram_.Reset();
+}
+
 void ReferenceProcessor::EnqueueClearedReferences(Thread* self) {
   Locks::mutator_lock_->AssertNotHeld(self);
   // When a runtime isn't started there are no reference queues to care about so ignore.
   if (!cleared_references_.IsEmpty()) {
     if (LIKELY(Runtime::Current()->IsStarted())) {
-      jobject cleared_references;
+      jobject cleared_references = nullptr;
       {
         ReaderMutexLock mu(self, *Locks::mutator_lock_);
-        cleared_references = self->GetJniEnv()->vm->AddGlobalRef(
-            self, cleared_references_.GetList());
+        ThreadPool* finalizer_thread_pool = finalizer_thread_pool_.LoadSequentiallyConsistent();
+        if (finalizer_thread_pool != nullptr) {
+          DispatchFinalizerReferences(self, finalizer_thread_pool);
+        }
+        if (!cleared_references_.IsEmpty()) {
+          cleared_references = self->GetJniEnv()->vm->AddGlobalRef(
+              self, cleared_references_.GetList());
+        }
       }
-      if (kAsyncReferenceQueueAdd) {
-        // TODO: This can cause RunFinalization to terminate before newly freed objects are
-        // finalized since they may not be enqueued by the time RunFinalization starts.
-        Runtime::Current()->GetHeap()->GetTaskProcessor()->AddTask(
-            self, new ClearedReferenceTask(cleared_references));
-      } else {
-        ClearedReferenceTask task(cleared_references);
-        task.Run(self);
+      // All the cleared references may have been finalizer references.
+      if (cleared_references != nullptr) {
+        if (kAsyncReferenceQueueAdd) {
+          // TODO: This can cause RunFinalization to terminate before newly freed objects are
+          // finalized since they may not be enqueued by the time RunFinalization starts.
+          Runtime::Current()->GetHeap()->GetTaskProcessor()->AddTask(
+              self, new ClearedReferenceTask(cleared_references));
+        } else {
+          ClearedReferenceTask task(cleared_references);
+          task.Run(self);
+        }
       }
     }
     cleared_references_.Clear();
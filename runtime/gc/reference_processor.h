@@ -17,6 +17,11 @@
 #ifndef ART_RUNTIME_GC_REFERENCE_PROCESSOR_H_
 #define ART_RUNTIME_GC_REFERENCE_PROCESSOR_H_
 
+#include <map>
+#include <ostream>
+
+#include "atomic.h"
+#include "base/histogram.h"
 #include "base/mutex.h"
 #include "globals.h"
 #include "jni.h"
@@ -25,6 +30,7 @@
 
 namespace art {
 
+class ThreadPool;
 class TimingLogger;
 
 namespace mirror {
@@ -40,6 +46,7 @@ namespace collector {
 class GarbageCollector;
 }  // namespace collector
 
+class FinalizerTask;
 class Heap;
 
 // Used to process java.lang.References concurrently or paused.
@@ -71,6 +78,24 @@ class ReferenceProcessor {
       REQUIRES(!Locks::reference_processor_lock_,
                !Locks::reference_queue_finalizer_references_lock_);
 
+  // Run the finalizers on a pool of num_threads runtime threads. From then on, cleared finalizer
+  // references are handed to the pool in batches instead of going through the Java
+  // ReferenceQueueDaemon and FinalizerDaemon.
+  void StartFinalizerThreads(Thread* self, size_t num_threads) REQUIRES(!Locks::mutator_lock_);
+  // Stop running finalizers, called when the runtime shuts down. The workers are not joined since
+  // they may be blocked in a finalizer, they are suspended with the other daemon threads.
+  void StopFinalizerThreads(Thread* self);
+  // Wait until the finalizer threads have run the finalizers of all the references handed to
+  // them so far. Called by System.runFinalization(), which only waits for the FinalizerDaemon.
+  void WaitForFinalizerThreads(Thread* self) REQUIRES(!Locks::mutator_lock_, !finalizer_lock_);
+  // Abort if a finalizer of the finalizer threads has been running for longer than
+  // kFinalizerTimeoutNs, the same limit the FinalizerWatchdogDaemon puts on the FinalizerDaemon.
+  // Otherwise, schedule the next check while finalizers are running.
+  void CheckFinalizerTimeout(Thread* self) REQUIRES(!Locks::mutator_lock_, !finalizer_lock_);
+
+  void DumpFinalizerInfo(std::ostream& os) REQUIRES(!finalizer_lock_);
+  void ResetFinalizerInfo() REQUIRES(!finalizer_lock_);
+
  private:
   bool SlowPathEnabled() SHARED_REQUIRES(Locks::mutator_lock_);
   // Called by ProcessReferences.
@@ -81,12 +106,41 @@ class ReferenceProcessor {
   // referents.
   void StartPreservingReferences(Thread* self) REQUIRES(!Locks::reference_processor_lock_);
   void StopPreservingReferences(Thread* self) REQUIRES(!Locks::reference_processor_lock_);
+  // Move the finalizer references out of cleared_references_ and hand them to the finalizer
+  // thread pool, kFinalizerBatchSize references per task.
+  void DispatchFinalizerReferences(Thread* self, ThreadPool* thread_pool)
+      SHARED_REQUIRES(Locks::mutator_lock_);
+  void DispatchFinalizerBatch(Thread* self,
+                              ThreadPool* thread_pool,
+                              ReferenceQueue* batch,
+                              size_t batch_size)
+      SHARED_REQUIRES(Locks::mutator_lock_)
+      REQUIRES(!finalizer_lock_);
+  // Run the finalizers of the circular list of finalizer references held by the global reference
+  // `references`, which were enqueued at `enqueue_time`.
+  void RunFinalizers(Thread* self, jobject references, uint64_t enqueue_time)
+      REQUIRES(!Locks::mutator_lock_, !finalizer_lock_);
+  // Record the start and the end of a finalize() call on a finalizer thread.
+  void StartFinalize(Thread* self) REQUIRES(!finalizer_lock_);
+  void FinishFinalize(Thread* self, uint64_t enqueue_time) REQUIRES(!finalizer_lock_);
   // Collector which is clearing references, used by the GetReferent to return referents which are
   // already marked.
   collector::GarbageCollector* collector_ GUARDED_BY(Locks::reference_processor_lock_);
   // Boolean for whether or not we are preserving references (either soft references or finalizers).
   // If this is true, then we cannot return a referent (see comment in GetReferent).
   bool preserving_references_ GUARDED_BY(Locks::reference_processor_lock_);
+  // How far the reference processing of the current GC went, tells GetReferent whether the
+  // referents of soft and weak references can be returned without waiting for the processing.
+  enum class RpState : uint8_t {
+    // The soft references may still be forwarded, referents are only returned if marked.
+    kStarting,
+    // Marking is done, the white referents are about to be cleared.
+    kInitMarkingDone,
+    // The soft and weak references with white referents are cleared, the finalizer references
+    // are being processed.
+    kInitClearingDone,
+  };
+  RpState rp_state_ GUARDED_BY(Locks::reference_processor_lock_);
   // Condition that people wait on if they attempt to get the referent of a reference while
   // processing is in progress.
   ConditionVariable condition_ GUARDED_BY(Locks::reference_processor_lock_);
@@ -97,6 +151,22 @@ class ReferenceProcessor {
   ReferenceQueue phantom_reference_queue_;
   ReferenceQueue cleared_references_;
 
+  // Threads running the finalizers, null if the finalizers are run by the Java FinalizerDaemon.
+  Atomic<ThreadPool*> finalizer_thread_pool_;
+  Mutex finalizer_lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  // Signaled when a finalizer thread finishes a finalizer, for WaitForFinalizerThreads.
+  ConditionVariable finalizer_cond_ GUARDED_BY(finalizer_lock_);
+  // Numbers of finalizer references handed to the finalizer threads and finalized so far.
+  uint64_t dispatched_finalizers_ GUARDED_BY(finalizer_lock_);
+  uint64_t completed_finalizers_ GUARDED_BY(finalizer_lock_);
+  // Start time of the finalize() call each finalizer thread is running, if any.
+  std::map<Thread*, uint64_t> running_finalizers_ GUARDED_BY(finalizer_lock_);
+  // Whether a task of the heap task processor will call CheckFinalizerTimeout.
+  bool finalizer_watchdog_scheduled_ GUARDED_BY(finalizer_lock_);
+  // Time in milliseconds between the GC finding an object unreachable and its finalizer returning.
+  Histogram<uint64_t> finalize_latency_histogram_ GUARDED_BY(finalizer_lock_);
+
+  friend class FinalizerTask;
   DISALLOW_COPY_AND_ASSIGN(ReferenceProcessor);
 };
 
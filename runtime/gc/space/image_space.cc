@@ -680,6 +680,39 @@ void ImageSpace::VerifyImageAllocations() {
   }
 }
 
+#ifndef MOE
+// Map anonymous memory at the image address and decompress the image data into it.
+static MemMap* MapCompressedImage(File* file,
+                                  const ImageHeader& image_header,
+                                  const char* image_filename,
+                                  std::string* error_msg) {
+  const uint64_t start_time = NanoTime();
+  std::unique_ptr<MemMap> map(MemMap::MapAnonymous(
+      image_filename, image_header.GetImageBegin(), image_header.GetImageSize(),
+      PROT_READ | PROT_WRITE, /* low_4gb */ false, /* reuse */ false, error_msg));
+  if (map.get() == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<MemMap> compressed_map(MemMap::MapFile(
+      sizeof(ImageHeader) + image_header.GetDataSize(), PROT_READ, MAP_PRIVATE, file->Fd(), 0,
+      image_filename, error_msg));
+  if (compressed_map.get() == nullptr) {
+    return nullptr;
+  }
+  memcpy(map->Begin(), &image_header, sizeof(ImageHeader));
+  if (!image_header.DecompressData(compressed_map->Begin() + sizeof(ImageHeader),
+                                   map->Begin() + sizeof(ImageHeader),
+                                   error_msg)) {
+    *error_msg = StringPrintf("Failed to decompress image '%s': %s",
+                              image_filename, error_msg->c_str());
+    return nullptr;
+  }
+  VLOG(startup) << "Decompressed image " << image_filename << " in "
+                << PrettyDuration(NanoTime() - start_time);
+  return map.release();
+}
+#endif
+
 ImageSpace* ImageSpace::Init(const char* image_filename, const char* image_location,
                              bool validate_oat_file, std::string* error_msg) {
   CHECK(image_filename != nullptr);
@@ -715,9 +748,15 @@ ImageSpace* ImageSpace::Init(const char* image_filename, const char* image_locat
 #ifndef MOE
   // Check that the file is large enough.
   uint64_t image_file_size = static_cast<uint64_t>(file->GetLength());
-  if (image_header.GetImageSize() > image_file_size) {
-    *error_msg = StringPrintf("Image file too small for image heap: %" PRIu64 " vs. %zu.",
-                              image_file_size, image_header.GetImageSize());
+  if (sizeof(ImageHeader) + image_header.GetDataSize() > image_file_size) {
+    *error_msg = StringPrintf("Image file too small for image data: %" PRIu64 " vs. %zu.",
+                              image_file_size, sizeof(ImageHeader) + image_header.GetDataSize());
+    return nullptr;
+  }
+#else
+  if (image_header.GetStorageMode() != ImageHeader::kStorageModeUncompressed) {
+    *error_msg = StringPrintf("Unsupported storage mode of image data: %u",
+                              static_cast<uint32_t>(image_header.GetStorageMode()));
     return nullptr;
   }
 #endif
@@ -734,7 +773,8 @@ ImageSpace* ImageSpace::Init(const char* image_filename, const char* image_locat
   }
 
   const auto& bitmap_section = image_header.GetImageSection(ImageHeader::kSectionImageBitmap);
-  auto end_of_bitmap = static_cast<size_t>(bitmap_section.End());
+  const size_t bitmap_file_offset = image_header.GetBitmapFileOffset();
+  auto end_of_bitmap = bitmap_file_offset + bitmap_section.Size();
   if (end_of_bitmap != image_file_size) {
     *error_msg = StringPrintf(
         "Image file size does not equal end of bitmap: size=%" PRIu64 " vs. %zu.", image_file_size,
@@ -743,10 +783,15 @@ ImageSpace* ImageSpace::Init(const char* image_filename, const char* image_locat
   }
 
 #ifndef MOE
-  // Note: The image header is part of the image due to mmap page alignment required of offset.
-  std::unique_ptr<MemMap> map(MemMap::MapFileAtAddress(
-      image_header.GetImageBegin(), image_header.GetImageSize(),
-      PROT_READ | PROT_WRITE, MAP_PRIVATE, file->Fd(), 0, false, image_filename, error_msg));
+  std::unique_ptr<MemMap> map;
+  if (image_header.GetStorageMode() == ImageHeader::kStorageModeUncompressed) {
+    // Note: The image header is part of the image due to mmap page alignment required of offset.
+    map.reset(MemMap::MapFileAtAddress(
+        image_header.GetImageBegin(), image_header.GetImageSize(),
+        PROT_READ | PROT_WRITE, MAP_PRIVATE, file->Fd(), 0, false, image_filename, error_msg));
+  } else {
+    map.reset(MapCompressedImage(file.get(), image_header, image_filename, error_msg));
+  }
 #else
   std::unique_ptr<MemMap> map(MemMap::MapAlias("map_image_space_data_alias",
       image_header.GetImageBegin(), reinterpret_cast<uint8_t *>(image_data),
@@ -763,7 +808,7 @@ ImageSpace* ImageSpace::Init(const char* image_filename, const char* image_locat
 #ifndef MOE
   std::unique_ptr<MemMap> image_map(MemMap::MapFileAtAddress(
       nullptr, bitmap_section.Size(), PROT_READ, MAP_PRIVATE, file->Fd(),
-      bitmap_section.Offset(), false, image_filename, error_msg));
+      bitmap_file_offset, false, image_filename, error_msg));
 #else
   uint8_t* image_start = reinterpret_cast<uint8_t *>(image_data) + bitmap_section.Offset();
   std::unique_ptr<MemMap> image_map(MemMap::MapAlias("image_map_image_space_data_alias",
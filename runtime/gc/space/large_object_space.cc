@@ -127,7 +127,15 @@ void LargeObjectSpace::CopyLiveToMarked() {
 
 LargeObjectMapSpace::LargeObjectMapSpace(const std::string& name)
     : LargeObjectSpace(name, nullptr, nullptr),
-      lock_("large object map space lock", kAllocSpaceLock) {}
+      lock_("large object map space lock", kAllocSpaceLock),
+      cached_maps_bytes_(0) {}
+
+LargeObjectMapSpace::~LargeObjectMapSpace() {
+  MutexLock mu(Thread::Current(), lock_);
+  for (auto& pair : cached_maps_) {
+    delete pair.second;
+  }
+}
 
 LargeObjectMapSpace* LargeObjectMapSpace::Create(const std::string& name) {
 #ifndef MOE
@@ -144,12 +152,15 @@ LargeObjectMapSpace* LargeObjectMapSpace::Create(const std::string& name) {
 mirror::Object* LargeObjectMapSpace::Alloc(Thread* self, size_t num_bytes,
                                            size_t* bytes_allocated, size_t* usable_size,
                                            size_t* bytes_tl_bulk_allocated) {
-  std::string error_msg;
-  MemMap* mem_map = MemMap::MapAnonymous("large object space allocation", nullptr, num_bytes,
-                                         PROT_READ | PROT_WRITE, true, false, &error_msg);
-  if (UNLIKELY(mem_map == nullptr)) {
-    LOG(WARNING) << "Large object allocation failed: " << error_msg;
-    return nullptr;
+  MemMap* mem_map = TakeCachedMap(self, RoundUp(num_bytes, kPageSize));
+  if (mem_map == nullptr) {
+    std::string error_msg;
+    mem_map = MemMap::MapAnonymous("large object space allocation", nullptr, num_bytes,
+                                   PROT_READ | PROT_WRITE, true, false, &error_msg);
+    if (UNLIKELY(mem_map == nullptr)) {
+      LOG(WARNING) << "Large object allocation failed: " << error_msg;
+      return nullptr;
+    }
   }
   mirror::Object* const obj = reinterpret_cast<mirror::Object*>(mem_map->Begin());
   if (kIsDebugBuild) {
@@ -177,10 +188,10 @@ mirror::Object* LargeObjectMapSpace::Alloc(Thread* self, size_t num_bytes,
   }
   DCHECK(bytes_tl_bulk_allocated != nullptr);
   *bytes_tl_bulk_allocated = allocation_size;
-  num_bytes_allocated_ += allocation_size;
-  total_bytes_allocated_ += allocation_size;
-  ++num_objects_allocated_;
-  ++total_objects_allocated_;
+  num_bytes_allocated_.FetchAndAddSequentiallyConsistent(allocation_size);
+  total_bytes_allocated_.FetchAndAddSequentiallyConsistent(allocation_size);
+  num_objects_allocated_.FetchAndAddSequentiallyConsistent(1);
+  total_objects_allocated_.FetchAndAddSequentiallyConsistent(1);
   return obj;
 }
 
@@ -199,21 +210,58 @@ void LargeObjectMapSpace::SetAllLargeObjectsAsZygoteObjects(Thread* self) {
 }
 
 size_t LargeObjectMapSpace::Free(Thread* self, mirror::Object* ptr) {
+  MemMap* mem_map;
+  size_t allocation_size;
+  {
+    MutexLock mu(self, lock_);
+    auto it = large_objects_.find(ptr);
+    if (UNLIKELY(it == large_objects_.end())) {
+      Runtime::Current()->GetHeap()->DumpSpaces(LOG(INTERNAL_FATAL));
+      LOG(FATAL) << "Attempted to free large object " << ptr << " which was not live";
+    }
+    mem_map = it->second.mem_map;
+    const size_t map_size = mem_map->BaseSize();
+    DCHECK_GE(num_bytes_allocated_.LoadRelaxed(), map_size);
+    allocation_size = map_size;
+    num_bytes_allocated_.FetchAndSubSequentiallyConsistent(allocation_size);
+    num_objects_allocated_.FetchAndSubSequentiallyConsistent(1);
+    large_objects_.erase(it);
+  }
+  // Release the pages without holding the lock, allocating threads only wait for the bookkeeping.
+  CacheOrDeleteMap(self, mem_map);
+  return allocation_size;
+}
+
+MemMap* LargeObjectMapSpace::TakeCachedMap(Thread* self, size_t map_size) {
+  if (map_size > kMaxCachedMapSize) {
+    return nullptr;
+  }
   MutexLock mu(self, lock_);
-  auto it = large_objects_.find(ptr);
-  if (UNLIKELY(it == large_objects_.end())) {
-    Runtime::Current()->GetHeap()->DumpSpaces(LOG(INTERNAL_FATAL));
-    LOG(FATAL) << "Attempted to free large object " << ptr << " which was not live";
+  auto it = cached_maps_.find(map_size);
+  if (it == cached_maps_.end()) {
+    return nullptr;
   }
-  MemMap* mem_map = it->second.mem_map;
+  MemMap* mem_map = it->second;
+  cached_maps_.erase(it);
+  DCHECK_GE(cached_maps_bytes_, map_size);
+  cached_maps_bytes_ -= map_size;
+  return mem_map;
+}
+
+void LargeObjectMapSpace::CacheOrDeleteMap(Thread* self, MemMap* mem_map) {
   const size_t map_size = mem_map->BaseSize();
-  DCHECK_GE(num_bytes_allocated_, map_size);
-  size_t allocation_size = map_size;
-  num_bytes_allocated_ -= allocation_size;
-  --num_objects_allocated_;
+  // Memory tools track the red zones of the previous object, do not reuse its mapping.
+  if (map_size <= kMaxCachedMapSize && !Runtime::Current()->IsRunningOnMemoryTool()) {
+    // The pages are zero when the mapping is reused, as required for new objects.
+    mem_map->MadviseDontNeedAndZero();
+    MutexLock mu(self, lock_);
+    if (cached_maps_bytes_ + map_size <= kMaxCachedMapsBytes) {
+      cached_maps_.emplace(map_size, mem_map);
+      cached_maps_bytes_ += map_size;
+      return;
+    }
+  }
   delete mem_map;
-  large_objects_.erase(it);
-  return allocation_size;
 }
 
 size_t LargeObjectMapSpace::AllocationSize(mirror::Object* obj, size_t* usable_size) {
@@ -373,7 +421,8 @@ FreeListSpace* FreeListSpace::Create(const std::string& name, uint8_t* requested
 FreeListSpace::FreeListSpace(const std::string& name, MemMap* mem_map, uint8_t* begin, uint8_t* end)
     : LargeObjectSpace(name, begin, end),
       mem_map_(mem_map),
-      lock_("free list space lock", kAllocSpaceLock) {
+      lock_("free list space lock", kAllocSpaceLock),
+      binned_bytes_(0) {
   const size_t space_capacity = end - begin;
   free_end_ = space_capacity;
   CHECK_ALIGNED(space_capacity, kAlignment);
@@ -391,12 +440,15 @@ FreeListSpace::FreeListSpace(const std::string& name, MemMap* mem_map, uint8_t*
 FreeListSpace::~FreeListSpace() {}
 
 void FreeListSpace::Walk(DlMallocSpace::WalkCallback callback, void* arg) {
-  MutexLock mu(Thread::Current(), lock_);
+  Thread* self = Thread::Current();
+  const std::set<uintptr_t> binned_blocks = GetBinnedBlocks(self);
+  MutexLock mu(self, lock_);
   const uintptr_t free_end_start = reinterpret_cast<uintptr_t>(end_) - free_end_;
   AllocationInfo* cur_info = &allocation_info_[0];
   const AllocationInfo* end_info = GetAllocationInfoForAddress(free_end_start);
   while (cur_info < end_info) {
-    if (!cur_info->IsFree()) {
+    if (!cur_info->IsFree() &&
+        binned_blocks.find(GetAddressForAllocationInfo(cur_info)) == binned_blocks.end()) {
       size_t alloc_size = cur_info->ByteSize();
       uint8_t* byte_start = reinterpret_cast<uint8_t*>(GetAddressForAllocationInfo(cur_info));
       uint8_t* byte_end = byte_start + alloc_size;
@@ -416,16 +468,50 @@ void FreeListSpace::RemoveFreePrev(AllocationInfo* info) {
   free_blocks_.erase(it);
 }
 
+// Zeroes the pages of a freed block, new objects must be zero when they are allocated.
+static void ReleaseFreedPages(mirror::Object* obj, size_t allocation_size) {
+#ifdef MOE
+  if (!kMadviseZeroes) {
+    moeRemapSpace(obj, allocation_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS);
+  }
+#endif
+  madvise(obj, allocation_size, MADV_DONTNEED);
+  if (kIsDebugBuild) {
+    // Catch writes to freed blocks, they are made writable again when they are allocated.
+    mprotect(obj, allocation_size, PROT_READ);
+  }
+}
+
 size_t FreeListSpace::Free(Thread* self, mirror::Object* obj) {
-  MutexLock mu(self, lock_);
   DCHECK(Contains(obj)) << reinterpret_cast<void*>(Begin()) << " " << obj << " "
                         << reinterpret_cast<void*>(End());
   DCHECK_ALIGNED(obj, kAlignment);
+  // The size of an allocated block is only changed by the thread which allocates or frees it.
   AllocationInfo* info = GetAllocationInfoForAddress(reinterpret_cast<uintptr_t>(obj));
   DCHECK(!info->IsFree());
   const size_t allocation_size = info->ByteSize();
   DCHECK_GT(allocation_size, 0U);
   DCHECK_ALIGNED(allocation_size, kAlignment);
+  // Zygote blocks go back to the free list, a binned block may be handed out as a new object.
+  if (allocation_size <= kMaxBinnedSize && !info->IsZygoteObject() &&
+      BinBlock(self, obj, allocation_size)) {
+    DCHECK_LE(allocation_size, num_bytes_allocated_.LoadRelaxed());
+    num_objects_allocated_.FetchAndSubSequentiallyConsistent(1);
+    num_bytes_allocated_.FetchAndSubSequentiallyConsistent(allocation_size);
+    return allocation_size;
+  }
+  MutexLock mu(self, lock_);
+  AddToFreeList(info);
+  num_objects_allocated_.FetchAndSubSequentiallyConsistent(1);
+  DCHECK_LE(allocation_size, num_bytes_allocated_.LoadRelaxed());
+  num_bytes_allocated_.FetchAndSubSequentiallyConsistent(allocation_size);
+  // Still under the lock, the block may be allocated again as soon as it is released.
+  ReleaseFreedPages(obj, allocation_size);
+  return allocation_size;
+}
+
+void FreeListSpace::AddToFreeList(AllocationInfo* info) {
+  const size_t allocation_size = info->ByteSize();
   info->SetByteSize(allocation_size, true);  // Mark as free.
   // Look at the next chunk.
   AllocationInfo* next_info = info->GetNextInfo();
@@ -464,20 +550,74 @@ size_t FreeListSpace::Free(Thread* self, mirror::Object* obj) {
     info->SetByteSize(new_free_size, true);
     DCHECK_EQ(info->GetNextInfo(), new_free_info);
   }
-  --num_objects_allocated_;
-  DCHECK_LE(allocation_size, num_bytes_allocated_);
-  num_bytes_allocated_ -= allocation_size;
-#ifdef MOE
-  if (!kMadviseZeroes) {
-    moeRemapSpace(obj, allocation_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS);
+}
+
+bool FreeListSpace::BinBlock(Thread* self, mirror::Object* obj, size_t allocation_size) {
+  if (binned_bytes_.FetchAndAddSequentiallyConsistent(allocation_size) + allocation_size >
+      kMaxBinnedBytes) {
+    binned_bytes_.FetchAndSubSequentiallyConsistent(allocation_size);
+    return false;
+  }
+  // The block stays allocated in the allocation infos, nobody else can touch it until it is in
+  // its bin, so release its pages without holding any lock.
+  ReleaseFreedPages(obj, allocation_size);
+  Bin& bin = bins_[allocation_size / kAlignment - 1];
+  MutexLock mu(self, bin.lock);
+  bin.blocks.push_back(obj);
+  return true;
+}
+
+mirror::Object* FreeListSpace::TakeBinnedBlock(Thread* self, size_t allocation_size) {
+  if (allocation_size > kMaxBinnedSize) {
+    return nullptr;
   }
-#endif
-  madvise(obj, allocation_size, MADV_DONTNEED);
+  Bin& bin = bins_[allocation_size / kAlignment - 1];
+  mirror::Object* obj;
+  {
+    MutexLock mu(self, bin.lock);
+    if (bin.blocks.empty()) {
+      return nullptr;
+    }
+    obj = bin.blocks.back();
+    bin.blocks.pop_back();
+  }
+  binned_bytes_.FetchAndSubSequentiallyConsistent(allocation_size);
+  DCHECK_EQ(GetAllocationInfoForAddress(reinterpret_cast<uintptr_t>(obj))->ByteSize(),
+            allocation_size);
   if (kIsDebugBuild) {
-    // Can't disallow reads since we use them to find next chunks during coalescing.
-    mprotect(obj, allocation_size, PROT_READ);
+    mprotect(obj, allocation_size, PROT_READ | PROT_WRITE);
   }
-  return allocation_size;
+  return obj;
+}
+
+void FreeListSpace::ReleaseBinnedBlocks(Thread* self) {
+  std::vector<mirror::Object*> blocks;
+  for (Bin& bin : bins_) {
+    MutexLock mu(self, bin.lock);
+    blocks.insert(blocks.end(), bin.blocks.begin(), bin.blocks.end());
+    bin.blocks.clear();
+  }
+  if (blocks.empty()) {
+    return;
+  }
+  MutexLock mu(self, lock_);
+  for (mirror::Object* obj : blocks) {
+    AllocationInfo* info = GetAllocationInfoForAddress(reinterpret_cast<uintptr_t>(obj));
+    binned_bytes_.FetchAndSubSequentiallyConsistent(info->ByteSize());
+    // The pages were already released when the block was binned.
+    AddToFreeList(info);
+  }
+}
+
+std::set<uintptr_t> FreeListSpace::GetBinnedBlocks(Thread* self) const {
+  std::set<uintptr_t> binned_blocks;
+  for (const Bin& bin : bins_) {
+    MutexLock mu(self, bin.lock);
+    for (mirror::Object* obj : bin.blocks) {
+      binned_blocks.insert(reinterpret_cast<uintptr_t>(obj));
+    }
+  }
+  return binned_blocks;
 }
 
 size_t FreeListSpace::AllocationSize(mirror::Object* obj, size_t* usable_size) {
@@ -493,8 +633,35 @@ size_t FreeListSpace::AllocationSize(mirror::Object* obj, size_t* usable_size) {
 
 mirror::Object* FreeListSpace::Alloc(Thread* self, size_t num_bytes, size_t* bytes_allocated,
                                      size_t* usable_size, size_t* bytes_tl_bulk_allocated) {
-  MutexLock mu(self, lock_);
   const size_t allocation_size = RoundUp(num_bytes, kAlignment);
+  mirror::Object* obj = TakeBinnedBlock(self, allocation_size);
+  if (obj == nullptr) {
+    obj = AllocFromFreeList(self, allocation_size);
+    if (UNLIKELY(obj == nullptr) && binned_bytes_.LoadRelaxed() != 0) {
+      // The binned blocks may be what keeps a large enough free block from forming.
+      ReleaseBinnedBlocks(self);
+      obj = AllocFromFreeList(self, allocation_size);
+    }
+    if (obj == nullptr) {
+      return nullptr;
+    }
+  }
+  DCHECK(bytes_allocated != nullptr);
+  *bytes_allocated = allocation_size;
+  if (usable_size != nullptr) {
+    *usable_size = allocation_size;
+  }
+  DCHECK(bytes_tl_bulk_allocated != nullptr);
+  *bytes_tl_bulk_allocated = allocation_size;
+  num_objects_allocated_.FetchAndAddSequentiallyConsistent(1);
+  total_objects_allocated_.FetchAndAddSequentiallyConsistent(1);
+  num_bytes_allocated_.FetchAndAddSequentiallyConsistent(allocation_size);
+  total_bytes_allocated_.FetchAndAddSequentiallyConsistent(allocation_size);
+  return obj;
+}
+
+mirror::Object* FreeListSpace::AllocFromFreeList(Thread* self, size_t allocation_size) {
+  MutexLock mu(self, lock_);
   AllocationInfo temp_info;
   temp_info.SetPrevFreeBytes(allocation_size);
   temp_info.SetByteSize(0, false);
@@ -525,18 +692,6 @@ mirror::Object* FreeListSpace::Alloc(Thread* self, size_t num_bytes, size_t* byt
       return nullptr;
     }
   }
-  DCHECK(bytes_allocated != nullptr);
-  *bytes_allocated = allocation_size;
-  if (usable_size != nullptr) {
-    *usable_size = allocation_size;
-  }
-  DCHECK(bytes_tl_bulk_allocated != nullptr);
-  *bytes_tl_bulk_allocated = allocation_size;
-  // Need to do these inside of the lock.
-  ++num_objects_allocated_;
-  ++total_objects_allocated_;
-  num_bytes_allocated_ += allocation_size;
-  total_bytes_allocated_ += allocation_size;
   mirror::Object* obj = reinterpret_cast<mirror::Object*>(GetAddressForAllocationInfo(new_info));
   // We always put our object at the start of the free block, there can not be another free block
   // before it.
@@ -549,7 +704,9 @@ mirror::Object* FreeListSpace::Alloc(Thread* self, size_t num_bytes, size_t* byt
 }
 
 void FreeListSpace::Dump(std::ostream& os) const {
-  MutexLock mu(Thread::Current(), lock_);
+  Thread* self = Thread::Current();
+  const std::set<uintptr_t> binned_blocks = GetBinnedBlocks(self);
+  MutexLock mu(self, lock_);
   os << GetName() << " -"
      << " begin: " << reinterpret_cast<void*>(Begin())
      << " end: " << reinterpret_cast<void*>(End()) << "\n";
@@ -563,6 +720,9 @@ void FreeListSpace::Dump(std::ostream& os) const {
     if (cur_info->IsFree()) {
       os << "Free block at address: " << reinterpret_cast<const void*>(address)
          << " of length " << size << " bytes\n";
+    } else if (binned_blocks.find(address) != binned_blocks.end()) {
+      os << "Binned block at address: " << reinterpret_cast<const void*>(address)
+         << " of length " << size << " bytes\n";
     } else {
       os << "Large object at address: " << reinterpret_cast<const void*>(address)
          << " of length " << size << " bytes\n";
@@ -582,6 +742,8 @@ bool FreeListSpace::IsZygoteLargeObject(Thread* self ATTRIBUTE_UNUSED, mirror::O
 }
 
 void FreeListSpace::SetAllLargeObjectsAsZygoteObjects(Thread* self) {
+  // Binned blocks are free, they must not be marked.
+  ReleaseBinnedBlocks(self);
   MutexLock mu(self, lock_);
   uintptr_t free_end_start = reinterpret_cast<uintptr_t>(end_) - free_end_;
   for (AllocationInfo* cur_info = GetAllocationInfoForAddress(reinterpret_cast<uintptr_t>(Begin())),
@@ -17,6 +17,7 @@
 #ifndef ART_RUNTIME_GC_SPACE_LARGE_OBJECT_SPACE_H_
 #define ART_RUNTIME_GC_SPACE_LARGE_OBJECT_SPACE_H_
 
+#include "atomic.h"
 #include "base/allocator.h"
 #include "dlmalloc_space.h"
 #include "safe_map.h"
@@ -49,16 +50,16 @@ class LargeObjectSpace : public DiscontinuousSpace, public AllocSpace {
   virtual ~LargeObjectSpace() {}
 
   uint64_t GetBytesAllocated() OVERRIDE {
-    return num_bytes_allocated_;
+    return num_bytes_allocated_.LoadRelaxed();
   }
   uint64_t GetObjectsAllocated() OVERRIDE {
-    return num_objects_allocated_;
+    return num_objects_allocated_.LoadRelaxed();
   }
   uint64_t GetTotalBytesAllocated() const {
-    return total_bytes_allocated_;
+    return total_bytes_allocated_.LoadRelaxed();
   }
   uint64_t GetTotalObjectsAllocated() const {
-    return total_objects_allocated_;
+    return total_objects_allocated_.LoadRelaxed();
   }
   size_t FreeList(Thread* self, size_t num_ptrs, mirror::Object** ptrs) OVERRIDE;
   // LargeObjectSpaces don't have thread local state.
@@ -108,11 +109,12 @@ class LargeObjectSpace : public DiscontinuousSpace, public AllocSpace {
   explicit LargeObjectSpace(const std::string& name, uint8_t* begin, uint8_t* end);
   static void SweepCallback(size_t num_ptrs, mirror::Object** ptrs, void* arg);
 
-  // Approximate number of bytes which have been allocated into the space.
-  uint64_t num_bytes_allocated_;
-  uint64_t num_objects_allocated_;
-  uint64_t total_bytes_allocated_;
-  uint64_t total_objects_allocated_;
+  // Approximate number of bytes which have been allocated into the space. Atomic since the free
+  // list space updates them outside of its lock.
+  Atomic<uint64_t> num_bytes_allocated_;
+  Atomic<uint64_t> num_objects_allocated_;
+  Atomic<uint64_t> total_bytes_allocated_;
+  Atomic<uint64_t> total_objects_allocated_;
   // Begin and end, may change as more large objects are allocated.
   uint8_t* begin_;
   uint8_t* end_;
@@ -145,15 +147,31 @@ class LargeObjectMapSpace : public LargeObjectSpace {
     bool is_zygote;
   };
   explicit LargeObjectMapSpace(const std::string& name);
-  virtual ~LargeObjectMapSpace() {}
+  virtual ~LargeObjectMapSpace();
 
   bool IsZygoteLargeObject(Thread* self, mirror::Object* obj) const OVERRIDE REQUIRES(!lock_);
   void SetAllLargeObjectsAsZygoteObjects(Thread* self) OVERRIDE REQUIRES(!lock_);
 
+  // Freed mappings of at most this size are kept, with their pages released, so that later
+  // allocations of the same size reuse them instead of calling mmap and munmap.
+  static constexpr size_t kMaxCachedMapSize = 128 * KB;
+  // Maximum total size of the cached mappings, they only hold address space.
+  static constexpr size_t kMaxCachedMapsBytes = 2 * MB;
+
+  // Returns a zeroed cached mapping of map_size bytes, or null if there is none.
+  MemMap* TakeCachedMap(Thread* self, size_t map_size) REQUIRES(!lock_);
+  // Releases the pages of mem_map and caches it, or deletes it if it is too large or the cache
+  // is full.
+  void CacheOrDeleteMap(Thread* self, MemMap* mem_map) REQUIRES(!lock_);
+
   // Used to ensure mutual exclusion when the allocation spaces data structures are being modified.
   mutable Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
   AllocationTrackingSafeMap<mirror::Object*, LargeObject, kAllocatorTagLOSMaps> large_objects_
       GUARDED_BY(lock_);
+  // Cached mappings by size.
+  AllocationTrackingMultiMap<size_t, MemMap*, kAllocatorTagLOSMaps> cached_maps_
+      GUARDED_BY(lock_);
+  size_t cached_maps_bytes_ GUARDED_BY(lock_);
 };
 
 // A continuous large object space with a free-list to handle holes.
@@ -192,6 +210,34 @@ class FreeListSpace FINAL : public LargeObjectSpace {
   bool IsZygoteLargeObject(Thread* self, mirror::Object* obj) const OVERRIDE;
   void SetAllLargeObjectsAsZygoteObjects(Thread* self) OVERRIDE REQUIRES(!lock_);
 
+  // Freed blocks of at most this size are kept in a bin per size, with their pages released, so
+  // that freeing and allocating them again only takes the lock of their bin.
+  static constexpr size_t kMaxBinnedSize = 128 * KB;
+  static constexpr size_t kNumBins = kMaxBinnedSize / kAlignment;
+  // Maximum total size of the binned blocks, they can not be used for other sizes.
+  static constexpr size_t kMaxBinnedBytes = 2 * MB;
+
+  struct Bin {
+    Bin() : lock("free list space bin lock", kAllocSpaceLock) {}
+
+    // Never held together with lock_ or another bin lock.
+    mutable Mutex lock;
+    std::vector<mirror::Object*> blocks GUARDED_BY(lock);
+  };
+
+  // Allocates a block of allocation_size bytes from the free blocks or the end of the space.
+  mirror::Object* AllocFromFreeList(Thread* self, size_t allocation_size) REQUIRES(!lock_);
+  // Marks the block of info as free and coalesces it with its free neighbours.
+  void AddToFreeList(AllocationInfo* info) REQUIRES(lock_);
+  // Returns a zeroed binned block of allocation_size bytes, or null if there is none.
+  mirror::Object* TakeBinnedBlock(Thread* self, size_t allocation_size);
+  // Releases the pages of the freed block obj and bins it. Returns false if the bins are full.
+  bool BinBlock(Thread* self, mirror::Object* obj, size_t allocation_size);
+  // Moves all binned blocks to the free list, so that they can be coalesced.
+  void ReleaseBinnedBlocks(Thread* self) REQUIRES(!lock_);
+  // Returns the addresses of the binned blocks, which look allocated in the allocation infos.
+  std::set<uintptr_t> GetBinnedBlocks(Thread* self) const;
+
   class SortByPrevFree {
    public:
     bool operator()(const AllocationInfo* a, const AllocationInfo* b) const;
@@ -210,6 +256,9 @@ class FreeListSpace FINAL : public LargeObjectSpace {
   // Free bytes at the end of the space.
   size_t free_end_ GUARDED_BY(lock_);
   FreeBlocks free_blocks_ GUARDED_BY(lock_);
+  // Freed blocks by number of pages minus one.
+  Bin bins_[kNumBins];
+  Atomic<size_t> binned_bytes_;
 };
 
 }  // namespace space
@@ -15,6 +15,7 @@
  */
 
 #include "base/time_utils.h"
+#include "gc/heap.h"
 #include "space_test.h"
 #include "large_object_space.h"
 
@@ -29,6 +30,25 @@ class LargeObjectSpaceTest : public SpaceTest {
   static constexpr size_t kNumThreads = 10;
   static constexpr size_t kNumIterations = 1000;
   void RaceTest();
+  void MapReuseTest();
+  void DefaultTypeReuseTest();
+  void FreeListBinTest();
+
+  // Creates a large object space of the given type like the heap does.
+  static LargeObjectSpace* CreateLargeObjectSpace(LargeObjectSpaceType type, size_t capacity) {
+    if (type == LargeObjectSpaceType::kFreeList) {
+      return space::FreeListSpace::Create("large object space", nullptr, capacity);
+    }
+    CHECK(type == LargeObjectSpaceType::kMap);
+    return space::LargeObjectMapSpace::Create("large object space");
+  }
+
+  static void CountObjectsCallback(void* start, void* end ATTRIBUTE_UNUSED,
+                                   size_t num_bytes ATTRIBUTE_UNUSED, void* arg) {
+    if (start != nullptr) {
+      ++*reinterpret_cast<size_t*>(arg);
+    }
+  }
 };
 
 
@@ -164,6 +184,126 @@ void LargeObjectSpaceTest::RaceTest() {
   }
 }
 
+void LargeObjectSpaceTest::MapReuseTest() {
+  Thread* const self = Thread::Current();
+  LargeObjectSpace* los = space::LargeObjectMapSpace::Create("large object space");
+  static const size_t request_size = 16 * KB;
+  size_t allocation_size, bytes_tl_bulk_allocated;
+  mirror::Object* obj = los->Alloc(self, request_size, &allocation_size, nullptr,
+                                   &bytes_tl_bulk_allocated);
+  ASSERT_TRUE(obj != nullptr);
+  memset(obj, 0xAB, request_size);
+  los->Free(self, obj);
+
+  // An allocation of the same size reuses the freed mapping, which must be zeroed.
+  mirror::Object* obj2 = los->Alloc(self, request_size, &allocation_size, nullptr,
+                                    &bytes_tl_bulk_allocated);
+  ASSERT_TRUE(obj2 != nullptr);
+  if (!Runtime::Current()->IsRunningOnMemoryTool()) {
+    EXPECT_EQ(obj, obj2);
+  }
+  for (size_t k = 0; k < request_size; ++k) {
+    ASSERT_EQ(reinterpret_cast<const uint8_t*>(obj2)[k], 0u);
+  }
+  EXPECT_EQ(allocation_size, los->GetBytesAllocated());
+  EXPECT_EQ(1U, los->GetObjectsAllocated());
+
+  // Mappings larger than the cached size limit are unmapped when freed.
+  mirror::Object* large_obj = los->Alloc(self, 1 * MB, &allocation_size, nullptr,
+                                         &bytes_tl_bulk_allocated);
+  ASSERT_TRUE(large_obj != nullptr);
+  los->Free(self, large_obj);
+  los->Free(self, obj2);
+  EXPECT_EQ(0U, los->GetBytesAllocated());
+  EXPECT_EQ(0U, los->GetObjectsAllocated());
+  delete los;
+}
+
+void LargeObjectSpaceTest::DefaultTypeReuseTest() {
+  Thread* const self = Thread::Current();
+  LargeObjectSpace* los = CreateLargeObjectSpace(Heap::kDefaultLargeObjectSpaceType, 128 * MB);
+  // Sizes from the large object threshold up to the largest cached size, and one past it.
+  const size_t request_sizes[] = {
+      Heap::kDefaultLargeObjectThreshold, 16 * KB, 64 * KB, 128 * KB, 128 * KB + kPageSize };
+  for (size_t request_size : request_sizes) {
+    size_t allocation_size, bytes_tl_bulk_allocated;
+    mirror::Object* obj = los->Alloc(self, request_size, &allocation_size, nullptr,
+                                     &bytes_tl_bulk_allocated);
+    ASSERT_TRUE(obj != nullptr);
+    memset(obj, 0xCD, request_size);
+    EXPECT_EQ(allocation_size, los->Free(self, obj));
+    EXPECT_EQ(0U, los->GetBytesAllocated());
+    EXPECT_EQ(0U, los->GetObjectsAllocated());
+
+    // Freed blocks may be handed out again, they must be zeroed.
+    mirror::Object* obj2 = los->Alloc(self, request_size, &allocation_size, nullptr,
+                                      &bytes_tl_bulk_allocated);
+    ASSERT_TRUE(obj2 != nullptr);
+    if (request_size <= 128 * KB && !Runtime::Current()->IsRunningOnMemoryTool()) {
+      EXPECT_EQ(obj, obj2) << request_size;
+    }
+    for (size_t k = 0; k < request_size; ++k) {
+      ASSERT_EQ(reinterpret_cast<const uint8_t*>(obj2)[k], 0u) << request_size;
+    }
+    EXPECT_EQ(allocation_size, los->GetBytesAllocated());
+    EXPECT_EQ(1U, los->GetObjectsAllocated());
+    los->Free(self, obj2);
+  }
+  EXPECT_EQ(0U, los->GetBytesAllocated());
+  EXPECT_EQ(0U, los->GetObjectsAllocated());
+  EXPECT_EQ(2 * arraysize(request_sizes), los->GetTotalObjectsAllocated());
+  delete los;
+}
+
+void LargeObjectSpaceTest::FreeListBinTest() {
+  Thread* const self = Thread::Current();
+  static const size_t capacity = 4 * MB;
+  static const size_t block_size = 128 * KB;
+  LargeObjectSpace* los = CreateLargeObjectSpace(LargeObjectSpaceType::kFreeList, capacity);
+  std::vector<mirror::Object*> objs;
+  size_t allocation_size, bytes_tl_bulk_allocated;
+  for (size_t i = 0; i < capacity / block_size; ++i) {
+    mirror::Object* obj = los->Alloc(self, block_size, &allocation_size, nullptr,
+                                     &bytes_tl_bulk_allocated);
+    ASSERT_TRUE(obj != nullptr);
+    objs.push_back(obj);
+  }
+  // Free every block, more than the bins can hold. The binned blocks are not walked.
+  for (mirror::Object* obj : objs) {
+    los->Free(self, obj);
+  }
+  size_t num_objects = 0;
+  los->Walk(CountObjectsCallback, &num_objects);
+  EXPECT_EQ(0U, num_objects);
+  los->Dump(LOG(INFO));
+
+  // Binned blocks are not marked as zygote objects, and are reused as regular ones.
+  mirror::Object* obj = los->Alloc(self, block_size, &allocation_size, nullptr,
+                                   &bytes_tl_bulk_allocated);
+  ASSERT_TRUE(obj != nullptr);
+  los->SetAllLargeObjectsAsZygoteObjects(self);
+  EXPECT_TRUE(los->IsZygoteLargeObject(self, obj));
+  mirror::Object* obj2 = los->Alloc(self, block_size, &allocation_size, nullptr,
+                                    &bytes_tl_bulk_allocated);
+  ASSERT_TRUE(obj2 != nullptr);
+  EXPECT_FALSE(los->IsZygoteLargeObject(self, obj2));
+  num_objects = 0;
+  los->Walk(CountObjectsCallback, &num_objects);
+  EXPECT_EQ(2U, num_objects);
+  los->Free(self, obj2);
+  los->Free(self, obj);
+
+  // The whole space is only free once the binned blocks are coalesced with the others.
+  mirror::Object* large_obj = los->Alloc(self, capacity, &allocation_size, nullptr,
+                                         &bytes_tl_bulk_allocated);
+  ASSERT_TRUE(large_obj != nullptr);
+  EXPECT_EQ(capacity, los->GetBytesAllocated());
+  los->Free(self, large_obj);
+  EXPECT_EQ(0U, los->GetBytesAllocated());
+  EXPECT_EQ(0U, los->GetObjectsAllocated());
+  delete los;
+}
+
 TEST_F(LargeObjectSpaceTest, LargeObjectTest) {
   LargeObjectTest();
 }
@@ -172,6 +312,18 @@ TEST_F(LargeObjectSpaceTest, RaceTest) {
   RaceTest();
 }
 
+TEST_F(LargeObjectSpaceTest, MapReuseTest) {
+  MapReuseTest();
+}
+
+TEST_F(LargeObjectSpaceTest, DefaultTypeReuseTest) {
+  DefaultTypeReuseTest();
+}
+
+TEST_F(LargeObjectSpaceTest, FreeListBinTest) {
+  FreeListBinTest();
+}
+
 }  // namespace space
 }  // namespace gc
 }  // namespace art
@@ -17,7 +17,11 @@
 
 #include "image.h"
 
+#include <zlib.h>
+
 #include "base/bit_utils.h"
+#include "base/casts.h"
+#include "base/stringprintf.h"
 #include "mirror/object_array.h"
 #include "mirror/object_array-inl.h"
 #include "mirror/object-inl.h"
@@ -28,7 +32,8 @@
 namespace art {
 
 const uint8_t ImageHeader::kImageMagic[] = { 'a', 'r', 't', '\n' };
-const uint8_t ImageHeader::kImageVersion[] = { '0', '2', '2', '\0' };
+const uint8_t ImageHeader::kImageVersion[] = { '0', '2', '3', '\0' };
+constexpr size_t ImageHeader::kCompressionBlockSize;
 
 #ifndef MOE
 ImageHeader::ImageHeader(uint32_t image_begin,
@@ -66,7 +71,9 @@ ImageHeader::ImageHeader(uint64_t image_begin,
     patch_delta_(0),
     image_roots_(image_roots),
     pointer_size_(pointer_size),
-    compile_pic_(compile_pic) {
+    compile_pic_(compile_pic),
+    storage_mode_(kStorageModeUncompressed),
+    data_size_(image_size - sizeof(ImageHeader)) {
 
 #if defined(MOE) && TARGET_OS_OSX
   size_t pageSize = 4096;
@@ -131,6 +138,9 @@ bool ImageHeader::IsValid() const {
   if (!IsAligned<kPageSize>(patch_delta_)) {
     return false;
   }
+  if (storage_mode_ >= kStorageModeCount) {
+    return false;
+  }
 #ifdef MOE
   if (!IsAligned<kPageSize>(image_begin_)) {
     return false;
@@ -180,6 +190,72 @@ const ImageSection& ImageHeader::GetImageSection(ImageSections index) const {
   return sections_[index];
 }
 
+size_t ImageHeader::GetBitmapFileOffset() const {
+  if (GetStorageMode() == kStorageModeUncompressed) {
+    return GetImageSection(kSectionImageBitmap).Offset();
+  }
+  return RoundUp(sizeof(ImageHeader) + GetDataSize(), kPageSize);
+}
+
+size_t ImageHeader::CompressData(StorageMode storage_mode,
+                                 const uint8_t* data,
+                                 size_t data_size,
+                                 std::vector<uint8_t>* out,
+                                 std::string* error_msg) {
+  CHECK_EQ(storage_mode, kStorageModeZlib);
+  const size_t num_blocks = RoundUp(data_size, kCompressionBlockSize) / kCompressionBlockSize;
+  const size_t table_size = num_blocks * sizeof(uint32_t);
+  out->resize(table_size + num_blocks * compressBound(kCompressionBlockSize));
+  size_t out_pos = table_size;
+  for (size_t i = 0; i != num_blocks; ++i) {
+    const size_t block_begin = i * kCompressionBlockSize;
+    const size_t block_size = std::min(kCompressionBlockSize, data_size - block_begin);
+    uLongf compressed_size = out->size() - out_pos;
+    int result = compress2(out->data() + out_pos, &compressed_size, data + block_begin, block_size,
+                           Z_DEFAULT_COMPRESSION);
+    if (result != Z_OK) {
+      *error_msg = StringPrintf("Failed to compress image block %zu: %d", i, result);
+      return 0u;
+    }
+    out_pos += compressed_size;
+    uint32_t block_end = dchecked_integral_cast<uint32_t>(out_pos);
+    memcpy(out->data() + i * sizeof(uint32_t), &block_end, sizeof(block_end));
+  }
+  out->resize(out_pos);
+  return out_pos;
+}
+
+bool ImageHeader::DecompressData(const uint8_t* data, uint8_t* out, std::string* error_msg) const {
+  CHECK_EQ(GetStorageMode(), kStorageModeZlib);
+  const size_t data_size = GetImageSize() - sizeof(ImageHeader);
+  const size_t num_blocks = RoundUp(data_size, kCompressionBlockSize) / kCompressionBlockSize;
+  size_t block_begin = num_blocks * sizeof(uint32_t);
+  if (block_begin > GetDataSize()) {
+    *error_msg = StringPrintf("Image block table of %zu blocks exceeds data size %zu",
+                              num_blocks, GetDataSize());
+    return false;
+  }
+  for (size_t i = 0; i != num_blocks; ++i) {
+    uint32_t block_end;
+    memcpy(&block_end, data + i * sizeof(uint32_t), sizeof(block_end));
+    if (block_end < block_begin || block_end > GetDataSize()) {
+      *error_msg = StringPrintf("Invalid end %u of image block %zu", block_end, i);
+      return false;
+    }
+    const size_t block_size = std::min(kCompressionBlockSize, data_size - i * kCompressionBlockSize);
+    uLongf decompressed_size = block_size;
+    int result = uncompress(out + i * kCompressionBlockSize, &decompressed_size,
+                            data + block_begin, block_end - block_begin);
+    if (result != Z_OK || decompressed_size != block_size) {
+      *error_msg = StringPrintf("Failed to decompress image block %zu: %d, size %lu vs. %zu",
+                                i, result, decompressed_size, block_size);
+      return false;
+    }
+    block_begin = block_end;
+  }
+  return true;
+}
+
 std::ostream& operator<<(std::ostream& os, const ImageSection& section) {
   return os << "size=" << section.Size() << " range=" << section.Offset() << "-" << section.End();
 }
@@ -20,6 +20,9 @@
 
 #include <string.h>
 
+#include <string>
+#include <vector>
+
 #include "globals.h"
 #include "mirror/object.h"
 
@@ -82,7 +85,8 @@ class PACKED(4) ImageHeader {
   ImageHeader()
       : image_begin_(0U), image_size_(0U), oat_checksum_(0U), oat_file_begin_(0U),
         oat_data_begin_(0U), oat_data_end_(0U), oat_file_end_(0U), patch_delta_(0),
-        image_roots_(0U), pointer_size_(0U), compile_pic_(0) {}
+        image_roots_(0U), pointer_size_(0U), compile_pic_(0),
+        storage_mode_(kStorageModeUncompressed), data_size_(0U) {}
 
 #ifndef MOE
   ImageHeader(uint32_t image_begin,
@@ -111,6 +115,17 @@ class PACKED(4) ImageHeader {
               uint32_t pointer_size,
               bool compile_pic_);
 
+  // How the image data following the header is stored in the image file.
+  enum StorageMode : uint32_t {
+    kStorageModeUncompressed,
+    // The data is split into blocks of kCompressionBlockSize bytes which are deflated separately.
+    // A table of the end offsets of the compressed blocks precedes them.
+    kStorageModeZlib,
+    kStorageModeCount,  // Number of elements in enum.
+  };
+  static constexpr StorageMode kDefaultStorageMode = kStorageModeUncompressed;
+  static constexpr size_t kCompressionBlockSize = 256 * KB;
+
   bool IsValid() const;
   const char* GetMagic() const;
 
@@ -209,6 +224,35 @@ class PACKED(4) ImageHeader {
     return compile_pic_ != 0;
   }
 
+  StorageMode GetStorageMode() const {
+    return static_cast<StorageMode>(storage_mode_);
+  }
+
+  // Size of the image data following the header in the image file, compressed or not.
+  size_t GetDataSize() const {
+    return data_size_;
+  }
+
+  void SetStorageMode(StorageMode storage_mode, size_t data_size) {
+    storage_mode_ = storage_mode;
+    data_size_ = data_size;
+  }
+
+  // Offset of the image bitmap in the image file. It follows the image data on the next page.
+  size_t GetBitmapFileOffset() const;
+
+  // Compress the image data following the header, data_size bytes at data, into out. Returns the
+  // compressed size, or 0 with an error message on failure.
+  static size_t CompressData(StorageMode storage_mode,
+                             const uint8_t* data,
+                             size_t data_size,
+                             std::vector<uint8_t>* out,
+                             std::string* error_msg);
+
+  // Decompress the GetDataSize() bytes at data into the image data following the header, which
+  // is GetImageSize() - sizeof(ImageHeader) bytes at out.
+  bool DecompressData(const uint8_t* data, uint8_t* out, std::string* error_msg) const;
+
  private:
   static const uint8_t kImageMagic[4];
   static const uint8_t kImageVersion[4];
@@ -278,6 +322,10 @@ class PACKED(4) ImageHeader {
   // Boolean (0 or 1) to denote if the image was compiled with --compile-pic option
   const uint32_t compile_pic_;
 
+  // Storage mode and size in the file of the image data following the header.
+  uint32_t storage_mode_;
+  uint32_t data_size_;
+
   // Image sections
   ImageSection sections_[kSectionCount];
 
@@ -291,6 +339,7 @@ std::ostream& operator<<(std::ostream& os, const ImageHeader::ImageMethod& polic
 std::ostream& operator<<(std::ostream& os, const ImageHeader::ImageRoot& policy);
 std::ostream& operator<<(std::ostream& os, const ImageHeader::ImageSections& section);
 std::ostream& operator<<(std::ostream& os, const ImageSection& section);
+std::ostream& operator<<(std::ostream& os, const ImageHeader::StorageMode& mode);
 
 }  // namespace art
 
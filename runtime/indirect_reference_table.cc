@@ -125,16 +125,23 @@ IndirectRef IndirectReferenceTable::Add(uint32_t cookie, mirror::Object* obj) {
   size_t index;
   if (numHoles > 0) {
     DCHECK_GT(topIndex, 1U);
-    // Find the first hole; likely to be near the end of the list.
-    IrtEntry* pScan = &table_[topIndex - 1];
-    DCHECK(!pScan->GetReference()->IsNull());
-    --pScan;
-    while (!pScan->GetReference()->IsNull()) {
-      DCHECK_GE(pScan, table_ + prevState.parts.topIndex);
+    if (!PopHole(topIndex, &index)) {
+      DCHECK(!UsesHoleList());
+      // Find the first hole; likely to be near the end of the list.
+      IrtEntry* pScan = &table_[topIndex - 1];
+      DCHECK(!pScan->GetReference()->IsNull());
       --pScan;
+      while (!pScan->GetReference()->IsNull()) {
+        DCHECK_GE(pScan, table_ + prevState.parts.topIndex);
+        --pScan;
+      }
+      index = pScan - table_;
     }
-    index = pScan - table_;
     segment_state_.parts.numHoles--;
+    if (segment_state_.parts.numHoles == 0) {
+      // Anything left on the list is stale.
+      free_holes_.clear();
+    }
   } else {
     // Add to the end.
     index = topIndex++;
@@ -151,6 +158,19 @@ IndirectRef IndirectReferenceTable::Add(uint32_t cookie, mirror::Object* obj) {
   return result;
 }
 
+bool IndirectReferenceTable::PopHole(size_t top_index, size_t* index) {
+  while (!free_holes_.empty()) {
+    const uint32_t candidate = free_holes_.back();
+    free_holes_.pop_back();
+    // The hole may have been consumed by removing the top-most entry and possibly refilled since.
+    if (candidate < top_index && table_[candidate].GetReference()->IsNull()) {
+      *index = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
 void IndirectReferenceTable::AssertEmpty() {
   for (size_t i = 0; i < Capacity(); ++i) {
     if (!table_[i].GetReference()->IsNull()) {
@@ -233,6 +253,9 @@ bool IndirectReferenceTable::Remove(uint32_t cookie, IndirectRef iref) {
       }
       segment_state_.parts.numHoles = numHoles + prevState.parts.numHoles;
       segment_state_.parts.topIndex = topIndex;
+      if (segment_state_.parts.numHoles == 0) {
+        free_holes_.clear();
+      }
     } else {
       segment_state_.parts.topIndex = topIndex-1;
       if ((false)) {
@@ -252,6 +275,9 @@ bool IndirectReferenceTable::Remove(uint32_t cookie, IndirectRef iref) {
 
     *table_[idx].GetReference() = GcRoot<mirror::Object>(nullptr);
     segment_state_.parts.numHoles++;
+    if (UsesHoleList()) {
+      free_holes_.push_back(idx);
+    }
     if ((false)) {
       LOG(INFO) << "+++ left hole at " << idx << ", holes=" << segment_state_.parts.numHoles;
     }
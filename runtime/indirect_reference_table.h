@@ -21,6 +21,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/mutex.h"
@@ -175,10 +176,12 @@ static const uint32_t IRT_FIRST_SEGMENT = 0;
  * stale references aren't possible (though we may be able to get similar
  * benefits with other approaches).
  *
- * TODO: consider a "lastDeleteIndex" for quick hole-filling when an
- * add immediately follows a delete; must invalidate after segment pop
- * (which could increase the cost/complexity of method call/return).
- * Might be worth only using it for JNI globals.
+ * Global and weak global tables only ever use the first segment and see
+ * high rates of add/remove in arbitrary order, so they keep a list of the
+ * holes left by Remove.  This makes filling a hole O(1) instead of a scan
+ * down from the top of the table.  Holes consumed when the top-most entry
+ * is removed are not taken off the list; stale entries are dropped when
+ * they are popped.  Local tables are segmented and keep scanning for holes.
  *
  * TODO: may want completely different add/remove algorithms for global
  * and local refs to improve performance.  A large circular buffer might
@@ -372,6 +375,15 @@ class IndirectReferenceTable {
   // Abort if check_jni is not enabled.
   static void AbortIfNoCheckJNI();
 
+  // Whether Remove records holes in free_holes_, see the table definition comment.
+  bool UsesHoleList() const {
+    return kind_ != kLocal;
+  }
+
+  // Pop a hole below top_index from free_holes_, dropping stale entries. Returns false if there
+  // is no such hole recorded.
+  bool PopHole(size_t top_index, size_t* index);
+
   /* extra debugging checks */
   bool GetChecked(IndirectRef) const;
   bool CheckEntry(const char*, IndirectRef, int) const;
@@ -388,6 +400,8 @@ class IndirectReferenceTable {
   const IndirectRefKind kind_;
   /* max #of entries allowed */
   const size_t max_entries_;
+  // Indices of holes left by Remove, only used if UsesHoleList().
+  std::vector<uint32_t> free_holes_;
 };
 
 }  // namespace art
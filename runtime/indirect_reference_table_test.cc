@@ -254,4 +254,61 @@ TEST_F(IndirectReferenceTableTest, BasicTest) {
   CheckDump(&irt, 0, 0);
 }
 
+TEST_F(IndirectReferenceTableTest, GlobalHoleReuse) {
+  ScopedObjectAccess soa(Thread::Current());
+  static const size_t kTableMax = 64;
+  IndirectReferenceTable irt(kTableMax, kTableMax, kGlobal);
+
+  mirror::Class* c = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Object;");
+  ASSERT_TRUE(c != nullptr);
+  mirror::Object* obj0 = c->AllocObject(soa.Self());
+  ASSERT_TRUE(obj0 != nullptr);
+  mirror::Object* obj1 = c->AllocObject(soa.Self());
+  ASSERT_TRUE(obj1 != nullptr);
+
+  const uint32_t cookie = IRT_FIRST_SEGMENT;
+  static const size_t kNumRefs = 16;
+  IndirectRef refs[kNumRefs];
+  for (size_t i = 0; i < kNumRefs; i++) {
+    refs[i] = irt.Add(cookie, obj0);
+    ASSERT_TRUE(refs[i] != nullptr);
+  }
+
+  // Punch holes in every other slot below the top, then refill them.
+  for (size_t i = 0; i < kNumRefs - 1; i += 2) {
+    ASSERT_TRUE(irt.Remove(cookie, refs[i]));
+  }
+  for (size_t i = 0; i < kNumRefs - 1; i += 2) {
+    refs[i] = irt.Add(cookie, obj1);
+    ASSERT_TRUE(refs[i] != nullptr);
+    EXPECT_EQ(obj1, irt.Get(refs[i]));
+  }
+  ASSERT_EQ(kNumRefs, irt.Capacity()) << "holes not filled";
+  CheckDump(&irt, kNumRefs, 2);
+
+  // Leave a hole at the bottom and holes just below the top, then consume the latter by removing
+  // the top-most entry. The holes recorded for them are stale and must not be handed out again.
+  ASSERT_TRUE(irt.Remove(cookie, refs[0]));
+  ASSERT_TRUE(irt.Remove(cookie, refs[kNumRefs - 3]));
+  ASSERT_TRUE(irt.Remove(cookie, refs[kNumRefs - 2]));
+  ASSERT_TRUE(irt.Remove(cookie, refs[kNumRefs - 1]));
+  ASSERT_EQ(kNumRefs - 3, irt.Capacity());
+  refs[0] = irt.Add(cookie, obj0);
+  ASSERT_TRUE(refs[0] != nullptr);
+  ASSERT_EQ(kNumRefs - 3, irt.Capacity());
+  IndirectRef top = irt.Add(cookie, obj0);
+  ASSERT_TRUE(top != nullptr);
+  ASSERT_EQ(kNumRefs - 2, irt.Capacity());
+  for (size_t i = 0; i < kNumRefs - 3; i++) {
+    EXPECT_TRUE(irt.Get(refs[i]) != nullptr) << i;
+  }
+
+  for (size_t i = 0; i < kNumRefs - 3; i++) {
+    ASSERT_TRUE(irt.Remove(cookie, refs[i])) << i;
+  }
+  ASSERT_TRUE(irt.Remove(cookie, top));
+  ASSERT_EQ(0U, irt.Capacity());
+  CheckDump(&irt, 0, 0);
+}
+
 }  // namespace art
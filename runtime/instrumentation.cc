@@ -27,6 +27,7 @@
 #include "entrypoints/quick/quick_entrypoints.h"
 #include "entrypoints/quick/quick_alloc_entrypoints.h"
 #include "entrypoints/runtime_asm_entrypoints.h"
+#include "gc/heap.h"
 #include "gc_root-inl.h"
 #include "interpreter/interpreter.h"
 #include "jit/jit.h"
@@ -622,13 +623,21 @@ void Instrumentation::SetEntrypointsInstrumented(bool instrumented) {
   Locks::instrument_entrypoints_lock_->AssertHeld(self);
   if (runtime->IsStarted()) {
     ScopedSuspendAll ssa(__FUNCTION__);
-    MutexLock mu(self, *Locks::runtime_shutdown_lock_);
-    SetQuickAllocEntryPointsInstrumented(instrumented);
-    ResetQuickAllocEntryPoints();
+    {
+      MutexLock mu(self, *Locks::runtime_shutdown_lock_);
+      SetQuickAllocEntryPointsInstrumented(instrumented);
+      ResetQuickAllocEntryPoints();
+    }
+    runtime->GetHeap()->SetAllocationEntrypointsInstrumented(instrumented);
   } else {
-    MutexLock mu(self, *Locks::runtime_shutdown_lock_);
-    SetQuickAllocEntryPointsInstrumented(instrumented);
-    ResetQuickAllocEntryPoints();
+    {
+      MutexLock mu(self, *Locks::runtime_shutdown_lock_);
+      SetQuickAllocEntryPointsInstrumented(instrumented);
+      ResetQuickAllocEntryPoints();
+    }
+    if (runtime->GetHeap() != nullptr) {
+      runtime->GetHeap()->SetAllocationEntrypointsInstrumented(instrumented);
+    }
   }
 }
 
@@ -35,6 +35,7 @@
 #include "ScopedLocalRef.h"
 #include "ScopedUtfChars.h"
 #include "utils.h"
+#include "verifier/background_verifier.h"
 #include "well_known_classes.h"
 #include "zip_archive.h"
 
@@ -172,6 +173,11 @@ static jobject DexFile_openDexFileNative(
                                                                /*out*/ &error_msgs);
 
   if (!dex_files.empty()) {
+    // Collect the dex files before ConvertDexFilesToJavaArray releases them.
+    std::vector<const DexFile*> opened_dex_files;
+    for (const auto& dex_file : dex_files) {
+      opened_dex_files.push_back(dex_file.get());
+    }
     jlongArray array = ConvertDexFilesToJavaArray(env, oat_file, dex_files);
     if (array == nullptr) {
       ScopedObjectAccess soa(env);
@@ -180,6 +186,8 @@ static jobject DexFile_openDexFileNative(
           dex_file.release();
         }
       }
+    } else if (runtime->GetBackgroundVerifier() != nullptr) {
+      runtime->GetBackgroundVerifier()->AddDexFiles(opened_dex_files);
     }
     return array;
   } else {
@@ -221,6 +229,9 @@ static jboolean DexFile_closeDexFile(JNIEnv* env, jclass, jobject cookie) {
         if (class_linker->FindDexCache(soa.Self(), *dex_file, true) == nullptr) {
           // Clear the element in the array so that we can call close again.
           long_dex_files->Set(i, 0);
+          if (runtime->GetBackgroundVerifier() != nullptr) {
+            runtime->GetBackgroundVerifier()->RemoveDexFile(dex_file);
+          }
           delete dex_file;
         } else {
           all_deleted = false;
@@ -22,13 +22,23 @@
 #include "mirror/object-inl.h"
 #include "mirror/reference-inl.h"
 #include "scoped_fast_native_object_access.h"
+#include "scoped_thread_state_change.h"
 
 namespace art {
 
 static jboolean FinalizerReference_makeCircularListIfUnenqueued(JNIEnv* env, jobject javaThis) {
   ScopedFastNativeObjectAccess soa(env);
   mirror::FinalizerReference* const ref = soa.Decode<mirror::FinalizerReference*>(javaThis);
-  return Runtime::Current()->GetHeap()->GetReferenceProcessor()->MakeCircularListIfUnenqueued(ref);
+  gc::ReferenceProcessor* const reference_processor =
+      Runtime::Current()->GetHeap()->GetReferenceProcessor();
+  if (!reference_processor->MakeCircularListIfUnenqueued(ref)) {
+    return JNI_FALSE;
+  }
+  // This is how System.runFinalization() enqueues the sentinel it waits for, which only the
+  // FinalizerDaemon finalizes. Also wait for the finalizers on the finalizer threads, if any.
+  ScopedThreadSuspension sts(soa.Self(), kWaiting);
+  reference_processor->WaitForFinalizerThreads(soa.Self());
+  return JNI_TRUE;
 }
 
 static JNINativeMethod gMethods[] = {
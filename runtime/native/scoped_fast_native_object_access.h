@@ -31,8 +31,8 @@ class ScopedFastNativeObjectAccess : public ScopedObjectAccessAlreadyRunnable {
     SHARED_LOCK_FUNCTION(Locks::mutator_lock_) ALWAYS_INLINE
      : ScopedObjectAccessAlreadyRunnable(env) {
     Locks::mutator_lock_->AssertSharedHeld(Self());
-    DCHECK((*Self()->GetManagedStack()->GetTopQuickFrame())->IsFastNative());
-    // Don't work with raw objects in non-runnable states.
+    // Don't work with raw objects in non-runnable states. This also catches methods which were
+    // not fast when called, the flag of the method may have changed since.
     DCHECK_EQ(Self()->GetState(), kRunnable);
   }
 
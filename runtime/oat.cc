@@ -80,6 +80,8 @@ OatHeader::OatHeader(InstructionSet instruction_set,
   memcpy(magic_, kOatMagic, sizeof(kOatMagic));
   memcpy(version_, kOatVersion, sizeof(kOatVersion));
   executable_offset_ = 0;
+  verifier_deps_offset_ = 0;
+  verifier_deps_size_ = 0;
   image_patch_delta_ = 0;
 
   adler32_checksum_ = adler32(0L, Z_NULL, 0);
@@ -208,6 +210,27 @@ void OatHeader::SetExecutableOffset(uint32_t executable_offset) {
   UpdateChecksum(&executable_offset_, sizeof(executable_offset));
 }
 
+uint32_t OatHeader::GetVerifierDepsOffset() const {
+  DCHECK(IsValid());
+  return verifier_deps_offset_;
+}
+
+uint32_t OatHeader::GetVerifierDepsSize() const {
+  DCHECK(IsValid());
+  return verifier_deps_size_;
+}
+
+void OatHeader::SetVerifierDeps(uint32_t offset, uint32_t size) {
+  DCHECK(IsValid());
+  DCHECK_EQ(verifier_deps_size_, 0U);
+  CHECK_GE(offset, sizeof(OatHeader));
+
+  verifier_deps_offset_ = offset;
+  verifier_deps_size_ = size;
+  UpdateChecksum(&verifier_deps_offset_, sizeof(verifier_deps_offset_));
+  UpdateChecksum(&verifier_deps_size_, sizeof(verifier_deps_size_));
+}
+
 const void* OatHeader::GetInterpreterToInterpreterBridge() const {
   return reinterpret_cast<const uint8_t*>(this) + GetInterpreterToInterpreterBridgeOffset();
 }
@@ -31,7 +31,7 @@ class InstructionSetFeatures;
 class PACKED(4) OatHeader {
  public:
   static constexpr uint8_t kOatMagic[] = { 'o', 'a', 't', '\n' };
-  static constexpr uint8_t kOatVersion[] = { '0', '7', '2', '\0' };
+  static constexpr uint8_t kOatVersion[] = { '0', '7', '4', '\0' };
 
   static constexpr const char* kImageLocationKey = "image-location";
   static constexpr const char* kDex2OatCmdLineKey = "dex2oat-cmdline";
@@ -62,6 +62,12 @@ class PACKED(4) OatHeader {
   uint32_t GetExecutableOffset() const;
   void SetExecutableOffset(uint32_t executable_offset);
 
+  // The verifier dependencies of the dex files, see verifier::VerifierDeps. The size is 0 if
+  // they were not recorded.
+  uint32_t GetVerifierDepsOffset() const;
+  uint32_t GetVerifierDepsSize() const;
+  void SetVerifierDeps(uint32_t offset, uint32_t size);
+
   const void* GetInterpreterToInterpreterBridge() const;
   uint32_t GetInterpreterToInterpreterBridgeOffset() const;
   void SetInterpreterToInterpreterBridgeOffset(uint32_t offset);
@@ -125,6 +131,8 @@ class PACKED(4) OatHeader {
   uint32_t instruction_set_features_bitmap_;
   uint32_t dex_file_count_;
   uint32_t executable_offset_;
+  uint32_t verifier_deps_offset_;
+  uint32_t verifier_deps_size_;
   uint32_t interpreter_to_interpreter_bridge_offset_;
   uint32_t interpreter_to_compiled_code_bridge_offset_;
   uint32_t jni_dlsym_lookup_offset_;
@@ -211,6 +211,12 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-Xstacktracefile:_")
           .WithType<std::string>()
           .IntoKey(M::StackTraceFile)
+      .Define("-Xallocsampleinterval:_")
+          .WithType<unsigned int>()
+          .IntoKey(M::AllocSampleInterval)
+      .Define("-Xallocsamplefile:_")
+          .WithType<std::string>()
+          .IntoKey(M::AllocSampleFile)
       .Define("-Xmethod-trace")
           .IntoKey(M::MethodTrace)
       .Define("-Xmethod-trace-file:_")
@@ -253,6 +259,12 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
                          {"all",      verifier::VerifyMode::kEnable},
                          {"softfail", verifier::VerifyMode::kSoftFail}})
           .IntoKey(M::Verify)
+      .Define("-Xbackground-verify-threads:_")
+          .WithType<unsigned int>()
+          .IntoKey(M::BackgroundVerifyThreads)
+      .Define("-Xfinalizer-threads:_")
+          .WithType<unsigned int>()
+          .IntoKey(M::FinalizerThreads)
       .Define("-XX:NativeBridge=_")
           .WithType<std::string>()
           .IntoKey(M::NativeBridge)
@@ -684,6 +696,14 @@ void ParsedOptions::Usage(const char* fmt, ...) {
   UsageMessage(stream, "  -Ximage-compiler-option dex2oat-option\n");
   UsageMessage(stream, "  -Xpatchoat:filename\n");
   UsageMessage(stream, "  -Xusejit:booleanvalue\n");
+  UsageMessage(stream, "  -Xbackground-verify-threads:integervalue "
+                       "(Load and verify all classes of dex files loaded at runtime on N threads)\n");
+  UsageMessage(stream, "  -Xfinalizer-threads:integervalue "
+                       "(Run finalizers on N runtime threads instead of the FinalizerDaemon)\n");
+  UsageMessage(stream, "  -Xallocsampleinterval:integervalue "
+                       "(Sample one allocation every N bytes allocated by a thread)\n");
+  UsageMessage(stream, "  -Xallocsamplefile:<filename> "
+                       "(Write the allocation samples to the file on SIGQUIT)\n");
   UsageMessage(stream, "  -X[no]relocate\n");
   UsageMessage(stream, "  -X[no]dex2oat (Whether to invoke dex2oat on the application)\n");
   UsageMessage(stream, "  -X[no]image-dex2oat (Whether to create and use a boot image)\n");
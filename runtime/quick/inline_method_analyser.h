@@ -39,10 +39,15 @@ enum InlineMethodOpcode : uint16_t {
   kIntrinsicFloatCvt,
   kIntrinsicReverseBits,
   kIntrinsicReverseBytes,
+  kIntrinsicBitCount,
+  kIntrinsicCompare,
+  kIntrinsicHighestOneBit,
+  kIntrinsicLowestOneBit,
   kIntrinsicNumberOfLeadingZeros,
   kIntrinsicNumberOfTrailingZeros,
   kIntrinsicRotateRight,
   kIntrinsicRotateLeft,
+  kIntrinsicSignum,
   kIntrinsicAbsInt,
   kIntrinsicAbsLong,
   kIntrinsicAbsFloat,
@@ -51,6 +56,14 @@ enum InlineMethodOpcode : uint16_t {
   kIntrinsicMinMaxLong,
   kIntrinsicMinMaxFloat,
   kIntrinsicMinMaxDouble,
+  kIntrinsicCos,
+  kIntrinsicSin,
+  kIntrinsicTan,
+  kIntrinsicAtan2,
+  kIntrinsicExp,
+  kIntrinsicLog,
+  kIntrinsicPow,
+  kIntrinsicHypot,
   kIntrinsicSqrt,
   kIntrinsicCeil,
   kIntrinsicFloor,
@@ -64,6 +77,9 @@ enum InlineMethodOpcode : uint16_t {
   kIntrinsicGetCharsNoCheck,
   kIntrinsicIsEmptyOrLength,
   kIntrinsicIndexOf,
+  kIntrinsicHashCode,
+  kIntrinsicIndexOfString,
+  kIntrinsicContentEquals,
   kIntrinsicNewStringFromBytes,
   kIntrinsicNewStringFromChars,
   kIntrinsicNewStringFromString,
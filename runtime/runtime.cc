@@ -136,6 +136,7 @@
 #include "trace.h"
 #include "transaction.h"
 #include "utils.h"
+#include "verifier/background_verifier.h"
 #include "verifier/method_verifier.h"
 #include "well_known_classes.h"
 
@@ -260,6 +261,8 @@ Runtime::Runtime()
       dump_gc_performance_on_shutdown_(false),
       preinitialization_transaction_(nullptr),
       verify_(verifier::VerifyMode::kNone),
+      background_verify_threads_(0u),
+      finalizer_threads_(0u),
       allow_dex_file_fallback_(true),
       target_sdk_version_(0),
       implicit_null_checks_(false),
@@ -309,6 +312,7 @@ Runtime::~Runtime() {
     self->ClearException();
     self->GetJniEnv()->CallStaticVoidMethod(WellKnownClasses::java_lang_Daemons,
                                             WellKnownClasses::java_lang_Daemons_stop);
+    heap_->GetReferenceProcessor()->StopFinalizerThreads(self);
   }
 
   Trace::Shutdown();
@@ -332,6 +336,10 @@ Runtime::~Runtime() {
     // JIT compiler threads.
     jit_->DeleteThreadPool();
   }
+  if (background_verifier_ != nullptr) {
+    // Like the JIT threads, the verifier threads must be gone before the thread list.
+    background_verifier_->DeleteThreadPool();
+  }
 
   // Make sure our internal threads are dead before we start tearing down things they're using.
   Dbg::StopJdwp();
@@ -766,6 +774,16 @@ void Runtime::DidForkFromZygote(JNIEnv* env, NativeBridgeAction action, const ch
     CreateJit();
   }
 
+  if (background_verifier_ == nullptr &&
+      background_verify_threads_ != 0u &&
+      IsVerificationEnabled()) {
+    background_verifier_.reset(new verifier::BackgroundVerifier(background_verify_threads_));
+  }
+
+  if (finalizer_threads_ != 0u) {
+    heap_->GetReferenceProcessor()->StartFinalizerThreads(Thread::Current(), finalizer_threads_);
+  }
+
   StartSignalCatcher();
 
   // Start the JDWP thread. If the command-line debugger flags specified "suspend=y",
@@ -959,6 +977,8 @@ bool Runtime::Init(const RuntimeOptions& raw_options, bool ignore_unrecognized)
   intern_table_ = new InternTable;
 
   verify_ = runtime_options.GetOrDefault(Opt::Verify);
+  background_verify_threads_ = runtime_options.GetOrDefault(Opt::BackgroundVerifyThreads);
+  finalizer_threads_ = runtime_options.GetOrDefault(Opt::FinalizerThreads);
   allow_dex_file_fallback_ = !runtime_options.Exists(Opt::NoDexFileFallback);
 
   no_sig_chain_ = runtime_options.Exists(Opt::NoSigChain);
@@ -1021,6 +1041,11 @@ bool Runtime::Init(const RuntimeOptions& raw_options, bool ignore_unrecognized)
 
   dump_gc_performance_on_shutdown_ = runtime_options.Exists(Opt::DumpGCPerformanceOnShutdown);
 
+  if (runtime_options.GetOrDefault(Opt::AllocSampleInterval) != 0) {
+    heap_->EnableAllocationSampling(runtime_options.GetOrDefault(Opt::AllocSampleInterval),
+                                    runtime_options.GetOrDefault(Opt::AllocSampleFile));
+  }
+
   if (runtime_options.Exists(Opt::JdwpOptions)) {
     Dbg::ConfigureJdwp(runtime_options.GetOrDefault(Opt::JdwpOptions));
   }
@@ -75,6 +75,7 @@ namespace mirror {
   class Throwable;
 }  // namespace mirror
 namespace verifier {
+  class BackgroundVerifier;
   class MethodVerifier;
   enum class VerifyMode : int8_t;
 }  // namespace verifier
@@ -516,6 +517,11 @@ class Runtime {
   bool IsVerificationEnabled() const;
   bool IsVerificationSoftFail() const;
 
+  // Null unless classes of dex files loaded at runtime are verified in the background.
+  verifier::BackgroundVerifier* GetBackgroundVerifier() const {
+    return background_verifier_.get();
+  }
+
   bool IsDexFileFallbackEnabled() const {
     return allow_dex_file_fallback_;
   }
@@ -740,6 +746,14 @@ class Runtime {
   // If kNone, verification is disabled. kEnable by default.
   verifier::VerifyMode verify_;
 
+  // Number of threads verifying the classes of dex files loaded at runtime, 0 to verify them on
+  // the thread which initializes them.
+  size_t background_verify_threads_;
+
+  // Number of threads running the finalizers, 0 to leave them to the Java FinalizerDaemon.
+  size_t finalizer_threads_;
+  std::unique_ptr<verifier::BackgroundVerifier> background_verifier_;
+
   // If true, the runtime may use dex files directly with the interpreter if an oat file is not
   // available/usable.
   bool allow_dex_file_fallback_;
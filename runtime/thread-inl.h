@@ -143,6 +143,11 @@ inline void Thread::TransitionFromRunnableToSuspended(ThreadState new_state) {
   DCHECK_EQ(this, Thread::Current());
   // Change to non-runnable state, thereby appearing suspended to the system.
   TransitionToSuspendedAndRunCheckpoints(new_state);
+  if (UNLIKELY(ReadFlag(kActiveSuspendBarrier))) {
+    // The share of the mutator_lock_ is still held, remember where we stopped running managed
+    // code for the thread waiting on the barrier.
+    RecordSuspendPoint();
+  }
   // Mark the release of the share of the mutator_lock_.
   Locks::mutator_lock_->TransitionFromRunnableToSuspended(this);
   // Once suspended - check the active suspend barrier flag
@@ -193,6 +198,8 @@ inline ThreadState Thread::TransitionFromSuspendedToRunnable() {
       DCHECK_EQ(GetSuspendCount(), 0);
     }
   } while (true);
+  // Our roots may change from now on, a concurrent GC needs to revisit them when remarking.
+  roots_dirty_ = true;
   // Run the flip function, if set.
   Closure* flip_func = GetFlipFunction();
   if (flip_func != nullptr) {
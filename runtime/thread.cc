@@ -1077,6 +1077,12 @@ bool Thread::PassActiveSuspendBarriers(Thread* self) {
       pass_barriers[i] = tlsPtr_.active_suspend_barriers[i];
       tlsPtr_.active_suspend_barriers[i] = nullptr;
     }
+    // Record the time under the lock so that the suspending thread reads it consistently.
+    suspend_barrier_pass_time_ = NanoTime();
+    suspend_barrier_pass_method_ = suspend_point_method_;
+    suspend_barrier_pass_dex_pc_ = suspend_point_dex_pc_;
+    suspend_point_method_ = nullptr;
+    suspend_point_dex_pc_ = 0u;
     AtomicClearFlag(kActiveSuspendBarrier);
   }
 
@@ -1103,6 +1109,10 @@ bool Thread::PassActiveSuspendBarriers(Thread* self) {
   return true;
 }
 
+void Thread::RecordSuspendPoint() {
+  suspend_point_method_ = GetCurrentMethod(&suspend_point_dex_pc_, /* abort_on_error */ false);
+}
+
 void Thread::ClearSuspendBarrier(AtomicInteger* target) {
   CHECK(ReadFlag(kActiveSuspendBarrier));
   bool clear_flag = true;
@@ -1611,7 +1621,17 @@ void Thread::Shutdown() {
   }
 }
 
-Thread::Thread(bool daemon) : tls32_(daemon), wait_monitor_(nullptr), interrupted_(false) {
+Thread::Thread(bool daemon)
+    : tls32_(daemon),
+      wait_monitor_(nullptr),
+      interrupted_(false),
+      roots_dirty_(true),
+      suspend_barrier_pass_time_(0),
+      suspend_point_method_(nullptr),
+      suspend_point_dex_pc_(0u),
+      suspend_barrier_pass_method_(nullptr),
+      suspend_barrier_pass_dex_pc_(0u),
+      alloc_sample_bytes_left_(0) {
   wait_mutex_ = new Mutex("a thread wait mutex");
   wait_cond_ = new ConditionVariable("a thread wait condition variable", *wait_mutex_);
   tlsPtr_.instrumentation_stack = new std::deque<instrumentation::InstrumentationStackFrame>;
@@ -2514,6 +2534,14 @@ void Thread::DumpThreadOffset(std::ostream& os, uint32_t offset) {
   QUICK_ENTRY_POINT_INFO(pShlLong)
   QUICK_ENTRY_POINT_INFO(pShrLong)
   QUICK_ENTRY_POINT_INFO(pUshrLong)
+  QUICK_ENTRY_POINT_INFO(pCos)
+  QUICK_ENTRY_POINT_INFO(pSin)
+  QUICK_ENTRY_POINT_INFO(pTan)
+  QUICK_ENTRY_POINT_INFO(pAtan2)
+  QUICK_ENTRY_POINT_INFO(pExp)
+  QUICK_ENTRY_POINT_INFO(pLog)
+  QUICK_ENTRY_POINT_INFO(pPow)
+  QUICK_ENTRY_POINT_INFO(pHypot)
   QUICK_ENTRY_POINT_INFO(pIndexOf)
   QUICK_ENTRY_POINT_INFO(pStringCompareTo)
   QUICK_ENTRY_POINT_INFO(pMemcpy)
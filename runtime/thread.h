@@ -236,6 +236,28 @@ class Thread {
   bool ModifySuspendCount(Thread* self, int delta, AtomicInteger* suspend_barrier, bool for_debugger)
       REQUIRES(Locks::thread_suspend_count_lock_);
 
+  // Returns true if the thread may have changed its roots since they were last visited by a
+  // concurrent root marking checkpoint. Only meaningful while the thread is suspended.
+  bool AreRootsDirty() const {
+    return roots_dirty_;
+  }
+
+  // Called by a marking checkpoint once it has visited the roots of this thread. A thread which
+  // visits its own roots keeps running and must stay dirty.
+  void SetRootsDirty(bool dirty) {
+    roots_dirty_ = dirty;
+  }
+
+  // Bytes this thread may allocate before its next allocation is sampled by the
+  // gc::AllocationSampler, zero until the first allocation it counts.
+  int64_t GetAllocSampleBytesLeft() const {
+    return alloc_sample_bytes_left_;
+  }
+
+  void SetAllocSampleBytesLeft(int64_t bytes) {
+    alloc_sample_bytes_left_ = bytes;
+  }
+
   bool RequestCheckpoint(Closure* function)
       REQUIRES(Locks::thread_suspend_count_lock_);
 
@@ -919,9 +941,26 @@ class Thread {
   bool PassActiveSuspendBarriers(Thread* self)
       REQUIRES(!Locks::thread_suspend_count_lock_);
 
+  // Record the current method and dex pc, for the next PassActiveSuspendBarriers.
+  void RecordSuspendPoint() SHARED_REQUIRES(Locks::mutator_lock_);
+
   void ClearSuspendBarrier(AtomicInteger* target)
       REQUIRES(Locks::thread_suspend_count_lock_);
 
+  // Time in ns at which this thread last passed an active suspend barrier, used to find the
+  // threads that are slow to reach a suspend point.
+  uint64_t GetSuspendBarrierPassTime() const REQUIRES(Locks::thread_suspend_count_lock_) {
+    return suspend_barrier_pass_time_;
+  }
+
+  // Method and dex pc at which this thread stopped running managed code when it last passed an
+  // active suspend barrier, or null if it was not running managed code.
+  ArtMethod* GetSuspendBarrierPassMethod(uint32_t* dex_pc) const
+      REQUIRES(Locks::thread_suspend_count_lock_) {
+    *dex_pc = suspend_barrier_pass_dex_pc_;
+    return suspend_barrier_pass_method_;
+  }
+
   bool ReadFlag(ThreadFlag flag) const {
     return (tls32_.state_and_flags.as_struct.flags & flag) != 0;
   }
@@ -1047,6 +1086,9 @@ class Thread {
       PassActiveSuspendBarriers();
     } else {
       tls32_.state_and_flags.as_struct.state = new_state;
+      if (new_state == kRunnable) {
+        roots_dirty_ = true;
+      }
     }
     return old_state;
   }
@@ -1395,6 +1437,26 @@ class Thread {
   // Thread "interrupted" status; stays raised until queried or thrown.
   bool interrupted_ GUARDED_BY(wait_mutex_);
 
+  // Set on every transition to runnable and cleared when a marking checkpoint visits the roots of
+  // the thread while it is suspended. Lets the concurrent mark sweep remark pause skip threads
+  // which have not run managed code since their roots were marked.
+  bool roots_dirty_;
+
+  // See GetSuspendBarrierPassTime.
+  uint64_t suspend_barrier_pass_time_ GUARDED_BY(Locks::thread_suspend_count_lock_);
+
+  // Set by RecordSuspendPoint and only accessed by this thread, PassActiveSuspendBarriers moves
+  // them to the suspend_barrier_pass_ fields.
+  ArtMethod* suspend_point_method_;
+  uint32_t suspend_point_dex_pc_;
+
+  // See GetSuspendBarrierPassMethod.
+  ArtMethod* suspend_barrier_pass_method_ GUARDED_BY(Locks::thread_suspend_count_lock_);
+  uint32_t suspend_barrier_pass_dex_pc_ GUARDED_BY(Locks::thread_suspend_count_lock_);
+
+  // See GetAllocSampleBytesLeft.
+  int64_t alloc_sample_bytes_left_;
+
   friend class Dbg;  // For SetStateUnsafe.
   friend class gc::collector::SemiSpace;  // For getting stack traces.
   friend class Runtime;  // For CreatePeer.
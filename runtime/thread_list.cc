@@ -28,6 +28,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <sstream>
 
 #include "base/histogram-inl.h"
@@ -60,10 +61,16 @@ static constexpr uint64_t kThreadSuspendTimeoutMs = 30 * 1000;  // 30s.
 static constexpr useconds_t kThreadSuspendInitialSleepUs = 0;
 static constexpr useconds_t kThreadSuspendMaxYieldUs = 3000;
 static constexpr useconds_t kThreadSuspendMaxSleepUs = 5000;
+// Number of threads reported when a suspend all request takes longer than
+// kLongThreadSuspendThreshold.
+static constexpr size_t kNumSlowestSuspendThreadsToReport = 4;
 
 ThreadList::ThreadList()
     : suspend_all_count_(0), debug_suspend_all_count_(0), unregistering_count_(0),
-      suspend_all_historam_("suspend all histogram", 16, 64), long_suspend_(false) {
+      suspend_all_historam_("suspend all histogram", 16, 64), long_suspend_(false),
+      suspend_all_start_time_(0),
+      time_to_suspend_histogram_("time to suspend histogram", 16, 64),
+      max_time_to_suspend_(0) {
   CHECK(Monitor::IsValidLockWord(LockWord::FromThinLockId(kMaxThreadId, 1, 0U)));
 }
 
@@ -395,11 +402,14 @@ size_t ThreadList::FlipThreadRoots(Closure* thread_flip_visitor, Closure* flip_c
   Locks::thread_suspend_count_lock_->AssertNotHeld(self);
   CHECK_NE(self->GetState(), kRunnable);
 
-  SuspendAllInternal(self, self, nullptr);
+  std::vector<Thread*> threads_to_suspend;
+  SuspendAllInternal(self, self, nullptr, false, &threads_to_suspend);
 
   // Run the flip callback for the collector.
   Locks::mutator_lock_->ExclusiveLock(self);
   flip_callback->Run(self);
+  TimesToSuspend times_to_suspend;
+  RecordTimeToSuspend(self, threads_to_suspend, &times_to_suspend);
   Locks::mutator_lock_->ExclusiveUnlock(self);
   collector->RegisterPause(NanoTime() - start_time);
 
@@ -453,6 +463,7 @@ size_t ThreadList::FlipThreadRoots(Closure* thread_flip_visitor, Closure* flip_c
     Thread::resume_cond_->Broadcast(self);
   }
 
+  ReportTimeToSuspend(self, start_time, &times_to_suspend);
   return runnable_threads.size() + other_threads.size() + 1;  // +1 for self.
 }
 
@@ -467,7 +478,8 @@ void ThreadList::SuspendAll(const char* cause, bool long_suspend) {
   ATRACE_BEGIN("Suspending mutator threads");
   const uint64_t start_time = NanoTime();
 
-  SuspendAllInternal(self, self);
+  std::vector<Thread*> runnable_threads;
+  SuspendAllInternal(self, self, nullptr, false, &runnable_threads);
   // All threads are known to have suspended (but a thread may still own the mutator lock)
   // Make sure this thread grabs exclusive access to the mutator lock and its protected data.
 #if HAVE_TIMED_RWLOCK
@@ -486,6 +498,12 @@ void ThreadList::SuspendAll(const char* cause, bool long_suspend) {
 #endif
 
   long_suspend_ = long_suspend;
+  suspend_all_start_time_ = start_time;
+  RecordTimeToSuspend(self, runnable_threads, &suspend_all_times_to_suspend_);
+  if (self != nullptr) {
+    // Holding the mutator lock exclusively lets us touch any object, treat it like running.
+    self->SetRootsDirty(true);
+  }
 
   const uint64_t end_time = NanoTime();
   const uint64_t suspend_time = end_time - start_time;
@@ -514,7 +532,7 @@ void ThreadList::SuspendAll(const char* cause, bool long_suspend) {
 // SuspendAllInternal. This is safe because it will be set back to suspended state before
 // the SuspendAll returns.
 void ThreadList::SuspendAllInternal(Thread* self, Thread* ignore1, Thread* ignore2,
-                                    bool debug_suspend) {
+                                    bool debug_suspend, std::vector<Thread*>* runnable_threads) {
   Locks::mutator_lock_->AssertNotExclusiveHeld(self);
   Locks::thread_list_lock_->AssertNotHeld(self);
   Locks::thread_suspend_count_lock_->AssertNotHeld(self);
@@ -547,6 +565,14 @@ void ThreadList::SuspendAllInternal(Thread* self, Thread* ignore1, Thread* ignor
     if (debug_suspend)
       ++debug_suspend_all_count_;
     pending_threads.StoreRelaxed(list_.size() - num_ignored);
+    if (runnable_threads != nullptr) {
+      runnable_threads->reserve(list_.size());
+    }
+    // Threads already suspended do not have to pass the barrier. Their count is subtracted once
+    // all requests are installed instead of per thread, which avoids contending on the counter
+    // with the runnable threads passing the barrier. The counter can not reach zero early since
+    // it only goes down.
+    int32_t num_suspended = 0;
     // Increment everybody's suspend count (except those that should be ignored).
     for (const auto& thread : list_) {
       if (thread == ignore1 || thread == ignore2) {
@@ -578,9 +604,14 @@ void ThreadList::SuspendAllInternal(Thread* self, Thread* ignore1, Thread* ignor
       if (thread->IsSuspended()) {
         // Only clear the counter for the current thread.
         thread->ClearSuspendBarrier(&pending_threads);
-        pending_threads.FetchAndSubSequentiallyConsistent(1);
+        ++num_suspended;
+      } else if (runnable_threads != nullptr) {
+        runnable_threads->push_back(thread);
       }
     }
+    if (num_suspended != 0) {
+      pending_threads.FetchAndSubSequentiallyConsistent(num_suspended);
+    }
   }
 
   // Wait for the barrier to be passed by all runnable threads. This wait
@@ -617,6 +648,132 @@ void ThreadList::SuspendAllInternal(Thread* self, Thread* ignore1, Thread* ignor
   }
 }
 
+void ThreadList::RecordTimeToSuspend(Thread* self,
+                                     const std::vector<Thread*>& runnable_threads,
+                                     TimesToSuspend* times_to_suspend) {
+  // The threads can not go away since their suspend count is raised.
+  times_to_suspend->clear();
+  times_to_suspend->reserve(runnable_threads.size());
+  MutexLock mu(self, *Locks::thread_suspend_count_lock_);
+  for (Thread* thread : runnable_threads) {
+    TimeToSuspend time_to_suspend;
+    time_to_suspend.time = thread->GetSuspendBarrierPassTime();
+    time_to_suspend.tid = thread->GetTid();
+    time_to_suspend.method = thread->GetSuspendBarrierPassMethod(&time_to_suspend.dex_pc);
+    times_to_suspend->push_back(time_to_suspend);
+  }
+}
+
+// Describe where a thread stopped running managed code to pass a suspend barrier.
+static std::string DescribeSuspendPoint(ArtMethod* method, uint32_t dex_pc)
+    SHARED_REQUIRES(Locks::mutator_lock_) {
+  if (method == nullptr) {
+    return " outside managed code";
+  }
+  return StringPrintf(" in %s at dex pc 0x%04x", PrettyMethod(method).c_str(), dex_pc);
+}
+
+void ThreadList::ReportTimeToSuspend(Thread* self,
+                                     uint64_t start_time,
+                                     TimesToSuspend* times_to_suspend) {
+  const size_t num_reported = std::min(times_to_suspend->size(),
+                                       kNumSlowestSuspendThreadsToReport);
+  if (num_reported == 0) {
+    return;
+  }
+  for (TimeToSuspend& time_to_suspend : *times_to_suspend) {
+    // A thread that passed the barrier before we sampled start_time can not be slow.
+    const uint64_t pass_time = time_to_suspend.time;
+    time_to_suspend.time = pass_time > start_time ? pass_time - start_time : 0u;
+  }
+  std::partial_sort(times_to_suspend->begin(),
+                    times_to_suspend->begin() + num_reported,
+                    times_to_suspend->end(),
+                    [](const TimeToSuspend& a, const TimeToSuspend& b) {
+                      return a.time > b.time;
+                    });
+  const uint64_t slowest_time = (*times_to_suspend)[0].time;
+  const bool is_long = slowest_time > kLongThreadSuspendThreshold;
+  bool is_new_max;
+  {
+    MutexLock mu(self, *Locks::thread_suspend_count_lock_);
+    for (const TimeToSuspend& time_to_suspend : *times_to_suspend) {
+      time_to_suspend_histogram_.AdjustAndAddValue(time_to_suspend.time);
+    }
+    is_new_max = slowest_time > max_time_to_suspend_;
+    if (is_new_max) {
+      max_time_to_suspend_ = slowest_time;
+    }
+  }
+  if (!is_long && !is_new_max && !ATRACE_ENABLED()) {
+    return;
+  }
+  // The threads may have exited since they were resumed, name the ones which are still there.
+  std::vector<std::string> names(num_reported);
+  {
+    MutexLock mu(self, *Locks::thread_list_lock_);
+    for (const auto& thread : list_) {
+      for (size_t i = 0; i < num_reported; ++i) {
+        if (thread->GetTid() == (*times_to_suspend)[i].tid) {
+          thread->GetThreadName(names[i]);
+        }
+      }
+    }
+  }
+  std::vector<std::string> descriptions(num_reported);
+  for (size_t i = 0; i < num_reported; ++i) {
+    descriptions[i] = StringPrintf("\"%s\" tid=%d",
+                                   names[i].c_str(),
+                                   static_cast<int>((*times_to_suspend)[i].tid));
+  }
+  if (self != nullptr) {
+    ReaderMutexLock mu(self, *Locks::mutator_lock_);
+    for (size_t i = 0; i < num_reported; ++i) {
+      const TimeToSuspend& time_to_suspend = (*times_to_suspend)[i];
+      descriptions[i] += DescribeSuspendPoint(time_to_suspend.method, time_to_suspend.dex_pc);
+    }
+  }
+  if (ATRACE_ENABLED()) {
+    std::ostringstream oss;
+    oss << "Slowest thread to suspend " << PrettyDuration(slowest_time) << " " << descriptions[0];
+    ATRACE_BEGIN(oss.str().c_str());
+    ATRACE_END();
+  }
+  if (is_new_max) {
+    MutexLock mu(self, *Locks::thread_suspend_count_lock_);
+    if (slowest_time == max_time_to_suspend_) {
+      max_time_to_suspend_location_ = descriptions[0];
+    }
+  }
+  if (is_long) {
+    std::ostringstream oss;
+    for (size_t i = 0; i < num_reported; ++i) {
+      oss << "\n  " << descriptions[i] << " took "
+          << PrettyDuration((*times_to_suspend)[i].time);
+    }
+    LOG(WARNING) << "Slowest of " << times_to_suspend->size() << " runnable threads to suspend:"
+                 << oss.str();
+  }
+}
+
+void ThreadList::DumpTimeToSuspendInfo(std::ostream& os) {
+  MutexLock mu(Thread::Current(), *Locks::thread_suspend_count_lock_);
+  if (time_to_suspend_histogram_.SampleSize() > 0) {
+    Histogram<uint64_t>::CumulativeData data;
+    time_to_suspend_histogram_.CreateHistogram(&data);
+    time_to_suspend_histogram_.PrintConfidenceIntervals(os, 0.99, data);
+    os << "Longest time to suspend " << PrettyDuration(max_time_to_suspend_) << " by "
+       << max_time_to_suspend_location_ << "\n";
+  }
+}
+
+void ThreadList::ResetTimeToSuspendInfo() {
+  MutexLock mu(Thread::Current(), *Locks::thread_suspend_count_lock_);
+  time_to_suspend_histogram_.Reset();
+  max_time_to_suspend_ = 0;
+  max_time_to_suspend_location_.clear();
+}
+
 void ThreadList::ResumeAll() {
   Thread* self = Thread::Current();
 
@@ -635,6 +792,10 @@ void ThreadList::ResumeAll() {
   }
 
   long_suspend_ = false;
+  // Report the times to suspend once the threads run again.
+  const uint64_t start_time = suspend_all_start_time_;
+  TimesToSuspend times_to_suspend;
+  times_to_suspend.swap(suspend_all_times_to_suspend_);
 
   Locks::mutator_lock_->ExclusiveUnlock(self);
   {
@@ -661,6 +822,8 @@ void ThreadList::ResumeAll() {
   }
   ATRACE_END();
 
+  ReportTimeToSuspend(self, start_time, &times_to_suspend);
+
   if (self != nullptr) {
     VLOG(threads) << *self << " ResumeAll complete";
   } else {
@@ -1270,6 +1433,21 @@ void ThreadList::VisitRoots(RootVisitor* visitor) const {
   }
 }
 
+size_t ThreadList::VisitDirtyThreadRoots(RootVisitor* visitor) const {
+  Thread* const self = Thread::Current();
+  Locks::mutator_lock_->AssertExclusiveHeld(self);
+  MutexLock mu(self, *Locks::thread_list_lock_);
+  size_t skipped = 0;
+  for (const auto& thread : list_) {
+    if (thread == self || thread->AreRootsDirty()) {
+      thread->VisitRoots(visitor);
+    } else {
+      ++skipped;
+    }
+  }
+  return skipped;
+}
+
 uint32_t ThreadList::AllocThreadId(Thread* self) {
   MutexLock mu(self, *Locks::allocated_thread_ids_lock_);
   for (size_t i = 0; i < allocated_ids_.size(); ++i) {
@@ -26,6 +26,8 @@
 
 #include <bitset>
 #include <list>
+#include <string>
+#include <vector>
 
 namespace art {
 namespace gc {
@@ -33,6 +35,7 @@ namespace gc {
     class GarbageCollector;
   }  // namespac collector
 }  // namespace gc
+class ArtMethod;
 class Closure;
 class Thread;
 class TimingLogger;
@@ -134,6 +137,12 @@ class ThreadList {
   void VisitRoots(RootVisitor* visitor) const
       SHARED_REQUIRES(Locks::mutator_lock_);
 
+  // Visit the roots of the threads which may have changed them since they were last visited by a
+  // marking checkpoint (see Thread::AreRootsDirty). Requires all threads to be suspended. Returns
+  // the number of threads whose roots were skipped.
+  size_t VisitDirtyThreadRoots(RootVisitor* visitor) const
+      SHARED_REQUIRES(Locks::mutator_lock_);
+
   // Return a copy of the thread list.
   std::list<Thread*> GetList() REQUIRES(Locks::thread_list_lock_) {
     return list_;
@@ -142,6 +151,12 @@ class ThreadList {
   void DumpNativeStacks(std::ostream& os)
       REQUIRES(!Locks::thread_list_lock_);
 
+  // Dump the histogram of per-thread time to suspend and the slowest suspend point seen.
+  void DumpTimeToSuspendInfo(std::ostream& os)
+      REQUIRES(!Locks::thread_suspend_count_lock_);
+  void ResetTimeToSuspendInfo()
+      REQUIRES(!Locks::thread_suspend_count_lock_);
+
  private:
   uint32_t AllocThreadId(Thread* self);
   void ReleaseThreadId(Thread* self, uint32_t id) REQUIRES(!Locks::allocated_thread_ids_lock_);
@@ -159,13 +174,43 @@ class ThreadList {
   void WaitForOtherNonDaemonThreadsToExit()
       REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
 
+  // If runnable_threads is non-null, it receives the threads which were not suspended yet and
+  // had to pass the suspend barrier.
   void SuspendAllInternal(Thread* self, Thread* ignore1, Thread* ignore2 = nullptr,
-                          bool debug_suspend = false)
+                          bool debug_suspend = false,
+                          std::vector<Thread*>* runnable_threads = nullptr)
       REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
 
   void AssertThreadsAreSuspended(Thread* self, Thread* ignore1, Thread* ignore2 = nullptr)
       REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
 
+  // When a thread which had to pass the suspend barrier of a suspend all request did so, and
+  // where it stopped running managed code.
+  struct TimeToSuspend {
+    // Barrier pass time, replaced by the time to suspend in ReportTimeToSuspend.
+    uint64_t time;
+    pid_t tid;
+    ArtMethod* method;
+    uint32_t dex_pc;
+  };
+  typedef std::vector<TimeToSuspend> TimesToSuspend;
+
+  // Copy the barrier pass times, tids and suspend points of runnable_threads. Cheap enough to do
+  // while the threads are suspended, ReportTimeToSuspend does the rest once they are resumed.
+  void RecordTimeToSuspend(Thread* self,
+                           const std::vector<Thread*>& runnable_threads,
+                           TimesToSuspend* times_to_suspend)
+      REQUIRES(!Locks::thread_suspend_count_lock_);
+
+  // Add the times to suspend of a suspend all request started at start_time to the histogram and
+  // log the slowest threads if the request was long. Must not be called while the threads are
+  // suspended, it takes the thread list lock to name them and the mutator lock to describe their
+  // methods.
+  void ReportTimeToSuspend(Thread* self, uint64_t start_time, TimesToSuspend* times_to_suspend)
+      REQUIRES(!Locks::mutator_lock_,
+               !Locks::thread_list_lock_,
+               !Locks::thread_suspend_count_lock_);
+
   std::bitset<kMaxThreadId> allocated_ids_ GUARDED_BY(Locks::allocated_thread_ids_lock_);
 
   // The actual list of all threads.
@@ -185,6 +230,18 @@ class ThreadList {
   // Whether or not the current thread suspension is long.
   bool long_suspend_;
 
+  // Per-thread time to reach a suspend point, for the threads which were runnable when a suspend
+  // all was requested.
+  Histogram<uint64_t> time_to_suspend_histogram_ GUARDED_BY(Locks::thread_suspend_count_lock_);
+
+  // Start and barrier pass times of the ongoing SuspendAll, reported by ResumeAll.
+  uint64_t suspend_all_start_time_ GUARDED_BY(Locks::mutator_lock_);
+  TimesToSuspend suspend_all_times_to_suspend_ GUARDED_BY(Locks::mutator_lock_);
+
+  // Longest time to suspend seen, the thread which took it and where it reached its suspend point.
+  uint64_t max_time_to_suspend_ GUARDED_BY(Locks::thread_suspend_count_lock_);
+  std::string max_time_to_suspend_location_ GUARDED_BY(Locks::thread_suspend_count_lock_);
+
   friend class Thread;
 
   DISALLOW_COPY_AND_ASSIGN(ThreadList);
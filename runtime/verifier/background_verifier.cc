@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "background_verifier.h"
+
+#include <utility>
+
+#include "ScopedLocalRef.h"
+#include "class_linker.h"
+#include "dex_file-inl.h"
+#include "handle_scope-inl.h"
+#include "java_vm_ext.h"
+#include "mirror/class-inl.h"
+#include "mirror/class_loader.h"
+#include "oat_file.h"
+#include "runtime.h"
+#include "scoped_thread_state_change.h"
+#include "thread.h"
+#include "thread_pool.h"
+#include "utf.h"
+#include "utils.h"
+#include "well_known_classes.h"
+
+namespace art {
+namespace verifier {
+
+constexpr size_t BackgroundVerifier::kClassesPerTask;
+
+// Returns whether all the class loaders of the chain starting at class_loader are the boot class
+// loader or BaseDexClassLoaders whose class is on the boot class path. Their loadClass() only runs
+// code of the boot class path, so the workers can call it.
+static bool IsBaseDexClassLoaderChain(ScopedObjectAccess& soa, mirror::ClassLoader* class_loader)
+    SHARED_REQUIRES(Locks::mutator_lock_) {
+  mirror::Class* boot_class_loader_class =
+      soa.Decode<mirror::Class*>(WellKnownClasses::java_lang_BootClassLoader);
+  mirror::Class* base_dex_class_loader_class =
+      soa.Decode<mirror::Class*>(WellKnownClasses::dalvik_system_BaseDexClassLoader);
+  for (; class_loader != nullptr; class_loader = class_loader->GetParent()) {
+    mirror::Class* klass = class_loader->GetClass();
+    if (klass == boot_class_loader_class) {
+      return true;
+    }
+    if (klass->GetClassLoader() != nullptr ||
+        !base_dex_class_loader_class->IsAssignableFrom(klass)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Loads the class through ClassLoader.loadClass(), like ClassLinker::FindClass does for the class
+// loaders it does not handle itself. Returns null with an exception pending on failure.
+static mirror::Class* LoadClassInJava(ScopedObjectAccess& soa,
+                                      Thread* self,
+                                      const char* descriptor,
+                                      Handle<mirror::ClassLoader> class_loader)
+    SHARED_REQUIRES(Locks::mutator_lock_) {
+  ScopedLocalRef<jobject> class_loader_object(soa.Env(),
+                                              soa.AddLocalReference<jobject>(class_loader.Get()));
+  ScopedLocalRef<jobject> result(soa.Env(), nullptr);
+  {
+    ScopedThreadStateChange tsc(self, kNative);
+    ScopedLocalRef<jobject> class_name_object(
+        soa.Env(), soa.Env()->NewStringUTF(DescriptorToDot(descriptor).c_str()));
+    if (class_name_object.get() == nullptr) {
+      return nullptr;
+    }
+    result.reset(soa.Env()->CallObjectMethod(class_loader_object.get(),
+                                             WellKnownClasses::java_lang_ClassLoader_loadClass,
+                                             class_name_object.get()));
+  }
+  return soa.Decode<mirror::Class*>(result.get());
+}
+
+class VerifyClassesTask FINAL : public Task {
+ public:
+  VerifyClassesTask(const DexFile& dex_file,
+                    jobject class_loader,
+                    std::vector<uint16_t>&& class_def_indexes)
+      : dex_file_(dex_file),
+        class_loader_(class_loader),
+        class_def_indexes_(std::move(class_def_indexes)) {}
+
+  ~VerifyClassesTask() {
+    Thread* self = Thread::Current();
+    Runtime::Current()->GetJavaVM()->DeleteGlobalRef(self, class_loader_);
+  }
+
+  void Run(Thread* self) OVERRIDE {
+    ScopedObjectAccess soa(self);
+    ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+    StackHandleScope<2> hs(self);
+    Handle<mirror::ClassLoader> class_loader(
+        hs.NewHandle(soa.Decode<mirror::ClassLoader*>(class_loader_)));
+    MutableHandle<mirror::Class> klass(hs.NewHandle<mirror::Class>(nullptr));
+    for (uint16_t class_def_index : class_def_indexes_) {
+      const DexFile::ClassDef& class_def = dex_file_.GetClassDef(class_def_index);
+      const char* descriptor = dex_file_.GetClassDescriptor(class_def);
+      const size_t hash = ComputeModifiedUtf8Hash(descriptor);
+      mirror::Class* result = class_linker->LookupClass(self, descriptor, hash, class_loader.Get());
+      // Only load classes through class loaders of the boot class path, the workers must not run
+      // code of the application. The runtime loads the classes of PathClassLoaders itself, the
+      // other BaseDexClassLoaders are called on the peer of the worker.
+      if (result == nullptr &&
+          !class_linker->FindClassInPathClassLoader(
+              soa, self, descriptor, hash, class_loader, &result)) {
+        if (!IsBaseDexClassLoaderChain(soa, class_loader.Get())) {
+          return;
+        }
+        result = LoadClassInJava(soa, self, descriptor, class_loader);
+      }
+      klass.Assign(result);
+      // A class which another thread is still loading is left to that thread.
+      if (klass.Get() != nullptr &&
+          klass->IsResolved() &&
+          !klass->IsVerified() &&
+          !klass->IsErroneous()) {
+        VLOG(verifier) << "Verifying " << descriptor << " in the background";
+        class_linker->VerifyClass(self, klass);
+      }
+      // Failures are reported again to the thread which uses the class.
+      self->ClearException();
+    }
+  }
+
+  void Finalize() OVERRIDE {
+    delete this;
+  }
+
+ private:
+  const DexFile& dex_file_;
+  const jobject class_loader_;
+  const std::vector<uint16_t> class_def_indexes_;
+
+  DISALLOW_IMPLICIT_CONSTRUCTORS(VerifyClassesTask);
+};
+
+BackgroundVerifier::BackgroundVerifier(size_t num_threads)
+    : lock_("background verifier lock"),
+      num_pending_dex_files_(0u),
+      thread_pool_(new ThreadPool("Background verifier thread pool",
+                                  num_threads,
+                                  /* create_peers */ true)) {
+  thread_pool_->StartWorkers(Thread::Current());
+}
+
+BackgroundVerifier::~BackgroundVerifier() {
+  DeleteThreadPool();
+}
+
+void BackgroundVerifier::DeleteThreadPool() {
+  thread_pool_.reset();
+}
+
+bool BackgroundVerifier::NeedsVerification(const DexFile& dex_file, uint16_t class_def_index) {
+  const OatFile::OatDexFile* oat_dex_file = dex_file.GetOatDexFile();
+  return oat_dex_file == nullptr ||
+      oat_dex_file->GetOatClass(class_def_index).GetStatus() < mirror::Class::kStatusVerified;
+}
+
+void BackgroundVerifier::AddDexFiles(const std::vector<const DexFile*>& dex_files) {
+  Thread* self = Thread::Current();
+  for (const DexFile* dex_file : dex_files) {
+    for (size_t i = 0; i != dex_file->NumClassDefs(); ++i) {
+      if (NeedsVerification(*dex_file, i)) {
+        MutexLock mu(self, lock_);
+        pending_dex_files_.insert(dex_file);
+        num_pending_dex_files_.StoreRelaxed(pending_dex_files_.size());
+        break;
+      }
+    }
+  }
+}
+
+void BackgroundVerifier::RemoveDexFile(const DexFile* dex_file) {
+  MutexLock mu(Thread::Current(), lock_);
+  pending_dex_files_.erase(dex_file);
+  num_pending_dex_files_.StoreRelaxed(pending_dex_files_.size());
+}
+
+void BackgroundVerifier::MaybeStartVerification(Thread* self,
+                                                const DexFile& dex_file,
+                                                Handle<mirror::ClassLoader> class_loader) {
+  if (num_pending_dex_files_.LoadRelaxed() == 0u || thread_pool_ == nullptr) {
+    return;
+  }
+  {
+    MutexLock mu(self, lock_);
+    if (pending_dex_files_.erase(&dex_file) == 0u) {
+      return;
+    }
+    num_pending_dex_files_.StoreRelaxed(pending_dex_files_.size());
+  }
+  VLOG(verifier) << "Starting background verification of " << dex_file.GetLocation();
+  JavaVMExt* vm = Runtime::Current()->GetJavaVM();
+  std::vector<uint16_t> class_def_indexes;
+  for (size_t i = 0; i != dex_file.NumClassDefs(); ++i) {
+    if (NeedsVerification(dex_file, i)) {
+      class_def_indexes.push_back(i);
+    }
+    if (class_def_indexes.size() == kClassesPerTask || i + 1 == dex_file.NumClassDefs()) {
+      if (!class_def_indexes.empty()) {
+        // The global reference keeps the class loader alive until the task is done.
+        jobject loader = vm->AddGlobalRef(self, class_loader.Get());
+        thread_pool_->AddTask(
+            self, new VerifyClassesTask(dex_file, loader, std::move(class_def_indexes)));
+        class_def_indexes.clear();
+      }
+    }
+  }
+}
+
+}  // namespace verifier
+}  // namespace art
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_VERIFIER_BACKGROUND_VERIFIER_H_
+#define ART_RUNTIME_VERIFIER_BACKGROUND_VERIFIER_H_
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "atomic.h"
+#include "base/macros.h"
+#include "base/mutex.h"
+#include "handle.h"
+
+namespace art {
+
+class DexFile;
+class Thread;
+class ThreadPool;
+
+namespace mirror {
+  class ClassLoader;
+}  // namespace mirror
+
+namespace verifier {
+
+// Verifies the classes of dex files loaded at runtime on a pool of worker threads, so that the
+// thread which initializes a class usually finds it verified already. ClassLinker::VerifyClass
+// holds the lock of the class being verified, so a thread which needs a class that a worker is
+// still verifying waits for that result instead of verifying the class again.
+//
+// Verification needs the class loader of the dex file, which is not known when the dex file is
+// opened. The dex file is therefore only remembered when it is opened, and its classes are
+// scheduled for verification once the first class of the dex file is defined by a class loader.
+//
+// Verifying a class requires loading and linking it, so the workers load all the classes of the
+// dex file which need verification, including the ones the application never uses. This trades
+// the memory of those classes for less verification on the threads which initialize classes.
+// Only classes of BaseDexClassLoaders of the boot class path, such as PathClassLoader and
+// DexClassLoader, are loaded. The workers never call into the class loaders of the application.
+class BackgroundVerifier {
+ public:
+  // Number of classes verified by one task of the thread pool.
+  static constexpr size_t kClassesPerTask = 32;
+
+  explicit BackgroundVerifier(size_t num_threads);
+  ~BackgroundVerifier();
+
+  // Remember the dex files which contain classes that were not verified at compile time.
+  void AddDexFiles(const std::vector<const DexFile*>& dex_files) REQUIRES(!lock_);
+
+  // Forget dex_file, which is about to be closed.
+  void RemoveDexFile(const DexFile* dex_file) REQUIRES(!lock_);
+
+  // Called when class_loader defined a class from dex_file. Schedules the verification of all
+  // the classes of dex_file if it was added with AddDexFiles().
+  void MaybeStartVerification(Thread* self,
+                              const DexFile& dex_file,
+                              Handle<mirror::ClassLoader> class_loader)
+      SHARED_REQUIRES(Locks::mutator_lock_)
+      REQUIRES(!lock_);
+
+  // Stop the worker threads, pending tasks are dropped. Called when the runtime shuts down.
+  void DeleteThreadPool();
+
+ private:
+  static bool NeedsVerification(const DexFile& dex_file, uint16_t class_def_index);
+
+  Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  std::set<const DexFile*> pending_dex_files_ GUARDED_BY(lock_);
+  // Size of pending_dex_files_, checked without taking lock_ every time a class is defined.
+  Atomic<size_t> num_pending_dex_files_;
+
+  std::unique_ptr<ThreadPool> thread_pool_;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundVerifier);
+};
+
+}  // namespace verifier
+}  // namespace art
+
+#endif  // ART_RUNTIME_VERIFIER_BACKGROUND_VERIFIER_H_
@@ -47,6 +47,7 @@
 #include "utils.h"
 #include "handle_scope-inl.h"
 #include "verifier/dex_gc_map.h"
+#include "verifier/verifier_deps.h"
 
 namespace art {
 namespace verifier {
@@ -58,12 +59,14 @@ static constexpr bool gDebugVerify = false;
 // On VLOG(verifier), should we dump the whole state when we run into a hard failure?
 static constexpr bool kDumpRegLinesOnHardFailureIfVLOG = true;
 
+PcToRegisterLineTable::PcToRegisterLineTable(ScopedArenaAllocator& arena)
+    : register_lines_(arena.Adapter(kArenaAllocVerifier)) {}
+
 void PcToRegisterLineTable::Init(RegisterTrackingMode mode, InstructionFlags* flags,
                                  uint32_t insns_size, uint16_t registers_size,
                                  MethodVerifier* verifier) {
   DCHECK_GT(insns_size, 0U);
-  register_lines_.reset(new RegisterLine*[insns_size]());
-  size_ = insns_size;
+  register_lines_.resize(insns_size);
   for (uint32_t i = 0; i < insns_size; i++) {
     bool interesting = false;
     switch (mode) {
@@ -80,19 +83,12 @@ void PcToRegisterLineTable::Init(RegisterTrackingMode mode, InstructionFlags* fl
         break;
     }
     if (interesting) {
-      register_lines_[i] = RegisterLine::Create(registers_size, verifier);
+      register_lines_[i].reset(RegisterLine::Create(registers_size, verifier));
     }
   }
 }
 
-PcToRegisterLineTable::~PcToRegisterLineTable() {
-  for (size_t i = 0; i < size_; i++) {
-    delete register_lines_[i];
-    if (kIsDebugBuild) {
-      register_lines_[i] = nullptr;
-    }
-  }
-}
+PcToRegisterLineTable::~PcToRegisterLineTable() {}
 
 // Note: returns true on failure.
 ALWAYS_INLINE static inline bool FailOrAbort(MethodVerifier* verifier, bool condition,
@@ -398,7 +394,10 @@ MethodVerifier::MethodVerifier(Thread* self,
                                bool need_precise_constants, bool verify_to_dump,
                                bool allow_thread_suspension)
     : self_(self),
-      reg_types_(can_load_classes),
+      arena_stack_(Runtime::Current()->GetArenaPool()),
+      arena_(&arena_stack_),
+      reg_types_(can_load_classes, arena_),
+      reg_table_(arena_),
       work_insn_idx_(DexFile::kDexNoIndex),
       dex_method_idx_(dex_method_idx),
       mirror_method_(method),
@@ -1895,8 +1894,8 @@ bool MethodVerifier::CodeFlowVerifyInstruction(uint32_t* start_guess) {
   // We need to ensure the work line is consistent while performing validation. When we spot a
   // peephole pattern we compute a new line for either the fallthrough instruction or the
   // branch target.
-  std::unique_ptr<RegisterLine> branch_line;
-  std::unique_ptr<RegisterLine> fallthrough_line;
+  RegisterLineArenaUniquePtr branch_line;
+  RegisterLineArenaUniquePtr fallthrough_line;
 
   switch (inst->Opcode()) {
     case Instruction::NOP:
@@ -3505,6 +3504,9 @@ const RegType& MethodVerifier::ResolveClassAndCheckAccess(uint32_t class_idx) {
   }
   if (klass == nullptr && !result.IsUnresolvedTypes()) {
     dex_cache_->SetResolvedType(class_idx, result.GetClass());
+  } else if (klass != nullptr) {
+    // The dex cache hit bypasses the RegTypeCache resolution, which records the dependency.
+    VerifierDeps::MaybeRecordClassResolution(descriptor, klass);
   }
   // Check if access is allowed. Unresolved types use xxxWithAccessCheck to
   // check at runtime if access is allowed and so pass here. If result is
@@ -3584,6 +3586,12 @@ ArtMethod* MethodVerifier::ResolveMethodAndCheckAccess(
   auto* cl = Runtime::Current()->GetClassLinker();
   auto pointer_size = cl->GetImagePointerSize();
   ArtMethod* res_method = dex_cache_->GetResolvedMethod(dex_method_idx, pointer_size);
+  VerifierDeps::MethodResolutionKind resolution_kind =
+      (method_type == METHOD_DIRECT || method_type == METHOD_STATIC)
+          ? VerifierDeps::kDirectMethodResolution
+          : (method_type == METHOD_INTERFACE)
+              ? VerifierDeps::kInterfaceMethodResolution
+              : VerifierDeps::kVirtualMethodResolution;
   if (res_method == nullptr) {
     const char* name = dex_file_->GetMethodName(method_id);
     const Signature signature = dex_file_->GetMethodSignature(method_id);
@@ -3605,6 +3613,8 @@ ArtMethod* MethodVerifier::ResolveMethodAndCheckAccess(
         res_method = klass->FindDirectMethod(name, signature, pointer_size);
       }
       if (res_method == nullptr) {
+        VerifierDeps::MaybeRecordMethodResolution(
+            *dex_file_, dex_method_idx, resolution_kind, nullptr);
         Fail(VERIFY_ERROR_NO_METHOD) << "couldn't find method "
                                      << PrettyDescriptor(klass) << "." << name
                                      << " " << signature;
@@ -3612,6 +3622,8 @@ ArtMethod* MethodVerifier::ResolveMethodAndCheckAccess(
       }
     }
   }
+  VerifierDeps::MaybeRecordMethodResolution(
+      *dex_file_, dex_method_idx, resolution_kind, res_method);
   // Make sure calls to constructors are "direct". There are additional restrictions but we don't
   // enforce them here.
   if (res_method->IsConstructor() && method_type != METHOD_DIRECT) {
@@ -3862,6 +3874,12 @@ ArtMethod* MethodVerifier::VerifyInvocationArgs(
       return nullptr;
     }
     mirror::Class* super_klass = super.GetClass();
+    // The superclass has a vtable entry for the method as long as it is a subclass of the
+    // declaring class of the method, whose resolution is recorded separately.
+    VerifierDeps::MaybeRecordAssignability(
+        res_method->GetDeclaringClass(),
+        super_klass,
+        res_method->GetDeclaringClass()->IsAssignableFrom(super_klass));
     if (res_method->GetMethodIndex() >= super_klass->GetVTableLength()) {
       Fail(VERIFY_ERROR_NO_METHOD) << "invalid invoke-super from "
                                    << PrettyMethod(dex_method_idx_, *dex_file_)
@@ -4239,6 +4257,7 @@ ArtField* MethodVerifier::GetStaticField(int field_idx) {
   ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
   ArtField* field = class_linker->ResolveFieldJLS(*dex_file_, field_idx, dex_cache_,
                                                   class_loader_);
+  VerifierDeps::MaybeRecordFieldResolution(*dex_file_, field_idx, field);
   if (field == nullptr) {
     VLOG(verifier) << "Unable to resolve static field " << field_idx << " ("
               << dex_file_->GetFieldName(field_id) << ") in "
@@ -4274,6 +4293,7 @@ ArtField* MethodVerifier::GetInstanceField(const RegType& obj_type, int field_id
   ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
   ArtField* field = class_linker->ResolveFieldJLS(*dex_file_, field_idx, dex_cache_,
                                                   class_loader_);
+  VerifierDeps::MaybeRecordFieldResolution(*dex_file_, field_idx, field);
   if (field == nullptr) {
     VLOG(verifier) << "Unable to resolve instance field " << field_idx << " ("
               << dex_file_->GetFieldName(field_id) << ") in "
@@ -4621,9 +4641,9 @@ bool MethodVerifier::UpdateRegisters(uint32_t next_insn, RegisterLine* merge_lin
       AdjustReturnLine(this, ret_inst, target_line);
     }
   } else {
-    std::unique_ptr<RegisterLine> copy(gDebugVerify ?
-                                 RegisterLine::Create(target_line->NumRegs(), this) :
-                                 nullptr);
+    RegisterLineArenaUniquePtr copy(gDebugVerify ?
+                                    RegisterLine::Create(target_line->NumRegs(), this) :
+                                    nullptr);
     if (gDebugVerify) {
       copy->CopyFromLine(target_line);
     }
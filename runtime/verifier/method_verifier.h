@@ -22,11 +22,13 @@
 #include <vector>
 
 #include "base/macros.h"
+#include "base/scoped_arena_containers.h"
 #include "dex_file.h"
 #include "handle.h"
 #include "instruction_flags.h"
 #include "method_reference.h"
 #include "reg_type_cache.h"
+#include "register_line.h"
 
 namespace art {
 
@@ -107,7 +109,7 @@ enum RegisterTrackingMode {
 // execution of that instruction.
 class PcToRegisterLineTable {
  public:
-  PcToRegisterLineTable() : size_(0) {}
+  explicit PcToRegisterLineTable(ScopedArenaAllocator& arena);
   ~PcToRegisterLineTable();
 
   // Initialize the RegisterTable. Every instruction address can have a different set of information
@@ -117,13 +119,12 @@ class PcToRegisterLineTable {
             uint16_t registers_size, MethodVerifier* verifier);
 
   RegisterLine* GetLine(size_t idx) {
-    DCHECK_LT(idx, size_);
-    return register_lines_[idx];
+    DCHECK_LT(idx, register_lines_.size());
+    return register_lines_[idx].get();
   }
 
  private:
-  std::unique_ptr<RegisterLine*[]> register_lines_;
-  size_t size_;
+  ScopedArenaVector<RegisterLineArenaUniquePtr> register_lines_;
 
   DISALLOW_COPY_AND_ASSIGN(PcToRegisterLineTable);
 };
@@ -172,6 +173,11 @@ class MethodVerifier {
     return &reg_types_;
   }
 
+  // The arena holding the per-method data of the verifier, released when the verifier is deleted.
+  ScopedArenaAllocator& GetArena() {
+    return arena_;
+  }
+
   // Log a verification failure.
   std::ostream& Fail(VerifyError error);
 
@@ -687,19 +693,24 @@ class MethodVerifier {
   // The thread we're verifying on.
   Thread* const self_;
 
+  // Arena for the register types, the register lines and the other per-method data. Declared
+  // before the users of the arena, so that it outlives them.
+  ArenaStack arena_stack_;
+  ScopedArenaAllocator arena_;
+
   RegTypeCache reg_types_;
 
   PcToRegisterLineTable reg_table_;
 
   // Storage for the register status we're currently working on.
-  std::unique_ptr<RegisterLine> work_line_;
+  RegisterLineArenaUniquePtr work_line_;
 
   // The address of the instruction we're currently working on, note that this is in 2 byte
   // quantities
   uint32_t work_insn_idx_;
 
   // Storage for the register status we're saving for later.
-  std::unique_ptr<RegisterLine> saved_line_;
+  RegisterLineArenaUniquePtr saved_line_;
 
   const uint32_t dex_method_idx_;  // The method we're working on.
   // Its object representation if known.
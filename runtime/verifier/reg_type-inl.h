@@ -21,6 +21,7 @@
 
 #include "base/casts.h"
 #include "mirror/class.h"
+#include "verifier_deps.h"
 
 namespace art {
 namespace verifier {
@@ -99,10 +100,11 @@ inline bool RegType::AssignableFrom(const RegType& lhs, const RegType& rhs, bool
         return true;
       } else if (lhs.IsJavaLangObjectArray()) {
         return rhs.IsObjectArrayTypes();  // All reference arrays may be assigned to Object[]
-      } else if (lhs.HasClass() && rhs.HasClass() &&
-                 lhs.GetClass()->IsAssignableFrom(rhs.GetClass())) {
-        // We're assignable from the Class point-of-view.
-        return true;
+      } else if (lhs.HasClass() && rhs.HasClass()) {
+        // Check whether we're assignable from the Class point-of-view.
+        bool result = lhs.GetClass()->IsAssignableFrom(rhs.GetClass());
+        VerifierDeps::MaybeRecordAssignability(lhs.GetClass(), rhs.GetClass(), result);
+        return result;
       } else {
         // Unresolved types are only assignable for null and equality.
         return false;
@@ -690,6 +690,9 @@ const RegType& RegType::Merge(const RegType& incoming_type, RegTypeCache* reg_ty
       DCHECK(c1 != nullptr && !c1->IsPrimitive());
       DCHECK(c2 != nullptr && !c2->IsPrimitive());
       mirror::Class* join_class = ClassJoin(c1, c2);
+      // The merged type is only valid as long as the join is a superclass of both classes.
+      VerifierDeps::MaybeRecordAssignability(join_class, c1, true);
+      VerifierDeps::MaybeRecordAssignability(join_class, c2, true);
       if (c1 == join_class && !IsPreciseReference()) {
         return *this;
       } else if (c2 == join_class && !incoming_type.IsPreciseReference()) {
@@ -704,15 +707,24 @@ const RegType& RegType::Merge(const RegType& incoming_type, RegTypeCache* reg_ty
   }
 }
 
+// The join depends on whether one class is assignable from the other, so the checks are recorded
+// as verifier dependencies, in addition to the join being assignable from both classes.
+static bool IsAssignableFromAndRecord(mirror::Class* destination, mirror::Class* source)
+    SHARED_REQUIRES(Locks::mutator_lock_) {
+  bool result = destination->IsAssignableFrom(source);
+  VerifierDeps::MaybeRecordAssignability(destination, source, result);
+  return result;
+}
+
 // See comment in reg_type.h
 mirror::Class* RegType::ClassJoin(mirror::Class* s, mirror::Class* t) {
   DCHECK(!s->IsPrimitive()) << PrettyClass(s);
   DCHECK(!t->IsPrimitive()) << PrettyClass(t);
   if (s == t) {
     return s;
-  } else if (s->IsAssignableFrom(t)) {
+  } else if (IsAssignableFromAndRecord(s, t)) {
     return s;
-  } else if (t->IsAssignableFrom(s)) {
+  } else if (IsAssignableFromAndRecord(t, s)) {
     return t;
   } else if (s->IsArrayClass() && t->IsArrayClass()) {
     mirror::Class* s_ct = s->GetComponentType();
@@ -25,6 +25,7 @@
 #include "base/bit_vector.h"
 #include "base/macros.h"
 #include "base/mutex.h"
+#include "base/scoped_arena_allocator.h"
 #include "gc_root.h"
 #include "handle_scope.h"
 #include "object_callbacks.h"
@@ -271,6 +272,16 @@ class RegType {
 
   virtual ~RegType() {}
 
+  // The types shared by all caches are allocated on the heap, the other types live in the arena
+  // of the RegTypeCache that created them.
+  static void* operator new(size_t size) noexcept {
+    return ::operator new(size);
+  }
+
+  static void* operator new(size_t size, ScopedArenaAllocator* arena) {
+    return arena->Alloc(size, kArenaAllocVerifier);
+  }
+
   void VisitRoots(RootVisitor* visitor, const RootInfo& root_info) const
       SHARED_REQUIRES(Locks::mutator_lock_);
 
@@ -81,41 +81,36 @@ inline const ImpreciseConstType& RegTypeCache::PosShortConstant() {
 }
 
 inline const PreciseReferenceType& RegTypeCache::JavaLangClass() {
-  const RegType* result = &FromClass("Ljava/lang/Class;", mirror::Class::GetJavaLangClass(), true);
-  DCHECK(result->IsPreciseReference());
-  return *down_cast<const PreciseReferenceType*>(result);
+  DCHECK(java_lang_class_ != nullptr);
+  return *java_lang_class_;
 }
 
 inline const PreciseReferenceType& RegTypeCache::JavaLangString() {
   // String is final and therefore always precise.
-  const RegType* result = &FromClass("Ljava/lang/String;", mirror::String::GetJavaLangString(),
-                                     true);
-  DCHECK(result->IsPreciseReference());
-  return *down_cast<const PreciseReferenceType*>(result);
+  DCHECK(java_lang_string_ != nullptr);
+  return *java_lang_string_;
 }
 
 inline const RegType&  RegTypeCache::JavaLangThrowable(bool precise) {
-  const RegType* result = &FromClass("Ljava/lang/Throwable;",
-                                     mirror::Throwable::GetJavaLangThrowable(), precise);
-  if (precise) {
-    DCHECK(result->IsPreciseReference());
-    return *down_cast<const PreciseReferenceType*>(result);
-  } else {
-    DCHECK(result->IsReference());
-    return *down_cast<const ReferenceType*>(result);
+  if (!precise) {
+    DCHECK(java_lang_throwable_ != nullptr);
+    return *java_lang_throwable_;
   }
+  const RegType* result = &FromClass("Ljava/lang/Throwable;",
+                                     mirror::Throwable::GetJavaLangThrowable(), true);
+  DCHECK(result->IsPreciseReference());
+  return *down_cast<const PreciseReferenceType*>(result);
 }
 
 inline const RegType& RegTypeCache::JavaLangObject(bool precise) {
-  const RegType* result = &FromClass("Ljava/lang/Object;",
-                                     mirror::Class::GetJavaLangClass()->GetSuperClass(), precise);
-  if (precise) {
-    DCHECK(result->IsPreciseReference());
-    return *down_cast<const PreciseReferenceType*>(result);
-  } else {
-    DCHECK(result->IsReference());
-    return *down_cast<const ReferenceType*>(result);
+  if (!precise) {
+    DCHECK(java_lang_object_ != nullptr);
+    return *java_lang_object_;
   }
+  const RegType* result = &FromClass("Ljava/lang/Object;",
+                                     mirror::Class::GetJavaLangClass()->GetSuperClass(), true);
+  DCHECK(result->IsPreciseReference());
+  return *down_cast<const PreciseReferenceType*>(result);
 }
 
 }  // namespace verifier
@@ -17,7 +17,6 @@
 #include "reg_type_cache-inl.h"
 
 #include "base/casts.h"
-#include "base/stl_util.h"
 #include "class_linker-inl.h"
 #include "dex_file-inl.h"
 #include "mirror/class-inl.h"
@@ -30,6 +29,10 @@ namespace verifier {
 bool RegTypeCache::primitive_initialized_ = false;
 uint16_t RegTypeCache::primitive_count_ = 0;
 const PreciseConstType* RegTypeCache::small_precise_constants_[kMaxSmallConstant - kMinSmallConstant + 1];
+const ReferenceType* RegTypeCache::java_lang_object_ = nullptr;
+const PreciseReferenceType* RegTypeCache::java_lang_class_ = nullptr;
+const PreciseReferenceType* RegTypeCache::java_lang_string_ = nullptr;
+const ReferenceType* RegTypeCache::java_lang_throwable_ = nullptr;
 
 static bool MatchingPrecisionForClass(const RegType* entry, bool precise)
     SHARED_REQUIRES(Locks::mutator_lock_) {
@@ -64,6 +67,10 @@ void RegTypeCache::FillPrimitiveAndSmallConstantTypes() {
     DCHECK_EQ(entries_.size(), small_precise_constants_[i]->GetId());
     entries_.push_back(small_precise_constants_[i]);
   }
+  entries_.push_back(java_lang_object_);
+  entries_.push_back(java_lang_class_);
+  entries_.push_back(java_lang_string_);
+  entries_.push_back(java_lang_throwable_);
   DCHECK_EQ(entries_.size(), primitive_count_);
 }
 
@@ -124,8 +131,9 @@ const RegType& RegTypeCache::RegTypeFromPrimitiveType(Primitive::Type prim_type)
   }
 }
 
-bool RegTypeCache::MatchDescriptor(size_t idx, const StringPiece& descriptor, bool precise) {
-  const RegType* entry = entries_[idx];
+bool RegTypeCache::MatchDescriptor(const RegType* entry,
+                                   const StringPiece& descriptor,
+                                   bool precise) {
   if (descriptor != entry->descriptor_) {
     return false;
   }
@@ -138,6 +146,26 @@ bool RegTypeCache::MatchDescriptor(size_t idx, const StringPiece& descriptor, bo
   return true;
 }
 
+const RegType* RegTypeCache::FindSharedReferenceType(const StringPiece& descriptor, bool precise) {
+  for (const RegType* entry : { java_lang_object_, java_lang_class_, java_lang_string_,
+                                java_lang_throwable_ }) {
+    if (descriptor == entry->descriptor_) {
+      return MatchingPrecisionForClass(entry, precise) ? entry : nullptr;
+    }
+  }
+  return nullptr;
+}
+
+const RegType* RegTypeCache::FindSharedReferenceType(mirror::Class* klass, bool precise) {
+  for (const RegType* entry : { java_lang_object_, java_lang_class_, java_lang_string_,
+                                java_lang_throwable_ }) {
+    if (entry->klass_.Read() == klass) {
+      return MatchingPrecisionForClass(entry, precise) ? entry : nullptr;
+    }
+  }
+  return nullptr;
+}
+
 mirror::Class* RegTypeCache::ResolveClass(const char* descriptor, mirror::ClassLoader* loader) {
   // Class was not found, must create new type.
   // Try resolving class
@@ -148,6 +176,7 @@ mirror::Class* RegTypeCache::ResolveClass(const char* descriptor, mirror::ClassL
   mirror::Class* klass = nullptr;
   if (can_load_classes_) {
     klass = class_linker->FindClass(self, descriptor, class_loader);
+    VerifierDeps::MaybeRecordClassResolution(descriptor, klass);
   } else {
     klass = class_linker->LookupClass(self, descriptor, ComputeModifiedUtf8Hash(descriptor),
                                       loader);
@@ -164,9 +193,15 @@ const RegType& RegTypeCache::From(mirror::ClassLoader* loader, const char* descr
   // Try looking up the class in the cache first. We use a StringPiece to avoid continual strlen
   // operations on the descriptor.
   StringPiece descriptor_sp(descriptor);
-  for (size_t i = primitive_count_; i < entries_.size(); i++) {
-    if (MatchDescriptor(i, descriptor_sp, precise)) {
-      return *(entries_[i]);
+  const RegType* shared_entry = FindSharedReferenceType(descriptor_sp, precise);
+  if (shared_entry != nullptr) {
+    return *shared_entry;
+  }
+  auto range = descriptor_index_.equal_range(ComputeModifiedUtf8Hash(descriptor));
+  for (auto it = range.first; it != range.second; ++it) {
+    const RegType* entry = entries_[it->second];
+    if (MatchDescriptor(entry, descriptor_sp, precise)) {
+      return *entry;
     }
   }
   // Class not found in the cache, will create a new type for that.
@@ -186,9 +221,9 @@ const RegType& RegTypeCache::From(mirror::ClassLoader* loader, const char* descr
     if (klass->CannotBeAssignedFromOtherTypes() || precise) {
       DCHECK(!(klass->IsAbstract()) || klass->IsArrayClass());
       DCHECK(!klass->IsInterface());
-      entry = new PreciseReferenceType(klass, descriptor_sp.as_string(), entries_.size());
+      entry = new (&arena_) PreciseReferenceType(klass, descriptor_sp.as_string(), entries_.size());
     } else {
-      entry = new ReferenceType(klass, descriptor_sp.as_string(), entries_.size());
+      entry = new (&arena_) ReferenceType(klass, descriptor_sp.as_string(), entries_.size());
     }
     AddEntry(entry);
     return *entry;
@@ -202,7 +237,8 @@ const RegType& RegTypeCache::From(mirror::ClassLoader* loader, const char* descr
       DCHECK(!Thread::Current()->IsExceptionPending());
     }
     if (IsValidDescriptor(descriptor)) {
-      RegType* entry = new UnresolvedReferenceType(descriptor_sp.as_string(), entries_.size());
+      RegType* entry =
+          new (&arena_) UnresolvedReferenceType(descriptor_sp.as_string(), entries_.size());
       AddEntry(entry);
       return *entry;
     } else {
@@ -220,7 +256,11 @@ const RegType& RegTypeCache::FromClass(const char* descriptor, mirror::Class* kl
     // primitive classes are final.
     return RegTypeFromPrimitiveType(klass->GetPrimitiveType());
   } else {
-    // Look for the reference in the list of entries to have.
+    // Look for the reference in the shared types, then in the list of entries to have.
+    const RegType* shared_entry = FindSharedReferenceType(klass, precise);
+    if (shared_entry != nullptr) {
+      return *shared_entry;
+    }
     for (size_t i = primitive_count_; i < entries_.size(); i++) {
       const RegType* cur_entry = entries_[i];
       if (cur_entry->klass_.Read() == klass && MatchingPrecisionForClass(cur_entry, precise)) {
@@ -230,16 +270,20 @@ const RegType& RegTypeCache::FromClass(const char* descriptor, mirror::Class* kl
     // No reference to the class was found, create new reference.
     RegType* entry;
     if (precise) {
-      entry = new PreciseReferenceType(klass, descriptor, entries_.size());
+      entry = new (&arena_) PreciseReferenceType(klass, descriptor, entries_.size());
     } else {
-      entry = new ReferenceType(klass, descriptor, entries_.size());
+      entry = new (&arena_) ReferenceType(klass, descriptor, entries_.size());
     }
     AddEntry(entry);
     return *entry;
   }
 }
 
-RegTypeCache::RegTypeCache(bool can_load_classes) : can_load_classes_(can_load_classes) {
+RegTypeCache::RegTypeCache(bool can_load_classes, ScopedArenaAllocator& arena)
+    : entries_(arena.Adapter(kArenaAllocVerifier)),
+      descriptor_index_(std::less<size_t>(), arena.Adapter(kArenaAllocVerifier)),
+      arena_(arena),
+      can_load_classes_(can_load_classes) {
   if (kIsDebugBuild) {
     Thread::Current()->AssertThreadSuspensionIsAllowable(gAborting == 0);
   }
@@ -249,14 +293,11 @@ RegTypeCache::RegTypeCache(bool can_load_classes) : can_load_classes_(can_load_c
 
 RegTypeCache::~RegTypeCache() {
   CHECK_LE(primitive_count_, entries_.size());
-  // Delete only the non primitive types.
-  if (entries_.size() == kNumPrimitivesAndSmallConstants) {
-    // All entries are from the global pool, nothing to delete.
-    return;
-  }
-  std::vector<const RegType*>::iterator non_primitive_begin = entries_.begin();
-  std::advance(non_primitive_begin, kNumPrimitivesAndSmallConstants);
-  STLDeleteContainerPointers(non_primitive_begin, entries_.end());
+  // The non shared types live in the arena, which releases their memory. Only run their
+  // destructors, for the descriptor strings and the bit vectors of unresolved merged types.
+  for (size_t i = kNumSharedTypes; i < entries_.size(); ++i) {
+    entries_[i]->~RegType();
+  }
 }
 
 void RegTypeCache::ShutDown() {
@@ -278,6 +319,14 @@ void RegTypeCache::ShutDown() {
       delete type;
       small_precise_constants_[value - kMinSmallConstant] = nullptr;
     }
+    delete java_lang_object_;
+    java_lang_object_ = nullptr;
+    delete java_lang_class_;
+    java_lang_class_ = nullptr;
+    delete java_lang_string_;
+    java_lang_string_ = nullptr;
+    delete java_lang_throwable_;
+    java_lang_throwable_ = nullptr;
     RegTypeCache::primitive_initialized_ = false;
     RegTypeCache::primitive_count_ = 0;
   }
@@ -297,6 +346,16 @@ const Type* RegTypeCache::CreatePrimitiveTypeInstance(const std::string& descrip
   return entry;
 }
 
+template <class Type>
+const Type* RegTypeCache::CreateSharedReferenceType(const char* descriptor) {
+  mirror::Class* klass =
+      Runtime::Current()->GetClassLinker()->FindSystemClass(Thread::Current(), descriptor);
+  CHECK(klass != nullptr) << descriptor;
+  const Type* entry = new Type(klass, descriptor, RegTypeCache::primitive_count_);
+  RegTypeCache::primitive_count_++;
+  return entry;
+}
+
 void RegTypeCache::CreatePrimitiveAndSmallConstantTypes() {
   CreatePrimitiveTypeInstance<UndefinedType>("");
   CreatePrimitiveTypeInstance<ConflictType>("");
@@ -315,6 +374,11 @@ void RegTypeCache::CreatePrimitiveAndSmallConstantTypes() {
     small_precise_constants_[value - kMinSmallConstant] = type;
     primitive_count_++;
   }
+  // String and Class are final and therefore always precise.
+  java_lang_object_ = CreateSharedReferenceType<ReferenceType>("Ljava/lang/Object;");
+  java_lang_class_ = CreateSharedReferenceType<PreciseReferenceType>("Ljava/lang/Class;");
+  java_lang_string_ = CreateSharedReferenceType<PreciseReferenceType>("Ljava/lang/String;");
+  java_lang_throwable_ = CreateSharedReferenceType<ReferenceType>("Ljava/lang/Throwable;");
 }
 
 const RegType& RegTypeCache::FromUnresolvedMerge(const RegType& left, const RegType& right) {
@@ -369,10 +433,10 @@ const RegType& RegTypeCache::FromUnresolvedMerge(const RegType& left, const RegT
   }
 
   // Create entry.
-  RegType* entry = new UnresolvedMergedType(resolved_parts_merged,
-                                            types,
-                                            this,
-                                            entries_.size());
+  RegType* entry = new (&arena_) UnresolvedMergedType(resolved_parts_merged,
+                                                      types,
+                                                      this,
+                                                      entries_.size());
   AddEntry(entry);
   return *entry;
 }
@@ -391,7 +455,7 @@ const RegType& RegTypeCache::FromUnresolvedSuperClass(const RegType& child) {
       }
     }
   }
-  RegType* entry = new UnresolvedSuperClass(child.GetId(), this, entries_.size());
+  RegType* entry = new (&arena_) UnresolvedSuperClass(child.GetId(), this, entries_.size());
   AddEntry(entry);
   return *entry;
 }
@@ -409,7 +473,9 @@ const UninitializedType& RegTypeCache::Uninitialized(const RegType& type, uint32
         return *down_cast<const UnresolvedUninitializedRefType*>(cur_entry);
       }
     }
-    entry = new UnresolvedUninitializedRefType(descriptor, allocation_pc, entries_.size());
+    entry = new (&arena_) UnresolvedUninitializedRefType(descriptor,
+                                                         allocation_pc,
+                                                         entries_.size());
   } else {
     mirror::Class* klass = type.GetClass();
     for (size_t i = primitive_count_; i < entries_.size(); i++) {
@@ -421,7 +487,10 @@ const UninitializedType& RegTypeCache::Uninitialized(const RegType& type, uint32
         return *down_cast<const UninitializedReferenceType*>(cur_entry);
       }
     }
-    entry = new UninitializedReferenceType(klass, descriptor, allocation_pc, entries_.size());
+    entry = new (&arena_) UninitializedReferenceType(klass,
+                                                     descriptor,
+                                                     allocation_pc,
+                                                     entries_.size());
   }
   AddEntry(entry);
   return *entry;
@@ -439,18 +508,22 @@ const RegType& RegTypeCache::FromUninitialized(const RegType& uninit_type) {
         return *cur_entry;
       }
     }
-    entry = new UnresolvedReferenceType(descriptor, entries_.size());
+    entry = new (&arena_) UnresolvedReferenceType(descriptor, entries_.size());
   } else {
     mirror::Class* klass = uninit_type.GetClass();
     if (uninit_type.IsUninitializedThisReference() && !klass->IsFinal()) {
       // For uninitialized "this reference" look for reference types that are not precise.
+      const RegType* shared_entry = FindSharedReferenceType(klass, false);
+      if (shared_entry != nullptr) {
+        return *shared_entry;
+      }
       for (size_t i = primitive_count_; i < entries_.size(); i++) {
         const RegType* cur_entry = entries_[i];
         if (cur_entry->IsReference() && cur_entry->GetClass() == klass) {
           return *cur_entry;
         }
       }
-      entry = new ReferenceType(klass, "", entries_.size());
+      entry = new (&arena_) ReferenceType(klass, "", entries_.size());
     } else if (!klass->IsPrimitive()) {
       // We're uninitialized because of allocation, look or create a precise type as allocations
       // may only create objects of that type.
@@ -463,13 +536,19 @@ const RegType& RegTypeCache::FromUninitialized(const RegType& uninit_type) {
       //       2) Checking whether the klass is instantiable and using conflict may produce a hard
       //          error when the value is used, which leads to a VerifyError, which is not the
       //          correct semantics.
+      const RegType* shared_entry = FindSharedReferenceType(klass, true);
+      if (shared_entry != nullptr) {
+        return *shared_entry;
+      }
       for (size_t i = primitive_count_; i < entries_.size(); i++) {
         const RegType* cur_entry = entries_[i];
         if (cur_entry->IsPreciseReference() && cur_entry->GetClass() == klass) {
           return *cur_entry;
         }
       }
-      entry = new PreciseReferenceType(klass, uninit_type.GetDescriptor(), entries_.size());
+      entry = new (&arena_) PreciseReferenceType(klass,
+                                                 uninit_type.GetDescriptor(),
+                                                 entries_.size());
     } else {
       return Conflict();
     }
@@ -489,7 +568,7 @@ const UninitializedType& RegTypeCache::UninitializedThisArgument(const RegType&
         return *down_cast<const UninitializedType*>(cur_entry);
       }
     }
-    entry = new UnresolvedUninitializedThisRefType(descriptor, entries_.size());
+    entry = new (&arena_) UnresolvedUninitializedThisRefType(descriptor, entries_.size());
   } else {
     mirror::Class* klass = type.GetClass();
     for (size_t i = primitive_count_; i < entries_.size(); i++) {
@@ -498,7 +577,7 @@ const UninitializedType& RegTypeCache::UninitializedThisArgument(const RegType&
         return *down_cast<const UninitializedType*>(cur_entry);
       }
     }
-    entry = new UninitializedThisReferenceType(klass, descriptor, entries_.size());
+    entry = new (&arena_) UninitializedThisReferenceType(klass, descriptor, entries_.size());
   }
   AddEntry(entry);
   return *entry;
@@ -515,9 +594,9 @@ const ConstantType& RegTypeCache::FromCat1NonSmallConstant(int32_t value, bool p
   }
   ConstantType* entry;
   if (precise) {
-    entry = new PreciseConstType(value, entries_.size());
+    entry = new (&arena_) PreciseConstType(value, entries_.size());
   } else {
-    entry = new ImpreciseConstType(value, entries_.size());
+    entry = new (&arena_) ImpreciseConstType(value, entries_.size());
   }
   AddEntry(entry);
   return *entry;
@@ -533,9 +612,9 @@ const ConstantType& RegTypeCache::FromCat2ConstLo(int32_t value, bool precise) {
   }
   ConstantType* entry;
   if (precise) {
-    entry = new PreciseConstLoType(value, entries_.size());
+    entry = new (&arena_) PreciseConstLoType(value, entries_.size());
   } else {
-    entry = new ImpreciseConstLoType(value, entries_.size());
+    entry = new (&arena_) ImpreciseConstLoType(value, entries_.size());
   }
   AddEntry(entry);
   return *entry;
@@ -551,9 +630,9 @@ const ConstantType& RegTypeCache::FromCat2ConstHi(int32_t value, bool precise) {
   }
   ConstantType* entry;
   if (precise) {
-    entry = new PreciseConstHiType(value, entries_.size());
+    entry = new (&arena_) PreciseConstHiType(value, entries_.size());
   } else {
-    entry = new ImpreciseConstHiType(value, entries_.size());
+    entry = new (&arena_) ImpreciseConstHiType(value, entries_.size());
   }
   AddEntry(entry);
   return *entry;
@@ -610,6 +689,10 @@ void RegTypeCache::VisitStaticRoots(RootVisitor* visitor) {
     for (int32_t value = kMinSmallConstant; value <= kMaxSmallConstant; ++value) {
       small_precise_constants_[value - kMinSmallConstant]->VisitRoots(visitor, ri);
     }
+    java_lang_object_->VisitRoots(visitor, ri);
+    java_lang_class_->VisitRoots(visitor, ri);
+    java_lang_string_->VisitRoots(visitor, ri);
+    java_lang_throwable_->VisitRoots(visitor, ri);
   }
 }
 
@@ -621,6 +704,11 @@ void RegTypeCache::VisitRoots(RootVisitor* visitor, const RootInfo& root_info) {
 }
 
 void RegTypeCache::AddEntry(RegType* new_entry) {
+  DCHECK_EQ(new_entry->GetId(), entries_.size());
+  if (!new_entry->descriptor_.empty()) {
+    descriptor_index_.emplace(ComputeModifiedUtf8Hash(new_entry->descriptor_.c_str()),
+                              new_entry->GetId());
+  }
   entries_.push_back(new_entry);
 }
 
@@ -19,12 +19,12 @@
 
 #include "base/casts.h"
 #include "base/macros.h"
+#include "base/scoped_arena_containers.h"
 #include "object_callbacks.h"
 #include "reg_type.h"
 #include "runtime.h"
 
 #include <stdint.h>
-#include <vector>
 
 namespace art {
 namespace mirror {
@@ -39,13 +39,13 @@ class RegType;
 
 class RegTypeCache {
  public:
-  explicit RegTypeCache(bool can_load_classes);
+  RegTypeCache(bool can_load_classes, ScopedArenaAllocator& arena);
   ~RegTypeCache();
   static void Init() SHARED_REQUIRES(Locks::mutator_lock_) {
     if (!RegTypeCache::primitive_initialized_) {
       CHECK_EQ(RegTypeCache::primitive_count_, 0);
       CreatePrimitiveAndSmallConstantTypes();
-      CHECK_EQ(RegTypeCache::primitive_count_, kNumPrimitivesAndSmallConstants);
+      CHECK_EQ(RegTypeCache::primitive_count_, kNumSharedTypes);
       RegTypeCache::primitive_initialized_ = true;
     }
   }
@@ -145,13 +145,20 @@ class RegTypeCache {
   void FillPrimitiveAndSmallConstantTypes() SHARED_REQUIRES(Locks::mutator_lock_);
   mirror::Class* ResolveClass(const char* descriptor, mirror::ClassLoader* loader)
       SHARED_REQUIRES(Locks::mutator_lock_);
-  bool MatchDescriptor(size_t idx, const StringPiece& descriptor, bool precise)
+  bool MatchDescriptor(const RegType* entry, const StringPiece& descriptor, bool precise)
+      SHARED_REQUIRES(Locks::mutator_lock_);
+  const RegType* FindSharedReferenceType(const StringPiece& descriptor, bool precise)
+      SHARED_REQUIRES(Locks::mutator_lock_);
+  const RegType* FindSharedReferenceType(mirror::Class* klass, bool precise)
       SHARED_REQUIRES(Locks::mutator_lock_);
   const ConstantType& FromCat1NonSmallConstant(int32_t value, bool precise)
       SHARED_REQUIRES(Locks::mutator_lock_);
 
   void AddEntry(RegType* new_entry);
 
+  template <class Type>
+  static const Type* CreateSharedReferenceType(const char* descriptor)
+      SHARED_REQUIRES(Locks::mutator_lock_);
   template <class Type>
   static const Type* CreatePrimitiveTypeInstance(const std::string& descriptor)
       SHARED_REQUIRES(Locks::mutator_lock_);
@@ -165,14 +172,34 @@ class RegTypeCache {
   static constexpr size_t kNumPrimitivesAndSmallConstants =
       12 + (kMaxSmallConstant - kMinSmallConstant + 1);
 
+  // Well known reference types which are looked up by most methods. Like the primitives, they are
+  // created once and shared by all caches, with the same ids in every cache.
+  static const ReferenceType* java_lang_object_;
+  static const PreciseReferenceType* java_lang_class_;
+  static const PreciseReferenceType* java_lang_string_;
+  static const ReferenceType* java_lang_throwable_;
+
+  static constexpr size_t kNumSharedReferenceTypes = 4;
+
+  static constexpr size_t kNumSharedTypes =
+      kNumPrimitivesAndSmallConstants + kNumSharedReferenceTypes;
+
   // Have the well known global primitives been created?
   static bool primitive_initialized_;
 
-  // Number of well known primitives that will be copied into a RegTypeCache upon construction.
+  // Number of well known primitives, small constants and reference types that will be copied
+  // into a RegTypeCache upon construction.
   static uint16_t primitive_count_;
 
   // The actual storage for the RegTypes.
-  std::vector<const RegType*> entries_;
+  ScopedArenaVector<const RegType*> entries_;
+
+  // Ids of the entries with a descriptor, keyed by the hash of the descriptor. Entries with the
+  // same hash are kept in the order of their ids.
+  ScopedArenaMultimap<size_t, uint16_t> descriptor_index_;
+
+  // Arena for the entries that are not shared.
+  ScopedArenaAllocator& arena_;
 
   // Whether or not we're allowed to load classes.
   const bool can_load_classes_;
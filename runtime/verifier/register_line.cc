@@ -416,8 +416,8 @@ void RegisterLine::PopMonitor(MethodVerifier* verifier, uint32_t reg_idx) {
 // register in the src map. This establishes an alias.
 static bool FindLockAliasedRegister(
     uint32_t src,
-    const AllocationTrackingSafeMap<uint32_t, uint32_t, kAllocatorTagVerifier>& src_map,
-    const AllocationTrackingSafeMap<uint32_t, uint32_t, kAllocatorTagVerifier>& search_map) {
+    const ScopedArenaSafeMap<uint32_t, uint32_t>& src_map,
+    const ScopedArenaSafeMap<uint32_t, uint32_t>& search_map) {
   auto it = src_map.find(src);
   if (it == src_map.end()) {
     // "Not locked" is trivially aliased.
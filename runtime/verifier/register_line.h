@@ -20,7 +20,7 @@
 #include <memory>
 #include <vector>
 
-#include "safe_map.h"
+#include "base/scoped_arena_containers.h"
 
 namespace art {
 
@@ -58,11 +58,9 @@ enum class LockOp {
 // stack of entered monitors (identified by code unit offset).
 class RegisterLine {
  public:
-  static RegisterLine* Create(size_t num_regs, MethodVerifier* verifier) {
-    void* memory = operator new(sizeof(RegisterLine) + (num_regs * sizeof(uint16_t)));
-    RegisterLine* rl = new (memory) RegisterLine(num_regs, verifier);
-    return rl;
-  }
+  // Create a register line of num_regs registers. The line lives in the arena of the verifier,
+  // see RegisterLineArenaDelete.
+  static RegisterLine* Create(size_t num_regs, MethodVerifier* verifier);
 
   // Implement category-1 "move" instructions. Copy a 32-bit value from "vsrc" to "vdst".
   void CopyRegister1(MethodVerifier* verifier, uint32_t vdst, uint32_t vsrc, TypeCategory cat)
@@ -375,12 +373,12 @@ class RegisterLine {
     reg_to_lock_depths_.erase(reg);
   }
 
-  RegisterLine(size_t num_regs, MethodVerifier* verifier)
-      : num_regs_(num_regs), this_initialized_(false) {
-    memset(&line_, 0, num_regs_ * sizeof(uint16_t));
-    SetResultTypeToUnknown(verifier);
+  static size_t ComputeSize(size_t num_regs) {
+    return sizeof(RegisterLine) + num_regs * sizeof(uint16_t);
   }
 
+  RegisterLine(size_t num_regs, MethodVerifier* verifier);
+
   // Storage for the result register's type, valid after an invocation.
   uint16_t result_[2];
 
@@ -388,11 +386,11 @@ class RegisterLine {
   const uint32_t num_regs_;
 
   // A stack of monitor enter locations.
-  std::vector<uint32_t, TrackingAllocator<uint32_t, kAllocatorTagVerifier>> monitors_;
+  ScopedArenaVector<uint32_t> monitors_;
   // A map from register to a bit vector of indices into the monitors_ stack. As we pop the monitor
   // stack we verify that monitor-enter/exit are correctly nested. That is, if there was a
   // monitor-enter on v5 and then on v6, we expect the monitor-exit to be on v6 then on v5.
-  AllocationTrackingSafeMap<uint32_t, uint32_t, kAllocatorTagVerifier> reg_to_lock_depths_;
+  ScopedArenaSafeMap<uint32_t, uint32_t> reg_to_lock_depths_;
 
   // Whether "this" initialization (a constructor supercall) has happened.
   bool this_initialized_;
@@ -403,6 +401,19 @@ class RegisterLine {
   DISALLOW_COPY_AND_ASSIGN(RegisterLine);
 };
 
+// Deleter for register lines allocated by RegisterLine::Create(). The memory belongs to the arena
+// of the verifier and is released with it, so only the destructor is run.
+class RegisterLineArenaDelete {
+ public:
+  void operator()(RegisterLine* line) const {
+    if (line != nullptr) {
+      line->~RegisterLine();
+    }
+  }
+};
+
+using RegisterLineArenaUniquePtr = std::unique_ptr<RegisterLine, RegisterLineArenaDelete>;
+
 }  // namespace verifier
 }  // namespace art
 
@@ -0,0 +1,531 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "verifier_deps.h"
+
+#include <algorithm>
+
+#include "art_field-inl.h"
+#include "art_method-inl.h"
+#include "class_linker.h"
+#include "compiler_callbacks.h"
+#include "dex_file-inl.h"
+#include "leb128.h"
+#include "mirror/class-inl.h"
+#include "mirror/class_loader.h"
+#include "mirror/dex_cache.h"
+#include "runtime.h"
+#include "scoped_thread_state_change.h"
+#include "thread.h"
+#include "utils.h"
+
+namespace art {
+namespace verifier {
+
+constexpr uint32_t VerifierDeps::kUnresolvedMarker;
+
+VerifierDeps::VerifierDeps(const std::vector<const DexFile*>& dex_files)
+    : dex_files_(dex_files),
+      lock_("verifier deps lock"),
+      dex_deps_(dex_files.size()) {
+  for (size_t i = 0; i != dex_files_.size(); ++i) {
+    dex_deps_[i].verified_classes.resize(dex_files_[i]->NumClassDefs(), false);
+  }
+}
+
+VerifierDeps* VerifierDeps::GetVerifierDepsSingleton() {
+  CompilerCallbacks* callbacks = Runtime::Current()->GetCompilerCallbacks();
+  return (callbacks != nullptr) ? callbacks->GetVerifierDeps() : nullptr;
+}
+
+bool VerifierDeps::IsInCompiledDexFiles(mirror::Class* klass) const {
+  mirror::DexCache* dex_cache = klass->GetDexCache();
+  if (dex_cache == nullptr) {
+    return false;
+  }
+  const DexFile* dex_file = dex_cache->GetDexFile();
+  return std::find(dex_files_.begin(), dex_files_.end(), dex_file) != dex_files_.end();
+}
+
+const VerifierDeps::DexFileDeps* VerifierDeps::GetDexFileDeps(const DexFile& dex_file) const {
+  auto it = std::find(dex_files_.begin(), dex_files_.end(), &dex_file);
+  return (it != dex_files_.end()) ? &dex_deps_[it - dex_files_.begin()] : nullptr;
+}
+
+VerifierDeps::DexFileDeps* VerifierDeps::GetDexFileDeps(const DexFile& dex_file) {
+  auto it = std::find(dex_files_.begin(), dex_files_.end(), &dex_file);
+  return (it != dex_files_.end()) ? &dex_deps_[it - dex_files_.begin()] : nullptr;
+}
+
+VerifierDeps::MemberResolution VerifierDeps::GetMemberResolution(mirror::Class* declaring_class,
+                                                                 uint32_t access_flags) {
+  std::string temp;
+  return MemberResolution { access_flags & kAccJavaFlagsMask,
+                            declaring_class->GetDescriptor(&temp) };
+}
+
+void VerifierDeps::AddClassResolution(const char* descriptor, mirror::Class* klass) {
+  if (klass == nullptr) {
+    MutexLock mu(Thread::Current(), lock_);
+    classes_.emplace(descriptor, kUnresolvedMarker);
+    return;
+  }
+  // Array classes depend on their element class only.
+  while (klass->IsArrayClass()) {
+    klass = klass->GetComponentType();
+  }
+  if (klass->IsPrimitive() || IsInCompiledDexFiles(klass)) {
+    return;
+  }
+  std::string temp;
+  const char* element_descriptor = klass->GetDescriptor(&temp);
+  uint32_t access_flags = klass->GetAccessFlags() & kAccJavaFlagsMask;
+  MutexLock mu(Thread::Current(), lock_);
+  classes_.emplace(element_descriptor, access_flags);
+}
+
+void VerifierDeps::MaybeRecordClassResolution(const char* descriptor, mirror::Class* klass) {
+  VerifierDeps* deps = GetVerifierDepsSingleton();
+  if (deps != nullptr) {
+    deps->AddClassResolution(descriptor, klass);
+  }
+}
+
+void VerifierDeps::MaybeRecordAssignability(mirror::Class* destination,
+                                            mirror::Class* source,
+                                            bool is_assignable) {
+  VerifierDeps* deps = GetVerifierDepsSingleton();
+  if (deps == nullptr) {
+    return;
+  }
+  // Classpath classes cannot refer to the compiled dex files, so the relation between two classes
+  // defined there does not depend on the classpath.
+  if (deps->IsInCompiledDexFiles(destination) && deps->IsInCompiledDexFiles(source)) {
+    return;
+  }
+  std::string temp1;
+  std::string temp2;
+  auto types = std::make_pair(std::string(destination->GetDescriptor(&temp1)),
+                              std::string(source->GetDescriptor(&temp2)));
+  MutexLock mu(Thread::Current(), deps->lock_);
+  if (is_assignable) {
+    deps->assignable_types_.insert(std::move(types));
+  } else {
+    deps->unassignable_types_.insert(std::move(types));
+  }
+}
+
+void VerifierDeps::MaybeRecordFieldResolution(const DexFile& dex_file,
+                                              uint32_t field_idx,
+                                              ArtField* field) {
+  VerifierDeps* deps = GetVerifierDepsSingleton();
+  if (deps == nullptr) {
+    return;
+  }
+  MemberResolution resolution { kUnresolvedMarker, std::string() };
+  if (field != nullptr) {
+    if (deps->IsInCompiledDexFiles(field->GetDeclaringClass())) {
+      // Found in the compiled dex files before reaching any classpath class.
+      return;
+    }
+    resolution = GetMemberResolution(field->GetDeclaringClass(), field->GetAccessFlags());
+  }
+  MutexLock mu(Thread::Current(), deps->lock_);
+  DexFileDeps* dex_deps = deps->GetDexFileDeps(dex_file);
+  if (dex_deps != nullptr) {
+    dex_deps->fields.emplace(field_idx, std::move(resolution));
+  }
+}
+
+void VerifierDeps::MaybeRecordMethodResolution(const DexFile& dex_file,
+                                               uint32_t method_idx,
+                                               MethodResolutionKind kind,
+                                               ArtMethod* method) {
+  VerifierDeps* deps = GetVerifierDepsSingleton();
+  if (deps == nullptr) {
+    return;
+  }
+  MemberResolution resolution { kUnresolvedMarker, std::string() };
+  if (method != nullptr) {
+    if (deps->IsInCompiledDexFiles(method->GetDeclaringClass())) {
+      // Found in the compiled dex files before reaching any classpath class.
+      return;
+    }
+    resolution = GetMemberResolution(method->GetDeclaringClass(), method->GetAccessFlags());
+  }
+  MutexLock mu(Thread::Current(), deps->lock_);
+  DexFileDeps* dex_deps = deps->GetDexFileDeps(dex_file);
+  if (dex_deps != nullptr) {
+    dex_deps->methods.emplace(std::make_pair(method_idx, static_cast<uint8_t>(kind)),
+                              std::move(resolution));
+  }
+}
+
+void VerifierDeps::RecordClassVerified(const DexFile& dex_file,
+                                       uint16_t class_def_index,
+                                       bool verified) {
+  MutexLock mu(Thread::Current(), lock_);
+  DexFileDeps* dex_deps = GetDexFileDeps(dex_file);
+  DCHECK(dex_deps != nullptr) << dex_file.GetLocation();
+  dex_deps->verified_classes[class_def_index] = verified;
+}
+
+bool VerifierDeps::IsClassVerified(const DexFile& dex_file, uint16_t class_def_index) const {
+  MutexLock mu(Thread::Current(), lock_);
+  const DexFileDeps* dex_deps = GetDexFileDeps(dex_file);
+  return dex_deps != nullptr && dex_deps->verified_classes[class_def_index];
+}
+
+static void EncodeString(const std::string& str, std::vector<uint8_t>* buffer) {
+  EncodeUnsignedLeb128(buffer, str.size());
+  buffer->insert(buffer->end(), str.begin(), str.end());
+}
+
+static void EncodeMemberResolution(uint32_t access_flags,
+                                   const std::string& declaring_class,
+                                   std::vector<uint8_t>* buffer) {
+  EncodeUnsignedLeb128(buffer, access_flags);
+  if (access_flags != static_cast<uint32_t>(-1)) {
+    EncodeString(declaring_class, buffer);
+  }
+}
+
+void VerifierDeps::Encode(std::vector<uint8_t>* buffer) const {
+  MutexLock mu(Thread::Current(), lock_);
+  EncodeUnsignedLeb128(buffer, classes_.size());
+  for (const auto& entry : classes_) {
+    EncodeString(entry.first, buffer);
+    EncodeUnsignedLeb128(buffer, entry.second);
+  }
+  for (const auto* types : { &assignable_types_, &unassignable_types_ }) {
+    EncodeUnsignedLeb128(buffer, types->size());
+    for (const auto& entry : *types) {
+      EncodeString(entry.first, buffer);
+      EncodeString(entry.second, buffer);
+    }
+  }
+  for (size_t i = 0; i != dex_files_.size(); ++i) {
+    const DexFileDeps& dex_deps = dex_deps_[i];
+    EncodeUnsignedLeb128(buffer, dex_files_[i]->GetLocationChecksum());
+    EncodeUnsignedLeb128(buffer, dex_deps.fields.size());
+    for (const auto& entry : dex_deps.fields) {
+      EncodeUnsignedLeb128(buffer, entry.first);
+      EncodeMemberResolution(entry.second.access_flags, entry.second.declaring_class, buffer);
+    }
+    EncodeUnsignedLeb128(buffer, dex_deps.methods.size());
+    for (const auto& entry : dex_deps.methods) {
+      EncodeUnsignedLeb128(buffer, entry.first.first);
+      buffer->push_back(entry.first.second);
+      EncodeMemberResolution(entry.second.access_flags, entry.second.declaring_class, buffer);
+    }
+    // The verified classes as a bit vector.
+    const std::vector<bool>& verified_classes = dex_deps.verified_classes;
+    for (size_t j = 0; j < verified_classes.size(); j += kBitsPerByte) {
+      uint8_t bits = 0u;
+      for (size_t k = j; k != std::min(j + kBitsPerByte, verified_classes.size()); ++k) {
+        bits |= (verified_classes[k] ? 1u : 0u) << (k - j);
+      }
+      buffer->push_back(bits);
+    }
+  }
+}
+
+// Bounds checked decoding of the data written by Encode().
+class VerifierDepsDecoder {
+ public:
+  VerifierDepsDecoder(const uint8_t* data, size_t size) : pos_(data), end_(data + size) {}
+
+  bool ReadUint32(uint32_t* value) {
+    uint32_t result = 0u;
+    for (size_t shift = 0u; shift < 32u; shift += 7u) {
+      if (pos_ == end_) {
+        return false;
+      }
+      uint8_t byte = *pos_++;
+      result |= static_cast<uint32_t>(byte & 0x7fu) << shift;
+      if ((byte & 0x80u) == 0u) {
+        *value = result;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadByte(uint8_t* value) {
+    if (pos_ == end_) {
+      return false;
+    }
+    *value = *pos_++;
+    return true;
+  }
+
+  bool ReadString(std::string* str) {
+    uint32_t length;
+    if (!ReadUint32(&length) || length > static_cast<size_t>(end_ - pos_)) {
+      return false;
+    }
+    str->assign(reinterpret_cast<const char*>(pos_), length);
+    pos_ += length;
+    return true;
+  }
+
+  bool ReadMemberResolution(uint32_t* access_flags, std::string* declaring_class) {
+    if (!ReadUint32(access_flags)) {
+      return false;
+    }
+    declaring_class->clear();
+    return *access_flags == static_cast<uint32_t>(-1) || ReadString(declaring_class);
+  }
+
+  bool AtEnd() const {
+    return pos_ == end_;
+  }
+
+ private:
+  const uint8_t* pos_;
+  const uint8_t* const end_;
+};
+
+bool VerifierDeps::Decode(const uint8_t* data, size_t size) {
+  VerifierDepsDecoder decoder(data, size);
+  std::map<std::string, uint32_t> classes;
+  std::set<std::pair<std::string, std::string>> assignable_types;
+  std::set<std::pair<std::string, std::string>> unassignable_types;
+  std::vector<DexFileDeps> dex_deps(dex_files_.size());
+
+  uint32_t count;
+  if (!decoder.ReadUint32(&count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i != count; ++i) {
+    std::string descriptor;
+    uint32_t access_flags;
+    if (!decoder.ReadString(&descriptor) || !decoder.ReadUint32(&access_flags)) {
+      return false;
+    }
+    classes.emplace(std::move(descriptor), access_flags);
+  }
+  for (auto* types : { &assignable_types, &unassignable_types }) {
+    if (!decoder.ReadUint32(&count)) {
+      return false;
+    }
+    for (uint32_t i = 0; i != count; ++i) {
+      std::pair<std::string, std::string> entry;
+      if (!decoder.ReadString(&entry.first) || !decoder.ReadString(&entry.second)) {
+        return false;
+      }
+      types->insert(std::move(entry));
+    }
+  }
+  for (size_t i = 0; i != dex_files_.size(); ++i) {
+    uint32_t location_checksum;
+    if (!decoder.ReadUint32(&location_checksum) ||
+        location_checksum != dex_files_[i]->GetLocationChecksum()) {
+      return false;
+    }
+    if (!decoder.ReadUint32(&count)) {
+      return false;
+    }
+    for (uint32_t j = 0; j != count; ++j) {
+      uint32_t field_idx;
+      MemberResolution resolution;
+      if (!decoder.ReadUint32(&field_idx) ||
+          field_idx >= dex_files_[i]->NumFieldIds() ||
+          !decoder.ReadMemberResolution(&resolution.access_flags, &resolution.declaring_class)) {
+        return false;
+      }
+      dex_deps[i].fields.emplace(field_idx, std::move(resolution));
+    }
+    if (!decoder.ReadUint32(&count)) {
+      return false;
+    }
+    for (uint32_t j = 0; j != count; ++j) {
+      uint32_t method_idx;
+      uint8_t kind;
+      MemberResolution resolution;
+      if (!decoder.ReadUint32(&method_idx) ||
+          method_idx >= dex_files_[i]->NumMethodIds() ||
+          !decoder.ReadByte(&kind) ||
+          kind > kInterfaceMethodResolution ||
+          !decoder.ReadMemberResolution(&resolution.access_flags, &resolution.declaring_class)) {
+        return false;
+      }
+      dex_deps[i].methods.emplace(std::make_pair(method_idx, kind), std::move(resolution));
+    }
+    const size_t num_class_defs = dex_files_[i]->NumClassDefs();
+    dex_deps[i].verified_classes.resize(num_class_defs, false);
+    for (size_t j = 0; j < num_class_defs; j += kBitsPerByte) {
+      uint8_t bits;
+      if (!decoder.ReadByte(&bits)) {
+        return false;
+      }
+      for (size_t k = j; k != std::min(j + kBitsPerByte, num_class_defs); ++k) {
+        dex_deps[i].verified_classes[k] = ((bits >> (k - j)) & 1u) != 0u;
+      }
+    }
+  }
+  if (!decoder.AtEnd()) {
+    return false;
+  }
+
+  MutexLock mu(Thread::Current(), lock_);
+  classes_.swap(classes);
+  assignable_types_.swap(assignable_types);
+  unassignable_types_.swap(unassignable_types);
+  dex_deps_.swap(dex_deps);
+  return true;
+}
+
+VerifierDeps::MemberResolution VerifierDeps::ResolveField(const DexFile& dex_file,
+                                                          uint32_t field_idx,
+                                                          Handle<mirror::ClassLoader> class_loader,
+                                                          Thread* self) {
+  const DexFile::FieldId& field_id = dex_file.GetFieldId(field_idx);
+  StackHandleScope<1> hs(self);
+  Handle<mirror::Class> klass(hs.NewHandle(Runtime::Current()->GetClassLinker()->FindClass(
+      self, dex_file.GetFieldDeclaringClassDescriptor(field_id), class_loader)));
+  ArtField* field = nullptr;
+  if (klass.Get() != nullptr) {
+    field = mirror::Class::FindField(self,
+                                     klass,
+                                     dex_file.GetFieldName(field_id),
+                                     dex_file.GetFieldTypeDescriptor(field_id));
+  }
+  self->ClearException();
+  return (field != nullptr)
+      ? GetMemberResolution(field->GetDeclaringClass(), field->GetAccessFlags())
+      : MemberResolution { kUnresolvedMarker, std::string() };
+}
+
+VerifierDeps::MemberResolution VerifierDeps::ResolveMethod(const DexFile& dex_file,
+                                                           uint32_t method_idx,
+                                                           MethodResolutionKind kind,
+                                                           Handle<mirror::ClassLoader> class_loader,
+                                                           Thread* self) {
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  const DexFile::MethodId& method_id = dex_file.GetMethodId(method_idx);
+  mirror::Class* klass = class_linker->FindClass(
+      self, dex_file.GetMethodDeclaringClassDescriptor(method_id), class_loader);
+  ArtMethod* method = nullptr;
+  if (klass != nullptr) {
+    const char* name = dex_file.GetMethodName(method_id);
+    const Signature signature = dex_file.GetMethodSignature(method_id);
+    const size_t pointer_size = class_linker->GetImagePointerSize();
+    if (kind == kDirectMethodResolution) {
+      method = klass->FindDirectMethod(name, signature, pointer_size);
+    } else if (kind == kInterfaceMethodResolution) {
+      method = klass->FindInterfaceMethod(name, signature, pointer_size);
+    } else {
+      method = klass->FindVirtualMethod(name, signature, pointer_size);
+    }
+    if (method == nullptr && kind != kDirectMethodResolution) {
+      method = klass->FindDirectMethod(name, signature, pointer_size);
+    }
+  }
+  self->ClearException();
+  return (method != nullptr)
+      ? GetMemberResolution(method->GetDeclaringClass(), method->GetAccessFlags())
+      : MemberResolution { kUnresolvedMarker, std::string() };
+}
+
+bool VerifierDeps::ValidateDependencies(Handle<mirror::ClassLoader> class_loader,
+                                        Thread* self) const {
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  // Take a snapshot, lock_ cannot be held while looking up classes.
+  std::map<std::string, uint32_t> classes;
+  std::set<std::pair<std::string, std::string>> assignable_types;
+  std::set<std::pair<std::string, std::string>> unassignable_types;
+  std::vector<DexFileDeps> dex_deps;
+  {
+    MutexLock mu(self, lock_);
+    classes = classes_;
+    assignable_types = assignable_types_;
+    unassignable_types = unassignable_types_;
+    dex_deps = dex_deps_;
+  }
+  for (const auto& entry : classes) {
+    mirror::Class* klass = class_linker->FindClass(self, entry.first.c_str(), class_loader);
+    if (klass == nullptr) {
+      self->ClearException();
+      if (entry.second != kUnresolvedMarker) {
+        VLOG(verifier) << "Verifier dependency broken, class " << entry.first << " not found";
+        return false;
+      }
+    } else if (entry.second == kUnresolvedMarker ||
+               IsInCompiledDexFiles(klass) ||
+               (klass->GetAccessFlags() & kAccJavaFlagsMask) != entry.second) {
+      VLOG(verifier) << "Verifier dependency broken, class " << entry.first << " changed";
+      return false;
+    }
+  }
+  for (const auto* types : { &assignable_types, &unassignable_types }) {
+    const bool expected = (types == &assignable_types);
+    for (const auto& entry : *types) {
+      StackHandleScope<2> hs(self);
+      Handle<mirror::Class> destination(
+          hs.NewHandle(class_linker->FindClass(self, entry.first.c_str(), class_loader)));
+      Handle<mirror::Class> source(
+          hs.NewHandle(class_linker->FindClass(self, entry.second.c_str(), class_loader)));
+      if (destination.Get() == nullptr ||
+          source.Get() == nullptr ||
+          destination->IsAssignableFrom(source.Get()) != expected) {
+        self->ClearException();
+        VLOG(verifier) << "Verifier dependency broken, assignability of " << entry.first
+                       << " from " << entry.second << " changed";
+        return false;
+      }
+    }
+  }
+  for (size_t i = 0; i != dex_files_.size(); ++i) {
+    const DexFile& dex_file = *dex_files_[i];
+    // The verifier did not record dependencies on the classes of the compiled dex files, so a
+    // verified class must still be defined by them, and not be shadowed by a class of the boot
+    // class path or of the new classpath.
+    for (size_t j = 0; j != dex_file.NumClassDefs(); ++j) {
+      if (!dex_deps[i].verified_classes[j]) {
+        continue;
+      }
+      const char* descriptor = dex_file.GetClassDescriptor(dex_file.GetClassDef(j));
+      mirror::Class* klass = class_linker->FindClass(self, descriptor, class_loader);
+      if (klass == nullptr || !IsInCompiledDexFiles(klass)) {
+        self->ClearException();
+        VLOG(verifier) << "Verifier dependency broken, class " << descriptor
+                       << " is not defined by " << dex_file.GetLocation();
+        return false;
+      }
+    }
+    for (const auto& entry : dex_deps[i].fields) {
+      if (!(ResolveField(dex_file, entry.first, class_loader, self) == entry.second)) {
+        VLOG(verifier) << "Verifier dependency broken, resolution of "
+                       << PrettyField(entry.first, dex_file) << " changed";
+        return false;
+      }
+    }
+    for (const auto& entry : dex_deps[i].methods) {
+      MethodResolutionKind kind = static_cast<MethodResolutionKind>(entry.first.second);
+      if (!(ResolveMethod(dex_file, entry.first.first, kind, class_loader, self) ==
+            entry.second)) {
+        VLOG(verifier) << "Verifier dependency broken, resolution of "
+                       << PrettyMethod(entry.first.first, dex_file) << " changed";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace verifier
+}  // namespace art
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_VERIFIER_VERIFIER_DEPS_H_
+#define ART_RUNTIME_VERIFIER_VERIFIER_DEPS_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/mutex.h"
+#include "handle.h"
+
+namespace art {
+
+class ArtField;
+class ArtMethod;
+class DexFile;
+class Thread;
+
+namespace mirror {
+  class Class;
+  class ClassLoader;
+}  // namespace mirror
+
+namespace verifier {
+
+// The assumptions about classes outside of the dex files being compiled, i.e. on the classpath,
+// which the verifier relied on while verifying the dex files. As long as they still hold for a
+// later compilation of the same dex files against a different classpath, the classes which were
+// verified do not need to be verified again.
+//
+// The dependencies are collected while the compiler verifies the dex files, see
+// CompilerCallbacks::GetVerifierDeps(), and stored in the oat file.
+class VerifierDeps {
+ public:
+  // How the verifier looked up a method, see MethodVerifier::ResolveMethodAndCheckAccess().
+  enum MethodResolutionKind : uint8_t {
+    kDirectMethodResolution,
+    kVirtualMethodResolution,
+    kInterfaceMethodResolution,
+  };
+
+  explicit VerifierDeps(const std::vector<const DexFile*>& dex_files);
+
+  // Encode the dependencies. The dex files are identified by their location checksums.
+  void Encode(std::vector<uint8_t>* buffer) const REQUIRES(!lock_);
+
+  // Replace the dependencies by the ones encoded by Encode() for the same dex files. Returns
+  // false if the data is malformed or was recorded for different dex files.
+  bool Decode(const uint8_t* data, size_t size) REQUIRES(!lock_);
+
+  // Check that the dependencies still hold when looking up classes from class_loader, and that
+  // the classes recorded as verified are still defined by the compiled dex files.
+  bool ValidateDependencies(Handle<mirror::ClassLoader> class_loader, Thread* self) const
+      SHARED_REQUIRES(Locks::mutator_lock_)
+      REQUIRES(!lock_);
+
+  // Record whether a class of the compiled dex files was verified without any failures that
+  // need to be checked again at runtime.
+  void RecordClassVerified(const DexFile& dex_file, uint16_t class_def_index, bool verified)
+      REQUIRES(!lock_);
+
+  // Whether a class was recorded as verified, e.g. by the compilation the dependencies were
+  // decoded from.
+  bool IsClassVerified(const DexFile& dex_file, uint16_t class_def_index) const
+      REQUIRES(!lock_);
+
+  // The Maybe* functions record a dependency with the VerifierDeps of the compiler, if any.
+  // Dependencies on the compiled dex files themselves are not recorded.
+
+  // Record the result of resolving the class `descriptor`, klass is null if it failed.
+  static void MaybeRecordClassResolution(const char* descriptor, mirror::Class* klass)
+      SHARED_REQUIRES(Locks::mutator_lock_);
+
+  // Record the result of a mirror::Class::IsAssignableFrom() check.
+  static void MaybeRecordAssignability(mirror::Class* destination,
+                                       mirror::Class* source,
+                                       bool is_assignable)
+      SHARED_REQUIRES(Locks::mutator_lock_);
+
+  // Record the result of resolving field_idx of dex_file, field is null if it failed.
+  static void MaybeRecordFieldResolution(const DexFile& dex_file,
+                                         uint32_t field_idx,
+                                         ArtField* field)
+      SHARED_REQUIRES(Locks::mutator_lock_);
+
+  // Record the result of resolving method_idx of dex_file, method is null if it failed.
+  static void MaybeRecordMethodResolution(const DexFile& dex_file,
+                                          uint32_t method_idx,
+                                          MethodResolutionKind kind,
+                                          ArtMethod* method)
+      SHARED_REQUIRES(Locks::mutator_lock_);
+
+ private:
+  ART_FRIEND_TEST(VerifierDepsTest, ChangedSuperclass);
+  ART_FRIEND_TEST(VerifierDepsTest, PreResolvedClass);
+  ART_FRIEND_TEST(VerifierDepsTest, RemovedMethod);
+
+  // Access flags recorded for classes or members which could not be resolved.
+  static constexpr uint32_t kUnresolvedMarker = static_cast<uint32_t>(-1);
+
+  // The access flags and the descriptor of the declaring class of a resolved member.
+  struct MemberResolution {
+    uint32_t access_flags;
+    std::string declaring_class;
+
+    bool operator==(const MemberResolution& other) const {
+      return access_flags == other.access_flags && declaring_class == other.declaring_class;
+    }
+  };
+
+  struct DexFileDeps {
+    std::map<uint32_t, MemberResolution> fields;
+    // Keyed by method index and MethodResolutionKind.
+    std::map<std::pair<uint32_t, uint8_t>, MemberResolution> methods;
+    std::vector<bool> verified_classes;
+  };
+
+  static VerifierDeps* GetVerifierDepsSingleton();
+
+  // Whether klass is defined in one of the compiled dex files.
+  bool IsInCompiledDexFiles(mirror::Class* klass) const SHARED_REQUIRES(Locks::mutator_lock_);
+
+  // Returns null if dex_file is not one of the compiled dex files.
+  const DexFileDeps* GetDexFileDeps(const DexFile& dex_file) const REQUIRES(lock_);
+  DexFileDeps* GetDexFileDeps(const DexFile& dex_file) REQUIRES(lock_);
+
+  void AddClassResolution(const char* descriptor, mirror::Class* klass)
+      SHARED_REQUIRES(Locks::mutator_lock_)
+      REQUIRES(!lock_);
+
+  // Look up a member the same way the verifier does, see ValidateDependencies().
+  static MemberResolution ResolveField(const DexFile& dex_file,
+                                       uint32_t field_idx,
+                                       Handle<mirror::ClassLoader> class_loader,
+                                       Thread* self)
+      SHARED_REQUIRES(Locks::mutator_lock_);
+  static MemberResolution ResolveMethod(const DexFile& dex_file,
+                                        uint32_t method_idx,
+                                        MethodResolutionKind kind,
+                                        Handle<mirror::ClassLoader> class_loader,
+                                        Thread* self)
+      SHARED_REQUIRES(Locks::mutator_lock_);
+  static MemberResolution GetMemberResolution(mirror::Class* declaring_class,
+                                              uint32_t access_flags)
+      SHARED_REQUIRES(Locks::mutator_lock_);
+
+  const std::vector<const DexFile*> dex_files_;
+
+  mutable Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+
+  // Access flags of the classpath classes the verifier resolved, by descriptor.
+  std::map<std::string, uint32_t> classes_ GUARDED_BY(lock_);
+
+  // Pairs of (destination, source) classes where the destination was found to be assignable,
+  // or not assignable, from the source.
+  std::set<std::pair<std::string, std::string>> assignable_types_ GUARDED_BY(lock_);
+  std::set<std::pair<std::string, std::string>> unassignable_types_ GUARDED_BY(lock_);
+
+  // Member resolutions and verified classes of each of dex_files_, in the same order.
+  std::vector<DexFileDeps> dex_deps_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(VerifierDeps);
+};
+
+}  // namespace verifier
+}  // namespace art
+
+#endif  // ART_RUNTIME_VERIFIER_VERIFIER_DEPS_H_
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "verifier_deps.h"
+
+#include <vector>
+
+#include "class_linker.h"
+#include "common_runtime_test.h"
+#include "compiler_callbacks.h"
+#include "dex_file.h"
+#include "handle_scope-inl.h"
+#include "method_verifier.h"
+#include "modifiers.h"
+#include "mirror/class-inl.h"
+#include "mirror/class_loader.h"
+#include "mirror/dex_cache-inl.h"
+#include "scoped_thread_state_change.h"
+
+namespace art {
+namespace verifier {
+
+// Compiler callbacks that hand the verifier the dependencies set by the test, if any.
+class VerifierDepsCompilerCallbacks FINAL : public CompilerCallbacks {
+ public:
+  VerifierDepsCompilerCallbacks()
+      : CompilerCallbacks(CompilerCallbacks::CallbackMode::kCompileApp), deps_(nullptr) {}
+
+  bool MethodVerified(MethodVerifier* verifier ATTRIBUTE_UNUSED) OVERRIDE {
+    return true;
+  }
+
+  void ClassRejected(ClassReference ref ATTRIBUTE_UNUSED) OVERRIDE {}
+
+  bool IsRelocationPossible() OVERRIDE { return false; }
+
+  VerifierDeps* GetVerifierDeps() const OVERRIDE { return deps_; }
+  void SetVerifierDeps(VerifierDeps* deps) OVERRIDE { deps_ = deps; }
+
+ private:
+  VerifierDeps* deps_;
+
+  DISALLOW_COPY_AND_ASSIGN(VerifierDepsCompilerCallbacks);
+};
+
+class VerifierDepsTest : public CommonRuntimeTest {
+ protected:
+  void SetUpRuntimeOptions(RuntimeOptions* options ATTRIBUTE_UNUSED) OVERRIDE {
+    callbacks_.reset(new VerifierDepsCompilerCallbacks());
+  }
+};
+
+TEST_F(VerifierDepsTest, EncodeDecode) {
+  ASSERT_TRUE(java_lang_dex_file_ != nullptr);
+  ASSERT_GT(java_lang_dex_file_->NumClassDefs(), 2u);
+  std::vector<const DexFile*> dex_files = { java_lang_dex_file_ };
+
+  VerifierDeps deps(dex_files);
+  deps.RecordClassVerified(*java_lang_dex_file_, 0u, true);
+  deps.RecordClassVerified(*java_lang_dex_file_, 2u, true);
+  std::vector<uint8_t> buffer;
+  deps.Encode(&buffer);
+  ASSERT_FALSE(buffer.empty());
+
+  VerifierDeps decoded_deps(dex_files);
+  ASSERT_TRUE(decoded_deps.Decode(buffer.data(), buffer.size()));
+  EXPECT_TRUE(decoded_deps.IsClassVerified(*java_lang_dex_file_, 0u));
+  EXPECT_FALSE(decoded_deps.IsClassVerified(*java_lang_dex_file_, 1u));
+  EXPECT_TRUE(decoded_deps.IsClassVerified(*java_lang_dex_file_, 2u));
+
+  std::vector<uint8_t> reencoded_buffer;
+  decoded_deps.Encode(&reencoded_buffer);
+  EXPECT_EQ(buffer, reencoded_buffer);
+
+  // Truncated data and data recorded for other dex files are rejected.
+  VerifierDeps other_deps(dex_files);
+  EXPECT_FALSE(other_deps.Decode(buffer.data(), buffer.size() - 1u));
+  std::vector<const DexFile*> no_dex_files;
+  VerifierDeps empty_deps(no_dex_files);
+  EXPECT_FALSE(empty_deps.Decode(buffer.data(), buffer.size()));
+}
+
+TEST_F(VerifierDepsTest, ValidateWithoutDependencies) {
+  ScopedObjectAccess soa(Thread::Current());
+  std::vector<const DexFile*> dex_files = { java_lang_dex_file_ };
+  VerifierDeps deps(dex_files);
+  StackHandleScope<1> hs(soa.Self());
+  Handle<mirror::ClassLoader> class_loader(hs.NewHandle<mirror::ClassLoader>(nullptr));
+  EXPECT_TRUE(deps.ValidateDependencies(class_loader, soa.Self()));
+}
+
+TEST_F(VerifierDepsTest, ChangedSuperclass) {
+  ScopedObjectAccess soa(Thread::Current());
+  jobject jclass_loader = LoadDex("Nested");
+  VerifierDeps deps(GetDexFiles(jclass_loader));
+  StackHandleScope<1> hs(soa.Self());
+  Handle<mirror::ClassLoader> class_loader(
+      hs.NewHandle(soa.Decode<mirror::ClassLoader*>(jclass_loader)));
+
+  {
+    MutexLock mu(soa.Self(), deps.lock_);
+    deps.assignable_types_.emplace("Ljava/lang/Number;", "Ljava/lang/Integer;");
+    deps.unassignable_types_.emplace("Ljava/lang/Number;", "Ljava/lang/String;");
+  }
+  EXPECT_TRUE(deps.ValidateDependencies(class_loader, soa.Self()));
+
+  // As if String extended Number in the classpath the dependencies were recorded with.
+  {
+    MutexLock mu(soa.Self(), deps.lock_);
+    deps.unassignable_types_.clear();
+    deps.assignable_types_.emplace("Ljava/lang/Number;", "Ljava/lang/String;");
+  }
+  EXPECT_FALSE(deps.ValidateDependencies(class_loader, soa.Self()));
+}
+
+TEST_F(VerifierDepsTest, RemovedMethod) {
+  ScopedObjectAccess soa(Thread::Current());
+  jobject jclass_loader = LoadDex("MultiDex");
+  std::vector<const DexFile*> dex_files = GetDexFiles(jclass_loader);
+  ASSERT_EQ(2u, dex_files.size());
+  // Main, in the first dex file, calls Second.getSecond(), whose class is in the second dex file,
+  // which stands for the classpath.
+  const DexFile& dex_file = *dex_files[0];
+  uint32_t method_idx = 0u;
+  while (method_idx != dex_file.NumMethodIds()) {
+    const DexFile::MethodId& method_id = dex_file.GetMethodId(method_idx);
+    if (strcmp(dex_file.GetMethodDeclaringClassDescriptor(method_id), "LSecond;") == 0 &&
+        strcmp(dex_file.GetMethodName(method_id), "getSecond") == 0) {
+      break;
+    }
+    ++method_idx;
+  }
+  ASSERT_LT(method_idx, dex_file.NumMethodIds());
+
+  VerifierDeps deps({ &dex_file });
+  {
+    MutexLock mu(soa.Self(), deps.lock_);
+    deps.dex_deps_[0].methods.emplace(
+        std::make_pair(method_idx, static_cast<uint8_t>(VerifierDeps::kVirtualMethodResolution)),
+        VerifierDeps::MemberResolution { kAccPublic, "LSecond;" });
+  }
+  StackHandleScope<2> hs(soa.Self());
+  Handle<mirror::ClassLoader> class_loader(
+      hs.NewHandle(soa.Decode<mirror::ClassLoader*>(jclass_loader)));
+  EXPECT_TRUE(deps.ValidateDependencies(class_loader, soa.Self()));
+
+  // The boot class path does not have the method.
+  Handle<mirror::ClassLoader> boot_class_loader(hs.NewHandle<mirror::ClassLoader>(nullptr));
+  EXPECT_FALSE(deps.ValidateDependencies(boot_class_loader, soa.Self()));
+}
+
+TEST_F(VerifierDepsTest, ShadowedBootClass) {
+  ScopedObjectAccess soa(Thread::Current());
+  // A second copy of the core dex file, whose classes are shadowed by the boot class path.
+  std::string error_msg;
+  std::vector<std::unique_ptr<const DexFile>> copies;
+  ASSERT_TRUE(DexFile::Open(GetLibCoreDexFileName().c_str(),
+                            GetLibCoreDexFileName().c_str(),
+                            &error_msg,
+                            &copies)) << error_msg;
+  ASSERT_FALSE(copies.empty());
+  StackHandleScope<1> hs(soa.Self());
+  Handle<mirror::ClassLoader> class_loader(hs.NewHandle<mirror::ClassLoader>(nullptr));
+
+  VerifierDeps deps({ java_lang_dex_file_ });
+  deps.RecordClassVerified(*java_lang_dex_file_, 0u, true);
+  EXPECT_TRUE(deps.ValidateDependencies(class_loader, soa.Self()));
+
+  VerifierDeps shadowed_deps({ copies[0].get() });
+  shadowed_deps.RecordClassVerified(*copies[0], 0u, true);
+  EXPECT_FALSE(shadowed_deps.ValidateDependencies(class_loader, soa.Self()));
+}
+
+TEST_F(VerifierDepsTest, PreResolvedClass) {
+  ScopedObjectAccess soa(Thread::Current());
+  jobject jclass_loader = LoadDex("MultiDex");
+  std::vector<const DexFile*> dex_files = GetDexFiles(jclass_loader);
+  ASSERT_EQ(2u, dex_files.size());
+  // Main, in the first dex file, instantiates Second, whose class is in the second dex file,
+  // which stands for the classpath.
+  const DexFile& dex_file = *dex_files[0];
+  StackHandleScope<3> hs(soa.Self());
+  Handle<mirror::ClassLoader> class_loader(
+      hs.NewHandle(soa.Decode<mirror::ClassLoader*>(jclass_loader)));
+  Handle<mirror::Class> main_class(
+      hs.NewHandle(class_linker_->FindClass(soa.Self(), "LMain;", class_loader)));
+  ASSERT_TRUE(main_class.Get() != nullptr);
+  Handle<mirror::Class> second_class(
+      hs.NewHandle(class_linker_->FindClass(soa.Self(), "LSecond;", class_loader)));
+  ASSERT_TRUE(second_class.Get() != nullptr);
+
+  // As if code that ran earlier had resolved Second, the verifier finds it in the dex cache.
+  const DexFile::StringId* string_id = dex_file.FindStringId("LSecond;");
+  ASSERT_TRUE(string_id != nullptr);
+  const DexFile::TypeId* type_id = dex_file.FindTypeId(dex_file.GetIndexForStringId(*string_id));
+  ASSERT_TRUE(type_id != nullptr);
+  main_class->GetDexCache()->SetResolvedType(dex_file.GetIndexForTypeId(*type_id),
+                                             second_class.Get());
+
+  VerifierDeps deps({ &dex_file });
+  CompilerCallbacks* callbacks = Runtime::Current()->GetCompilerCallbacks();
+  callbacks->SetVerifierDeps(&deps);
+  std::string error_msg;
+  MethodVerifier::FailureKind failure =
+      MethodVerifier::VerifyClass(soa.Self(), main_class.Get(), true, &error_msg);
+  callbacks->SetVerifierDeps(nullptr);
+  ASSERT_EQ(MethodVerifier::kNoFailure, failure) << error_msg;
+
+  // The resolution of Second is a dependency even though the verifier did not resolve it.
+  MutexLock mu(soa.Self(), deps.lock_);
+  auto it = deps.classes_.find("LSecond;");
+  ASSERT_TRUE(it != deps.classes_.end());
+  EXPECT_EQ(second_class->GetAccessFlags() & kAccJavaFlagsMask, it->second);
+}
+
+}  // namespace verifier
+}  // namespace art
@@ -272,6 +272,54 @@ extern "C" JNIEXPORT void JNICALL Java_Main_removeLocalObject(JNIEnv* env, jclas
   env->DeleteLocalRef(o);
 }
 
+extern "C" JNIEXPORT jint JNICALL Java_Main_fastNativeAdd(JNIEnv*, jclass, jint a, jint b) {
+  return a + b;
+}
+
+extern "C" JNIEXPORT jclass JNICALL Java_Main_fastNativeGetSuperclass(JNIEnv* env, jclass,
+                                                                     jclass c) {
+  return env->GetSuperclass(c);
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_RegisteredNatives_add(JNIEnv*, jclass, jint a, jint b) {
+  return a + b;
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_RegisteredNatives_annotatedAdd(JNIEnv*, jclass, jint a,
+                                                                      jint b) {
+  return a + b;
+}
+
+extern "C" JNIEXPORT void JNICALL Java_Main_registerNativeAdd(JNIEnv* env, jclass,
+                                                              jboolean fast) {
+  jclass registered_natives = env->FindClass("RegisteredNatives");
+  assert(registered_natives != nullptr);
+  JNINativeMethod method = {
+      "add",
+      fast ? "!(II)I" : "(II)I",
+      reinterpret_cast<void*>(&Java_RegisteredNatives_add)
+  };
+  jint result = env->RegisterNatives(registered_natives, &method, 1);
+  assert(result == JNI_OK);
+}
+
+// Registers itself again while it runs, with a '!' signature prefix if fast is true.
+extern "C" JNIEXPORT void JNICALL Java_RegisteredNatives_reregister(JNIEnv* env, jclass c,
+                                                                    jboolean fast) {
+  JNINativeMethod method = {
+      "reregister",
+      fast ? "!(Z)V" : "(Z)V",
+      reinterpret_cast<void*>(&Java_RegisteredNatives_reregister)
+  };
+  jint result = env->RegisterNatives(c, &method, 1);
+  assert(result == JNI_OK);
+}
+
+extern "C" JNIEXPORT void JNICALL Java_Main_unregisterNatives(JNIEnv* env, jclass, jclass c) {
+  jint result = env->UnregisterNatives(c);
+  assert(result == JNI_OK);
+}
+
 extern "C" JNIEXPORT jboolean JNICALL Java_Main_nativeIsAssignableFrom(JNIEnv* env, jclass,
                                                                        jclass from, jclass to) {
   return env->IsAssignableFrom(from, to);
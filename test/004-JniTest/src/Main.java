@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+import dalvik.annotation.optimization.FastNative;
 import java.lang.reflect.InvocationHandler;
 import java.lang.reflect.Method;
 import java.lang.reflect.Proxy;
@@ -38,6 +39,8 @@ public class Main {
         testNewStringObject();
         testRemoveLocalObject();
         testProxyGetMethodID();
+        testFastNativeMethods();
+        testFastNativeRegistration();
     }
 
     private static native void testFindClassOnAttachedNativeThread();
@@ -222,6 +225,97 @@ public class Main {
     }
 
     private static native long testGetMethodID(Class<?> c);
+
+    // Looked up through dlsym on the first call, which must work while Runnable.
+    @FastNative
+    private static native int fastNativeAdd(int a, int b);
+
+    @FastNative
+    private static native Class<?> fastNativeGetSuperclass(Class<?> c);
+
+    private static void testFastNativeMethods() {
+        for (int i = 0; i < 3; i++) {
+            if (fastNativeAdd(i, 40) != i + 40) {
+                throw new AssertionError();
+            }
+        }
+        if (fastNativeGetSuperclass(Main.class) != Object.class) {
+            throw new AssertionError();
+        }
+    }
+
+    // Registers RegisteredNatives.add, with a '!' signature prefix if fast is true.
+    private static native void registerNativeAdd(boolean fast);
+
+    private static native void unregisterNatives(Class<?> c);
+
+    private static native boolean isFastNative(Method m);
+
+    private static void expectFastNative(Method m, boolean expected) {
+        if (isFastNative(m) != expected) {
+            throw new AssertionError(m + " expected fast native " + expected);
+        }
+    }
+
+    private static void testFastNativeRegistration() {
+        Method add;
+        Method annotatedAdd;
+        try {
+            add = RegisteredNatives.class.getDeclaredMethod("add", int.class, int.class);
+            annotatedAdd =
+                RegisteredNatives.class.getDeclaredMethod("annotatedAdd", int.class, int.class);
+        } catch (NoSuchMethodException e) {
+            throw new AssertionError(e);
+        }
+        expectFastNative(add, false);
+        expectFastNative(annotatedAdd, true);
+
+        registerNativeAdd(true);
+        expectFastNative(add, true);
+        if (RegisteredNatives.add(1, 2) != 3) {
+            throw new AssertionError();
+        }
+        // Registering again without the '!' prefix makes the method a regular native again.
+        registerNativeAdd(false);
+        expectFastNative(add, false);
+        if (RegisteredNatives.add(2, 3) != 5) {
+            throw new AssertionError();
+        }
+
+        // Unregistering goes back to the dlsym lookup, which must not keep the method fast unless
+        // it is annotated with @FastNative.
+        registerNativeAdd(true);
+        unregisterNatives(RegisteredNatives.class);
+        expectFastNative(add, false);
+        expectFastNative(annotatedAdd, true);
+        if (RegisteredNatives.add(3, 4) != 7 || RegisteredNatives.annotatedAdd(4, 5) != 9) {
+            throw new AssertionError();
+        }
+
+        // Changing the flag while the method runs must not change how the call returns from
+        // native code. The collection needs this thread to be runnable again after each call.
+        Method reregister;
+        try {
+            reregister = RegisteredNatives.class.getDeclaredMethod("reregister", boolean.class);
+        } catch (NoSuchMethodException e) {
+            throw new AssertionError(e);
+        }
+        RegisteredNatives.reregister(true);
+        expectFastNative(reregister, true);
+        Runtime.getRuntime().gc();
+        RegisteredNatives.reregister(false);
+        expectFastNative(reregister, false);
+        Runtime.getRuntime().gc();
+    }
+}
+
+class RegisteredNatives {
+    static native int add(int a, int b);
+
+    static native void reregister(boolean fast);
+
+    @FastNative
+    static native int annotatedAdd(int a, int b);
 }
 
 class JniCallNonvirtualTest {
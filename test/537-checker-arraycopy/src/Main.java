@@ -54,6 +54,12 @@ public class Main {
   /// CHECK-NOT:      test
   /// CHECK-NOT:      call
   /// CHECK:          ReturnVoid
+
+  /// CHECK-START-ARM64: void Main.arraycopy() disassembly (after)
+  /// CHECK:          InvokeStaticOrDirect
+  /// CHECK-NOT:      cbz
+  /// CHECK-NOT:      blr
+  /// CHECK:          ReturnVoid
   // Checks that the call is intrinsified and that there is no test instruction
   // when we know the source and destination are not null.
   public static void arraycopy() {
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  /// CHECK-START: int Main.bitCountInt(int) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:i\d+>>  InvokeStaticOrDirect intrinsic:IntegerBitCount
+  /// CHECK-DAG:                      Return [<<Result>>]
+
+  /// CHECK-START-ARM64: int Main.bitCountInt(int) disassembly (after)
+  /// CHECK:                          InvokeStaticOrDirect intrinsic:IntegerBitCount
+  /// CHECK:                          cnt
+  /// CHECK:                          addv
+  public static int bitCountInt(int x) {
+    return Integer.bitCount(x);
+  }
+
+  /// CHECK-START: int Main.bitCountLong(long) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:i\d+>>  InvokeStaticOrDirect intrinsic:LongBitCount
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static int bitCountLong(long x) {
+    return Long.bitCount(x);
+  }
+
+  /// CHECK-START: int Main.highestOneBitInt(int) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:i\d+>>  InvokeStaticOrDirect intrinsic:IntegerHighestOneBit
+  /// CHECK-DAG:                      Return [<<Result>>]
+
+  /// CHECK-START-ARM64: int Main.highestOneBitInt(int) disassembly (after)
+  /// CHECK:                          InvokeStaticOrDirect intrinsic:IntegerHighestOneBit
+  /// CHECK:                          clz
+  public static int highestOneBitInt(int x) {
+    return Integer.highestOneBit(x);
+  }
+
+  /// CHECK-START: long Main.highestOneBitLong(long) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:j\d+>>  InvokeStaticOrDirect intrinsic:LongHighestOneBit
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static long highestOneBitLong(long x) {
+    return Long.highestOneBit(x);
+  }
+
+  /// CHECK-START: int Main.lowestOneBitInt(int) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:i\d+>>  InvokeStaticOrDirect intrinsic:IntegerLowestOneBit
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static int lowestOneBitInt(int x) {
+    return Integer.lowestOneBit(x);
+  }
+
+  /// CHECK-START: long Main.lowestOneBitLong(long) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:j\d+>>  InvokeStaticOrDirect intrinsic:LongLowestOneBit
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static long lowestOneBitLong(long x) {
+    return Long.lowestOneBit(x);
+  }
+
+  /// CHECK-START: int Main.signumInt(int) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:i\d+>>  InvokeStaticOrDirect intrinsic:IntegerSignum
+  /// CHECK-DAG:                      Return [<<Result>>]
+
+  /// CHECK-START-ARM64: int Main.signumInt(int) disassembly (after)
+  /// CHECK:                          InvokeStaticOrDirect intrinsic:IntegerSignum
+  /// CHECK:                          cset
+  /// CHECK:                          cneg
+  public static int signumInt(int x) {
+    return Integer.signum(x);
+  }
+
+  /// CHECK-START: int Main.signumLong(long) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:i\d+>>  InvokeStaticOrDirect intrinsic:LongSignum
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static int signumLong(long x) {
+    return Long.signum(x);
+  }
+
+  /// CHECK-START: int Main.compareInt(int, int) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:i\d+>>  InvokeStaticOrDirect intrinsic:IntegerCompare
+  /// CHECK-DAG:                      Return [<<Result>>]
+
+  /// CHECK-START-X86_64: int Main.compareInt(int, int) disassembly (after)
+  /// CHECK:                          InvokeStaticOrDirect intrinsic:IntegerCompare
+  /// CHECK-NOT:                      call
+  /// CHECK:                          Return
+  public static int compareInt(int x, int y) {
+    return Integer.compare(x, y);
+  }
+
+  /// CHECK-START: int Main.compareLong(long, long) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:i\d+>>  InvokeStaticOrDirect intrinsic:LongCompare
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static int compareLong(long x, long y) {
+    return Long.compare(x, y);
+  }
+
+  public static void main(String[] args) {
+    int[] ints = { 0, 1, -1, 2, 3, 0x40, 0x7f, 0x80, 0x1234, 0x7fffffff, 0x80000000, 0x80000001,
+                   0x55555555, 0xaaaaaaaa, 0xf0f0f0f0, 0x00ff0000 };
+    for (int x : ints) {
+      expectEquals(referenceBitCount(x & 0xffffffffL), bitCountInt(x));
+      expectEquals(referenceHighestOneBit(x), highestOneBitInt(x));
+      expectEquals(x & -x, lowestOneBitInt(x));
+      expectEquals(x > 0 ? 1 : (x < 0 ? -1 : 0), signumInt(x));
+      for (int y : ints) {
+        expectEquals(x > y ? 1 : (x < y ? -1 : 0), compareInt(x, y));
+      }
+    }
+
+    long[] longs = { 0L, 1L, -1L, 2L, 3L, 0x80L, 0x7fffffffL, 0x80000000L, 0x100000000L,
+                     0x123456789abcdefL, 0x7fffffffffffffffL, 0x8000000000000000L,
+                     0x8000000000000001L, 0x5555555555555555L, 0xaaaaaaaaaaaaaaaaL,
+                     0xffffffff00000000L, 0x00000000ffffffffL };
+    for (long x : longs) {
+      expectEquals(referenceBitCount(x), bitCountLong(x));
+      expectEquals(referenceHighestOneBit(x), highestOneBitLong(x));
+      expectEquals(x & -x, lowestOneBitLong(x));
+      expectEquals(x > 0 ? 1 : (x < 0 ? -1 : 0), signumLong(x));
+      for (long y : longs) {
+        expectEquals(x > y ? 1 : (x < y ? -1 : 0), compareLong(x, y));
+      }
+    }
+
+    System.out.println("passed");
+  }
+
+  private static int referenceBitCount(long x) {
+    int count = 0;
+    for (int i = 0; i < 64; i++) {
+      count += (int) ((x >>> i) & 1);
+    }
+    return count;
+  }
+
+  private static int referenceHighestOneBit(int x) {
+    for (int i = 31; i >= 0; i--) {
+      if ((x & (1 << i)) != 0) {
+        return 1 << i;
+      }
+    }
+    return 0;
+  }
+
+  private static long referenceHighestOneBit(long x) {
+    for (int i = 63; i >= 0; i--) {
+      if ((x & (1L << i)) != 0) {
+        return 1L << i;
+      }
+    }
+    return 0;
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(long expected, long result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  /// CHECK-START: int Main.hashCode(java.lang.String) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:i\d+>>  {{Invoke\w+}} intrinsic:StringHashCode
+  /// CHECK-DAG:                      Return [<<Result>>]
+
+  /// CHECK-START-X86_64: int Main.hashCode(java.lang.String) disassembly (after)
+  /// CHECK:                          {{Invoke\w+}} intrinsic:StringHashCode
+  /// CHECK:                          imul
+
+  /// CHECK-START-ARM64: int Main.hashCode(java.lang.String) disassembly (after)
+  /// CHECK:                          {{Invoke\w+}} intrinsic:StringHashCode
+  /// CHECK:                          madd
+  public static int hashCode(String s) {
+    return s.hashCode();
+  }
+
+  public static void main(String[] args) {
+    StringBuilder sb = new StringBuilder();
+    for (int length = 0; length <= 40; length++) {
+      // Build a fresh string, whose hash code has not been cached yet.
+      String s = new String(sb.toString().toCharArray());
+      int expected = referenceHashCode(s);
+      expectEquals(expected, hashCode(s));
+      // The second call returns the cached hash code.
+      expectEquals(expected, hashCode(s));
+      sb.append((char) (0xfff0 + length * 7919));
+    }
+
+    expectEquals(0, hashCode(""));
+    expectEquals(-1880044555, hashCode("Hello, world!"));
+    expectEquals(referenceHashCode("\uffff\uffff\uffff\uffff\uffff"),
+                 hashCode("\uffff\uffff\uffff\uffff\uffff"));
+
+    System.out.println("passed");
+  }
+
+  private static int referenceHashCode(String s) {
+    int hash = 0;
+    for (int i = 0; i < s.length(); i++) {
+      hash = hash * 31 + s.charAt(i);
+    }
+    return hash;
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
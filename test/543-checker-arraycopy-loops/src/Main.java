@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  /// CHECK-START: void Main.copyChars(char[], int, char[], int, int) intrinsics_recognition (after)
+  /// CHECK:                          InvokeStaticOrDirect intrinsic:SystemArrayCopyChar
+
+  /// CHECK-START-ARM64: void Main.copyChars(char[], int, char[], int, int) disassembly (after)
+  /// CHECK:                          InvokeStaticOrDirect intrinsic:SystemArrayCopyChar
+  /// CHECK:                          ldrh
+  /// CHECK:                          strh
+  public static void copyChars(char[] src, int srcPos, char[] dest, int destPos, int length) {
+    System.arraycopy(src, srcPos, dest, destPos, length);
+  }
+
+  /// CHECK-START: void Main.copyStrings(java.lang.String[], int, java.lang.String[], int, int) intrinsics_recognition (after)
+  /// CHECK:                          InvokeStaticOrDirect intrinsic:SystemArrayCopy
+
+  /// CHECK-START-ARM64: void Main.copyStrings(java.lang.String[], int, java.lang.String[], int, int) disassembly (after)
+  /// CHECK:                          InvokeStaticOrDirect intrinsic:SystemArrayCopy
+  /// CHECK:                          ldp
+  /// CHECK:                          stp
+  public static void copyStrings(String[] src, int srcPos, String[] dest, int destPos,
+                                 int length) {
+    System.arraycopy(src, srcPos, dest, destPos, length);
+  }
+
+  public static void copyObjects(Object[] src, int srcPos, Object[] dest, int destPos,
+                                 int length) {
+    System.arraycopy(src, srcPos, dest, destPos, length);
+  }
+
+  // The constant positions copy forward, which is only correct when the arrays differ, so the
+  // intrinsic has to compare the arrays at runtime.
+  public static void $noinline$copyStringsForward(String[] src, String[] dest, int length) {
+    System.arraycopy(src, 1, dest, 2, length);
+  }
+
+  public static void main(String[] args) {
+    testChars();
+    testObjects();
+    testGetChars();
+    System.out.println("passed");
+  }
+
+  private static void testChars() {
+    for (int length = 0; length <= 20; length++) {
+      for (int srcPos = 0; srcPos <= 3; srcPos++) {
+        for (int destPos = 0; destPos <= 3; destPos++) {
+          char[] src = newChars(32);
+          char[] dest = new char[32];
+          copyChars(src, srcPos, dest, destPos, length);
+          for (int i = 0; i < dest.length; i++) {
+            boolean copied = i >= destPos && i < destPos + length;
+            expectEquals(copied ? src[srcPos + i - destPos] : 0, dest[i]);
+          }
+
+          // Copy within the same array, forward or backward depending on the positions.
+          char[] same = newChars(32);
+          char[] expected = newChars(32);
+          referenceCopy(expected, srcPos, destPos, length);
+          copyChars(same, srcPos, same, destPos, length);
+          for (int i = 0; i < same.length; i++) {
+            expectEquals(expected[i], same[i]);
+          }
+        }
+      }
+    }
+
+    char[] chars = newChars(4);
+    try {
+      copyChars(chars, 2, chars, 0, 3);
+      throw new Error("Should not be here");
+    } catch (ArrayIndexOutOfBoundsException e) {
+      // Ignore.
+    }
+  }
+
+  private static void testObjects() {
+    for (int length = 0; length <= 9; length++) {
+      String[] src = new String[12];
+      for (int i = 0; i < src.length; i++) {
+        src[i] = Integer.toString(i);
+      }
+      String[] dest = new String[12];
+      copyStrings(src, 1, dest, 2, length);
+      for (int i = 0; i < dest.length; i++) {
+        boolean copied = i >= 2 && i < 2 + length;
+        expectSame(copied ? src[i - 1] : null, dest[i]);
+      }
+
+      copyStrings(src, 3, src, 0, length);
+      for (int i = 0; i < length; i++) {
+        expectSame(Integer.toString(i + 3), src[i]);
+      }
+
+      String[] same = new String[12];
+      for (int i = 0; i < same.length; i++) {
+        same[i] = Integer.toString(i);
+      }
+      String[] original = same.clone();
+      $noinline$copyStringsForward(same, same, length);
+      for (int i = 0; i < same.length; i++) {
+        boolean copied = i >= 2 && i < 2 + length;
+        expectSame(copied ? original[i - 1] : original[i], same[i]);
+      }
+
+      Object[] objects = new Object[12];
+      copyObjects(src, 0, objects, 0, length);
+      for (int i = 0; i < length; i++) {
+        expectSame(src[i], objects[i]);
+      }
+    }
+
+    // Elements of an Object[] are checked against the component type of the destination.
+    Object[] mixed = { "a", Integer.valueOf(1) };
+    try {
+      copyObjects(mixed, 0, new String[2], 0, 2);
+      throw new Error("Should not be here");
+    } catch (ArrayStoreException e) {
+      // Ignore.
+    }
+  }
+
+  private static void testGetChars() {
+    String s = "0123456789abcdefghijklmnopqrstuvwxyz";
+    for (int begin = 0; begin <= 5; begin++) {
+      for (int end = begin; end <= s.length(); end++) {
+        char[] dest = new char[s.length() + 2];
+        s.getChars(begin, end, dest, 1);
+        for (int i = 0; i < dest.length; i++) {
+          boolean copied = i >= 1 && i < 1 + end - begin;
+          expectEquals(copied ? s.charAt(begin + i - 1) : 0, dest[i]);
+        }
+      }
+    }
+  }
+
+  private static char[] newChars(int length) {
+    char[] chars = new char[length];
+    for (int i = 0; i < length; i++) {
+      chars[i] = (char) ('A' + i);
+    }
+    return chars;
+  }
+
+  private static void referenceCopy(char[] array, int srcPos, int destPos, int length) {
+    char[] copy = new char[length];
+    for (int i = 0; i < length; i++) {
+      copy[i] = array[srcPos + i];
+    }
+    for (int i = 0; i < length; i++) {
+      array[destPos + i] = copy[i];
+    }
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectSame(Object expected, Object result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
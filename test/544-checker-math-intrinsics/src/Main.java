@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  /// CHECK-START: double Main.cos(double) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:d\d+>>  InvokeStaticOrDirect intrinsic:MathCos
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static double cos(double x) {
+    return Math.cos(x);
+  }
+
+  /// CHECK-START: double Main.sin(double) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:d\d+>>  InvokeStaticOrDirect intrinsic:MathSin
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static double sin(double x) {
+    return Math.sin(x);
+  }
+
+  /// CHECK-START: double Main.tan(double) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:d\d+>>  InvokeStaticOrDirect intrinsic:MathTan
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static double tan(double x) {
+    return Math.tan(x);
+  }
+
+  /// CHECK-START: double Main.atan2(double, double) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:d\d+>>  InvokeStaticOrDirect intrinsic:MathAtan2
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static double atan2(double x, double y) {
+    return Math.atan2(x, y);
+  }
+
+  /// CHECK-START: double Main.exp(double) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:d\d+>>  InvokeStaticOrDirect intrinsic:MathExp
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static double exp(double x) {
+    return Math.exp(x);
+  }
+
+  /// CHECK-START: double Main.log(double) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:d\d+>>  InvokeStaticOrDirect intrinsic:MathLog
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static double log(double x) {
+    return Math.log(x);
+  }
+
+  /// CHECK-START: double Main.pow(double, double) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:d\d+>>  InvokeStaticOrDirect intrinsic:MathPow
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static double pow(double x, double y) {
+    return Math.pow(x, y);
+  }
+
+  /// CHECK-START: double Main.hypot(double, double) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:d\d+>>  InvokeStaticOrDirect intrinsic:MathHypot
+  /// CHECK-DAG:                      Return [<<Result>>]
+  public static double hypot(double x, double y) {
+    return Math.hypot(x, y);
+  }
+
+  private static final double[] VALUES = {
+    0.0, -0.0, 1.0, -1.0, 0.5, 2.0, 3.0, Math.PI, -Math.PI / 3, 1e-300, 1e300, 123456.789,
+    Double.MIN_VALUE, Double.MAX_VALUE, Double.POSITIVE_INFINITY, Double.NEGATIVE_INFINITY,
+    Double.NaN
+  };
+
+  public static void main(String[] args) {
+    for (double x : VALUES) {
+      expectClose(StrictMath.cos(x), cos(x), 1);
+      expectClose(StrictMath.sin(x), sin(x), 1);
+      expectClose(StrictMath.tan(x), tan(x), 1);
+      expectClose(StrictMath.exp(x), exp(x), 1);
+      expectClose(StrictMath.log(x), log(x), 1);
+      for (double y : VALUES) {
+        expectClose(StrictMath.atan2(x, y), atan2(x, y), 2);
+        expectClose(StrictMath.pow(x, y), pow(x, y), 1);
+        expectClose(StrictMath.hypot(x, y), hypot(x, y), 1);
+      }
+    }
+
+    // Results that the specification requires to be exact.
+    expectEquals(1.0, cos(0.0));
+    expectEquals(-0.0, sin(-0.0));
+    expectEquals(1.0, exp(0.0));
+    expectEquals(0.0, log(1.0));
+    expectEquals(Double.NEGATIVE_INFINITY, log(0.0));
+    expectEquals(1024.0, pow(2.0, 10.0));
+    expectEquals(1.0, pow(Double.NaN, 0.0));
+    expectEquals(Double.NaN, pow(1.0, Double.NaN));
+    expectEquals(Double.NaN, pow(-1.0, Double.POSITIVE_INFINITY));
+    expectEquals(5.0, hypot(3.0, -4.0));
+    expectEquals(Double.POSITIVE_INFINITY, hypot(Double.NEGATIVE_INFINITY, Double.NaN));
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(double expected, double result) {
+    if (Double.compare(expected, result) != 0) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  // Checks that `result` is within `ulps` units in the last place of `expected`.
+  private static void expectClose(double expected, double result, int ulps) {
+    if (Double.isNaN(expected) || Double.isInfinite(expected)) {
+      expectEquals(expected, result);
+    } else if (Math.abs(expected - result) > ulps * Math.ulp(expected)) {
+      throw new Error("Expected: " + expected + " within " + ulps + " ulps, found: " + result);
+    }
+  }
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.lang.ref.WeakReference;
+import java.util.concurrent.atomic.AtomicInteger;
+
+public class Main {
+  static final int COUNT = 2000;
+  static final AtomicInteger finalized = new AtomicInteger();
+  static final boolean[] seen = new boolean[COUNT];
+  static volatile boolean usedFinalizerThreads = false;
+  static volatile boolean finalizedTwice = false;
+
+  static class Finalizable {
+    private final int id;
+
+    Finalizable(int id) {
+      this.id = id;
+    }
+
+    @Override
+    protected void finalize() throws Throwable {
+      synchronized (seen) {
+        if (seen[id]) {
+          finalizedTwice = true;
+        }
+        seen[id] = true;
+      }
+      if (Thread.currentThread().getName().startsWith("Finalizer thread pool")) {
+        usedFinalizerThreads = true;
+      }
+      finalized.incrementAndGet();
+      if (id % 10 == 0) {
+        throw new RuntimeException("Ignored");
+      }
+    }
+  }
+
+  // Allocate in a separate method so that no reference stays live in the caller's frame.
+  static WeakReference<Object> allocate() {
+    for (int i = 0; i < COUNT; ++i) {
+      new Finalizable(i);
+    }
+    return new WeakReference<Object>(new Object());
+  }
+
+  public static void main(String[] args) throws Exception {
+    WeakReference<Object> weak = allocate();
+    // The GC hands all the unreachable objects to the finalizer threads, and
+    // System.runFinalization() waits for their finalizers.
+    Runtime.getRuntime().gc();
+    System.runFinalization();
+    if (finalizedTwice) {
+      System.out.println("An object was finalized twice");
+    }
+    System.out.println("Finalized " + finalized.get() + " objects");
+    System.out.println("Finalizer threads used: " + usedFinalizerThreads);
+    System.out.println("Weak references cleared: " + (weak.get() == null));
+  }
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.lang.ref.SoftReference;
+import java.lang.ref.WeakReference;
+import java.util.ArrayList;
+import java.util.concurrent.atomic.AtomicInteger;
+
+public class Main {
+  static final int NUM_READERS = 4;
+  static final int NUM_GCS = 50;
+  static final AtomicInteger finalized = new AtomicInteger();
+  static volatile boolean done = false;
+  static volatile boolean lostLiveReferent = false;
+
+  static class Finalizable {
+    // Only reachable from this finalizable object, so its weak reference must be cleared.
+    Object payload = new Object();
+    WeakReference<Object> payloadRef = new WeakReference<Object>(payload);
+
+    @Override
+    protected void finalize() {
+      finalized.incrementAndGet();
+    }
+  }
+
+  public static void main(String[] args) throws Exception {
+    final Object[] live = new Object[64];
+    final ArrayList<WeakReference<Object>> weakRefs = new ArrayList<WeakReference<Object>>();
+    final ArrayList<SoftReference<Object>> softRefs = new ArrayList<SoftReference<Object>>();
+    for (int i = 0; i < live.length; i++) {
+      live[i] = new Object();
+      weakRefs.add(new WeakReference<Object>(live[i]));
+      softRefs.add(new SoftReference<Object>(live[i]));
+    }
+
+    Thread[] readers = new Thread[NUM_READERS];
+    for (int t = 0; t < NUM_READERS; t++) {
+      readers[t] = new Thread() {
+        public void run() {
+          while (!done) {
+            for (int i = 0; i < live.length; i++) {
+              if (weakRefs.get(i).get() != live[i] || softRefs.get(i).get() != live[i]) {
+                lostLiveReferent = true;
+              }
+              // References to new objects, and to objects which die, are processed concurrently
+              // with the GC as well.
+              Object fresh = new Object();
+              if (new WeakReference<Object>(fresh).get() != fresh) {
+                lostLiveReferent = true;
+              }
+            }
+          }
+        }
+      };
+      readers[t].start();
+    }
+
+    ArrayList<WeakReference<Object>> deadRefs = new ArrayList<WeakReference<Object>>();
+    for (int i = 0; i < NUM_GCS; i++) {
+      deadRefs.add(makeFinalizable());
+      Runtime.getRuntime().gc();
+    }
+    done = true;
+    for (Thread reader : readers) {
+      reader.join();
+    }
+
+    Runtime.getRuntime().gc();
+    System.runFinalization();
+    Runtime.getRuntime().gc();
+    boolean cleared = true;
+    for (WeakReference<Object> ref : deadRefs) {
+      if (ref.get() != null) {
+        cleared = false;
+      }
+    }
+    System.out.println("Live referents lost: " + lostLiveReferent);
+    System.out.println("Dead referents cleared: " + cleared);
+    System.out.println("Finalizers ran: " + (finalized.get() > 0));
+    // Keep the live objects reachable until the end.
+    if (live[0] == null) {
+      System.out.println("unreachable");
+    }
+  }
+
+  static WeakReference<Object> makeFinalizable() {
+    return new Finalizable().payloadRef;
+  }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Entry {
+  public static void run() {
+    int sum = 0;
+    for (int i = 0; i < 100; i++) {
+      sum += Counter.next();
+    }
+    System.out.println(sum);
+    Shape[] shapes = { new Rectangle(3, 4), new Square(2) };
+    for (Shape shape : shapes) {
+      System.out.println("Shape area: " + shape.area());
+    }
+  }
+}
+
+class Counter {
+  private static int value = -1;
+
+  static int next() {
+    return ++value;
+  }
+}
+
+interface Shape {
+  int area();
+}
+
+class Rectangle implements Shape {
+  final int width;
+  final int height;
+
+  Rectangle(int width, int height) {
+    this.width = width;
+    this.height = height;
+  }
+
+  public int area() {
+    return width * height;
+  }
+}
+
+class Square extends Rectangle {
+  Square(int side) {
+    super(side, side);
+  }
+}
+
+class Unused {
+  static int twice(int value) {
+    return value * 2;
+  }
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.io.File;
+import java.lang.reflect.Constructor;
+import java.lang.reflect.Method;
+
+public class Main {
+  static final String DEX_LOCATION = System.getenv("DEX_LOCATION");
+  static final String DEX_FILE = DEX_LOCATION + "/547-background-verify-ex.jar";
+  static final String ODEX_ALT = "/tmp";
+
+  public static void main(String[] args) throws Exception {
+    System.loadLibrary(args[0]);
+    // The runtime does not load the classes of a DexClassLoader itself, the workers go through
+    // its loadClass().
+    Class<?> dexClassLoader = Class.forName("dalvik.system.DexClassLoader");
+    Constructor<?> constructor = dexClassLoader.getDeclaredConstructor(
+        String.class, String.class, String.class, ClassLoader.class);
+    String odexDir = new File(DEX_LOCATION).isDirectory() ? DEX_LOCATION : ODEX_ALT;
+    ClassLoader loader = (ClassLoader) constructor.newInstance(
+        DEX_FILE, odexDir, null, ClassLoader.getSystemClassLoader());
+    // Loading the first class starts the background verification of the whole dex file, the
+    // classes are then used while the workers may still be verifying them.
+    Class<?> entry = loader.loadClass("Entry");
+    Method run = entry.getDeclaredMethod("run");
+    run.invoke(null);
+
+    // Nothing initializes this class, only the workers verify it.
+    Class<?> unused = Class.forName("Unused", false, loader);
+    for (int i = 0; i < 100 && !isClassVerified(unused); i++) {
+      Thread.sleep(100);
+    }
+    System.out.println("Unused class verified: " + isClassVerified(unused));
+    System.out.println("done");
+  }
+
+  private static native boolean isClassVerified(Class<?> klass);
+}
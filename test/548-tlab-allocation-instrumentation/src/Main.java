@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.lang.reflect.Method;
+
+public class Main {
+  // Enough allocations to refill the thread-local allocation buffer and collect many times.
+  static final int NUM_ITERATIONS = 20000;
+  static final int NUM_LIVE = 1024;
+  static final int NUM_COUNTED = 10000;
+  // From dalvik.system.VMDebug.
+  static final int KIND_THREAD_ALLOCATED_OBJECTS = 1 << 16;
+
+  static volatile boolean done = false;
+
+  static Method startAllocCounting;
+  static Method stopAllocCounting;
+  static Method resetAllocCount;
+  static Method getAllocCount;
+
+  static class SmallObject {
+    int i;
+    long l;
+    Object o;
+  }
+
+  static class LargerObject {
+    long l0, l1, l2, l3, l4, l5, l6, l7;
+    Object o0, o1, o2, o3;
+    byte b;
+  }
+
+  public static void main(String[] args) throws Exception {
+    Class<?> vmDebug = Class.forName("dalvik.system.VMDebug");
+    startAllocCounting = vmDebug.getDeclaredMethod("startAllocCounting");
+    stopAllocCounting = vmDebug.getDeclaredMethod("stopAllocCounting");
+    resetAllocCount = vmDebug.getDeclaredMethod("resetAllocCount", Integer.TYPE);
+    getAllocCount = vmDebug.getDeclaredMethod("getAllocCount", Integer.TYPE);
+
+    // Allocations done inline by compiled code bypass the instrumented entrypoints, so they must
+    // not happen while allocations are counted.
+    resetAllocCount.invoke(null, KIND_THREAD_ALLOCATED_OBJECTS);
+    startAllocCounting.invoke(null);
+    Object[] counted = allocateSmallObjects(NUM_COUNTED);
+    int count = (Integer) getAllocCount.invoke(null, KIND_THREAD_ALLOCATED_OBJECTS);
+    stopAllocCounting.invoke(null);
+    System.out.println("Allocations counted: " + (count >= counted.length + 1));
+
+    // Instrument and uninstrument the entrypoints while this thread allocates, each switch
+    // revokes the buffers and changes the allocation path of the next refill.
+    final int[] toggles = new int[1];
+    Thread toggler = new Thread() {
+      public void run() {
+        try {
+          while (!done) {
+            startAllocCounting.invoke(null);
+            Thread.sleep(1);
+            stopAllocCounting.invoke(null);
+            Thread.sleep(1);
+            toggles[0]++;
+          }
+        } catch (Exception e) {
+          throw new RuntimeException(e);
+        }
+      }
+    };
+    toggler.start();
+    allocateAndCheck();
+    done = true;
+    toggler.join();
+    System.out.println("Toggled instrumentation: " + (toggles[0] > 0));
+    System.out.println("Done");
+  }
+
+  static Object[] allocateSmallObjects(int n) {
+    Object[] objects = new Object[n];
+    for (int i = 0; i < n; i++) {
+      objects[i] = new SmallObject();
+    }
+    return objects;
+  }
+
+  static void allocateAndCheck() {
+    Object[] live = new Object[NUM_LIVE];
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+      SmallObject small = new SmallObject();
+      checkSmallObject(small);
+      small.i = i;
+      small.l = i;
+      small.o = small;
+
+      LargerObject larger = new LargerObject();
+      checkLargerObject(larger);
+      larger.l7 = i;
+      larger.o3 = larger;
+      larger.b = 1;
+
+      // Lengths around the largest arrays allocated inline, for each component size.
+      int length = i % 2200;
+      byte[] bytes = new byte[length];
+      checkBytes(bytes, length);
+      int[] ints = new int[length / 4];
+      checkInts(ints, length / 4);
+      long[] longs = new long[length / 8];
+      checkLongs(longs, length / 8);
+      Object[] objects = new Object[length / 4];
+      checkObjects(objects, length / 4);
+      int[] constant = new int[16];
+      checkInts(constant, 16);
+      fill(bytes, ints, longs, objects, constant, small);
+
+      live[i % NUM_LIVE] = small;
+      live[(i + 1) % NUM_LIVE] = larger;
+      live[(i + 2) % NUM_LIVE] = bytes;
+      live[(i + 3) % NUM_LIVE] = ints;
+      live[(i + 4) % NUM_LIVE] = longs;
+      live[(i + 5) % NUM_LIVE] = objects;
+      live[(i + 6) % NUM_LIVE] = constant;
+    }
+    for (Object o : live) {
+      if (o instanceof SmallObject && ((SmallObject) o).o != o) {
+        throw new Error("Lost the contents of a small object");
+      }
+      if (o instanceof LargerObject && ((LargerObject) o).o3 != o) {
+        throw new Error("Lost the contents of a larger object");
+      }
+    }
+  }
+
+  // Dirty the memory, so that an allocation reusing it without clearing it is caught.
+  static void fill(byte[] bytes, int[] ints, long[] longs, Object[] objects, int[] constant,
+                   Object value) {
+    for (int i = 0; i < bytes.length; i++) {
+      bytes[i] = (byte) -1;
+    }
+    for (int i = 0; i < ints.length; i++) {
+      ints[i] = -1;
+    }
+    for (int i = 0; i < longs.length; i++) {
+      longs[i] = -1;
+    }
+    for (int i = 0; i < objects.length; i++) {
+      objects[i] = value;
+    }
+    for (int i = 0; i < constant.length; i++) {
+      constant[i] = -1;
+    }
+  }
+
+  static void checkSmallObject(SmallObject small) {
+    if (small.getClass() != SmallObject.class || small.i != 0 || small.l != 0 ||
+        small.o != null) {
+      throw new Error("Bad small object");
+    }
+  }
+
+  static void checkLargerObject(LargerObject larger) {
+    if (larger.getClass() != LargerObject.class || larger.l0 != 0 || larger.l7 != 0 ||
+        larger.o0 != null || larger.o3 != null || larger.b != 0) {
+      throw new Error("Bad larger object");
+    }
+  }
+
+  static void checkBytes(byte[] array, int length) {
+    if (array.length != length) {
+      throw new Error("Bad byte array length " + array.length + ", expected " + length);
+    }
+    for (int i = 0; i < length; i++) {
+      if (array[i] != 0) {
+        throw new Error("Byte array not cleared at " + i);
+      }
+    }
+  }
+
+  static void checkInts(int[] array, int length) {
+    if (array.length != length) {
+      throw new Error("Bad int array length " + array.length + ", expected " + length);
+    }
+    for (int i = 0; i < length; i++) {
+      if (array[i] != 0) {
+        throw new Error("Int array not cleared at " + i);
+      }
+    }
+  }
+
+  static void checkLongs(long[] array, int length) {
+    if (array.length != length) {
+      throw new Error("Bad long array length " + array.length + ", expected " + length);
+    }
+    for (int i = 0; i < length; i++) {
+      if (array[i] != 0) {
+        throw new Error("Long array not cleared at " + i);
+      }
+    }
+  }
+
+  static void checkObjects(Object[] array, int length) {
+    if (array.length != length) {
+      throw new Error("Bad object array length " + array.length + ", expected " + length);
+    }
+    for (int i = 0; i < length; i++) {
+      if (array[i] != null) {
+        throw new Error("Object array not cleared at " + i);
+      }
+    }
+  }
+}
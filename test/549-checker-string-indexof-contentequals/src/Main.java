@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  /// CHECK-START: int Main.indexOf(java.lang.String, java.lang.String) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:i\d+>>  {{Invoke\w+}} intrinsic:StringIndexOfString
+  /// CHECK-DAG:                      Return [<<Result>>]
+
+  /// CHECK-START-X86_64: int Main.indexOf(java.lang.String, java.lang.String) disassembly (after)
+  /// CHECK:                          {{Invoke\w+}} intrinsic:StringIndexOfString
+  /// CHECK:                          repne scasw
+  /// CHECK:                          repe cmpsw
+
+  /// CHECK-START-ARM64: int Main.indexOf(java.lang.String, java.lang.String) disassembly (after)
+  /// CHECK:                          {{Invoke\w+}} intrinsic:StringIndexOfString
+  /// CHECK:                          ldrh
+  public static int indexOf(String s, String pattern) {
+    return s.indexOf(pattern);
+  }
+
+  /// CHECK-START: boolean Main.contentEquals(java.lang.String, java.lang.CharSequence) intrinsics_recognition (after)
+  /// CHECK-DAG:     <<Result:z\d+>>  {{Invoke\w+}} intrinsic:StringContentEquals
+  /// CHECK-DAG:                      Return [<<Result>>]
+
+  /// CHECK-START-X86_64: boolean Main.contentEquals(java.lang.String, java.lang.CharSequence) disassembly (after)
+  /// CHECK:                          {{Invoke\w+}} intrinsic:StringContentEquals
+  /// CHECK:                          repe cmps
+
+  /// CHECK-START-ARM64: boolean Main.contentEquals(java.lang.String, java.lang.CharSequence) disassembly (after)
+  /// CHECK:                          {{Invoke\w+}} intrinsic:StringContentEquals
+  /// CHECK:                          ldr
+  public static boolean contentEquals(String s, CharSequence cs) {
+    return s.contentEquals(cs);
+  }
+
+  public static void main(String[] args) {
+    testIndexOf();
+    testContentEquals();
+    System.out.println("passed");
+  }
+
+  private static void testIndexOf() {
+    expectEquals(0, indexOf("", ""));
+    expectEquals(0, indexOf("abc", ""));
+    expectEquals(-1, indexOf("", "a"));
+    expectEquals(-1, indexOf("ab", "abc"));
+    expectEquals(0, indexOf("abc", "abc"));
+    expectEquals(0, indexOf("abc", "a"));
+    expectEquals(2, indexOf("abc", "c"));
+    expectEquals(-1, indexOf("abc", "d"));
+    expectEquals(1, indexOf("abcabc", "bca"));
+    // Partial matches before the real match.
+    expectEquals(3, indexOf("abcabd", "abd"));
+    expectEquals(2, indexOf("aabaab", "baab"));
+    expectEquals(2, indexOf("aaaab", "aab"));
+    expectEquals(-1, indexOf("aaaaa", "aab"));
+    expectEquals(4, indexOf("\uffff\u0000\uffff\u0000\uffff\uffff", "\uffff\uffff"));
+    expectEquals(1, indexOf("\uffff\u0000\uffff", "\u0000\uffff"));
+
+    // Patterns of all lengths around a multiple of four chars, at every start, and with a
+    // mismatch at every position. The strings are not padded after the last char compared.
+    StringBuilder sb = new StringBuilder();
+    for (int i = 0; i < 40; i++) {
+      sb.append((char) ('a' + (i * 7) % 26));
+    }
+    String text = sb.toString();
+    for (int start = 0; start < text.length(); start++) {
+      for (int end = start; end <= text.length(); end++) {
+        String pattern = text.substring(start, end);
+        expectEquals(referenceIndexOf(text, pattern), indexOf(text, pattern));
+        // The pattern ends at the end of the string.
+        String prefix = text.substring(0, end);
+        expectEquals(referenceIndexOf(prefix, pattern), indexOf(prefix, pattern));
+        for (int mismatch = start; mismatch < end; mismatch++) {
+          char[] chars = pattern.toCharArray();
+          chars[mismatch - start] = '?';
+          String other = new String(chars);
+          expectEquals(-1, indexOf(text, other));
+          expectEquals(-1, indexOf(prefix, other));
+        }
+      }
+    }
+
+    try {
+      indexOf("abc", null);
+      throw new Error("Expected NullPointerException");
+    } catch (NullPointerException expected) {
+    }
+  }
+
+  private static void testContentEquals() {
+    expectEquals(true, contentEquals("", ""));
+    expectEquals(true, contentEquals("abc", "abc"));
+    expectEquals(false, contentEquals("abc", "abd"));
+    expectEquals(false, contentEquals("abc", "ab"));
+    expectEquals(false, contentEquals("ab", "abc"));
+    String s = "Hello, world!";
+    expectEquals(true, contentEquals(s, s));
+    expectEquals(true, contentEquals(s, new String(s.toCharArray())));
+
+    // Other CharSequences are compared by the Java method.
+    expectEquals(true, contentEquals("", new StringBuilder()));
+    expectEquals(true, contentEquals(s, new StringBuilder(s)));
+    expectEquals(false, contentEquals(s, new StringBuilder(s).append('!')));
+    expectEquals(true, contentEquals(s, new StringBuffer(s)));
+    expectEquals(false, contentEquals(s, new StringBuffer("Hello, World!")));
+    expectEquals(true, contentEquals(s, new CharSequenceWrapper(s)));
+    expectEquals(false, contentEquals(s, new CharSequenceWrapper("Hello")));
+
+    // Lengths around a multiple of four chars, with a mismatch at every position.
+    StringBuilder sb = new StringBuilder();
+    for (int length = 0; length <= 20; length++) {
+      String a = sb.toString();
+      String b = new String(a.toCharArray());
+      expectEquals(true, contentEquals(a, b));
+      for (int i = 0; i < length; i++) {
+        char[] chars = a.toCharArray();
+        chars[i] = '?';
+        expectEquals(false, contentEquals(a, new String(chars)));
+      }
+      sb.append((char) ('a' + length));
+    }
+
+    try {
+      contentEquals("abc", null);
+      throw new Error("Expected NullPointerException");
+    } catch (NullPointerException expected) {
+    }
+  }
+
+  private static int referenceIndexOf(String s, String pattern) {
+    for (int i = 0; i + pattern.length() <= s.length(); i++) {
+      if (s.regionMatches(i, pattern, 0, pattern.length())) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  static class CharSequenceWrapper implements CharSequence {
+    private final String s;
+
+    CharSequenceWrapper(String s) {
+      this.s = s;
+    }
+
+    public char charAt(int index) {
+      return s.charAt(index);
+    }
+
+    public int length() {
+      return s.length();
+    }
+
+    public CharSequence subSequence(int start, int end) {
+      return new CharSequenceWrapper(s.substring(start, end));
+    }
+
+    public String toString() {
+      return s;
+    }
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(boolean expected, boolean result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2016 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The run script limits the unroll factor to three.
+public class Main {
+
+  static boolean doThrow = false;
+
+  /// CHECK-START: int Main.sumSquares9() loop_optimization (before)
+  /// CHECK:     Mul
+  /// CHECK-NOT: Mul
+
+  /// CHECK-START: int Main.sumSquares9() loop_optimization (after)
+  /// CHECK:     Mul
+  /// CHECK:     Mul
+  /// CHECK:     Mul
+  /// CHECK-NOT: Mul
+
+  /// CHECK-START: int Main.sumSquares9() loop_optimization (after)
+  /// CHECK:     If
+  /// CHECK:     If
+  /// CHECK-NOT: If
+  static int sumSquares9() {
+    if (doThrow) {
+      // Try defeating inlining, the pass does not run on main(), which has try blocks.
+      throw new Error();
+    }
+    // Nine iterations: three copies of the body, without exit tests.
+    int sum = 0;
+    for (int i = 0; i < 9; i++) {
+      sum += i * i;
+    }
+    return sum;
+  }
+
+  /// CHECK-START: int Main.sumSquares10() loop_optimization (after)
+  /// CHECK:     Mul
+  /// CHECK:     Mul
+  /// CHECK-NOT: Mul
+  static int sumSquares10() {
+    if (doThrow) {
+      throw new Error();
+    }
+    // Ten iterations: three does not divide the trip count, two does.
+    int sum = 0;
+    for (int i = 0; i < 10; i++) {
+      sum += i * i;
+    }
+    return sum;
+  }
+
+  static int lastIndex;
+
+  /// CHECK-START: int Main.sumSquares(int) loop_optimization (after)
+  /// CHECK:     Mul
+  /// CHECK:     Mul
+  /// CHECK:     Mul
+  /// CHECK-NOT: Mul
+
+  /// CHECK-START: int Main.sumSquares(int) loop_optimization (after)
+  /// CHECK:     If
+  /// CHECK:     If
+  /// CHECK:     If
+  /// CHECK:     If
+  /// CHECK-NOT: If
+  static int sumSquares(int n) {
+    if (doThrow) {
+      throw new Error();
+    }
+    // Unknown trip count: every copy of the body keeps its exit test, and both loop
+    // values are used after the loop.
+    int sum = 0;
+    int i = 0;
+    for (; i < n; i++) {
+      sum += i * i;
+    }
+    lastIndex = i;
+    return sum;
+  }
+
+  /// CHECK-START: int Main.sumElement(int[], int, int) loop_optimization (before)
+  /// CHECK-DAG: NullCheck  loop:{{B\d+}}
+  /// CHECK-DAG: BoundsCheck loop:{{B\d+}}
+
+  /// CHECK-START: int Main.sumElement(int[], int, int) loop_optimization (after)
+  /// CHECK-DAG: NullCheck  loop:none
+  /// CHECK-DAG: BoundsCheck loop:none
+
+  /// CHECK-START: int Main.sumElement(int[], int, int) loop_optimization (after)
+  /// CHECK-NOT: NullCheck  loop:{{B\d+}}
+  /// CHECK-NOT: BoundsCheck loop:{{B\d+}}
+  static int sumElement(int[] a, int k, int n) {
+    if (doThrow) {
+      throw new Error();
+    }
+    // The checks of `a` and `k` are peeled out of the loop, they only throw when the
+    // loop runs at least once.
+    int sum = 0;
+    int i = 0;
+    for (; i < n; i++) {
+      sum += a[k];
+    }
+    lastIndex = i;
+    return sum;
+  }
+
+  /// CHECK-START: int Main.sumQuotient(int, int, int) loop_optimization (after)
+  /// CHECK-DAG: DivZeroCheck loop:none
+
+  /// CHECK-START: int Main.sumQuotient(int, int, int) loop_optimization (after)
+  /// CHECK-NOT: DivZeroCheck loop:{{B\d+}}
+  static int sumQuotient(int x, int d, int n) {
+    if (doThrow) {
+      throw new Error();
+    }
+    int sum = 0;
+    for (int i = 0; i < n; i++) {
+      sum += x / d;
+    }
+    return sum;
+  }
+
+  static void fill(int[] a, int n) {
+    if (doThrow) {
+      throw new Error();
+    }
+    // The null check is peeled, the bounds check stays in every unrolled copy.
+    for (int i = 0; i < n; i++) {
+      a[i] = i + 1;
+    }
+  }
+
+  public static void main(String[] args) {
+    expectEquals(204, sumSquares9());
+    expectEquals(285, sumSquares10());
+
+    for (int n = -1; n <= 20; n++) {
+      expectEquals(expectedSumSquares(n), sumSquares(n));
+      expectEquals(Math.max(n, 0), lastIndex);
+    }
+    expectEquals(expectedSumSquares(100), sumSquares(100));
+    expectEquals(100, lastIndex);
+
+    int[] a = { 3, 5, 7 };
+    for (int n = 0; n <= 7; n++) {
+      expectEquals(5 * n, sumElement(a, 1, n));
+      expectEquals(n, lastIndex);
+    }
+    // The checks do not throw when the loop does not run.
+    expectEquals(0, sumElement(null, 0, 0));
+    expectEquals(0, sumElement(a, 3, 0));
+    expectEquals(0, sumElement(a, -1, -5));
+    lastIndex = -1;
+    try {
+      sumElement(null, 0, 1);
+      throw new Error("Expected NullPointerException");
+    } catch (NullPointerException e) {
+      // Expected, the loop did not get to the end.
+      expectEquals(-1, lastIndex);
+    }
+    try {
+      sumElement(a, 3, 5);
+      throw new Error("Expected ArrayIndexOutOfBoundsException");
+    } catch (ArrayIndexOutOfBoundsException e) {
+      expectEquals(-1, lastIndex);
+    }
+    try {
+      sumElement(a, -1, 2);
+      throw new Error("Expected ArrayIndexOutOfBoundsException");
+    } catch (ArrayIndexOutOfBoundsException e) {
+      expectEquals(-1, lastIndex);
+    }
+
+    for (int n = 0; n <= 7; n++) {
+      expectEquals(3 * n, sumQuotient(10, 3, n));
+    }
+    expectEquals(0, sumQuotient(10, 0, 0));
+    try {
+      sumQuotient(10, 0, 1);
+      throw new Error("Expected ArithmeticException");
+    } catch (ArithmeticException e) {
+      // Expected.
+    }
+
+    // Bounds checks failing in an unrolled copy of the body other than the first one.
+    for (int length = 0; length <= 7; length++) {
+      for (int n = 0; n <= 9; n++) {
+        int[] b = new int[length];
+        try {
+          fill(b, n);
+          if (n > length) {
+            throw new Error("Expected ArrayIndexOutOfBoundsException");
+          }
+        } catch (ArrayIndexOutOfBoundsException e) {
+          if (n <= length) {
+            throw new Error("Unexpected ArrayIndexOutOfBoundsException");
+          }
+        }
+        for (int i = 0; i < length; i++) {
+          expectEquals(i < n ? i + 1 : 0, b[i]);
+        }
+      }
+    }
+    try {
+      fill(null, 1);
+      throw new Error("Expected NullPointerException");
+    } catch (NullPointerException e) {
+      // Expected.
+    }
+    fill(null, 0);
+
+    System.out.println("passed");
+  }
+
+  static int expectedSumSquares(int n) {
+    if (n <= 0) {
+      return 0;
+    }
+    long m = n;
+    return (int) ((m - 1) * m * (2 * m - 1) / 6);
+  }
+
+  static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
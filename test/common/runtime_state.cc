@@ -16,6 +16,7 @@
 
 #include "jni.h"
 
+#include "art_method-inl.h"
 #include "base/logging.h"
 #include "dex_file-inl.h"
 #include "mirror/class-inl.h"
@@ -38,6 +39,26 @@ extern "C" JNIEXPORT jboolean JNICALL Java_Main_hasOatFile(JNIEnv* env, jclass c
   return (oat_dex_file != nullptr) ? JNI_TRUE : JNI_FALSE;
 }
 
+// public static native boolean isFastNative(Method m);
+
+extern "C" JNIEXPORT jboolean JNICALL Java_Main_isFastNative(JNIEnv* env,
+                                                             jclass cls ATTRIBUTE_UNUSED,
+                                                             jobject method) {
+  jmethodID method_id = env->FromReflectedMethod(method);
+  ScopedObjectAccess soa(env);
+  ArtMethod* art_method = soa.DecodeMethod(method_id);
+  return art_method->IsFastNative() ? JNI_TRUE : JNI_FALSE;
+}
+
+// public static native boolean isClassVerified(Class<?> klass);
+
+extern "C" JNIEXPORT jboolean JNICALL Java_Main_isClassVerified(JNIEnv* env,
+                                                                jclass cls ATTRIBUTE_UNUSED,
+                                                                jclass klass) {
+  ScopedObjectAccess soa(env);
+  return soa.Decode<mirror::Class*>(klass)->IsVerified() ? JNI_TRUE : JNI_FALSE;
+}
+
 // public static native boolean runtimeIsSoftFail();
 
 extern "C" JNIEXPORT jboolean JNICALL Java_Main_runtimeIsSoftFail(JNIEnv* env ATTRIBUTE_UNUSED,